@@ -24,9 +24,31 @@
 #include <phTmlNfc.h>
 #include <phNxpLog.h>
 #include <dlfcn.h>
+#include <stdio.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <nci_config.h>
 
 #define NXP_NFC_FW_STORE_PATH_SIZE  0x100
 
+/* Record of the last loaded firmware image, so an unchanged image is not loaded again
+ * just to read its version. Kept in the stack storage directory (NFA_STORAGE). */
+#define NXP_NFC_FW_IMG_CACHE_NAME   "/nxpFwImgCache.bin"
+#define NXP_NFC_FW_IMG_CACHE_DIR    "/usr/local/lib/"
+#define PHDNLDNFC_IMG_CACHE_MAGIC   (0x31474D49U)   /* "IMG1" */
+
+typedef struct phDnldNfc_ImgCache
+{
+    uint32_t dwMagic;       /* PHDNLDNFC_IMG_CACHE_MAGIC */
+    uint64_t qwDev;         /* device, inode, size and mtime of the image file */
+    uint64_t qwIno;
+    uint64_t qwSize;
+    int64_t  qwMtime;
+    uint32_t dwHash;        /* FNV-1a hash of the image file contents */
+    uint16_t wFwVer;        /* FW version in the image */
+}phDnldNfc_ImgCache_t;
+
 static void *pFwLibHandle; /* Global firmware lib handle used in this file only */
 
 static char nfcFwStore[NXP_NFC_FW_STORE_PATH_SIZE];
@@ -47,6 +69,9 @@ static void*                   UserCtxt; /* Pointer to upper layer context */
 /* Function prototype declaration */
 static void phDnldNfc_ReadComplete(void* pContext, NFCSTATUS status, void* pInfo);
 static char *phDnldNfc_GetFwPath(bool_t ignore_cfg);
+static NFCSTATUS phDnldNfc_HashImgFile(const char* pathName, uint32_t *pHash);
+static void phDnldNfc_UpdateImgCache(const char* pathName, uint16_t wImgFwVer);
+static bool_t phDnldNfc_GetImgCachePath(char *pCachePath, size_t size);
 
 /*******************************************************************************
 **
@@ -501,6 +526,8 @@ NFCSTATUS phDnldNfc_Write(bool_t  bRecoverSeq, pphDnldNfc_Buff_t pData, pphDnldN
 
                 memset(&(gpphDnldContext->tRWInfo),0,sizeof(gpphDnldContext->tRWInfo));
                 (gpphDnldContext->tRWInfo.bFirstWrReq) = TRUE;
+                clock_gettime(CLOCK_MONOTONIC, &(gpphDnldContext->tWrStartTime));
+                (gpphDnldContext->dwWrNextReport) = wLen / PHDNLDNFC_WR_REPORT_STEPS;
                 (gpphDnldContext->UserCb) = pNotify;
                 (gpphDnldContext->UserCtxt) = pContext;
 
@@ -929,6 +956,11 @@ NFCSTATUS phDnldNfc_InitImgInfo(void)
            /* get the FW version */
            wFwVer = (((uint16_t)(gpphDnldContext->nxp_nfc_fw[5]) << 8U) | (gpphDnldContext->nxp_nfc_fw[4]));
            wStatus = NFCSTATUS_SUCCESS;
+
+           if (gRecFWDwnld != TRUE)
+           {
+               phDnldNfc_UpdateImgCache(pathName, wFwVer);
+           }
        }
        else
        {
@@ -940,6 +972,202 @@ NFCSTATUS phDnldNfc_InitImgInfo(void)
    return wStatus;
 }
 
+/*******************************************************************************
+**
+** Function         phDnldNfc_HashImgFile
+**
+** Description      Computes the FNV-1a hash of a firmware image file
+**
+** Parameters       pathName - Firmware image path
+**                  pHash    - receives the hash
+**
+** Returns          NFC status
+**
+*******************************************************************************/
+static NFCSTATUS phDnldNfc_HashImgFile(const char* pathName, uint32_t *pHash)
+{
+    uint8_t aBuff[4096];
+    uint32_t dwHash = 0x811C9DC5U;
+    size_t len, i;
+    FILE *pFile = fopen(pathName, "rb");
+
+    if (pFile == NULL)
+    {
+        return NFCSTATUS_FAILED;
+    }
+    while ((len = fread(aBuff, 1, sizeof(aBuff), pFile)) > 0)
+    {
+        for (i = 0; i < len; i++)
+        {
+            dwHash = (dwHash ^ aBuff[i]) * 0x01000193U;
+        }
+    }
+    fclose(pFile);
+    (*pHash) = dwHash;
+    return NFCSTATUS_SUCCESS;
+}
+
+/*******************************************************************************
+**
+** Function         phDnldNfc_GetImgCachePath
+**
+** Description      Builds the path of the firmware image record, in the stack
+**                  storage directory that only the NFC service can write
+**
+** Parameters       pCachePath - receives the path
+**                  size       - size of pCachePath
+**
+** Returns          TRUE if the path fits in pCachePath
+**
+*******************************************************************************/
+static bool_t phDnldNfc_GetImgCachePath(char *pCachePath, size_t size)
+{
+    char storeDir[NXP_NFC_FW_STORE_PATH_SIZE];
+    int len;
+
+    if (!GetStrValue(NAME_NFA_STORAGE, storeDir, sizeof(storeDir)))
+    {
+        strcpy(storeDir, NXP_NFC_FW_IMG_CACHE_DIR);
+    }
+    len = snprintf(pCachePath, size, "%s%s", storeDir, NXP_NFC_FW_IMG_CACHE_NAME);
+    return ((len > 0) && ((size_t)len < size)) ? TRUE : FALSE;
+}
+
+/*******************************************************************************
+**
+** Function         phDnldNfc_UpdateImgCache
+**
+** Description      Records the firmware image file and the FW version it holds,
+**                  for phDnldNfc_GetCachedFwVer
+**
+** Parameters       pathName  - Firmware image path
+**                  wImgFwVer - FW version in the image
+**
+** Returns          None
+**
+*******************************************************************************/
+static void phDnldNfc_UpdateImgCache(const char* pathName, uint16_t wImgFwVer)
+{
+    phDnldNfc_ImgCache_t tCache;
+    struct stat st;
+    int fd;
+    bool_t bWritten;
+    char cachePath[NXP_NFC_FW_STORE_PATH_SIZE + sizeof(NXP_NFC_FW_IMG_CACHE_NAME)];
+    char tmpPath[sizeof(cachePath) + 4];
+
+    memset(&tCache, 0, sizeof(tCache));
+    if ((pathName == NULL) || (stat(pathName, &st) != 0) ||
+        (NFCSTATUS_SUCCESS != phDnldNfc_HashImgFile(pathName, &tCache.dwHash)))
+    {
+        return;
+    }
+    tCache.dwMagic = PHDNLDNFC_IMG_CACHE_MAGIC;
+    tCache.qwDev = st.st_dev;
+    tCache.qwIno = st.st_ino;
+    tCache.qwSize = st.st_size;
+    tCache.qwMtime = st.st_mtime;
+    tCache.wFwVer = wImgFwVer;
+
+    if (!phDnldNfc_GetImgCachePath(cachePath, sizeof(cachePath)))
+    {
+        return;
+    }
+
+    /* write aside and rename, so a reader never sees a partial record; the
+     * temporary file is created anew and never opened through a symlink */
+    snprintf(tmpPath, sizeof(tmpPath), "%s.tmp", cachePath);
+    unlink(tmpPath);
+    fd = open(tmpPath, O_WRONLY | O_CREAT | O_EXCL | O_NOFOLLOW, S_IRUSR | S_IWUSR);
+    if (fd < 0)
+    {
+        NXPLOG_FWDNLD_W("Cannot write FW image cache %s", tmpPath);
+        return;
+    }
+    bWritten = (write(fd, &tCache, sizeof(tCache)) == (ssize_t)sizeof(tCache));
+    if ((close(fd) != 0) || (bWritten == FALSE) ||
+        (rename(tmpPath, cachePath) != 0))
+    {
+        NXPLOG_FWDNLD_W("Cannot write FW image cache %s", cachePath);
+        unlink(tmpPath);
+    }
+}
+
+/*******************************************************************************
+**
+** Function         phDnldNfc_GetCachedFwVer
+**
+** Description      Gets the FW version of the firmware image without loading it,
+**                  if the image file is the one recorded when it was last loaded.
+**                  The file is identified by its device, inode, size and mtime;
+**                  if those changed, its contents are hashed and compared instead.
+**
+** Parameters       pFwVer - receives the FW version of the image
+**
+** Returns          NFCSTATUS_SUCCESS if the image is unchanged, NFCSTATUS_FAILED
+**                  if it must be loaded with phDnldNfc_InitImgInfo
+**
+*******************************************************************************/
+NFCSTATUS phDnldNfc_GetCachedFwVer(uint16_t *pFwVer)
+{
+    phDnldNfc_ImgCache_t tCache;
+    struct stat st;
+    uint32_t dwHash = 0;
+    char* pathName = NULL;
+    char cachePath[NXP_NFC_FW_STORE_PATH_SIZE + sizeof(NXP_NFC_FW_IMG_CACHE_NAME)];
+    int fd;
+
+    if ((pFwVer == NULL) || (gRecFWDwnld == TRUE) ||
+        !phDnldNfc_GetImgCachePath(cachePath, sizeof(cachePath)))
+    {
+        return NFCSTATUS_FAILED;
+    }
+
+    fd = open(cachePath, O_RDONLY | O_NOFOLLOW);
+    if (fd < 0)
+    {
+        return NFCSTATUS_FAILED;
+    }
+    /* only trust a record written by this service */
+    if ((fstat(fd, &st) != 0) || !S_ISREG(st.st_mode) ||
+        (st.st_uid != geteuid()) || (st.st_mode & (S_IWGRP | S_IWOTH)))
+    {
+        NXPLOG_FWDNLD_W("Ignoring untrusted FW image cache %s", cachePath);
+        close(fd);
+        return NFCSTATUS_FAILED;
+    }
+    if ((read(fd, &tCache, sizeof(tCache)) != (ssize_t)sizeof(tCache)) ||
+        (tCache.dwMagic != PHDNLDNFC_IMG_CACHE_MAGIC))
+    {
+        close(fd);
+        return NFCSTATUS_FAILED;
+    }
+    close(fd);
+
+    pathName = phDnldNfc_GetFwPath(FALSE);
+    if (stat(pathName, &st) != 0)
+    {
+        return NFCSTATUS_FAILED;
+    }
+
+    if ((tCache.qwDev != (uint64_t)st.st_dev) || (tCache.qwIno != (uint64_t)st.st_ino) ||
+        (tCache.qwSize != (uint64_t)st.st_size) || (tCache.qwMtime != (int64_t)st.st_mtime))
+    {
+        /* file replaced or touched: only its contents decide */
+        if ((tCache.qwSize != (uint64_t)st.st_size) ||
+            (NFCSTATUS_SUCCESS != phDnldNfc_HashImgFile(pathName, &dwHash)) ||
+            (dwHash != tCache.dwHash))
+        {
+            NXPLOG_FWDNLD_D("FW image %s changed", pathName);
+            return NFCSTATUS_FAILED;
+        }
+        phDnldNfc_UpdateImgCache(pathName, tCache.wFwVer);
+    }
+
+    NXPLOG_FWDNLD_D("FW image %s unchanged, FW version 0x%x", pathName, tCache.wFwVer);
+    (*pFwVer) = tCache.wFwVer;
+    return NFCSTATUS_SUCCESS;
+}
+
 /*******************************************************************************
 **
 ** Function         phDnldNfc_LoadRecInfo
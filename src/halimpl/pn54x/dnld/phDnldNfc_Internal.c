@@ -76,6 +76,7 @@ static NFCSTATUS phDnldNfc_SetupResendTimer(pphDnldNfc_DlContext_t pDlContext);
 static NFCSTATUS phDnldNfc_UpdateRsp(pphDnldNfc_DlContext_t   pDlContext, phTmlNfc_TransactInfo_t  *pInfo, uint16_t wPldLen);
 static void phDnldNfc_RspTimeOutCb(uint32_t TimerId, void *pContext);
 static void phDnldNfc_ResendTimeOutCb(uint32_t TimerId, void *pContext);
+static void phDnldNfc_ReportWrProgress(pphDnldNfc_DlContext_t pDlCtxt, bool_t bDone);
 
 /*
 *************************** Function Definitions ***************************
@@ -502,6 +503,11 @@ static void phDnldNfc_ProcessRWSeqState(void *pContext, phTmlNfc_TransactInfo_t
 
                 if((0 != (pDlCtxt->tRWInfo.wRemBytes)) && (NFCSTATUS_SUCCESS == wStatus))
                 {
+                    if(phDnldNfc_EventWrite == pDlCtxt->tCurrEvent)
+                    {
+                        phDnldNfc_ReportWrProgress(pDlCtxt, FALSE);
+                    }
+
                     /* Abort TML read operation which is always kept open */
                     wIntStatus  = phTmlNfc_ReadAbort();
 
@@ -530,6 +536,11 @@ static void phDnldNfc_ProcessRWSeqState(void *pContext, phTmlNfc_TransactInfo_t
                 }
                 else
                 {
+                    if((phDnldNfc_EventWrite == pDlCtxt->tCurrEvent) && (NFCSTATUS_SUCCESS == wStatus))
+                    {
+                        phDnldNfc_ReportWrProgress(pDlCtxt, TRUE);
+                    }
+
                     (pDlCtxt->tRWInfo.bFramesSegmented) = FALSE;
                     /* Abort TML read operation which is always kept open */
                     wIntStatus  = phTmlNfc_ReadAbort();
@@ -1335,3 +1346,48 @@ static NFCSTATUS phDnldNfc_UpdateRsp(pphDnldNfc_DlContext_t   pDlContext, phTmlN
 
     return wStatus;
 }
+
+/*******************************************************************************
+**
+** Function         phDnldNfc_ReportWrProgress
+**
+** Description      Prints the image write progress with throughput and ETA,
+**                  PHDNLDNFC_WR_REPORT_STEPS times per image, and a summary
+**                  once the image is written
+**
+** Parameters       pDlCtxt - pointer to the download context structure
+**                  bDone   - TRUE once the last write frame is acknowledged
+**
+** Returns          None
+**
+*******************************************************************************/
+static void phDnldNfc_ReportWrProgress(pphDnldNfc_DlContext_t pDlCtxt, bool_t bDone)
+{
+    struct timespec tNow;
+    uint32_t dwTotal = (pDlCtxt->tUserData.wLen);
+    uint32_t dwDone = dwTotal - (pDlCtxt->tRWInfo.wRemBytes);
+    uint32_t dwElapsedMs;
+    uint32_t dwRate;
+
+    if((FALSE == bDone) && (dwDone < (pDlCtxt->dwWrNextReport)))
+    {
+        return;
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &tNow);
+    dwElapsedMs = (uint32_t)(((tNow.tv_sec - pDlCtxt->tWrStartTime.tv_sec) * 1000) +
+                    ((tNow.tv_nsec - pDlCtxt->tWrStartTime.tv_nsec) / 1000000));
+    dwRate = (0 != dwElapsedMs) ? (uint32_t)(((uint64_t)dwDone * 1000) / dwElapsedMs) : 0;
+
+    if(TRUE == bDone)
+    {
+        NXPLOG_FWDNLD_D("FW image written: %u bytes in %u ms, %u bytes/s", dwDone, dwElapsedMs, dwRate);
+    }
+    else
+    {
+        NXPLOG_FWDNLD_D("FW write %u/%u bytes (%u%%), %u bytes/s, ETA %u ms", dwDone, dwTotal,
+                (dwDone * 100) / dwTotal, dwRate,
+                (0 != dwRate) ? (uint32_t)(((uint64_t)(dwTotal - dwDone) * 1000) / dwRate) : 0);
+        (pDlCtxt->dwWrNextReport) = dwDone + (dwTotal / PHDNLDNFC_WR_REPORT_STEPS);
+    }
+}
@@ -24,14 +24,21 @@
 #include <phDnldNfc_Cmd.h>
 #include <phDnldNfc_Status.h>
 #include <phNxpNciHal.h>
+#include <time.h>
 
-#define PHDNLDNFC_CMDRESP_MAX_BUFF_SIZE   (0x100U)  /* DL Host Frame Buffer Size for all CMD/RSP
-                                                         except pipelined WRITE */
+/* DL Host Frame Buffer Size for all CMD/RSP except pipelined WRITE. Builds for controllers
+ * accepting longer download frames may raise it, up to the I2C fragment size, to stream the
+ * image in fewer fragments */
+#ifndef PHDNLDNFC_CMDRESP_MAX_BUFF_SIZE
+#define PHDNLDNFC_CMDRESP_MAX_BUFF_SIZE   (0x100U)
+#endif
 #if ( PHDNLDNFC_CMDRESP_MAX_BUFF_SIZE > PHNFC_I2C_FRAGMENT_SIZE )
 #undef PHDNLDNFC_CMDRESP_MAX_BUFF_SIZE
 #define PHDNLDNFC_CMDRESP_MAX_BUFF_SIZE   (PHNFC_I2C_FRAGMENT_SIZE)
 #endif
 
+#define PHDNLDNFC_WR_REPORT_STEPS     (8U)      /* Number of progress reports printed during an image write */
+
 #define PHDNLDNFC_WRITERSP_BUFF_SIZE  (0x08U)   /* DL Host Short Frame Buffer Size for pipelined WRITE RSP */
 
 #define PHDNLDNFC_FRAME_HDR_LEN  (0x02U)   /* DL Host Frame Buffer Header Length */
@@ -174,6 +181,8 @@ typedef struct phDnldNfc_DlContext
     phDnldNfc_Buff_t        tTKey;                 /* Defualt Transport Key provided by caller */
     phDnldNfc_RWInfo_t      tRWInfo;               /* Read/Write segmented frame info */
     phDnldNfc_Status_t      tLastStatus;           /* saved status to distinguish signature or pltform recovery */
+    struct timespec         tWrStartTime;          /* start of the image write, for the throughput report */
+    uint32_t                dwWrNextReport;        /* image offset at which the next write progress report is due */
 }phDnldNfc_DlContext_t,*pphDnldNfc_DlContext_t; /* pointer to #phDnldNfc_DlContext_t structure */
 
 /* The phDnldNfc_CmdHandler function declaration */
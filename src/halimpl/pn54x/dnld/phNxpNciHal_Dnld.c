@@ -328,7 +328,6 @@ static void phNxpNciHal_fw_dnld_normal_cb(void* pContext, NFCSTATUS status,
     p_cb_data->status = status;
 
     SEM_POST(p_cb_data);
-    usleep(1000 * 10);
 
     return;
 }
@@ -364,7 +363,6 @@ static void phNxpNciHal_fw_dnld_force_cb(void* pContext, NFCSTATUS status,
     p_cb_data->status = status;
 
     SEM_POST(p_cb_data);
-    usleep(1000 * 10);
 
     return;
 }
@@ -580,7 +580,12 @@ init_retry:
     }
     phNxpNciHal_enable_i2c_fragmentation();
     /*Get FW version from device*/
-    status = phDnldNfc_InitImgInfo();
+    status = phDnldNfc_GetCachedFwVer(&wFwVer);
+    if ((status != NFCSTATUS_SUCCESS) || ((wFwVerRsp & 0x0000FFFF) != wFwVer))
+    {
+        /* image changed or device differs: load the image itself */
+        status = phDnldNfc_InitImgInfo();
+    }
     NXPLOG_NCIHAL_D ("FW version for FW file = 0x%x", wFwVer);
     NXPLOG_NCIHAL_D ("FW version from device = 0x%x", wFwVerRsp);
     if ((wFwVerRsp & 0x0000FFFF) == wFwVer)
@@ -110,6 +110,7 @@ int isNxpConfigValid(unsigned long type);
 #define NAME_TxDO_MEASUREDRANGE_TOLERANCE            "TxDO_MEASUREDRANGE_TOLERANCE"
  /* Agc Values */
 #define NAME_NXP_AGC_DEBUG_ENABLE                    "NXP_AGC_DEBUG_ENABLE"
+#define NAME_NXP_AGC_DEBUG_INTERVAL                  "NXP_AGC_DEBUG_INTERVAL"
 #define NAME_AGC_VALUE                               "AGC_VALUE"
 #define NAME_AGC_VALUE_TOLERANCE                     "AGC_VALUE_TOLERANCE"
  /* Agc Values with fixed NFCLD Level*/
@@ -87,6 +87,14 @@ extern "C" {
 #define NFA_PROTOCOL_MIFARE             0x80
 typedef unsigned char tNFC_PROTOCOL;
 
+/* MIFARE Classic authentication key types */
+#define MFC_KEY_A                       0x60
+#define MFC_KEY_B                       0x61
+/* MIFARE Classic sector status */
+#define MFC_SECTOR_OK                   0x00
+#define MFC_SECTOR_AUTH_FAILED          0x01
+#define MFC_SECTOR_IO_FAILED            0x02
+
 /**
  *  \brief setting this flag allows host application ignore
  *  an NDEF check command from reader
@@ -191,6 +199,21 @@ typedef struct
 
 }nfc_tag_info_t;
 
+/**
+ * \brief MIFARE Classic sector key structure definition.
+ */
+typedef struct
+{
+    /**
+     *  \brief key type, MFC_KEY_A or MFC_KEY_B
+     */
+    unsigned char key_type;
+    /**
+     *  \brief the key value
+     */
+    unsigned char key[6];
+}nfc_mfc_key_t;
+
 /**
  * \brief NFC NDEF Message information structure definition.
  */
@@ -352,6 +375,41 @@ typedef struct {
     void (*onTagDeparture) (void);
 }nfcTagCallback_t;
 
+/**
+ * \brief NFC Tag streaming NDEF read callback function definition.\n
+ *        Called from the stack thread for each segment of NDEF message; it must not
+ *        call any other API of this library.
+ * \param data          segment of NDEF message (only valid during the callback)
+ * \param data_length   segment length
+ * \param offset        offset of the segment in the NDEF message
+ * \param total_length  total length of the NDEF message
+ * \param context       context given to nfcTag_readNdefStream()
+ * \return 0 to continue reading, any other value to stop reading
+ */
+typedef int (nfcTagNdefSegmentCallback_t) (unsigned char *data, unsigned int data_length,
+                                unsigned int offset, unsigned int total_length, void *context);
+
+/**
+ * \brief NFC SNEP client PUT completion callback function definition.\n
+ *        Called from the stack thread. Messages still queued when the P2P link goes down are
+ *        failed from the stack thread too, but those still queued on nfcSnep_deregisterClientCallback()
+ *        or nfcManager_doDeinitialize() are failed from the thread calling it, before it returns.
+ *        In either case it must not call any other API of this library.
+ * \param status        0 if the remote server accepted the message, otherwise -1
+ * \param context       context given to nfcSnep_putMessageAsync()
+ */
+typedef void (nfcSnepPutCallback_t) (int status, void *context);
+
+/**
+ * \brief NFC LLCP connectionless data callback function definition.\n
+ *        Called from the stack thread for each received UI PDU instead of queueing it;
+ *        it must not call any other API of this library.
+ * \param remote_sap    SAP of the remote service which sent the message
+ * \param data          LLCP message (only valid during the callback)
+ * \param length        LLCP message length
+ */
+typedef void (nfcLlcpConnLessDataCallback_t) (unsigned char remote_sap, unsigned char *data, unsigned int length);
+
 /**
  * \brief NFC SNEP server callback function structure definition.
  */
@@ -409,6 +467,120 @@ typedef struct {
     void (*onDeviceDeparture) (void);
 }nfcSnepClientCallback_t, nfcllcpConnlessClientCallback_t;
 
+/**
+ * \brief LLCP connectionless receive queue statistics structure definition.
+ */
+typedef struct
+{
+    /**
+     *  \brief number of messages received from the remote device
+     */
+    unsigned int received;
+    /**
+     *  \brief number of messages dropped (oldest first) because the queue was full
+     */
+    unsigned int dropped;
+    /**
+     *  \brief number of messages waiting in the queue, and the highest number seen
+     */
+    unsigned int queued;
+    unsigned int max_queued;
+    /**
+     *  \brief maximum number of messages the queue holds
+     */
+    unsigned int queue_size;
+}nfc_llcp_connless_rx_stats_t;
+
+/**
+ * \brief LLCP link, SNEP and Connection Handover data link parameters structure definition.
+ */
+typedef struct
+{
+    /**
+     *  \brief local link MIU, 128 to 2175 and not bigger than the stack buffers allow
+     */
+    unsigned short link_miu;
+    /**
+     *  \brief local link timeout (LTO) in ms, 10 to 2550
+     */
+    unsigned short link_timeout;
+    /**
+     *  \brief response waiting time index (WT) sent in ATR_RES, 0 to 14
+     */
+    unsigned char waiting_time;
+    /**
+     *  \brief delay in ms before answering a SYMM PDU when there is nothing to send
+     */
+    unsigned short symm_delay;
+    /**
+     *  \brief MIU of SNEP data link connections, 128 to 2175
+     */
+    unsigned short snep_miu;
+    /**
+     *  \brief receive window (RW) of SNEP data link connections, 1 to 15
+     */
+    unsigned char snep_rw;
+    /**
+     *  \brief MIU of Connection Handover data link connections, 128 to 2175
+     */
+    unsigned short cho_miu;
+    /**
+     *  \brief receive window (RW) of Connection Handover data link connections, 1 to 15
+     */
+    unsigned char cho_rw;
+}nfc_llcp_config_t;
+
+/**
+ * \brief LLCP link statistics structure definition.
+ */
+typedef struct
+{
+    /**
+     *  \brief 1 if the link is still activated, 0 if these are the statistics of the last link
+     */
+    unsigned char is_activated;
+    /**
+     *  \brief negotiated link MIU of local and remote device
+     */
+    unsigned short local_link_miu;
+    unsigned short remote_link_miu;
+    /**
+     *  \brief link timeout of remote device in ms
+     */
+    unsigned short remote_link_timeout;
+    /**
+     *  \brief well-known services of remote device
+     */
+    unsigned short remote_wks;
+    /**
+     *  \brief time the link has been (or was) activated in ms
+     */
+    unsigned int duration;
+    /**
+     *  \brief number of LLC PDUs sent and received, and how many of them were SYMM
+     */
+    unsigned int tx_pdus;
+    unsigned int rx_pdus;
+    unsigned int tx_symm_pdus;
+    unsigned int rx_symm_pdus;
+    /**
+     *  \brief bytes of payload sent and received in I and UI PDUs
+     */
+    unsigned int tx_bytes;
+    unsigned int rx_bytes;
+    /**
+     *  \brief payload bytes per second over the link duration
+     */
+    unsigned int tx_throughput;
+    unsigned int rx_throughput;
+    /**
+     *  \brief number of measured PDU round trips, their average and maximum in ms
+     */
+    unsigned int rtt_count;
+    unsigned int rtt_avg;
+    unsigned int rtt_max;
+}nfc_llcp_link_stats_t;
+
 /**
  *  \brief Host card emulation callback function structure definition.
  */
@@ -432,6 +604,156 @@ typedef struct {
     void (*onDataReceived)(unsigned char *data, unsigned int data_length);
 }nfcHostCardEmulationCallback_t;
 
+/**
+ *  \brief Host card emulation statistics structure definition, reset at each activation.
+ */
+typedef struct
+{
+    /**
+     *  \brief number of C-APDUs given to onDataReceived, and how many of them were chained
+     */
+    unsigned int apdu_count;
+    unsigned int chained_count;
+    /**
+     *  \brief number of C-APDUs dropped because they were too long
+     */
+    unsigned int dropped_count;
+    /**
+     *  \brief number of R-APDUs sent
+     */
+    unsigned int response_count;
+    /**
+     *  \brief time from receiving a C-APDU to sending its R-APDU in us: last, average and maximum
+     */
+    unsigned int last_turnaround_us;
+    unsigned int avg_turnaround_us;
+    unsigned int max_turnaround_us;
+    /**
+     *  \brief number of C-APDUs answered and not answered by responses added with nfcHce_addApduResponse()
+     */
+    unsigned int cache_hits;
+    unsigned int cache_misses;
+}nfc_hce_stats_t;
+
+#define NFC_POLL_STATS_NUM_TECH    8
+
+/**
+ *  \brief Polling statistics, see nfcManager_getPollingStats()
+ */
+typedef struct
+{
+    /**
+     *  \brief 1 if adaptive polling is enabled
+     */
+    unsigned int adaptive;
+    /**
+     *  \brief reader mode activations per technology: A, B, F, A active, F active, ISO15693, B', Kovio
+     */
+    unsigned int activations[NFC_POLL_STATS_NUM_TECH];
+    /**
+     *  \brief number of discovery starts, and how many of them polled every technology as configured
+     */
+    unsigned int discovery_starts;
+    unsigned int sweeps;
+    /**
+     *  \brief time from (re)starting discovery to the next reader mode activation in ms: samples, last, min, max and average
+     */
+    unsigned int ttfa_count;
+    unsigned int ttfa_last_ms;
+    unsigned int ttfa_min_ms;
+    unsigned int ttfa_max_ms;
+    unsigned int ttfa_avg_ms;
+}nfc_polling_stats_t;
+
+/**
+ *  \brief Kinds of stack work timed by the stall watch, see nfc_stall_info_t
+ */
+#define NFC_STALL_KIND_WAIT     1
+#define NFC_STALL_KIND_MBOX     2
+#define NFC_STALL_KIND_EVENT    3
+
+/**
+ *  \brief Time spent by a stack task on one kind of work, see nfcManager_getStallReport()
+ */
+typedef struct
+{
+    /**
+     *  \brief stack task that did the work
+     */
+    unsigned int task;
+    /**
+     *  \brief NFC_STALL_KIND_WAIT: events a task woke up for, id is the event mask;
+     *          NFC_STALL_KIND_MBOX: message read from a task mailbox, id is the mailbox;
+     *          NFC_STALL_KIND_EVENT: message dispatched by the NFA layer, id is its event
+     */
+    unsigned int kind;
+    unsigned int id;
+    /**
+     *  \brief number of times the work was timed, and how many of them exceeded the stall budget
+     */
+    unsigned int count;
+    unsigned int over_budget;
+    /**
+     *  \brief worst case and average duration in microseconds
+     */
+    unsigned int max_us;
+    unsigned int avg_us;
+}nfc_stall_info_t;
+
+/**
+ *  \brief What made the NFCC take an RF telemetry sample, see nfc_rf_telemetry_t
+ */
+#define NFC_RF_TELEMETRY_TRIGGER_FIELD_ON   1
+#define NFC_RF_TELEMETRY_TRIGGER_ACTIVATED  2
+#define NFC_RF_TELEMETRY_TRIGGER_PERIODIC   3
+
+#define NFC_RF_TELEMETRY_MAX_RAW            252
+
+/**
+ *  \brief RF telemetry sample, taken from the NFCC AGC debug response
+ */
+typedef struct
+{
+    /**
+     *  \brief incremented for every sample; a gap means samples were dropped from the ring
+     */
+    unsigned int sequence;
+    /**
+     *  \brief monotonic time stamp in ms
+     */
+    unsigned int timestamp_ms;
+    /**
+     *  \brief NFC_RF_TELEMETRY_TRIGGER_xxx
+     */
+    unsigned char trigger;
+    /**
+     *  \brief 1 if a remote reader field was present, 1 if a remote device was activated
+     */
+    unsigned char field_on;
+    unsigned char activated;
+    /**
+     *  \brief NCI status of the response; raw is only valid if 0
+     */
+    unsigned char status;
+    /**
+     *  \brief response payload following the status, as reported by the NFCC;
+     *         its layout is NFCC firmware specific and not decoded here
+     */
+    unsigned char raw_len;
+    unsigned char raw[NFC_RF_TELEMETRY_MAX_RAW];
+}nfc_rf_telemetry_t;
+
+/**
+ *  \brief RF telemetry callback function structure definition.
+ */
+typedef struct {
+    /**
+     * \brief Called for every new sample, from the stack task; must not block.
+     * \param sample      the sample
+     */
+    void (*onRfTelemetry)(nfc_rf_telemetry_t *sample);
+}nfcRfTelemetryCallback_t;
+
 /**
  *  \brief Handover callback functions structure definition.
  */
@@ -493,9 +815,9 @@ extern int ndef_readHandoverRequestInfo(unsigned char *ndef_buff, unsigned int n
 /**
 * \brief Create a new NDEF Record containing a URI.
 * \param uri:  the uri to be written
-* \param out_ndef_buff:  the buffer to store ndef message
+* \param out_ndef_buff:  the buffer to store ndef message, or NULL to get the size needed
 * \param out_ndef_buff_length:  the length of ndef buffer
-* \return the length of NDEF buffer be used.
+* \return the length of NDEF buffer be used (or needed if out_ndef_buff is NULL), 0 if failed.
 */
 extern int ndef_createUri(char *uri, unsigned char *out_ndef_buff, unsigned int out_ndef_buff_length);
 
@@ -503,9 +825,9 @@ extern int ndef_createUri(char *uri, unsigned char *out_ndef_buff, unsigned int
 * \brief Create a new NDEF Record containing a text.
 * \param language_code:  language encoding code
 * \param text:  text to be written
-* \param out_ndef_buff:  the buffer to store ndef message
+* \param out_ndef_buff:  the buffer to store ndef message, or NULL to get the size needed
 * \param out_ndef_buff_length:  the length of ndef buffer
-* \return the length of NDEF buffer be used.
+* \return the length of NDEF buffer be used (or needed if out_ndef_buff is NULL), 0 if failed.
 */
 extern int ndef_createText(char *language_code, char *text,
                                                     unsigned char *out_ndef_buff, unsigned int out_ndef_buff_length);
@@ -515,9 +837,9 @@ extern int ndef_createText(char *language_code, char *text,
 * \param mime_type:    a valid MIME type
 * \param mime_data:  MIME data as bytes array
 * \param mime_data_length:  MIME data length
-* \param out_ndef_buff:  the buffer to store ndef message
+* \param out_ndef_buff:  the buffer to store ndef message, or NULL to get the size needed
 * \param out_ndef_buff_length:  the length of ndef buffer
-* \return the length of NDEF buffer be used.
+* \return the length of NDEF buffer be used (or needed if out_ndef_buff is NULL), 0 if failed.
 */
 extern int ndef_createMime(char *mime_type, unsigned char *mime_data, unsigned int mime_data_length,
                                                     unsigned char *out_ndef_buff, unsigned int out_ndef_buff_length);
@@ -528,9 +850,9 @@ extern int ndef_createMime(char *mime_type, unsigned char *mime_data, unsigned i
 * \param carrier_data_ref:  carrier data reference name
 * \param ndef_buff:  carrier configuration record
 * \param ndef_buff_length:  carrier configuration record length
-* \param out_ndef_buff:  the buffer to store handover select message
+* \param out_ndef_buff:  the buffer to store handover select message, or NULL to get the size needed
 * \param out_ndef_buff_length:  the length of handover select message
-* \return the length of NDEF buffer be used.
+* \return the length of NDEF buffer be used (or needed if out_ndef_buff is NULL), 0 if failed.
 */
 extern int ndef_createHandoverSelect(nfc_handover_cps_t cps, char *carrier_data_ref,
                                 unsigned char *ndef_buff, unsigned int ndef_buff_length, unsigned char *out_ndef_buff, unsigned int out_ndef_buff_length);
@@ -555,6 +877,71 @@ extern int nfcTag_isNdef(unsigned int handle, ndef_info_t *info);
 */
 extern int nfcTag_readNdef(unsigned int handle, unsigned char *ndef_buffer,  unsigned int ndef_buffer_length, nfc_friendly_type_t *friendly_ndef_type);
 
+/**
+* \brief Read ndef message from tag in streaming mode.\n
+*        Each segment of the ndef message is passed to callback as soon as it is read from
+*        the tag (no need for a buffer of the whole message). Callback may stop the read
+*        once it has the records it needs.
+* \param handle:  handle to the tag.
+* \param callback:  function called for each segment of ndef message
+* \param context:  passed back to callback
+* \return the number of bytes delivered to callback if success, otherwise -1.
+*
+*/
+extern int nfcTag_readNdefStream(unsigned int handle, nfcTagNdefSegmentCallback_t *callback, void *context);
+
+/**
+* \brief Read blocks of a FeliCa (Type 3) tag.\n
+*        Blocks may belong to different services. They are read with as few CHECK
+*        commands as the tag accepts.
+* \param handle:  handle to the tag.
+* \param service_codes:  service code of each block
+* \param block_numbers:  block number of each block
+* \param num_blocks:  number of blocks to read (1 to 255)
+* \param rx_buffer:  the buffer to be filled with block data, 16 bytes per block
+* \param rx_buffer_length:  the length of receive buffer
+* \return the number of bytes read if success, otherwise -1.
+*
+*/
+extern int nfcTag_readFelicaBlocks(unsigned int handle, unsigned short *service_codes, unsigned short *block_numbers,
+                                   unsigned int num_blocks, unsigned char *rx_buffer, unsigned int rx_buffer_length);
+
+/**
+* \brief Read a range of blocks of a MIFARE Classic tag.\n
+*        Each sector is authenticated once, then its blocks are read back to back.
+*        A sector that fails does not stop the read; its blocks are zero-filled.
+* \param handle:  handle to the tag.
+* \param first_block:  first block to read
+* \param num_blocks:  number of blocks to read
+* \param keys:  one key per sector of the range, starting with the sector of first_block
+* \param rx_buffer:  the buffer to be filled with block data, 16 bytes per block
+* \param rx_buffer_length:  the length of receive buffer
+* \param sector_status:  filled with MFC_SECTOR_* for each sector of the range (may be NULL)
+* \return the number of bytes read if at least one sector was read, otherwise -1.
+*
+*/
+extern int nfcTag_readMifareClassicBlocks(unsigned int handle, unsigned char first_block, unsigned int num_blocks,
+                                          const nfc_mfc_key_t *keys, unsigned char *rx_buffer,
+                                          unsigned int rx_buffer_length, unsigned char *sector_status);
+
+/**
+* \brief Write a range of blocks of a MIFARE Classic tag.\n
+*        Each sector is authenticated once, then its blocks are written back to back.
+*        A sector that fails does not stop the write of the following sectors.
+* \param handle:  handle to the tag.
+* \param first_block:  first block to write
+* \param num_blocks:  number of blocks to write
+* \param keys:  one key per sector of the range, starting with the sector of first_block
+* \param tx_buffer:  the block data to write, 16 bytes per block
+* \param tx_buffer_length:  the length of transmit buffer
+* \param sector_status:  filled with MFC_SECTOR_* for each sector of the range (may be NULL)
+* \return 0 if all sectors were written, otherwise -1.
+*
+*/
+extern int nfcTag_writeMifareClassicBlocks(unsigned int handle, unsigned char first_block, unsigned int num_blocks,
+                                           const nfc_mfc_key_t *keys, const unsigned char *tx_buffer,
+                                           unsigned int tx_buffer_length, unsigned char *sector_status);
+
 /**
 * \brief Write ndef message to tag.
 * \param handle:  handle to the tag.
@@ -670,12 +1057,106 @@ extern int nfcManager_selectNextTag(void);
 */
 extern int nfcManager_getNumTags(void);
 
+/**
+* \brief Get every tag in the field in one call: all tags reported during discovery, and, while an
+*        ISO 15693 tag is activated, every ISO 15693 label that answers an inventory search. Labels found
+*        by the search share the handle of the activated tag and are read with addressed commands
+*        (their uid, LSB first) through nfcTag_transceive.
+* \param tags:  receives the tags.
+* \param max_tags:  number of entries tags can hold.
+* \return number of tags written to tags, -1 if failed.
+*/
+extern int nfcManager_getTagInventory(nfc_tag_info_t *tags, unsigned int max_tags);
+
+/**
+* \brief Activate the discovered tag with the given handle without restarting discovery.
+*        The current tag is put to sleep and onTagArrival is called for the selected tag.
+* \param handle:  handle of a tag returned by nfcManager_getTagInventory.
+* \return 0 if success, otherwise failed.
+*/
+extern int nfcManager_selectTag(unsigned int handle);
+
 /**
 * \brief Return FW version.
 * \return FW version on chip, return 0 if fails.
 */
 extern int nfcManager_getFwVersion();
 
+/**
+* \brief Enable or disable adaptive polling. The technologies that produce most activations are polled first,
+*        technologies with less than 5% of the activations are polled every rare_freq discovery periods,
+*        and every sweep_interval discovery starts all technologies are polled as configured.
+*        Takes effect the next time discovery is started. Resets the polling statistics.
+* \param enable:  1 to enable, 0 to disable.
+* \param rare_freq:  polling period of rare technologies, 0 for default (4).
+* \param sweep_interval:  discovery starts between full sweeps, 0 for default (8).
+* \return 0 if success, otherwise failed.
+*/
+extern int nfcManager_setAdaptivePolling(int enable, unsigned char rare_freq, unsigned char sweep_interval);
+
+/**
+* \brief Get polling statistics, including time to first activation.
+* \param stats:  receives the statistics.
+* \return 0 if success, otherwise failed.
+*/
+extern int nfcManager_getPollingStats(nfc_polling_stats_t *stats);
+
+/**
+* \brief Enable or disable low-power card detection (LPCD). Between polling loops the NFC controller senses
+*        the antenna load instead of running full RF polling, and only polls when a card changes the load.
+*        While enabled, the stack also stops its system tick whenever no stack timers are running.
+*        Running discovery is stopped to reconfigure the controller and restarted afterwards.
+* \param enable:  1 to enable, 0 to disable.
+* \param threshold:  detection sensitivity; the load change that wakes the controller, lower is more sensitive.
+* \param fallback_count:  number of low-power cycles after which full discovery runs even if no card was
+*        sensed, bounding the detection latency (TAG_DETECTOR_FALLBACK_CNT_CFG of the controller).
+* \return 0 if success, otherwise failed.
+*/
+extern int nfcManager_setLowPowerCardDetection(int enable, unsigned char threshold, unsigned char fallback_count);
+
+/**
+* \brief Get the stack work that took longest. Every event and message handled by the stack tasks is timed;
+*        work exceeding the stall budget (STALL_BUDGET_MS in libnfc-nci.conf, 20 ms by default) is also
+*        logged with the events it was nested in. Timings are kept across deinitialization.
+* \param stalls:  receives the entries, longest worst case first.
+* \param max_stalls:  size of stalls.
+* \param reset:  1 to clear the timings after reading them.
+* \return number of entries written, or -1 on error.
+*/
+extern int nfcManager_getStallReport(nfc_stall_info_t *stalls, unsigned int max_stalls, int reset);
+
+/**
+* \brief Enable or disable RF telemetry. The NFCC AGC debug response is sampled when a remote field
+*        appears or a remote device is activated, then every interval_ms until the field is gone and the
+*        device deactivated. Overrides NXP_AGC_DEBUG_ENABLE and NXP_AGC_DEBUG_INTERVAL of the config file.
+*        Not supported on PN547C2.
+* \param enable:  1 to enable, 0 to disable.
+* \param interval_ms:  sampling interval, 0 for default (500 ms).
+* \return 0 if success, otherwise failed.
+*/
+extern int nfcManager_setRfTelemetry(int enable, unsigned int interval_ms);
+
+/**
+* \brief Register a callback receiving every RF telemetry sample.
+* \param callback:  RF telemetry callback functions.
+* \return None
+*/
+extern void nfcManager_registerRfTelemetryCallback(nfcRfTelemetryCallback_t *callback);
+
+/**
+* \brief Deregister the RF telemetry callback.
+* \return None
+*/
+extern void nfcManager_deregisterRfTelemetryCallback();
+
+/**
+* \brief Get the most recent RF telemetry samples, oldest first. The last 32 samples are kept.
+* \param samples:  receives the samples.
+* \param max_samples:  size of samples.
+* \return number of samples written, or -1 on error.
+*/
+extern int nfcManager_getRfTelemetry(nfc_rf_telemetry_t *samples, unsigned int max_samples);
+
 /**
 * \brief Register a callback functions for snep client.
 * \param client_callback:  snep client callback functions.
@@ -710,6 +1191,18 @@ extern void nfcSnep_stopServer();
 */
 extern int nfcSnep_putMessage(unsigned char* msg, unsigned int length);
 
+/**
+* \brief put a snep message to remote snep server without waiting for the response.\n
+*        Messages are queued and sent one after the other over the connection of
+*        the current P2P session, which stays up between messages.
+* \param msg:  snep message; it must stay valid until the callback is called.
+* \param length:  snep message length.
+* \param callback:  called with the result of this message.
+* \param context:  context given to the callback.
+* \return 0 if the message is queued, otherwise failed.
+*/
+extern int nfcSnep_putMessageAsync(unsigned char* msg, unsigned int length, nfcSnepPutCallback_t *callback, void *context);
+
 /**
 * \brief Register a callback functions for host card emulation.
 * \param callback:  host card emualtion callback functions.
@@ -724,13 +1217,41 @@ extern void nfcHce_registerHceCallback(nfcHostCardEmulationCallback_t *callback)
 extern void nfcHce_deregisterHceCallback();
 
 /**
-* \brief Send Apdu to remote reader.
+* \brief Send Apdu to remote reader.\n
+*        It may be called from onDataReceived to reply without leaving the callback.
 * \param command:  apdu package to be sent.
 * \param command_length: apdu package length
 * \return 0 if success, otherwise failed.
 */
 extern int nfcHce_sendCommand(unsigned char* command, unsigned int command_length);
 
+/**
+* \brief Get host card emulation statistics of the current or last activation.
+* \param stats:  filled with the statistics.
+* \return 0 if success, otherwise failed.
+*/
+extern int nfcHce_getStats(nfc_hce_stats_t *stats);
+
+/**
+* \brief Add a response the stack sends by itself, without onDataReceived, when a matching Apdu is received.\n
+*        Other Apdus are still given to onDataReceived. If a SELECT is answered this way,
+*        onHostCardEmulationActivated comes with the first Apdu given to onDataReceived.
+* \param command:  apdu to match.
+* \param mask:  bits of command to compare, NULL to compare all of them.
+* \param command_length:  apdu length, up to 32 bytes.
+* \param response:  response apdu including status words.
+* \param response_length:  response length.
+* \return 0 if success, otherwise failed.
+*/
+extern int nfcHce_addApduResponse(unsigned char* command, unsigned char* mask, unsigned int command_length,
+                                  unsigned char* response, unsigned int response_length);
+
+/**
+* \brief Remove all responses added with nfcHce_addApduResponse().
+* \return 0 if success, otherwise failed.
+*/
+extern int nfcHce_clearApduResponses();
+
 /**
 * \brief register T3T identifier
 * \param id:  T3T identifier value.
@@ -810,6 +1331,61 @@ extern int nfcLlcp_ConnLessSendMessage(unsigned char* msg, unsigned int length);
 */
 extern int nfcLlcp_ConnLessReceiveMessage(unsigned char* msg, unsigned int *length);
 
+/**
+* \brief Get the length of the next received LLCP message without removing it from the queue.
+* \param length:  LLCP message length.
+* \return 0 if success, otherwise failed (no message is queued).
+*/
+extern int nfcLlcp_ConnLessPeekMessage(unsigned int *length);
+
+/**
+* \brief Receive a LLCP message from remote LLCP server without waiting.
+* \param msg:  LLCP message.
+* \param length:  size of msg on input, LLCP message length on output.
+* \return 0 if success, otherwise failed (no message is queued, or msg is too small and the message is kept).
+*/
+extern int nfcLlcp_ConnLessTryReceiveMessage(unsigned char* msg, unsigned int *length);
+
+/**
+* \brief Set a callback receiving LLCP messages directly instead of queueing them.
+* \param data_callback:  data callback function, NULL to queue messages again.
+* \return 0 if success, otherwise failed.
+*/
+extern int nfcLlcp_ConnLessSetDataCallback(nfcLlcpConnLessDataCallback_t *data_callback);
+
+/**
+* \brief Get statistics of the LLCP connectionless receive queue.
+* \param stats:  filled with the receive queue statistics.
+* \return 0 if success, otherwise failed.
+*/
+extern int nfcLlcp_ConnLessGetRxStats(nfc_llcp_connless_rx_stats_t *stats);
+
+/**
+* \brief Set LLCP link, SNEP and Connection Handover data link parameters.\n
+*        Link parameters are used from the next link activation, so this fails while a link is active.
+*        Nothing is changed if any of the parameters is out of range.
+*        Use nfcLlcp_getConfig() first to change only some of them.
+* \param config:  the new parameters.
+* \return 0 if success, otherwise failed.
+*/
+extern int nfcLlcp_setConfig(const nfc_llcp_config_t *config);
+
+/**
+* \brief Get current LLCP link, SNEP and Connection Handover data link parameters.
+* \param config:  filled with the current parameters.
+* \return 0 if success, otherwise failed.
+*/
+extern int nfcLlcp_getConfig(nfc_llcp_config_t *config);
+
+/**
+* \brief Get statistics of the current LLCP link, or of the last one once it is deactivated.\n
+*        Comparing them across links set up with different nfcLlcp_setConfig() parameters
+*        shows which settings give the best throughput with a given peer.
+* \param stats:  filled with the link statistics.
+* \return 0 if success, otherwise failed (no link has been activated yet).
+*/
+extern int nfcLlcp_getLinkStats(nfc_llcp_link_stats_t *stats);
+
 
 #ifdef __cplusplus
 }
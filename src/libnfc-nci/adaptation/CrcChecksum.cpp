@@ -42,6 +42,7 @@
 #include <fcntl.h>
 #include <unistd.h>
 #include <errno.h>
+#include <pthread.h>
 #include <string>
 
 #ifndef LOG_TAG
@@ -49,41 +50,79 @@
 #endif
 
 
-static const unsigned short crctab [256] =
+/* Slicing-by-8 tables: [k][b] is the CRC register contribution of byte b followed by k zero bytes */
+static unsigned short sArcTab [8][256];         /* CRC-16/ARC, reflected poly 0x8005 (NV checksum) */
+static unsigned short sCcittTab [8][256];       /* CRC-16/CCITT, poly 0x1021, MSB first */
+static pthread_once_t sCrcTabOnce = PTHREAD_ONCE_INIT;
+
+
+/*******************************************************************************
+**
+** Function         crcBuildTables
+**
+** Description      Generate the slicing-by-8 tables of all CRC engines.
+**
+** Returns          None
+**
+*******************************************************************************/
+static void crcBuildTables (void)
+{
+    for (int n = 0; n < 256; n++)
+    {
+        unsigned short arc = n;
+        unsigned short ccitt = n << 8;
+        for (int bit = 0; bit < 8; bit++)
+        {
+            arc = (arc & 1) ? (arc >> 1) ^ 0xA001 : (arc >> 1);
+            ccitt = (ccitt & 0x8000) ? (ccitt << 1) ^ 0x1021 : (ccitt << 1);
+        }
+        sArcTab [0][n] = arc;
+        sCcittTab [0][n] = ccitt;
+    }
+    for (int k = 1; k < 8; k++)
+    {
+        for (int n = 0; n < 256; n++)
+        {
+            unsigned short arc = sArcTab [k - 1][n];
+            unsigned short ccitt = sCcittTab [k - 1][n];
+            sArcTab [k][n] = (arc >> 8) ^ sArcTab [0][arc & 0xff];
+            sCcittTab [k][n] = (unsigned short) (ccitt << 8) ^ sCcittTab [0][ccitt >> 8];
+        }
+    }
+}
+
+
+/*******************************************************************************
+**
+** Function         crcReflected
+**
+** Description      Update a reflected (LSB first) 16-bit CRC, eight bytes
+**                  per step.
+**                  tab: slicing-by-8 tables of the polynomial.
+**                  crc: current CRC register.
+**
+** Returns          Updated CRC register.
+**
+*******************************************************************************/
+static unsigned short crcReflected (unsigned short tab [8][256], unsigned short crc,
+        const unsigned char *cp, int cnt)
 {
-    0x0000, 0xc0c1, 0xc181, 0x0140, 0xc301, 0x03c0, 0x0280, 0xc241,
-    0xc601, 0x06c0, 0x0780, 0xc741, 0x0500, 0xc5c1, 0xc481, 0x0440,
-    0xcc01, 0x0cc0, 0x0d80, 0xcd41, 0x0f00, 0xcfc1, 0xce81, 0x0e40,
-    0x0a00, 0xcac1, 0xcb81, 0x0b40, 0xc901, 0x09c0, 0x0880, 0xc841,
-    0xd801, 0x18c0, 0x1980, 0xd941, 0x1b00, 0xdbc1, 0xda81, 0x1a40,
-    0x1e00, 0xdec1, 0xdf81, 0x1f40, 0xdd01, 0x1dc0, 0x1c80, 0xdc41,
-    0x1400, 0xd4c1, 0xd581, 0x1540, 0xd701, 0x17c0, 0x1680, 0xd641,
-    0xd201, 0x12c0, 0x1380, 0xd341, 0x1100, 0xd1c1, 0xd081, 0x1040,
-    0xf001, 0x30c0, 0x3180, 0xf141, 0x3300, 0xf3c1, 0xf281, 0x3240,
-    0x3600, 0xf6c1, 0xf781, 0x3740, 0xf501, 0x35c0, 0x3480, 0xf441,
-    0x3c00, 0xfcc1, 0xfd81, 0x3d40, 0xff01, 0x3fc0, 0x3e80, 0xfe41,
-    0xfa01, 0x3ac0, 0x3b80, 0xfb41, 0x3900, 0xf9c1, 0xf881, 0x3840,
-    0x2800, 0xe8c1, 0xe981, 0x2940, 0xeb01, 0x2bc0, 0x2a80, 0xea41,
-    0xee01, 0x2ec0, 0x2f80, 0xef41, 0x2d00, 0xedc1, 0xec81, 0x2c40,
-    0xe401, 0x24c0, 0x2580, 0xe541, 0x2700, 0xe7c1, 0xe681, 0x2640,
-    0x2200, 0xe2c1, 0xe381, 0x2340, 0xe101, 0x21c0, 0x2080, 0xe041,
-    0xa001, 0x60c0, 0x6180, 0xa141, 0x6300, 0xa3c1, 0xa281, 0x6240,
-    0x6600, 0xa6c1, 0xa781, 0x6740, 0xa501, 0x65c0, 0x6480, 0xa441,
-    0x6c00, 0xacc1, 0xad81, 0x6d40, 0xaf01, 0x6fc0, 0x6e80, 0xae41,
-    0xaa01, 0x6ac0, 0x6b80, 0xab41, 0x6900, 0xa9c1, 0xa881, 0x6840,
-    0x7800, 0xb8c1, 0xb981, 0x7940, 0xbb01, 0x7bc0, 0x7a80, 0xba41,
-    0xbe01, 0x7ec0, 0x7f80, 0xbf41, 0x7d00, 0xbdc1, 0xbc81, 0x7c40,
-    0xb401, 0x74c0, 0x7580, 0xb541, 0x7700, 0xb7c1, 0xb681, 0x7640,
-    0x7200, 0xb2c1, 0xb381, 0x7340, 0xb101, 0x71c0, 0x7080, 0xb041,
-    0x5000, 0x90c1, 0x9181, 0x5140, 0x9301, 0x53c0, 0x5280, 0x9241,
-    0x9601, 0x56c0, 0x5780, 0x9741, 0x5500, 0x95c1, 0x9481, 0x5440,
-    0x9c01, 0x5cc0, 0x5d80, 0x9d41, 0x5f00, 0x9fc1, 0x9e81, 0x5e40,
-    0x5a00, 0x9ac1, 0x9b81, 0x5b40, 0x9901, 0x59c0, 0x5880, 0x9841,
-    0x8801, 0x48c0, 0x4980, 0x8941, 0x4b00, 0x8bc1, 0x8a81, 0x4a40,
-    0x4e00, 0x8ec1, 0x8f81, 0x4f40, 0x8d01, 0x4dc0, 0x4c80, 0x8c41,
-    0x4400, 0x84c1, 0x8581, 0x4540, 0x8701, 0x47c0, 0x4680, 0x8641,
-    0x8201, 0x42c0, 0x4380, 0x8341, 0x4100, 0x81c1, 0x8081, 0x4040,
-};
+    pthread_once (&sCrcTabOnce, crcBuildTables);
+
+    while (cnt >= 8)
+    {
+        crc ^= cp[0] | (cp[1] << 8);
+        crc = tab[7][crc & 0xff] ^ tab[6][crc >> 8] ^ tab[5][cp[2]] ^ tab[4][cp[3]] ^
+              tab[3][cp[4]] ^ tab[2][cp[5]] ^ tab[1][cp[6]] ^ tab[0][cp[7]];
+        cp += 8;
+        cnt -= 8;
+    }
+    while (cnt--)
+    {
+        crc = (crc >> 8) ^ tab[0][(crc ^ *cp++) & 0xff];
+    }
+    return crc;
+}
 
 
 /*******************************************************************************
@@ -97,15 +136,42 @@ static const unsigned short crctab [256] =
 *******************************************************************************/
 unsigned short crcChecksumCompute (const unsigned char *buffer, int bufferLen)
 {
-    register unsigned short crc = 0;
-    const register unsigned char  *cp = buffer;
-    register          int   cnt = bufferLen;
+    return crcReflected (sArcTab, 0, buffer, bufferLen);
+}
+
 
+/*******************************************************************************
+**
+** Function         crcCcittCompute
+**
+** Description      Update a CRC-16/CCITT (poly 0x1021, MSB first, no final
+**                  XOR) over a buffer of data; start with 0xFFFF.
+**                  crc: CRC of the data before buffer.
+**
+** Returns          2-byte CRC.
+**
+*******************************************************************************/
+unsigned short crcCcittCompute (unsigned short crc, const unsigned char *buffer, int bufferLen)
+{
+    const unsigned char *cp = buffer;
+    int cnt = bufferLen;
+
+    pthread_once (&sCrcTabOnce, crcBuildTables);
+
+    while (cnt >= 8)
+    {
+        crc ^= (cp[0] << 8) | cp[1];
+        crc = sCcittTab[7][crc >> 8] ^ sCcittTab[6][crc & 0xff] ^ sCcittTab[5][cp[2]] ^
+              sCcittTab[4][cp[3]] ^ sCcittTab[3][cp[4]] ^ sCcittTab[2][cp[5]] ^
+              sCcittTab[1][cp[6]] ^ sCcittTab[0][cp[7]];
+        cp += 8;
+        cnt -= 8;
+    }
     while (cnt--)
     {
-        crc = ((crc >> 8) & 0xff) ^ crctab[(crc & 0xff) ^ *cp++];
+        crc = (unsigned short) (crc << 8) ^ sCcittTab[0][((crc >> 8) ^ *cp++) & 0xff];
     }
-    return(crc);
+    return crc;
 }
 
 
@@ -59,6 +59,7 @@ extern "C" void GKI_shutdown();
 extern void resetConfig();
 extern "C" void verify_stack_non_volatile_store ();
 extern "C" void delete_stack_non_volatile_store (BOOLEAN forceDelete);
+extern "C" void flush_stack_non_volatile_store ();
 
 
 
@@ -200,6 +201,8 @@ void NfcAdaptation::Initialize ()
 
     GKI_init ();
     GKI_enable ();
+    if ( GetNumValue ( NAME_STALL_BUDGET_MS, &num, sizeof ( num ) ) )
+        GKI_set_stall_budget ( num );
     GKI_create_task ((TASKPTR)NFCA_TASK, BTU_TASK, (INT8*)"NFCA_TASK", 0, 0, (pthread_cond_t*)NULL, NULL);
     {
         mCondVar.lock();
@@ -262,6 +265,7 @@ void NfcAdaptation::Finalize()
 
     NXPLOG_API_D ("%s: enter", func);
     GKI_shutdown ();
+    flush_stack_non_volatile_store ();
 
     resetConfig();
 
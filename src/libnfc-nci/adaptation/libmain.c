@@ -41,6 +41,9 @@
 #include <malloc.h>
 #include <fcntl.h>
 #include <errno.h>
+#include <string.h>
+#include <unistd.h>
+#include <pthread.h>
 #include "buildcfg.h"
 #include "nfa_nv_co.h"
 #include "nci_config.h"
@@ -84,6 +87,255 @@ extern void nfa_mem_co_free(void *pBuffer)
 }
 
 
+/* NV blocks are cached in memory; writes are coalesced and committed to the
+** per-block files by a background thread so the NFA task never blocks on
+** file I/O. Lock order is sNvIoMutex before sNvCacheMutex. */
+#define NV_CACHE_MAX_BLOCKS     8
+
+typedef struct
+{
+    UINT8   block;
+    BOOLEAN valid;              /* p_data holds the content of the block   */
+    BOOLEAN dirty;              /* p_data is newer than the file on disk   */
+    UINT16  len;
+    UINT8   *p_data;
+} tNV_CACHE_ENTRY;
+
+static tNV_CACHE_ENTRY sNvCache[NV_CACHE_MAX_BLOCKS];
+static pthread_mutex_t sNvCacheMutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_mutex_t sNvIoMutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t  sNvCacheCond = PTHREAD_COND_INITIALIZER;
+static BOOLEAN sNvWriterStarted = FALSE;
+
+/*******************************************************************************
+**
+** Function         nv_get_filename
+**
+** Description      Build the name of the file backing an NV block.
+**
+** Returns          TRUE if the name fits in the buffer
+**
+*******************************************************************************/
+static BOOLEAN nv_get_filename (char *filename, size_t size, UINT8 block)
+{
+    if (strlen (nfc_nci_store) + strlen (sNfaStorageBin) > 200)
+    {
+        //ALOGE ("%s: filename too long", __FUNCTION__);
+        return FALSE;
+    }
+    snprintf (filename, size, "%s%s%u", nfc_nci_store, sNfaStorageBin, block);
+    return TRUE;
+}
+
+/*******************************************************************************
+**
+** Function         nv_cache_find
+**
+** Description      Find the cache entry of a block, allocating a free one if
+**                  requested. Caller must hold sNvCacheMutex.
+**
+** Returns          pointer to the entry, or NULL
+**
+*******************************************************************************/
+static tNV_CACHE_ENTRY *nv_cache_find (UINT8 block, BOOLEAN alloc)
+{
+    tNV_CACHE_ENTRY *p_free = NULL;
+    int xx;
+
+    for (xx = 0; xx < NV_CACHE_MAX_BLOCKS; xx++)
+    {
+        if (sNvCache[xx].valid || sNvCache[xx].dirty)
+        {
+            if (sNvCache[xx].block == block)
+                return &sNvCache[xx];
+        }
+        else if (p_free == NULL)
+            p_free = &sNvCache[xx];
+    }
+    if (alloc && p_free)
+        p_free->block = block;
+    return alloc ? p_free : NULL;
+}
+
+/*******************************************************************************
+**
+** Function         nv_cache_store
+**
+** Description      Copy a block's content into its cache entry. Caller must
+**                  hold sNvCacheMutex.
+**
+** Returns          the entry, or NULL if out of entries or memory
+**
+*******************************************************************************/
+static tNV_CACHE_ENTRY *nv_cache_store (UINT8 block, const UINT8 *p_data, UINT16 len)
+{
+    tNV_CACHE_ENTRY *p_entry = nv_cache_find (block, TRUE);
+    UINT8 *p_buf;
+
+    if (p_entry == NULL)
+        return NULL;
+    if ((p_entry->p_data == NULL) || (p_entry->len < len))
+    {
+        if ((p_buf = (UINT8 *) realloc (p_entry->p_data, len ? len : 1)) == NULL)
+            return NULL;
+        p_entry->p_data = p_buf;
+    }
+    memcpy (p_entry->p_data, p_data, len);
+    p_entry->len   = len;
+    p_entry->valid = TRUE;
+    return p_entry;
+}
+
+/*******************************************************************************
+**
+** Function         nv_write_file
+**
+** Description      Write a block with its checksum to a temporary file, sync
+**                  it and rename it over the block file, so a crash leaves
+**                  either the old or the new content.
+**
+** Returns          TRUE if the block was committed
+**
+*******************************************************************************/
+static BOOLEAN nv_write_file (UINT8 block, const UINT8 *p_data, UINT16 len)
+{
+    char filename[256], tmpname[272];
+    unsigned short checksum;
+    BOOLEAN written;
+    int fileStream;
+
+    if (!nv_get_filename (filename, sizeof(filename), block))
+        return FALSE;
+    snprintf (tmpname, sizeof(tmpname), "%s.tmp", filename);
+
+    fileStream = open (tmpname, O_WRONLY | O_CREAT | O_TRUNC, S_IRUSR | S_IWUSR);
+    if (fileStream < 0)
+    {
+        //ALOGE ("%s: fail to open, error = %d", __FUNCTION__, errno);
+        return FALSE;
+    }
+    checksum = crcChecksumCompute (p_data, len);
+    written = (write (fileStream, &checksum, sizeof(checksum)) == (ssize_t) sizeof(checksum))
+           && (write (fileStream, p_data, len) == (ssize_t) len)
+           && (fsync (fileStream) == 0);
+    close (fileStream);
+
+    if (written && (rename (tmpname, filename) == 0))
+        return TRUE;
+    //ALOGE ("%s: fail to write, error = %d", __FUNCTION__, errno);
+    remove (tmpname);
+    return FALSE;
+}
+
+/*******************************************************************************
+**
+** Function         nv_flush_dirty
+**
+** Description      Commit every dirty cache entry to disk. A block written
+**                  again while its file is being updated stays dirty and is
+**                  picked up by the next pass of the loop.
+**
+** Returns          none
+**
+*******************************************************************************/
+static void nv_flush_dirty (void)
+{
+    tNV_CACHE_ENTRY *p_entry;
+    UINT8 *p_copy, block;
+    UINT16 len;
+    int xx;
+
+    pthread_mutex_lock (&sNvIoMutex);
+    for (;;)
+    {
+        p_copy = NULL;
+        len = 0;
+        pthread_mutex_lock (&sNvCacheMutex);
+        for (xx = 0, p_entry = NULL; xx < NV_CACHE_MAX_BLOCKS; xx++)
+        {
+            if (sNvCache[xx].dirty)
+            {
+                p_entry = &sNvCache[xx];
+                break;
+            }
+        }
+        if (p_entry)
+        {
+            block = p_entry->block;
+            len   = p_entry->len;
+            if ((p_copy = (UINT8 *) malloc (len ? len : 1)) != NULL)
+            {
+                memcpy (p_copy, p_entry->p_data, len);
+                p_entry->dirty = FALSE;
+            }
+        }
+        pthread_mutex_unlock (&sNvCacheMutex);
+
+        if (p_copy == NULL)
+            break;
+        nv_write_file (block, p_copy, len);
+        free (p_copy);
+    }
+    pthread_mutex_unlock (&sNvIoMutex);
+}
+
+/*******************************************************************************
+**
+** Function         nv_writer_thread
+**
+** Description      Background thread committing dirty NV blocks.
+**
+** Returns          NULL
+**
+*******************************************************************************/
+static void *nv_writer_thread (void *arg)
+{
+    int xx;
+    BOOLEAN dirty;
+
+    (void) arg;
+    for (;;)
+    {
+        pthread_mutex_lock (&sNvCacheMutex);
+        for (;;)
+        {
+            for (xx = 0, dirty = FALSE; xx < NV_CACHE_MAX_BLOCKS; xx++)
+                dirty |= sNvCache[xx].dirty;
+            if (dirty)
+                break;
+            pthread_cond_wait (&sNvCacheCond, &sNvCacheMutex);
+        }
+        pthread_mutex_unlock (&sNvCacheMutex);
+        nv_flush_dirty ();
+    }
+    return NULL;
+}
+
+/*******************************************************************************
+**
+** Function         nv_start_writer
+**
+** Description      Start the background writer on first use. Caller must
+**                  hold sNvCacheMutex.
+**
+** Returns          TRUE if the writer is running
+**
+*******************************************************************************/
+static BOOLEAN nv_start_writer (void)
+{
+    pthread_attr_t attr;
+    pthread_t thread;
+
+    if (sNvWriterStarted)
+        return TRUE;
+    pthread_attr_init (&attr);
+    pthread_attr_setdetachstate (&attr, PTHREAD_CREATE_DETACHED);
+    if (pthread_create (&thread, &attr, nv_writer_thread, NULL) == 0)
+        sNvWriterStarted = TRUE;
+    pthread_attr_destroy (&attr);
+    return sNvWriterStarted;
+}
+
 /*******************************************************************************
 **
 ** Function         nfa_nv_co_read
@@ -106,30 +358,42 @@ extern void nfa_mem_co_free(void *pBuffer)
 *******************************************************************************/
 extern void nfa_nv_co_read(UINT8 *pBuffer, UINT16 nbytes, UINT8 block)
 {
-    char filename[256], filename2[256];
+    tNV_CACHE_ENTRY *p_entry;
+    char filename[256];
+    UINT16 len = 0;
 
-    memset (filename, 0, sizeof(filename));
-    memset (filename2, 0, sizeof(filename2));
-    strcpy(filename2, nfc_nci_store);
-    strncat(filename2, sNfaStorageBin, sizeof(filename2)-strlen(filename2)-1);
-    if (strlen(filename2) > 200)
+    pthread_mutex_lock (&sNvCacheMutex);
+    p_entry = nv_cache_find (block, FALSE);
+    if (p_entry && p_entry->valid)
     {
-        //ALOGE ("%s: filename too long", __FUNCTION__);
+        len = (p_entry->len < nbytes) ? p_entry->len : nbytes;
+        memcpy (pBuffer, p_entry->p_data, len);
+        pthread_mutex_unlock (&sNvCacheMutex);
+        nfa_nv_ci_read (len, len ? NFA_NV_CO_OK : NFA_NV_CO_FAIL, block);
         return;
     }
-    sprintf (filename, "%s%u", filename2, block);
+    pthread_mutex_unlock (&sNvCacheMutex);
+
+    if (!nv_get_filename (filename, sizeof(filename), block))
+        return;
 
     //ALOGD ("%s: buffer len=%u; file=%s", __FUNCTION__, nbytes, filename);
     int fileStream = open (filename, O_RDONLY);
     if (fileStream >= 0)
     {
         unsigned short checksum = 0;
-        size_t actualReadCrc = read (fileStream, &checksum, sizeof(checksum));
-        size_t actualReadData = read (fileStream, pBuffer, nbytes);
+        ssize_t actualReadCrc = read (fileStream, &checksum, sizeof(checksum));
+        ssize_t actualReadData = read (fileStream, pBuffer, nbytes);
         close (fileStream);
-        if (actualReadData > 0)
+        if ((actualReadCrc == (ssize_t) sizeof(checksum)) && (actualReadData > 0))
         {
-            //ALOGD ("%s: data size=%zu", __FUNCTION__, actualReadData);
+            //ALOGD ("%s: data size=%zd", __FUNCTION__, actualReadData);
+            pthread_mutex_lock (&sNvCacheMutex);
+            p_entry = nv_cache_find (block, FALSE);
+            /* only fill the cache if no write raced with the file read */
+            if ((p_entry == NULL) || !p_entry->valid)
+                nv_cache_store (block, pBuffer, (UINT16) actualReadData);
+            pthread_mutex_unlock (&sNvCacheMutex);
             nfa_nv_ci_read (actualReadData, NFA_NV_CO_OK, block);
         }
         else
@@ -150,7 +414,9 @@ extern void nfa_nv_co_read(UINT8 *pBuffer, UINT16 nbytes, UINT8 block)
 ** Function         nfa_nv_co_write
 **
 ** Description      This function is called by io to send file data to the
-**                  phone.
+**                  phone. The data is cached and committed to the file by
+**                  the background writer; repeated writes of a block before
+**                  it is committed are coalesced into one file update.
 **
 ** Parameters       pBuffer   - buffer to read the data from.
 **                  nbytes  - number of bytes to write out to the file.
@@ -165,45 +431,46 @@ extern void nfa_nv_co_read(UINT8 *pBuffer, UINT16 nbytes, UINT8 block)
 *******************************************************************************/
 extern void nfa_nv_co_write(const UINT8 *pBuffer, UINT16 nbytes, UINT8 block)
 {
-    char filename[256], filename2[256];
+    tNV_CACHE_ENTRY *p_entry;
+    BOOLEAN queued = FALSE;
 
-    memset (filename, 0, sizeof(filename));
-    memset (filename2, 0, sizeof(filename2));
-    strcpy(filename2, nfc_nci_store);
-    strncat(filename2, sNfaStorageBin, sizeof(filename2)-strlen(filename2)-1);
-    if (strlen(filename2) > 200)
+    //ALOGD ("%s: bytes=%u; block=%u", __FUNCTION__, nbytes, block);
+    pthread_mutex_lock (&sNvCacheMutex);
+    if (nv_start_writer () && ((p_entry = nv_cache_store (block, pBuffer, nbytes)) != NULL))
     {
-        //ALOGE ("%s: filename too long", __FUNCTION__);
-        return;
+        p_entry->dirty = TRUE;
+        pthread_cond_signal (&sNvCacheCond);
+        queued = TRUE;
     }
-    sprintf (filename, "%s%u", filename2, block);
-    //ALOGD ("%s: bytes=%u; file=%s", __FUNCTION__, nbytes, filename);
-
-    int fileStream = 0;
+    pthread_mutex_unlock (&sNvCacheMutex);
 
-    fileStream = open (filename, O_WRONLY | O_CREAT | O_TRUNC, S_IRUSR | S_IWUSR);
-    if (fileStream >= 0)
+    if (queued)
     {
-        unsigned short checksum = crcChecksumCompute (pBuffer, nbytes);
-        size_t actualWrittenCrc = write (fileStream, &checksum, sizeof(checksum));
-        size_t actualWrittenData = write (fileStream, pBuffer, nbytes);
-        //ALOGD ("%s: %zu bytes written", __FUNCTION__, actualWrittenData);
-        if ((actualWrittenData == nbytes) && (actualWrittenCrc == sizeof(checksum)))
-        {
-            nfa_nv_ci_write (NFA_NV_CO_OK);
-        }
-        else
-        {
-            //ALOGE ("%s: fail to write", __FUNCTION__);
-            nfa_nv_ci_write (NFA_NV_CO_FAIL);
-        }
-        close (fileStream);
-    }
-    else
-    {
-        //ALOGE ("%s: fail to open, error = %d", __FUNCTION__, errno);
-        nfa_nv_ci_write (NFA_NV_CO_FAIL);
+        nfa_nv_ci_write (NFA_NV_CO_OK);
+        return;
     }
+
+    /* no writer or cache entry available, fall back to a synchronous write */
+    pthread_mutex_lock (&sNvIoMutex);
+    queued = nv_write_file (block, pBuffer, nbytes);
+    pthread_mutex_unlock (&sNvIoMutex);
+    nfa_nv_ci_write (queued ? NFA_NV_CO_OK : NFA_NV_CO_FAIL);
+}
+
+/*******************************************************************************
+**
+** Function         flush_stack_non_volatile_store
+**
+** Description      Synchronously commit all pending NV block writes.
+**
+** Parameters       none
+**
+** Returns          none
+**
+*******************************************************************************/
+void flush_stack_non_volatile_store ()
+{
+    nv_flush_dirty ();
 }
 
 /*******************************************************************************
@@ -221,11 +488,22 @@ void delete_stack_non_volatile_store (BOOLEAN forceDelete)
 {
     static BOOLEAN firstTime = TRUE;
     char filename[256], filename2[256];
+    int xx;
 
     if ((firstTime == FALSE) && (forceDelete == FALSE))
         return;
     firstTime = FALSE;
 
+    /* drop pending writes so they are not committed after the delete */
+    pthread_mutex_lock (&sNvIoMutex);
+    pthread_mutex_lock (&sNvCacheMutex);
+    for (xx = 0; xx < NV_CACHE_MAX_BLOCKS; xx++)
+    {
+        free (sNvCache[xx].p_data);
+        memset (&sNvCache[xx], 0, sizeof(sNvCache[xx]));
+    }
+    pthread_mutex_unlock (&sNvCacheMutex);
+
     //ALOGD ("%s", __FUNCTION__);
 
     memset (filename, 0, sizeof(filename));
@@ -235,6 +513,7 @@ void delete_stack_non_volatile_store (BOOLEAN forceDelete)
     if (strlen(filename2) > 200)
     {
         //ALOGE ("%s: filename too long", __FUNCTION__);
+        pthread_mutex_unlock (&sNvIoMutex);
         return;
     }
     sprintf (filename, "%s%u", filename2, DH_NV_BLOCK);
@@ -247,6 +526,7 @@ void delete_stack_non_volatile_store (BOOLEAN forceDelete)
     remove (filename);
     sprintf (filename, "%s%u", filename2, HC_F5_NV_BLOCK);
     remove (filename);
+    pthread_mutex_unlock (&sNvIoMutex);
 }
 
 /*******************************************************************************
@@ -266,6 +546,8 @@ void verify_stack_non_volatile_store ()
     char filename[256], filename2[256];
     BOOLEAN isValid = FALSE;
 
+    flush_stack_non_volatile_store ();
+
     memset (filename, 0, sizeof(filename));
     memset (filename2, 0, sizeof(filename2));
     strcpy(filename2, nfc_nci_store);
@@ -92,6 +92,25 @@
 
 #define EVENT_MASK(evt)       ((UINT16)(0x0001 << (evt)))
 
+/* Kinds of work timed by the stall watch
+*/
+#define GKI_STALL_KIND_WAIT     1   /* events returned by GKI_wait(), id is the event mask */
+#define GKI_STALL_KIND_MBOX     2   /* message read by GKI_read_mbox(), id is the mailbox  */
+#define GKI_STALL_KIND_EVENT    3   /* message dispatched by the stack, id is its event    */
+
+/* Stall report entry, see GKI_get_stalls()
+*/
+typedef struct
+{
+    UINT8   task_id;
+    UINT8   kind;               /* GKI_STALL_KIND_xxx                   */
+    UINT16  id;
+    UINT32  count;              /* number of times the work was timed   */
+    UINT32  over_budget;        /* number of times it exceeded budget   */
+    UINT32  max_us;
+    UINT32  avg_us;
+} tGKI_STALL_INFO;
+
 /************************************************************************
 **  Max Time Queue
 **/
@@ -481,6 +500,15 @@ typedef void (SYSTEM_TICK_CBACK)(BOOLEAN);
 */
 GKI_API extern BOOLEAN GKI_timer_queue_empty (void);
 GKI_API extern void    GKI_timer_queue_register_callback(SYSTEM_TICK_CBACK *);
+GKI_API extern void    GKI_allow_tick_stop(BOOLEAN);
+
+/* Stall watch
+*/
+GKI_API extern void    GKI_stall_begin (UINT8, UINT16);
+GKI_API extern void    GKI_stall_end (UINT8);
+GKI_API extern void    GKI_set_stall_budget (UINT32);
+GKI_API extern UINT8   GKI_get_stalls (tGKI_STALL_INFO *, UINT8);
+GKI_API extern void    GKI_reset_stalls (void);
 
 /* Disable Interrupts, Enable Interrupts
 */
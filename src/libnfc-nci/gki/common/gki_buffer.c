@@ -795,6 +795,9 @@ void *GKI_read_mbox (UINT8 mbox)
     if ((task_id >= GKI_MAX_TASKS) || (mbox >= NUM_TASK_MBOX))
         return (NULL);
 
+    /* the task is done with the previous message it read */
+    GKI_stall_end (GKI_STALL_KIND_MBOX);
+
     GKI_disable();
 
     if (gki_cb.com.OSTaskQFirst[task_id][mbox])
@@ -810,6 +813,9 @@ void *GKI_read_mbox (UINT8 mbox)
 
     GKI_enable();
 
+    if (p_buf)
+        GKI_stall_begin (GKI_STALL_KIND_MBOX, mbox);
+
     return (p_buf);
 }
 
@@ -376,6 +376,7 @@ extern BOOLEAN   gki_chk_buf_owner(void *);
 extern void      gki_buffer_init (void);
 extern void      gki_timers_init(void);
 extern void      gki_adjust_timer_count (INT32);
+extern BOOLEAN   gki_timers_is_timer_running(void);
 
 extern void    OSStartRdy(void);
 extern void    OSCtxSw(void);
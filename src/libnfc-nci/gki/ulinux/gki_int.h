@@ -48,6 +48,28 @@
 #include <sys/times.h>
 #endif
 
+#if (GKI_STALL_WATCH == TRUE)
+/* Work being timed by a task */
+typedef struct
+{
+    UINT8               kind;
+    UINT16              id;
+    struct timespec     start;
+} tGKI_STALL_FRAME;
+
+/* Accumulated timings of one kind of work of a task */
+typedef struct
+{
+    UINT8               task_id;
+    UINT8               kind;
+    UINT16              id;
+    UINT32              count;
+    UINT32              over_budget;
+    UINT32              max_us;
+    UINT64              total_us;
+} tGKI_STALL_REC;
+#endif
+
 typedef struct
 {
     pthread_mutex_t     GKI_mutex;
@@ -60,6 +82,14 @@ typedef struct
     pthread_mutex_t     gki_timer_mutex;
     pthread_cond_t      gki_timer_cond;
     int                 gki_timer_wake_lock_on;
+    BOOLEAN             tick_stop_allowed;  /* TRUE: stop the tick while no timers are running */
+#if (GKI_STALL_WATCH == TRUE)
+    pthread_mutex_t     stall_mutex;
+    UINT32              stall_budget_us;    /* 0: do not flag stalls */
+    UINT8               stall_depth[GKI_MAX_TASKS];
+    tGKI_STALL_FRAME    stall_frame[GKI_MAX_TASKS][GKI_STALL_MAX_DEPTH];
+    tGKI_STALL_REC      stall_rec[GKI_MAX_STALL_RECORDS];
+#endif
 #if (GKI_DEBUG == TRUE)
     pthread_mutex_t     GKI_trace_mutex;
 #endif
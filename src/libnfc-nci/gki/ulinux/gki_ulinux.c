@@ -38,6 +38,7 @@
 #include <stdio.h>
 #include <stdarg.h>
 #include <errno.h>
+#include <string.h>
 
 #define GKI_DEBUG   FALSE
 
@@ -69,7 +70,9 @@ tGKI_CB   gki_cb;
 /* works only for 1ms to 1000ms heart beat ranges */
 #define LINUX_SEC (1000/TICKS_PER_SEC)
 // #define GKI_TICK_TIMER_DEBUG
-#define GKI_NO_TICK_STOP
+/* Define GKI_NO_TICK_STOP to keep the system tick running all the time. Otherwise the
+ * tick is stopped while no GKI timers are running, once allowed by GKI_allow_tick_stop() */
+// #define GKI_NO_TICK_STOP
 
 #define LOCK(m)  pthread_mutex_lock(&m)
 #define UNLOCK(m) pthread_mutex_unlock(&m)
@@ -182,7 +185,14 @@ void GKI_init(void)
     /* Initialiase GKI_timer_update suspend variables & mutexes to be in running state.
      * this works too even if GKI_NO_TICK_STOP is defined in btld.txt */
     p_os->no_timer_suspend = GKI_TIMER_TICK_RUN_COND;
+    p_os->tick_stop_allowed = FALSE;
     pthread_mutex_init(&p_os->gki_timer_mutex, NULL);
+#if (GKI_STALL_WATCH == TRUE)
+    /* timings are kept across restarts of the stack */
+    pthread_mutex_init(&p_os->stall_mutex, NULL);
+    p_os->stall_budget_us = GKI_STALL_BUDGET_MS * 1000;
+    memset (p_os->stall_depth, 0, sizeof (p_os->stall_depth));
+#endif
     pthread_cond_init(&p_os->gki_timer_cond, NULL);
 }
 
@@ -398,10 +408,12 @@ void GKI_shutdown(void)
         //release_wake_lock(WAKE_LOCK_ID);
         gki_cb.os.gki_timer_wake_lock_on = 0;
     }
+    pthread_mutex_lock( &gki_cb.os.gki_timer_mutex );
     oldCOnd = *p_run_cond;
     *p_run_cond = GKI_TIMER_TICK_EXIT_COND;
     if (oldCOnd == GKI_TIMER_TICK_STOP_COND)
         pthread_cond_signal( &gki_cb.os.gki_timer_cond );
+    pthread_mutex_unlock( &gki_cb.os.gki_timer_mutex );
 
 }
 
@@ -421,37 +433,340 @@ void gki_system_tick_start_stop_cback(BOOLEAN start)
 {
     tGKI_OS         *p_os = &gki_cb.os;
     volatile int    *p_run_cond = &p_os->no_timer_suspend;
+#ifdef GKI_TICK_TIMER_DEBUG
     static volatile int wake_lock_count;
-    if ( FALSE == start )
+#endif
+
+    pthread_mutex_lock( &p_os->gki_timer_mutex );
+    if (GKI_TIMER_TICK_EXIT_COND == *p_run_cond)
+    {
+        /* GKI is shutting down, leave the exit condition in place */
+    }
+    else if ( FALSE == start )
     {
-        /* this can lead to a race condition. however as we only read this variable in the timer loop
-         * we should be fine with this approach. otherwise uncomment below mutexes.
-         */
-        /* GKI_disable(); */
-        *p_run_cond = GKI_TIMER_TICK_STOP_COND;
-        /* GKI_enable(); */
+        /* keep ticking until stopping the system tick is allowed */
+        if (p_os->tick_stop_allowed)
+        {
+            *p_run_cond = GKI_TIMER_TICK_STOP_COND;
 #ifdef GKI_TICK_TIMER_DEBUG
-        BT_TRACE_1( TRACE_LAYER_HCI, TRACE_TYPE_DEBUG, ">>> STOP GKI_timer_update(), wake_lock_count:%d", --wake_lock_count);
+            BT_TRACE_1( TRACE_LAYER_HCI, TRACE_TYPE_DEBUG, ">>> STOP GKI_timer_update(), wake_lock_count:%d", --wake_lock_count);
 #endif
-        release_wake_lock(WAKE_LOCK_ID);
-        gki_cb.os.gki_timer_wake_lock_on = 0;
+        }
     }
-    else
+    else if (GKI_TIMER_TICK_STOP_COND == *p_run_cond)
     {
         /* restart GKI_timer_update() loop */
-        acquire_wake_lock(PARTIAL_WAKE_LOCK, WAKE_LOCK_ID);
-        gki_cb.os.gki_timer_wake_lock_on = 1;
         *p_run_cond = GKI_TIMER_TICK_RUN_COND;
-        pthread_mutex_lock( &p_os->gki_timer_mutex );
         pthread_cond_signal( &p_os->gki_timer_cond );
-        pthread_mutex_unlock( &p_os->gki_timer_mutex );
 
 #ifdef GKI_TICK_TIMER_DEBUG
         BT_TRACE_1( TRACE_LAYER_HCI, TRACE_TYPE_DEBUG, ">>> START GKI_timer_update(), wake_lock_count:%d", ++wake_lock_count );
 #endif
     }
+    pthread_mutex_unlock( &p_os->gki_timer_mutex );
+}
+#endif
+
+/*******************************************************************************
+**
+** Function         GKI_allow_tick_stop
+**
+** Description      This function allows or forbids stopping the system tick
+**                  while no GKI timers are running. When allowed, the timer
+**                  loop in GKI_run() sleeps until the next timer is started
+**                  instead of waking up every tick.
+**
+** Parameters:      allow - (input) TRUE to stop the tick when idle
+**
+** Returns          void
+**
+*******************************************************************************/
+void GKI_allow_tick_stop (BOOLEAN allow)
+{
+#ifndef GKI_NO_TICK_STOP
+    GKI_disable();
+    gki_cb.os.tick_stop_allowed = allow;
+    if (gki_cb.com.p_tick_cb)
+    {
+        if (allow && !gki_timers_is_timer_running())
+        {
+            gki_cb.com.system_tick_running = FALSE;
+            gki_cb.com.p_tick_cb(FALSE);
+        }
+        else if (!allow)
+        {
+            gki_cb.com.system_tick_running = TRUE;
+            gki_cb.com.p_tick_cb(TRUE);
+        }
+    }
+    GKI_enable();
+#else
+    (void)allow;
+#endif
+}
+
+#if (GKI_STALL_WATCH == TRUE)
+static const char *gki_stall_kind_name[] = { "?", "wait", "mbox", "event" };
+#define GKI_STALL_KIND_NAME(k)  gki_stall_kind_name[((k) <= GKI_STALL_KIND_EVENT) ? (k) : 0]
+
+/*******************************************************************************
+**
+** Function         gki_stall_record
+**
+** Description      Add one timing to the record of a task's work. When the
+**                  table is full, the record with the shortest worst case is
+**                  replaced if this timing is longer.
+**
+** Returns          void
+**
+*******************************************************************************/
+static void gki_stall_record (UINT8 task_id, tGKI_STALL_FRAME *p_frame, UINT32 elapsed_us)
+{
+    tGKI_OS        *p_os = &gki_cb.os;
+    tGKI_STALL_REC *p_rec = NULL, *p_min = NULL;
+    int             xx;
+
+    pthread_mutex_lock (&p_os->stall_mutex);
+    for (xx = 0; xx < GKI_MAX_STALL_RECORDS; xx++)
+    {
+        tGKI_STALL_REC *p = &p_os->stall_rec[xx];
+
+        if (  (p->count) && (p->task_id == task_id)
+            &&(p->kind == p_frame->kind) && (p->id == p_frame->id)  )
+        {
+            p_rec = p;
+            break;
+        }
+        if ((p_min == NULL) || (p->count == 0) || ((p_min->count) && (p->max_us < p_min->max_us)))
+            p_min = p;
+    }
+
+    if (p_rec == NULL)
+    {
+        if ((p_min->count) && (p_min->max_us >= elapsed_us))
+        {
+            pthread_mutex_unlock (&p_os->stall_mutex);
+            return;
+        }
+        p_rec = p_min;
+        memset (p_rec, 0, sizeof (tGKI_STALL_REC));
+        p_rec->task_id = task_id;
+        p_rec->kind    = p_frame->kind;
+        p_rec->id      = p_frame->id;
+    }
+
+    p_rec->count++;
+    p_rec->total_us += elapsed_us;
+    if (elapsed_us > p_rec->max_us)
+        p_rec->max_us = elapsed_us;
+    if ((p_os->stall_budget_us) && (elapsed_us > p_os->stall_budget_us))
+        p_rec->over_budget++;
+    pthread_mutex_unlock (&p_os->stall_mutex);
+}
+
+/*******************************************************************************
+**
+** Function         gki_stall_pop
+**
+** Description      Close the innermost timed frame of a task. Work running
+**                  over budget is logged along with the frames it ran in.
+**
+** Returns          void
+**
+*******************************************************************************/
+static void gki_stall_pop (UINT8 task_id)
+{
+    tGKI_OS          *p_os = &gki_cb.os;
+    tGKI_STALL_FRAME *p_frame;
+    struct timespec   now;
+    UINT32            elapsed_us;
+    int               depth = --p_os->stall_depth[task_id];
+
+    if (depth >= GKI_STALL_MAX_DEPTH)
+        return;
+
+    p_frame = &p_os->stall_frame[task_id][depth];
+    clock_gettime (CLOCK_MONOTONIC, &now);
+    elapsed_us = (UINT32) ((now.tv_sec - p_frame->start.tv_sec) * 1000000
+                         + (now.tv_nsec - p_frame->start.tv_nsec) / 1000);
+    gki_stall_record (task_id, p_frame, elapsed_us);
+
+    if ((p_os->stall_budget_us) && (elapsed_us > p_os->stall_budget_us))
+    {
+        GKI_TRACE_ERROR_5 ("GKI stall: task %d %s 0x%04x took %u us, budget %u us",
+                           task_id, GKI_STALL_KIND_NAME(p_frame->kind), p_frame->id,
+                           elapsed_us, p_os->stall_budget_us);
+        while (--depth >= 0)
+        {
+            p_frame = &p_os->stall_frame[task_id][depth];
+            GKI_TRACE_ERROR_2 ("GKI stall:   in %s 0x%04x",
+                               GKI_STALL_KIND_NAME(p_frame->kind), p_frame->id);
+        }
+    }
+}
+#endif
+
+/*******************************************************************************
+**
+** Function         GKI_stall_begin
+**
+** Description      Start timing a piece of work done by the calling task.
+**                  Frames nest; each must be closed by GKI_stall_end().
+**                  GKI_wait() and GKI_read_mbox() time the events and
+**                  messages they return on their own.
+**
+** Parameters:      kind - (input) GKI_STALL_KIND_xxx
+**                  id   - (input) identifies the work within its kind
+**
+** Returns          void
+**
+*******************************************************************************/
+void GKI_stall_begin (UINT8 kind, UINT16 id)
+{
+#if (GKI_STALL_WATCH == TRUE)
+    UINT8             task_id = GKI_get_taskid();
+    tGKI_STALL_FRAME *p_frame;
+    UINT8             depth;
+
+    if (task_id >= GKI_MAX_TASKS)
+        return;
+
+    depth = gki_cb.os.stall_depth[task_id]++;
+    if (depth < GKI_STALL_MAX_DEPTH)
+    {
+        p_frame = &gki_cb.os.stall_frame[task_id][depth];
+        p_frame->kind = kind;
+        p_frame->id   = id;
+        clock_gettime (CLOCK_MONOTONIC, &p_frame->start);
+    }
+#else
+    (void)kind;
+    (void)id;
+#endif
+}
+
+/*******************************************************************************
+**
+** Function         GKI_stall_end
+**
+** Description      Stop timing the innermost piece of work of the calling
+**                  task, if it is of the given kind.
+**
+** Parameters:      kind - (input) GKI_STALL_KIND_xxx passed to GKI_stall_begin()
+**
+** Returns          void
+**
+*******************************************************************************/
+void GKI_stall_end (UINT8 kind)
+{
+#if (GKI_STALL_WATCH == TRUE)
+    UINT8 task_id = GKI_get_taskid();
+    UINT8 depth;
+
+    if (task_id >= GKI_MAX_TASKS)
+        return;
+
+    depth = gki_cb.os.stall_depth[task_id];
+    if (  (depth == 0)
+        ||((depth <= GKI_STALL_MAX_DEPTH) && (gki_cb.os.stall_frame[task_id][depth - 1].kind != kind))  )
+        return;
+
+    gki_stall_pop (task_id);
+#else
+    (void)kind;
+#endif
+}
+
+/*******************************************************************************
+**
+** Function         GKI_set_stall_budget
+**
+** Description      Set the time a task may spend on one event or message
+**                  before it is flagged as a stall.
+**
+** Parameters:      budget_ms - (input) budget in ms, 0 to only collect timings
+**
+** Returns          void
+**
+*******************************************************************************/
+void GKI_set_stall_budget (UINT32 budget_ms)
+{
+#if (GKI_STALL_WATCH == TRUE)
+    gki_cb.os.stall_budget_us = budget_ms * 1000;
+#else
+    (void)budget_ms;
+#endif
+}
+
+/*******************************************************************************
+**
+** Function         GKI_get_stalls
+**
+** Description      Get the timings collected by the stall watch, longest
+**                  worst case first.
+**
+** Parameters:      p_info - (output) receives the entries
+**                  max    - (input) size of p_info
+**
+** Returns          number of entries written
+**
+*******************************************************************************/
+UINT8 GKI_get_stalls (tGKI_STALL_INFO *p_info, UINT8 max)
+{
+    UINT8 num = 0;
+#if (GKI_STALL_WATCH == TRUE)
+    tGKI_STALL_REC  recs[GKI_MAX_STALL_RECORDS];
+    tGKI_STALL_REC *p_best;
+    int             xx;
+
+    pthread_mutex_lock (&gki_cb.os.stall_mutex);
+    memcpy (recs, gki_cb.os.stall_rec, sizeof (recs));
+    pthread_mutex_unlock (&gki_cb.os.stall_mutex);
+
+    while (num < max)
+    {
+        for (xx = 0, p_best = NULL; xx < GKI_MAX_STALL_RECORDS; xx++)
+        {
+            if ((recs[xx].count) && ((p_best == NULL) || (recs[xx].max_us > p_best->max_us)))
+                p_best = &recs[xx];
+        }
+        if (p_best == NULL)
+            break;
+
+        p_info[num].task_id     = p_best->task_id;
+        p_info[num].kind        = p_best->kind;
+        p_info[num].id          = p_best->id;
+        p_info[num].count       = p_best->count;
+        p_info[num].over_budget = p_best->over_budget;
+        p_info[num].max_us      = p_best->max_us;
+        p_info[num].avg_us      = (UINT32) (p_best->total_us / p_best->count);
+        p_best->count = 0;
+        num++;
+    }
+#else
+    (void)p_info;
+    (void)max;
+#endif
+    return (num);
 }
+
+/*******************************************************************************
+**
+** Function         GKI_reset_stalls
+**
+** Description      Clear the timings collected by the stall watch.
+**
+** Returns          void
+**
+*******************************************************************************/
+void GKI_reset_stalls (void)
+{
+#if (GKI_STALL_WATCH == TRUE)
+    pthread_mutex_lock (&gki_cb.os.stall_mutex);
+    memset (gki_cb.os.stall_rec, 0, sizeof (gki_cb.os.stall_rec));
+    pthread_mutex_unlock (&gki_cb.os.stall_mutex);
 #endif
+}
 
 /*******************************************************************************
 **
@@ -517,7 +832,7 @@ void GKI_run (void *p_task_id)
     /* register start stop function which disable timer loop in GKI_run() when no timers are
      * in any GKI/BTA/BTU this should save power when BTLD is idle! */
     GKI_timer_queue_register_callback( gki_system_tick_start_stop_cback );
-    APPL_TRACE_DEBUG0( "GKI_run(): Start/Stop GKI_timer_update_registered!" );
+    GKI_TRACE_0("GKI_run(): Start/Stop GKI_timer_update_registered!");
 #endif
 
 #ifdef NO_GKI_RUN_RETURN
@@ -576,13 +891,29 @@ void GKI_run (void *p_task_id)
         BT_TRACE_0( TRACE_LAYER_HCI, TRACE_TYPE_DEBUG, ">>> SUSPENDED GKI_timer_update()" );
 #endif
         if (GKI_TIMER_TICK_EXIT_COND != *p_run_cond) {
+            struct timespec suspended, resumed;
+            INT32 ms;
+
             GKI_TRACE_1("%s waiting timer mutex", __func__);
+            clock_gettime(CLOCK_MONOTONIC, &suspended);
             pthread_mutex_lock( &gki_cb.os.gki_timer_mutex );
-            pthread_cond_wait( &gki_cb.os.gki_timer_cond, &gki_cb.os.gki_timer_mutex );
+            /* the tick may have been restarted before we got here */
+            while (GKI_TIMER_TICK_STOP_COND == *p_run_cond)
+                pthread_cond_wait( &gki_cb.os.gki_timer_cond, &gki_cb.os.gki_timer_mutex );
             pthread_mutex_unlock( &gki_cb.os.gki_timer_mutex );
             GKI_TRACE_1("%s exited timer mutex", __func__);
+
+            /* keep the time stamps running across the suspension */
+            clock_gettime(CLOCK_MONOTONIC, &resumed);
+            ms = (INT32)((resumed.tv_sec - suspended.tv_sec) * 1000
+                         + (resumed.tv_nsec - suspended.tv_nsec) / NANOSEC_PER_MILLISEC);
+            if (ms >= LINUX_SEC)
+            {
+                GKI_disable();
+                gki_cb.com.OSTicks += ms / LINUX_SEC;
+                GKI_enable();
+            }
         }
-        /* potentially we need to adjust os gki_cb.com.OSTicks */
 
 #ifdef GKI_TICK_TIMER_DEBUG
         BT_TRACE_1( TRACE_LAYER_HCI, TRACE_TYPE_DEBUG, ">>> RESTARTED GKI_timer_update(): run_cond: %d",
@@ -656,6 +987,12 @@ UINT16 GKI_wait (UINT16 flag, UINT32 timeout)
         return 0;
     }
 
+#if (GKI_STALL_WATCH == TRUE)
+    /* the task is done with whatever the previous wait returned */
+    while (gki_cb.os.stall_depth[rtask])
+        gki_stall_pop (rtask);
+#endif
+
     gki_pthread_info_t* p_pthread_info = &gki_pthread_info[rtask];
     if (p_pthread_info->pCond != NULL && p_pthread_info->pMutex != NULL) {
         int ret;
@@ -757,6 +1094,9 @@ UINT16 GKI_wait (UINT16 flag, UINT32 timeout)
     pthread_mutex_unlock(&gki_cb.os.thread_evt_mutex[rtask]);
     GKI_TRACE_4("GKI_wait %d %x %d %x resumed", rtask, flag, timeout, evt);
 
+    if (evt)
+        GKI_stall_begin (GKI_STALL_KIND_WAIT, evt);
+
     return (evt);
 }
 
@@ -35,6 +35,20 @@ extern "C" {
 unsigned short crcChecksumCompute (const unsigned char *buffer, int bufferLen);
 
 
+/*******************************************************************************
+**
+** Function         crcCcittCompute
+**
+** Description      Update a CRC-16/CCITT (poly 0x1021, MSB first, no final
+**                  XOR) over a buffer of data; start with 0xFFFF.
+**                  crc: CRC of the data before buffer.
+**
+** Returns          2-byte CRC.
+**
+*******************************************************************************/
+unsigned short crcCcittCompute (unsigned short crc, const unsigned char *buffer, int bufferLen);
+
+
 /*******************************************************************************
 **
 ** Function         crcChecksumVerifyIntegrity
@@ -328,6 +328,26 @@ of order */
 #define GKI_MAX_EXCEPTION           8
 #endif
 
+/* TRUE to time the work tasks do between waits and report stalls. */
+#ifndef GKI_STALL_WATCH
+#define GKI_STALL_WATCH             TRUE
+#endif
+
+/* Default time in ms a task may spend on one event or message. */
+#ifndef GKI_STALL_BUDGET_MS
+#define GKI_STALL_BUDGET_MS         20
+#endif
+
+/* Number of task/event records kept for the stall report. */
+#ifndef GKI_MAX_STALL_RECORDS
+#define GKI_MAX_STALL_RECORDS       32
+#endif
+
+/* Nesting depth of timed frames per task. */
+#ifndef GKI_STALL_MAX_DEPTH
+#define GKI_STALL_MAX_DEPTH         4
+#endif
+
 /* Maximum number of chars stored for each exception message. */
 #ifndef GKI_MAX_EXCEPTION_MSGLEN
 #define GKI_MAX_EXCEPTION_MSGLEN    64
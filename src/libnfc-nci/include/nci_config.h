@@ -100,6 +100,14 @@ int GetNumValue(const char* name, void* p_value, unsigned long len);
 #if (NFC_NXP_LLCP_SECURED_P2P == TRUE)
 #define NAME_LLCP_SECURED_P2P_ENABLE    "LLCP_SECURED_P2P_ENABLE"
 #endif
+#define NAME_LLCP_MIU                   "LLCP_MIU"
+#define NAME_LLCP_LTO                   "LLCP_LTO"
+#define NAME_LLCP_WT                    "LLCP_WT"
+#define NAME_LLCP_DELAY_RESP_TIME       "LLCP_DELAY_RESP_TIME"
+#define NAME_SNEP_MIU                   "SNEP_MIU"
+#define NAME_SNEP_RW                    "SNEP_RW"
+#define NAME_CHO_MIU                    "CHO_MIU"
+#define NAME_CHO_RW                     "CHO_RW"
 
 #define NAME_SNOOZE_MODE_CFG            "SNOOZE_MODE_CFG"
 #define NAME_NFA_DM_DISC_DURATION_POLL  "NFA_DM_DISC_DURATION_POLL"
@@ -108,6 +116,7 @@ int GetNumValue(const char* name, void* p_value, unsigned long len);
 #define NAME_SPI_NEGOTIATION            "SPI_NEGOTIATION"
 #define NAME_AID_FOR_EMPTY_SELECT       "AID_FOR_EMPTY_SELECT"
 #define NAME_PRESERVE_STORAGE           "PRESERVE_STORAGE"
+#define NAME_STALL_BUDGET_MS            "STALL_BUDGET_MS"
 #define NAME_NFA_MAX_EE_SUPPORTED       "NFA_MAX_EE_SUPPORTED"
 #define NAME_NFCC_ENABLE_TIMEOUT        "NFCC_ENABLE_TIMEOUT"
 #define NAME_NFA_DM_PRE_DISCOVERY_CFG   "NFA_DM_PRE_DISCOVERY_CFG"
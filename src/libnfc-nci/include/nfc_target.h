@@ -301,6 +301,12 @@
 #define RW_T2T_SEC_SEL_TOUT_RESP    10
 #endif
 
+/* RW Type 2 Tag maximum number of blocks requested in one FAST_READ command.
+** 60 blocks (240 bytes) keep the response within a single NCI data packet */
+#ifndef RW_T2T_FAST_READ_MAX_BLOCKS
+#define RW_T2T_FAST_READ_MAX_BLOCKS 60
+#endif
+
 /* RW Type 3 Tag timeout for each API call, in ms */
 #ifndef RW_T3T_TOUT_RESP
 #define RW_T3T_TOUT_RESP            100         /* NFC-Android will use 100 instead of 75 for T3t presence-check */
@@ -348,6 +354,16 @@
 #define CE_T4T_MAX_REG_AID         4
 #endif
 
+/* CE Type 4 Tag, max number of preloaded R-APDUs */
+#ifndef CE_T4T_MAX_APDU_RSP
+#define CE_T4T_MAX_APDU_RSP        8
+#endif
+
+/* CE Type 4 Tag, max length of C-APDU matched with preloaded R-APDU */
+#ifndef CE_T4T_MAX_APDU_RSP_CMD_LEN
+#define CE_T4T_MAX_APDU_RSP_CMD_LEN 32
+#endif
+
 /* Sub carrier */
 #ifndef RW_I93_FLAG_SUB_CARRIER
 #define RW_I93_FLAG_SUB_CARRIER     I93_FLAG_SUB_CARRIER_SINGLE
@@ -358,6 +374,24 @@
 #define RW_I93_FLAG_DATA_RATE       I93_FLAG_DATA_RATE_HIGH
 #endif
 
+/* RW ISO 15693 number of consecutive successful Read Multiple Blocks before
+** the number of blocks per command is doubled (up to the limit of the tag and
+** of the NCI data packet) */
+#ifndef RW_I93_READ_MULTI_BLOCK_GROW_COUNT
+#define RW_I93_READ_MULTI_BLOCK_GROW_COUNT  2
+#endif
+
+/* RW ISO 15693 max number of UIDs collected by RW_I93InventoryAll () */
+#ifndef RW_I93_MAX_INVENTORY_UIDS
+#define RW_I93_MAX_INVENTORY_UIDS   64
+#endif
+
+/* RW ISO 15693 response timeout (ms) of a single slot of RW_I93InventoryAll ();
+** most slots of the search are empty, so don't wait RW_I93_MAX_RSP_TIMEOUT */
+#ifndef RW_I93_INVENTORY_TOUT_RESP
+#define RW_I93_INVENTORY_TOUT_RESP  50
+#endif
+
 /* TRUE, to include Card Emulation related test commands */
 #ifndef CE_TEST_INCLUDED
 #define CE_TEST_INCLUDED            FALSE
@@ -717,6 +751,11 @@
 #endif
 #endif
 
+/* Size of the compiled listen mode routing table kept to skip unchanged updates */
+#ifndef NFA_EE_LMRT_CACHE_SIZE
+#define NFA_EE_LMRT_CACHE_SIZE      (640)
+#endif
+
 /* Maximum number of callback functions can be registered through NFA_EeRegister() */
 #ifndef NFA_EE_MAX_CBACKS
 #define NFA_EE_MAX_CBACKS           (3)
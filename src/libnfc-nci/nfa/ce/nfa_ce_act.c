@@ -1671,3 +1671,42 @@ BOOLEAN nfa_ce_api_cfg_isodep_tech (tNFA_CE_MSG *p_ce_msg)
         nfa_ce_cb.isodep_disc_mask |= NFA_DM_DISC_MASK_LB_ISO_DEP;
     return TRUE;
 }
+
+/*******************************************************************************
+**
+** Function         nfa_ce_api_add_apdu_rsp
+**
+** Description      Add a preloaded R-APDU to CE T4T
+**
+** Returns          TRUE (message buffer to be freed by caller)
+**
+*******************************************************************************/
+BOOLEAN nfa_ce_api_add_apdu_rsp (tNFA_CE_MSG *p_ce_msg)
+{
+    tNFA_CE_API_ADD_APDU_RSP *p_add = &p_ce_msg->add_apdu_rsp;
+
+    if (CE_T4tAddApduResponse (p_add->cmd_len, p_add->cmd, p_add->mask,
+                               p_add->rsp_len, p_add->p_rsp) != NFC_STATUS_OK)
+    {
+        NFA_TRACE_ERROR0 ("nfa_ce_api_add_apdu_rsp (): R-APDU is not added");
+    }
+
+    return TRUE;
+}
+
+/*******************************************************************************
+**
+** Function         nfa_ce_api_clear_apdu_rsp
+**
+** Description      Remove all of preloaded R-APDUs from CE T4T
+**
+** Returns          TRUE (message buffer to be freed by caller)
+**
+*******************************************************************************/
+BOOLEAN nfa_ce_api_clear_apdu_rsp (tNFA_CE_MSG *p_ce_msg)
+{
+    CE_T4tClearApduResponses ();
+
+    return TRUE;
+}
+
@@ -45,6 +45,8 @@
 #include "nfa_sys.h"
 #include "nfa_ce_int.h"
 #include "nfa_sys_int.h"
+#include "ce_api.h"
+#include "ce_int.h"
 
 
 /*******************************************************************************
@@ -505,3 +507,113 @@ tNFA_STATUS NFA_CeSetIsoDepListenTech (tNFA_TECHNOLOGY_MASK tech_mask)
     return (NFA_STATUS_FAILED);
 }
 
+/*******************************************************************************
+**
+** Function         NFA_CeAddApduResponse
+**
+** Description      Add a R-APDU for ISO-DEP listen on DH, which is sent by NFA
+**                  without NFA_CE_DATA_EVT when the matching C-APDU is received.
+**                  A C-APDU matches if it has the same length and the same
+**                  bits set in mask. Other C-APDUs are reported as usual.
+**
+**                  cmd_len: length of C-APDU (up to CE_T4T_MAX_APDU_RSP_CMD_LEN)
+**                  p_cmd:   C-APDU
+**                  p_mask:  bits of C-APDU to compare, NULL to compare all
+**                  rsp_len: length of R-APDU including status words
+**                  p_rsp:   R-APDU
+**
+** Returns:
+**                  NFA_STATUS_OK, if command accepted
+**                  NFA_STATUS_INVALID_PARAM, if length is not valid
+**                  NFA_STATUS_FAILED: otherwise
+**
+*******************************************************************************/
+tNFA_STATUS NFA_CeAddApduResponse (UINT8   cmd_len,
+                                   UINT8  *p_cmd,
+                                   UINT8  *p_mask,
+                                   UINT16  rsp_len,
+                                   UINT8  *p_rsp)
+{
+    tNFA_CE_MSG *p_msg;
+
+    NFA_TRACE_API2 ("NFA_CeAddApduResponse (): cmd_len:%d, rsp_len:%d", cmd_len, rsp_len);
+
+    if (  (cmd_len == 0)
+        ||(cmd_len > CE_T4T_MAX_APDU_RSP_CMD_LEN)
+        ||(p_cmd == NULL)
+        ||(rsp_len < T4T_RSP_STATUS_WORDS_SIZE)
+        ||(rsp_len > CE_T4T_MAX_LE + T4T_RSP_STATUS_WORDS_SIZE)
+        ||(p_rsp == NULL)  )
+    {
+        NFA_TRACE_ERROR0 ("NFA_CeAddApduResponse (): Invalid parameter");
+        return (NFA_STATUS_INVALID_PARAM);
+    }
+
+    if ((p_msg = (tNFA_CE_MSG *) GKI_getbuf (sizeof (tNFA_CE_MSG) + rsp_len)) != NULL)
+    {
+        p_msg->hdr.event = NFA_CE_API_ADD_APDU_RSP_EVT;
+
+        p_msg->add_apdu_rsp.cmd_len = cmd_len;
+        memcpy (p_msg->add_apdu_rsp.cmd, p_cmd, cmd_len);
+
+        if (p_mask)
+            memcpy (p_msg->add_apdu_rsp.mask, p_mask, cmd_len);
+        else
+            memset (p_msg->add_apdu_rsp.mask, 0xFF, cmd_len);
+
+        p_msg->add_apdu_rsp.rsp_len = rsp_len;
+        p_msg->add_apdu_rsp.p_rsp   = (UINT8 *) (p_msg + 1);
+        memcpy (p_msg->add_apdu_rsp.p_rsp, p_rsp, rsp_len);
+
+        nfa_sys_sendmsg (p_msg);
+
+        return (NFA_STATUS_OK);
+    }
+
+    return (NFA_STATUS_FAILED);
+}
+
+/*******************************************************************************
+**
+** Function         NFA_CeClearApduResponses
+**
+** Description      Remove all of R-APDUs added by NFA_CeAddApduResponse ()
+**
+** Returns:
+**                  NFA_STATUS_OK, if command accepted
+**                  NFA_STATUS_FAILED: otherwise
+**
+*******************************************************************************/
+tNFA_STATUS NFA_CeClearApduResponses (void)
+{
+    BT_HDR *p_msg;
+
+    NFA_TRACE_API0 ("NFA_CeClearApduResponses ()");
+
+    if ((p_msg = (BT_HDR *) GKI_getbuf ((UINT16) sizeof(BT_HDR))) != NULL)
+    {
+        p_msg->event = NFA_CE_API_CLEAR_APDU_RSP_EVT;
+
+        nfa_sys_sendmsg (p_msg);
+
+        return (NFA_STATUS_OK);
+    }
+
+    return (NFA_STATUS_FAILED);
+}
+
+/*******************************************************************************
+**
+** Function         NFA_CeGetApduResponseStats
+**
+** Description      Get number of C-APDUs answered (hits) and not answered
+**                  (misses) by R-APDUs added with NFA_CeAddApduResponse ()
+**                  since the last ISO-DEP activation.
+**
+** Returns          None
+**
+*******************************************************************************/
+void NFA_CeGetApduResponseStats (UINT32 *p_hits, UINT32 *p_misses)
+{
+    CE_T4tGetApduResponseStats (p_hits, p_misses);
+}
@@ -28,6 +28,7 @@
 #include "nfa_ce_int.h"
 #include "nfa_dm_int.h"
 #include "nfa_sys_int.h"
+#include "ce_api.h"
 
 /* NFA_CE control block */
 tNFA_CE_CB nfa_ce_cb;
@@ -55,6 +56,8 @@ const tNFA_CE_ACTION nfa_ce_action_tbl[] =
     nfa_ce_api_cfg_isodep_tech, /* NFA_CE_API_CFG_ISODEP_TECH_EVT*/
     nfa_ce_activate_ntf,        /* NFA_CE_ACTIVATE_NTF_EVT      */
     nfa_ce_deactivate_ntf,      /* NFA_CE_DEACTIVATE_NTF_EVT    */
+    nfa_ce_api_add_apdu_rsp,    /* NFA_CE_API_ADD_APDU_RSP_EVT  */
+    nfa_ce_api_clear_apdu_rsp,  /* NFA_CE_API_CLEAR_APDU_RSP_EVT*/
 };
 #define NFA_CE_ACTION_TBL_SIZE  (sizeof (nfa_ce_action_tbl) / sizeof (tNFA_CE_ACTION))
 
@@ -112,6 +115,9 @@ void nfa_ce_sys_disable (void)
     /* Free scratch buf if any */
     nfa_ce_free_scratch_buf ();
 
+    /* Free preloaded R-APDUs */
+    CE_T4tClearApduResponses ();
+
     /* Delete discovery handles */
     for (xx = 0, p_info = nfa_ce_cb.listen_info; xx < NFA_CE_LISTEN_INFO_MAX; xx++, p_info++)
     {
@@ -229,6 +235,12 @@ static char *nfa_ce_evt_2_str (UINT16 event)
     case NFA_CE_DEACTIVATE_NTF_EVT:
         return "NFA_CE_DEACTIVATE_NTF_EVT";
 
+    case NFA_CE_API_ADD_APDU_RSP_EVT:
+        return "NFA_CE_API_ADD_APDU_RSP_EVT";
+
+    case NFA_CE_API_CLEAR_APDU_RSP_EVT:
+        return "NFA_CE_API_CLEAR_APDU_RSP_EVT";
+
     default:
         return "Unknown";
     }
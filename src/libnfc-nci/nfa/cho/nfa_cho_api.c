@@ -431,6 +431,69 @@ tNFA_STATUS NFA_ChoSendSelectError (UINT8  error_reason,
     return (NFA_STATUS_FAILED);
 }
 
+/*******************************************************************************
+**
+** Function         NFA_ChoSetConfig
+**
+** Description      This function is called to set MIU and RW of local
+**                  Handover end point for data link connections created
+**                  afterward.
+**
+**                  MIU is limited by local link MIU when data link connection
+**                  is created.
+**
+** Returns          NFA_STATUS_OK if successfully initiated
+**                  NFA_STATUS_INVALID_PARAM if MIU or RW is out of range
+**                  NFA_STATUS_FAILED otherwise
+**
+*******************************************************************************/
+tNFA_STATUS NFA_ChoSetConfig (UINT16 miu, UINT8 rw)
+{
+    tNFA_CHO_API_SET_CONFIG *p_msg;
+
+    CHO_TRACE_API2 ("NFA_ChoSetConfig (): miu:%d, rw:%d", miu, rw);
+
+    if (  (miu < LLCP_DEFAULT_MIU)
+        ||(miu > LLCP_MAX_MIU)
+        ||(rw == 0)
+        ||(rw > 0x0F)  )
+    {
+        CHO_TRACE_ERROR0 ("NFA_ChoSetConfig (): MIU or RW is out of range");
+        return (NFA_STATUS_INVALID_PARAM);
+    }
+
+    if ((p_msg = (tNFA_CHO_API_SET_CONFIG *) GKI_getbuf (sizeof (tNFA_CHO_API_SET_CONFIG))) != NULL)
+    {
+        p_msg->hdr.event = NFA_CHO_API_SET_CONFIG_EVT;
+        p_msg->miu       = miu;
+        p_msg->rw        = rw;
+
+        nfa_sys_sendmsg (p_msg);
+
+        return (NFA_STATUS_OK);
+    }
+
+    return (NFA_STATUS_FAILED);
+}
+
+/*******************************************************************************
+**
+** Function         NFA_ChoGetConfig
+**
+** Description      This function is called to read MIU and RW of local
+**                  Handover end point.
+**
+** Returns          None
+**
+*******************************************************************************/
+void NFA_ChoGetConfig (UINT16 *p_miu, UINT8 *p_rw)
+{
+    *p_miu = nfa_cho_cb.miu;
+    *p_rw  = nfa_cho_cb.rw;
+
+    CHO_TRACE_API2 ("NFA_ChoGetConfig (): miu:%d, rw:%d", *p_miu, *p_rw);
+}
+
 /*******************************************************************************
 **
 ** Function         NFA_ChoSetTraceLevel
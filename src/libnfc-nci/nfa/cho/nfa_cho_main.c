@@ -26,6 +26,8 @@
 #include "nfa_sys.h"
 #include "nfa_cho_api.h"
 #include "nfa_cho_int.h"
+#include "llcp_defs.h"
+#include "nci_config.h"
 #include "trace_api.h"
 
 /*****************************************************************************
@@ -85,6 +87,8 @@ static void nfa_cho_timer_cback (void *p_tle)
 *******************************************************************************/
 void nfa_cho_init (void)
 {
+    UINT32 num;
+
     CHO_TRACE_DEBUG0 ("nfa_cho_init ()");
 
     /* initialize control block */
@@ -100,6 +104,17 @@ void nfa_cho_init (void)
 
     nfa_cho_cb.trace_level    = APPL_INITIAL_TRACE_LEVEL;
 
+    nfa_cho_cb.miu = NFA_CHO_MIU;
+    nfa_cho_cb.rw  = NFA_CHO_RW;
+
+    /* override MIU and RW of data link connection from configuration file */
+    if (  (GetNumValue (NAME_CHO_MIU, &num, sizeof (num)))
+        &&(num >= LLCP_DEFAULT_MIU) && (num <= LLCP_MAX_MIU)  )
+        nfa_cho_cb.miu = (UINT16) num;
+    if (  (GetNumValue (NAME_CHO_RW, &num, sizeof (num)))
+        &&(num >= 1) && (num <= 0x0F)  )
+        nfa_cho_cb.rw = (UINT8) num;
+
     /* register message handler on NFA SYS */
     nfa_sys_register ( NFA_ID_CHO,  &nfa_cho_sys_reg);
 
@@ -145,7 +160,15 @@ static BOOLEAN nfa_cho_evt_hdlr (BT_HDR *p_msg)
 {
     tNFA_CHO_INT_EVENT_DATA *p_data = (tNFA_CHO_INT_EVENT_DATA *) p_msg;
 
-    nfa_cho_sm_execute (p_data->hdr.event, p_data);
+    if (p_data->hdr.event == NFA_CHO_API_SET_CONFIG_EVT)
+    {
+        /* used for data link connections created afterward, in any state */
+        nfa_cho_cb.miu = p_data->api_set_config.miu;
+        nfa_cho_cb.rw  = p_data->api_set_config.rw;
+        CHO_TRACE_DEBUG2 ("nfa_cho_evt_hdlr (): miu:%d, rw:%d", nfa_cho_cb.miu, nfa_cho_cb.rw);
+    }
+    else
+        nfa_cho_sm_execute (p_data->hdr.event, p_data);
 
     return TRUE;
 }
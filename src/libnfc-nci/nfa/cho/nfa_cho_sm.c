@@ -219,8 +219,8 @@ static void nfa_cho_sm_idle (tNFA_CHO_INT_EVT event, tNFA_CHO_INT_EVENT_DATA *p_
     case NFA_CHO_LLCP_CONNECT_IND_EVT:
 
         /* accept connection request */
-        params.miu = (UINT16) (nfa_cho_cb.local_link_miu >= NFA_CHO_MIU ? NFA_CHO_MIU : nfa_cho_cb.local_link_miu);
-        params.rw  = NFA_CHO_RW;
+        params.miu = (UINT16) (nfa_cho_cb.local_link_miu >= nfa_cho_cb.miu ? nfa_cho_cb.miu : nfa_cho_cb.local_link_miu);
+        params.rw  = nfa_cho_cb.rw;
         params.sn[0] = 0;
 
         LLCP_ConnectCfm (p_data->llcp_cback_data.connect_ind.local_sap,
@@ -364,8 +364,8 @@ static void nfa_cho_sm_w4_cc (tNFA_CHO_INT_EVT event, tNFA_CHO_INT_EVENT_DATA *p
             ** accept connection request and set collision flag
             ** wait for accepting connection request from peer or Hr message
             */
-            params.miu = (UINT16) (nfa_cho_cb.local_link_miu >= NFA_CHO_MIU ? NFA_CHO_MIU : nfa_cho_cb.local_link_miu);
-            params.rw  = NFA_CHO_RW;
+            params.miu = (UINT16) (nfa_cho_cb.local_link_miu >= nfa_cho_cb.miu ? nfa_cho_cb.miu : nfa_cho_cb.local_link_miu);
+            params.rw  = nfa_cho_cb.rw;
             params.sn[0] = 0;
 
             LLCP_ConnectCfm (p_data->llcp_cback_data.connect_ind.local_sap,
@@ -394,8 +394,8 @@ tNFA_STATUS nfa_cho_create_connection (void)
     else
     {
         /* create data link connection with server name */
-        conn_params.miu = (UINT16) (nfa_cho_cb.local_link_miu >= NFA_CHO_MIU ? NFA_CHO_MIU : nfa_cho_cb.local_link_miu);
-        conn_params.rw  = NFA_CHO_RW;
+        conn_params.miu = (UINT16) (nfa_cho_cb.local_link_miu >= nfa_cho_cb.miu ? nfa_cho_cb.miu : nfa_cho_cb.local_link_miu);
+        conn_params.rw  = nfa_cho_cb.rw;
         BCM_STRNCPY_S (conn_params.sn, sizeof (conn_params.sn),
                        p_cho_service_name, LLCP_MAX_SN_LEN);
         conn_params.sn[LLCP_MAX_SN_LEN] = 0;
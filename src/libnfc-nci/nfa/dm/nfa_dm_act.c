@@ -1420,6 +1420,32 @@ BOOLEAN nfa_dm_act_set_rf_disc_duration (tNFA_DM_MSG *p_data)
     nfa_dm_cb.disc_cb.disc_duration = p_data->disc_duration.rf_disc_dur_ms;
     return (TRUE);
 }
+
+/*******************************************************************************
+**
+** Function         nfa_dm_act_set_adaptive_poll
+**
+** Description      Enable/disable adaptive polling and reset its statistics
+**
+** Returns          TRUE (message buffer to be freed by caller)
+**
+*******************************************************************************/
+BOOLEAN nfa_dm_act_set_adaptive_poll (tNFA_DM_MSG *p_data)
+{
+    tNFA_DM_DISC_ADAPT *p_adapt = &nfa_dm_cb.disc_cb.adapt;
+
+    NFA_TRACE_DEBUG3 ("nfa_dm_act_set_adaptive_poll () enable:%d rare_freq:%d sweep_interval:%d",
+                       p_data->adaptive_poll.enable, p_data->adaptive_poll.rare_freq,
+                       p_data->adaptive_poll.sweep_interval);
+
+    memset (p_adapt, 0, sizeof (tNFA_DM_DISC_ADAPT));
+    p_adapt->enabled        = p_data->adaptive_poll.enable;
+    p_adapt->rare_freq      = (p_data->adaptive_poll.rare_freq) ? p_data->adaptive_poll.rare_freq
+                                                                : NFA_DM_ADAPT_DEF_RARE_FREQ;
+    p_adapt->sweep_interval = (p_data->adaptive_poll.sweep_interval) ? p_data->adaptive_poll.sweep_interval
+                                                                     : NFA_DM_ADAPT_DEF_SWEEP_INTERVAL;
+    return (TRUE);
+}
 #if(NFC_NXP_NOT_OPEN_INCLUDED == TRUE)
 /*******************************************************************************
 **
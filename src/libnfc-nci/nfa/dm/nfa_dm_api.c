@@ -758,6 +758,78 @@ tNFA_STATUS NFA_SetRfDiscoveryDuration (UINT16 discovery_period_ms)
     return (NFA_STATUS_FAILED);
 }
 
+/*******************************************************************************
+**
+** Function         NFA_SetAdaptivePolling
+**
+** Description      Enable or disable adaptive polling. When enabled, NFA counts
+**                  the poll mode activations of each technology. Once enough
+**                  activations are seen, the technologies that activate most
+**                  are listed first in RF_DISCOVER_CMD. Technologies with less
+**                  than 5% of the activations are polled every rare_freq
+**                  discovery periods. Every sweep_interval discovery starts,
+**                  all technologies use their configured frequency again.
+**                  Statistics are reset.
+**
+**                  rare_freq       - 0 to use the default (4)
+**                  sweep_interval  - 0 to use the default (8)
+**
+** Note:            Takes effect at the next start of RF discovery.
+**
+** Returns:
+**                  NFA_STATUS_OK, if command accepted
+**                  NFA_STATUS_FAILED: otherwise
+**
+*******************************************************************************/
+tNFA_STATUS NFA_SetAdaptivePolling (BOOLEAN enable, UINT8 rare_freq, UINT8 sweep_interval)
+{
+    tNFA_DM_API_SET_ADAPTIVE_POLL *p_msg;
+
+    NFA_TRACE_API3 ("NFA_SetAdaptivePolling () enable:%d rare_freq:%d sweep_interval:%d",
+                    enable, rare_freq, sweep_interval);
+
+    if ((p_msg = (tNFA_DM_API_SET_ADAPTIVE_POLL *) GKI_getbuf (sizeof (tNFA_DM_API_SET_ADAPTIVE_POLL))) != NULL)
+    {
+        p_msg->hdr.event      = NFA_DM_API_SET_ADAPTIVE_POLL_EVT;
+        p_msg->enable         = enable;
+        p_msg->rare_freq      = rare_freq;
+        p_msg->sweep_interval = sweep_interval;
+
+        nfa_sys_sendmsg (p_msg);
+
+        return (NFA_STATUS_OK);
+    }
+
+    return (NFA_STATUS_FAILED);
+}
+
+/*******************************************************************************
+**
+** Function         NFA_GetPollStats
+**
+** Description      Get poll mode activation and time-to-first-activation
+**                  statistics. Time-to-first-activation is measured from the
+**                  start (or restart after deactivation) of RF discovery to the
+**                  next poll mode activation.
+**
+** Returns          None
+**
+*******************************************************************************/
+void NFA_GetPollStats (tNFA_POLL_STATS *p_stats)
+{
+    tNFA_DM_DISC_ADAPT *p_adapt = &nfa_dm_cb.disc_cb.adapt;
+
+    if (p_stats == NULL)
+        return;
+
+    /* counters are updated by the NFA task; take a consistent snapshot */
+    GKI_disable ();
+    memcpy (p_stats, &p_adapt->stats, sizeof (tNFA_POLL_STATS));
+    p_stats->adaptive    = p_adapt->enabled;
+    p_stats->ttfa_avg_ms = (p_stats->ttfa_count) ? (p_adapt->ttfa_total_ms / p_stats->ttfa_count) : 0;
+    GKI_enable ();
+}
+
 /*******************************************************************************
 **
 ** Function         NFA_Select
@@ -41,6 +41,7 @@
  *
  ******************************************************************************/
 #include <string.h>
+#include <time.h>
 #include "nfa_sys.h"
 #include "nfa_api.h"
 #include "nfa_dm_int.h"
@@ -99,6 +100,180 @@ static nfa_dm_p2p_prio_logic_t p2p_prio_logic_data;
 static UINT16 P2P_PRIO_LOGIC_CLEANUP_TIMEOUT = 50; /*timeout value 500 ms for p2p_prio_logic_cleanup*/
 #endif
 BOOLEAN etsi_reader_in_progress = FALSE;
+/*******************************************************************************
+**
+** Function         nfa_dm_disc_adapt_tech_idx
+**
+** Description      Map a polling RF technology and mode to its index in
+**                  tNFA_POLL_STATS.activations[]
+**
+** Returns          index, or NFA_POLL_STATS_NUM_TECH if not a polling mode
+**
+*******************************************************************************/
+static UINT8 nfa_dm_disc_adapt_tech_idx (UINT8 tech_n_mode)
+{
+    if (tech_n_mode == NFC_DISCOVERY_TYPE_POLL_A)
+        return NFA_POLL_STATS_TECH_A;
+    else if (tech_n_mode == NFC_DISCOVERY_TYPE_POLL_B)
+        return NFA_POLL_STATS_TECH_B;
+    else if (tech_n_mode == NFC_DISCOVERY_TYPE_POLL_F)
+        return NFA_POLL_STATS_TECH_F;
+    else if (tech_n_mode == NFC_DISCOVERY_TYPE_POLL_A_ACTIVE)
+        return NFA_POLL_STATS_TECH_A_ACTIVE;
+    else if (tech_n_mode == NFC_DISCOVERY_TYPE_POLL_F_ACTIVE)
+        return NFA_POLL_STATS_TECH_F_ACTIVE;
+    else if (tech_n_mode == NFC_DISCOVERY_TYPE_POLL_ISO15693)
+        return NFA_POLL_STATS_TECH_ISO15693;
+    else if (tech_n_mode == NFC_DISCOVERY_TYPE_POLL_B_PRIME)
+        return NFA_POLL_STATS_TECH_B_PRIME;
+    else if (tech_n_mode == NFC_DISCOVERY_TYPE_POLL_KOVIO)
+        return NFA_POLL_STATS_TECH_KOVIO;
+
+    return NFA_POLL_STATS_NUM_TECH;
+}
+
+/*******************************************************************************
+**
+** Function         nfa_dm_disc_adapt_params
+**
+** Description      Adaptive polling: list the polling technologies that
+**                  activate most first, and poll the rarely activating ones
+**                  every rare_freq periods, except on every sweep_interval
+**                  discovery start.
+**
+** Returns          void
+**
+*******************************************************************************/
+static void nfa_dm_disc_adapt_params (tNFC_DISCOVER_PARAMS disc_params[], UINT8 num_params)
+{
+    tNFA_DM_DISC_ADAPT  *p_adapt = &nfa_dm_cb.disc_cb.adapt;
+    tNFC_DISCOVER_PARAMS poll_params[NFA_DM_MAX_DISC_PARAMS], tmp;
+    UINT8   poll_pos[NFA_DM_MAX_DISC_PARAMS];
+    UINT8   num_poll = 0, xx, yy, idx;
+    UINT32  count;
+
+    /* stats are read by NFA_GetPollStats () from the application thread */
+    GKI_disable ();
+    p_adapt->stats.discovery_starts++;
+    GKI_enable ();
+
+    if (  (!p_adapt->enabled)
+        ||(p_adapt->total_activations < NFA_DM_ADAPT_MIN_SAMPLES)  )
+    {
+        return;
+    }
+
+    if (++p_adapt->starts_since_sweep >= p_adapt->sweep_interval)
+    {
+        /* poll every technology as configured this time */
+        p_adapt->starts_since_sweep = 0;
+        GKI_disable ();
+        p_adapt->stats.sweeps++;
+        GKI_enable ();
+        NFA_TRACE_DEBUG1 ("nfa_dm_disc_adapt_params () sweep #%d", p_adapt->stats.sweeps);
+        return;
+    }
+
+    for (xx = 0; xx < num_params; xx++)
+    {
+        idx = nfa_dm_disc_adapt_tech_idx (disc_params[xx].type);
+        if (idx == NFA_POLL_STATS_NUM_TECH)
+            continue;
+
+        /* poll the rare technologies less often */
+        if (  (p_adapt->stats.activations[idx] * 100 < p_adapt->total_activations * NFA_DM_ADAPT_RARE_PERCENT)
+            &&(disc_params[xx].frequency < p_adapt->rare_freq)  )
+        {
+            disc_params[xx].frequency = p_adapt->rare_freq;
+        }
+        poll_pos[num_poll]      = xx;
+        poll_params[num_poll++] = disc_params[xx];
+    }
+
+    /* stable sort of the polling configurations, most activations first */
+    for (xx = 1; xx < num_poll; xx++)
+    {
+        tmp   = poll_params[xx];
+        count = p_adapt->stats.activations[nfa_dm_disc_adapt_tech_idx (tmp.type)];
+        for (yy = xx; yy > 0; yy--)
+        {
+            if (p_adapt->stats.activations[nfa_dm_disc_adapt_tech_idx (poll_params[yy - 1].type)] >= count)
+                break;
+            poll_params[yy] = poll_params[yy - 1];
+        }
+        poll_params[yy] = tmp;
+    }
+
+    for (xx = 0; xx < num_poll; xx++)
+    {
+        disc_params[poll_pos[xx]] = poll_params[xx];
+        NFA_TRACE_DEBUG2 ("nfa_dm_disc_adapt_params () type:0x%X frequency:%d",
+                           poll_params[xx].type, poll_params[xx].frequency);
+    }
+}
+
+/*******************************************************************************
+**
+** Function         nfa_dm_disc_adapt_now_ms
+**
+** Description      Read the monotonic clock in ms. GKI ticks are not used
+**                  since they stand still while LPCD has the tick stopped.
+**
+** Returns          current time in ms
+**
+*******************************************************************************/
+static UINT32 nfa_dm_disc_adapt_now_ms (void)
+{
+    struct timespec now;
+
+    clock_gettime (CLOCK_MONOTONIC, &now);
+    return (UINT32) (now.tv_sec * 1000 + now.tv_nsec / 1000000);
+}
+
+/*******************************************************************************
+**
+** Function         nfa_dm_disc_adapt_activated
+**
+** Description      Count a poll mode activation and record the time since RF
+**                  discovery started
+**
+** Returns          void
+**
+*******************************************************************************/
+static void nfa_dm_disc_adapt_activated (tNFC_RF_TECH_N_MODE tech_n_mode)
+{
+    tNFA_DM_DISC_ADAPT *p_adapt = &nfa_dm_cb.disc_cb.adapt;
+    UINT8   idx = nfa_dm_disc_adapt_tech_idx (tech_n_mode);
+    UINT32  elapsed_ms;
+
+    if (idx == NFA_POLL_STATS_NUM_TECH)
+        return;
+
+    GKI_disable ();
+    p_adapt->stats.activations[idx]++;
+    p_adapt->total_activations++;
+    GKI_enable ();
+
+    if (p_adapt->timing)
+    {
+        p_adapt->timing = FALSE;
+        elapsed_ms = nfa_dm_disc_adapt_now_ms () - p_adapt->start_ms;
+
+        GKI_disable ();
+        p_adapt->stats.ttfa_last_ms = elapsed_ms;
+        if ((p_adapt->stats.ttfa_count == 0) || (elapsed_ms < p_adapt->stats.ttfa_min_ms))
+            p_adapt->stats.ttfa_min_ms = elapsed_ms;
+        if (elapsed_ms > p_adapt->stats.ttfa_max_ms)
+            p_adapt->stats.ttfa_max_ms = elapsed_ms;
+        p_adapt->stats.ttfa_count++;
+        p_adapt->ttfa_total_ms += elapsed_ms;
+        GKI_enable ();
+
+        NFA_TRACE_DEBUG2 ("nfa_dm_disc_adapt_activated () tech_n_mode:0x%X ttfa:%d ms",
+                           tech_n_mode, elapsed_ms);
+    }
+}
+
 /*******************************************************************************
 **
 ** Function         nfa_dm_get_rf_discover_config
@@ -1325,6 +1500,9 @@ void nfa_dm_start_rf_discover (void)
         nfa_dm_set_total_duration ();
         nfa_dm_cb.disc_cb.dm_disc_mask = dm_disc_mask;
 
+        /* weight polling technologies by the activations seen so far */
+        nfa_dm_disc_adapt_params (disc_params, num_params);
+
         NFC_DiscoveryStart (num_params, disc_params, nfa_dm_disc_discovery_cback);
         /* set flag about waiting for response in IDLE state */
         nfa_dm_cb.disc_cb.disc_flags |= NFA_DM_DISC_FLAGS_W4_RSP;
@@ -1459,6 +1637,8 @@ static tNFA_STATUS nfa_dm_disc_notify_activation (tNFC_DISCOVER *p_data)
     NFA_TRACE_DEBUG2 ("nfa_dm_disc_notify_activation (): tech_n_mode:0x%X, proto:0x%X",
                        tech_n_mode, protocol);
 
+    nfa_dm_disc_adapt_activated (tech_n_mode);
+
     if (nfa_dm_cb.disc_cb.excl_disc_entry.in_use)
     {
         nfa_dm_cb.disc_cb.activated_tech_mode    = tech_n_mode;
@@ -2061,6 +2241,17 @@ void nfa_dm_disc_new_state (tNFA_DM_RF_DISC_STATE new_state)
 
     nfa_dm_cb.disc_cb.disc_state = new_state;
 
+    /* time-to-first-activation runs while polling, from (re)start of discovery */
+    if ((new_state == NFA_DM_RFST_DISCOVERY) && (old_state != NFA_DM_RFST_DISCOVERY))
+    {
+        nfa_dm_cb.disc_cb.adapt.timing      = TRUE;
+        nfa_dm_cb.disc_cb.adapt.start_ms    = nfa_dm_disc_adapt_now_ms ();
+    }
+    else if (new_state == NFA_DM_RFST_IDLE)
+    {
+        nfa_dm_cb.disc_cb.adapt.timing      = FALSE;
+    }
+
     if (  (new_state == NFA_DM_RFST_IDLE)
         &&(!(nfa_dm_cb.disc_cb.disc_flags & NFA_DM_DISC_FLAGS_W4_RSP))  ) /* not error recovering */
     {
@@ -94,6 +94,7 @@ const tNFA_DM_ACTION nfa_dm_action[] =
     nfa_dm_act_start_rf_discovery,      /* NFA_DM_API_START_RF_DISCOVERY_EVT    */
     nfa_dm_act_stop_rf_discovery,       /* NFA_DM_API_STOP_RF_DISCOVERY_EVT     */
     nfa_dm_act_set_rf_disc_duration,    /* NFA_DM_API_SET_RF_DISC_DURATION_EVT  */
+    nfa_dm_act_set_adaptive_poll,       /* NFA_DM_API_SET_ADAPTIVE_POLL_EVT     */
     nfa_dm_act_select,                  /* NFA_DM_API_SELECT_EVT                */
     nfa_dm_act_update_rf_params,        /* NFA_DM_API_UPDATE_RF_PARAMS_EVT      */
     nfa_dm_act_deactivate,              /* NFA_DM_API_DEACTIVATE_EVT            */
@@ -333,7 +334,9 @@ tNFA_STATUS nfa_dm_check_set_config (UINT8 tlv_list_len, UINT8 *p_tlv_list, BOOL
             }
             else
             {
-                update = FALSE;
+                /* not cached; do not compare against the previous TLV's cache */
+                update   = FALSE;
+                p_stored = NULL;
             }
 #endif
             break;
@@ -579,6 +582,9 @@ static char *nfa_dm_evt_2_str (UINT16 event)
     case NFA_DM_API_SET_RF_DISC_DURATION_EVT:
         return "NFA_DM_API_SET_RF_DISC_DURATION_EVT";
 
+    case NFA_DM_API_SET_ADAPTIVE_POLL_EVT:
+        return "NFA_DM_API_SET_ADAPTIVE_POLL_EVT";
+
     case NFA_DM_API_SELECT_EVT:
         return "NFA_DM_API_SELECT_EVT";
 
@@ -351,53 +351,135 @@ int nfa_all_ee_find_total_aid_len()
 }
 #endif
 
+/*******************************************************************************
+**
+** Function         nfa_ee_aid_hash
+**
+** Description      Hash the given AID to a bucket of the AID lookup index
+**
+** Returns          the bucket index
+**
+*******************************************************************************/
+static UINT16 nfa_ee_aid_hash(UINT8 aid_len, UINT8 *p_aid)
+{
+    UINT32 hash = 2166136261UL;  /* FNV-1a */
+    UINT8  xx;
+
+    for (xx = 0; xx < aid_len; xx++)
+    {
+        hash ^= p_aid[xx];
+        hash *= 16777619UL;
+    }
+    hash ^= aid_len;
+    return (UINT16)((hash ^ (hash >> 16)) & (NFA_EE_AID_HASH_SIZE - 1));
+}
+
+/*******************************************************************************
+**
+** Function         nfa_ee_aid_idx_insert
+**
+** Description      Add the AID entry at the given offset of the ECB to the AID
+**                  lookup index
+**
+** Returns          void
+**
+*******************************************************************************/
+static void nfa_ee_aid_idx_insert(tNFA_EE_ECB *p_ecb, int entry, int offset)
+{
+    tNFA_EE_AID_IDX *p_idx;
+    UINT8   *p_aid = &p_ecb->aid_cfg[offset + 1]; /* skip the tag */
+    UINT16  bucket;
+
+    if (nfa_ee_cb.aid_idx_used >= NFA_EE_AID_IDX_MAX)
+    {
+        NFA_TRACE_ERROR0 ("nfa_ee_aid_idx_insert () AID index full");
+        nfa_ee_cb.aid_idx_valid = FALSE;
+        return;
+    }
+    bucket          = nfa_ee_aid_hash(p_aid[0], p_aid + 1);
+    p_idx           = &nfa_ee_cb.aid_idx[nfa_ee_cb.aid_idx_used];
+    p_idx->offset   = (UINT16)offset;
+    p_idx->ecb_idx  = (UINT8)(p_ecb - nfa_ee_cb.ecb);
+    p_idx->entry    = (UINT8)entry;
+    p_idx->next     = nfa_ee_cb.aid_hash[bucket];
+    nfa_ee_cb.aid_hash[bucket] = nfa_ee_cb.aid_idx_used++;
+}
+
+/*******************************************************************************
+**
+** Function         nfa_ee_aid_idx_build
+**
+** Description      Rebuild the AID lookup index from aid_cfg[] of the DH and
+**                  the discovered NFCEEs
+**
+** Returns          void
+**
+*******************************************************************************/
+static void nfa_ee_aid_idx_build(void)
+{
+    tNFA_EE_ECB *p_ecb;
+    int  xx, yy, offset;
+
+    memset (nfa_ee_cb.aid_hash, 0xFF, sizeof (nfa_ee_cb.aid_hash));
+    nfa_ee_cb.aid_idx_used   = 0;
+    nfa_ee_cb.aid_idx_valid  = TRUE;
+    nfa_ee_cb.aid_idx_num_ee = nfa_ee_cb.cur_ee;
+
+    /* DH first, then the NFCEEs */
+    for (yy = 0; yy <= nfa_ee_cb.cur_ee && yy < NFA_EE_NUM_ECBS; yy++)
+    {
+        p_ecb  = (yy == 0) ? &nfa_ee_cb.ecb[NFA_EE_CB_4_DH] : &nfa_ee_cb.ecb[yy - 1];
+        offset = 0;
+        for (xx = 0; xx < p_ecb->aid_entries; xx++)
+        {
+            nfa_ee_aid_idx_insert(p_ecb, xx, offset);
+            offset += p_ecb->aid_len[xx];
+        }
+    }
+    NFA_TRACE_DEBUG1 ("nfa_ee_aid_idx_build () %d AID entries", nfa_ee_cb.aid_idx_used);
+}
+
 /*******************************************************************************
 **
 ** Function         nfa_ee_find_aid_offset
 **
 ** Description      Given the AID, find the associated tNFA_EE_ECB and the
 **                  offset in aid_cfg[]. *p_entry is the index.
+**                  The AID lookup index is rebuilt here if an AID entry was
+**                  removed or the NFCEEs changed since it was last built.
 **
-** Returns          void
+** Returns          the ECB holding the AID, or NULL if not found
 **
 *******************************************************************************/
 tNFA_EE_ECB * nfa_ee_find_aid_offset(UINT8 aid_len, UINT8 *p_aid, int *p_offset, int *p_entry)
 {
-    int  xx, yy, aid_len_offset, offset;
-    tNFA_EE_ECB *p_ret = NULL, *p_ecb;
+    tNFA_EE_AID_IDX *p_idx;
+    tNFA_EE_ECB *p_ecb;
+    UINT16  idx;
 
-    p_ecb = &nfa_ee_cb.ecb[NFA_EE_CB_4_DH];
-    aid_len_offset = 1; /* skip the tag */
-    for (yy = 0; yy < nfa_ee_cb.cur_ee; yy++, p_ecb++)
+    if (  (!nfa_ee_cb.aid_idx_valid)
+        ||(nfa_ee_cb.aid_idx_num_ee != nfa_ee_cb.cur_ee)  )
     {
-        if (p_ecb->aid_entries)
-        {
-            offset = 0;
-            for (xx = 0; xx < p_ecb->aid_entries; xx++)
-            {
-                if (  (p_ecb->aid_cfg[offset + aid_len_offset] == aid_len)
-                    &&(memcmp(&p_ecb->aid_cfg[offset + aid_len_offset + 1], p_aid, aid_len) == 0)  )
-                {
-                    p_ret = p_ecb;
-                    if (p_offset)
-                        *p_offset = offset;
-                    if (p_entry)
-                        *p_entry  = xx;
-                    break;
-                }
-                offset += p_ecb->aid_len[xx];
-            }
+        nfa_ee_aid_idx_build();
+    }
 
-            if (p_ret)
-            {
-                /* found the entry already */
-                break;
-            }
+    idx = nfa_ee_cb.aid_hash[nfa_ee_aid_hash(aid_len, p_aid)];
+    while (idx != NFA_EE_AID_IDX_NONE)
+    {
+        p_idx = &nfa_ee_cb.aid_idx[idx];
+        p_ecb = &nfa_ee_cb.ecb[p_idx->ecb_idx];
+        if (  (p_ecb->aid_cfg[p_idx->offset + 1] == aid_len)
+            &&(memcmp(&p_ecb->aid_cfg[p_idx->offset + 2], p_aid, aid_len) == 0)  )
+        {
+            if (p_offset)
+                *p_offset = p_idx->offset;
+            if (p_entry)
+                *p_entry  = p_idx->entry;
+            return p_ecb;
         }
-        p_ecb = &nfa_ee_cb.ecb[yy];
+        idx = p_idx->next;
     }
-
-    return p_ret;
+    return NULL;
 }
 
 /*******************************************************************************
@@ -823,6 +905,15 @@ void nfa_ee_api_add_aid(tNFA_EE_MSG *p_data)
 #else
                 p_cb->aid_len[p_cb->aid_entries++]     = (UINT8)(p - p_start);
 #endif
+                /* keep the AID lookup index in step; entries are appended */
+                if (nfa_ee_cb.aid_idx_valid)
+                {
+#if(NFC_NXP_NOT_OPEN_INCLUDED == TRUE)
+                    nfa_ee_aid_idx_insert(dh_ecb, dh_ecb->aid_entries - 1, len);
+#else
+                    nfa_ee_aid_idx_insert(p_cb, p_cb->aid_entries - 1, len);
+#endif
+                }
             }
         }
         else
@@ -896,6 +987,8 @@ void nfa_ee_api_remove_aid(tNFA_EE_MSG *p_data)
         }
         /* else the last entry, just reduce the aid_entries by 1 */
         p_cb->aid_entries--;
+        /* the entries after it moved; rebuild the AID lookup index on next use */
+        nfa_ee_cb.aid_idx_valid  = FALSE;
         nfa_ee_cb.ee_cfged      |= nfa_ee_ecb_to_mask(p_cb);
         nfa_ee_update_route_aid_size(p_cb);
         nfa_ee_start_timer();
@@ -926,6 +1019,7 @@ void nfa_ee_api_remove_aid(tNFA_EE_MSG *p_data)
         memset(&p_ecb->aid_rt_info[0], 0x00, sizeof(p_ecb->aid_rt_info));
         p_ecb->aid_entries = 0;
         p_cb->ecb_flags         |= NFA_EE_ECB_FLAGS_AID;
+        nfa_ee_cb.aid_idx_valid  = FALSE;
         nfa_ee_cb.ee_cfged      |= nfa_ee_ecb_to_mask(p_ecb);
     }
 #endif
@@ -1644,6 +1738,7 @@ void nfa_ee_nci_mode_set_rsp(tNFA_EE_MSG *p_data)
             p_cb->tech_switch_on    = p_cb->tech_switch_off = p_cb->tech_battery_off    = 0;
             p_cb->proto_switch_on   = p_cb->proto_switch_off= p_cb->proto_battery_off   = 0;
             p_cb->aid_entries       = 0;
+            nfa_ee_cb.aid_idx_valid = FALSE;
 #endif
             p_cb->ee_status = NFC_NFCEE_STATUS_INACTIVE;
         }
@@ -1730,6 +1825,13 @@ void nfa_ee_nci_wait_rsp(tNFA_EE_MSG *p_data)
         if (p_rsp->opcode == NCI_MSG_RF_SET_ROUTING)
             nfa_ee_cb.wait_rsp--;
     }
+    if (  (p_rsp->opcode == NCI_MSG_RF_SET_ROUTING)
+        &&(p_rsp->p_data)
+        &&(((tNFC_RESPONSE *)p_rsp->p_data)->status != NFC_STATUS_OK)  )
+    {
+        /* NFCC rejected (part of) the table; send it again on next update */
+        nfa_ee_cb.lmrt_last_valid = FALSE;
+    }
     nfa_ee_report_update_evt ();
 }
 
@@ -2112,6 +2214,131 @@ void nfa_ee_get_tech_route (UINT8 power_state, UINT8 *p_handles)
     NFA_TRACE_DEBUG4("0x%x, 0x%x, 0x%x, 0x%x", p_handles[0], p_handles[1], p_handles[2], p_handles[3]);
 }
 
+/*******************************************************************************
+**
+** Function         nfa_ee_set_routing
+**
+** Description      Send one RF_SET_LISTEN_MODE_ROUTING command to NFCC
+**
+** Returns          void
+**
+*******************************************************************************/
+static void nfa_ee_set_routing(BOOLEAN more, UINT8 num_tlv, UINT8 tlv_size, UINT8 *p_tlv)
+{
+    if (NFC_SetRouting(more, num_tlv, tlv_size, p_tlv) == NFA_STATUS_OK)
+    {
+        nfa_ee_cb.wait_rsp++;
+    }
+    else
+    {
+        /* NFCC content is unknown now */
+        nfa_ee_cb.lmrt_last_valid = FALSE;
+    }
+}
+
+/*******************************************************************************
+**
+** Function         nfa_ee_send_staged_routing
+**
+** Description      Send all the routing commands collected in lmrt_stage
+**
+** Returns          void
+**
+*******************************************************************************/
+static void nfa_ee_send_staged_routing(void)
+{
+    UINT8   *p = nfa_ee_cb.lmrt_stage;
+    UINT8   *p_end = p + nfa_ee_cb.lmrt_stage_len;
+    BOOLEAN more;
+    UINT8   num_tlv, tlv_size;
+
+    while (p < p_end)
+    {
+        more     = *p++;
+        num_tlv  = *p++;
+        tlv_size = *p++;
+        nfa_ee_set_routing(more, num_tlv, tlv_size, p);
+        p       += tlv_size;
+    }
+    nfa_ee_cb.lmrt_stage_len = 0;
+}
+
+/*******************************************************************************
+**
+** Function         nfa_ee_stage_routing
+**
+** Description      Collect one routing command of the listen mode routing table
+**                  being compiled. The commands are sent by nfa_ee_commit_lmrt()
+**                  once the whole table is known. If the table does not fit in
+**                  lmrt_stage, it is sent as it is built.
+**
+** Returns          void
+**
+*******************************************************************************/
+static void nfa_ee_stage_routing(BOOLEAN more, UINT8 num_tlv, UINT8 tlv_size, UINT8 *p_tlv)
+{
+    UINT8   *p;
+
+    if (  (!nfa_ee_cb.lmrt_passthru)
+        &&(nfa_ee_cb.lmrt_stage_len + 3 + tlv_size > NFA_EE_LMRT_CACHE_SIZE)  )
+    {
+        NFA_TRACE_DEBUG1 ("nfa_ee_stage_routing () LMRT exceeds %d bytes; not cached", NFA_EE_LMRT_CACHE_SIZE);
+        nfa_ee_cb.lmrt_passthru   = TRUE;
+        nfa_ee_cb.lmrt_last_valid = FALSE;
+        nfa_ee_send_staged_routing();
+    }
+
+    if (nfa_ee_cb.lmrt_passthru)
+    {
+        nfa_ee_set_routing(more, num_tlv, tlv_size, p_tlv);
+        return;
+    }
+
+    p    = nfa_ee_cb.lmrt_stage + nfa_ee_cb.lmrt_stage_len;
+    *p++ = more;
+    *p++ = num_tlv;
+    *p++ = tlv_size;
+    memcpy(p, p_tlv, tlv_size);
+    nfa_ee_cb.lmrt_stage_len += 3 + tlv_size;
+}
+
+/*******************************************************************************
+**
+** Function         nfa_ee_commit_lmrt
+**
+** Description      Send the compiled listen mode routing table to NFCC, unless
+**                  it is identical to the one NFCC already has.
+**
+** Returns          void
+**
+*******************************************************************************/
+static void nfa_ee_commit_lmrt(void)
+{
+    if (nfa_ee_cb.lmrt_passthru)
+    {
+        /* already sent while compiling */
+        nfa_ee_cb.lmrt_passthru = FALSE;
+        return;
+    }
+
+    if (nfa_ee_cb.lmrt_stage_len == 0)
+        return;
+
+    if (  (nfa_ee_cb.lmrt_last_valid)
+        &&(nfa_ee_cb.lmrt_last_len == nfa_ee_cb.lmrt_stage_len)
+        &&(memcmp(nfa_ee_cb.lmrt_last, nfa_ee_cb.lmrt_stage, nfa_ee_cb.lmrt_stage_len) == 0)  )
+    {
+        NFA_TRACE_DEBUG1 ("nfa_ee_commit_lmrt () LMRT unchanged (%d bytes); not sent", nfa_ee_cb.lmrt_stage_len);
+        nfa_ee_cb.lmrt_stage_len = 0;
+        return;
+    }
+
+    memcpy(nfa_ee_cb.lmrt_last, nfa_ee_cb.lmrt_stage, nfa_ee_cb.lmrt_stage_len);
+    nfa_ee_cb.lmrt_last_len   = nfa_ee_cb.lmrt_stage_len;
+    nfa_ee_cb.lmrt_last_valid = TRUE;
+    nfa_ee_send_staged_routing();
+}
+
 /*******************************************************************************
 **
 ** Function         nfa_ee_check_set_routing
@@ -2129,10 +2356,7 @@ void nfa_ee_check_set_routing(UINT16 new_size, int *p_max_len, UINT8 *p, int *p_
 
     if (new_size + *p_cur_offset > max_tlv)
     {
-        if (NFC_SetRouting(TRUE, *p, *p_cur_offset, p + 1) == NFA_STATUS_OK)
-        {
-            nfa_ee_cb.wait_rsp++;
-        }
+        nfa_ee_stage_routing(TRUE, *p, (UINT8)*p_cur_offset, p + 1);
         /* after the routing command is sent, re-use the same buffer to send the next routing command.
          * reset the related parameters */
         if (*p_max_len > *p_cur_offset)
@@ -2363,10 +2587,7 @@ tNFA_STATUS nfa_ee_route_add_one_ecb(tNFA_EE_ECB *p_cb, int *p_max_len, BOOLEAN
                 nfa_ee_cb.ee_cfg_sts       &= ~NFA_EE_STS_PREV_ROUTING;
             }
             NFA_TRACE_DEBUG2 ("nfa_ee_route_add_one_ecb: set routing num_tlv:%d tlv_size:%d", num_tlv, tlv_size);
-            if (NFC_SetRouting(more, num_tlv, (UINT8)(*p_cur_offset), ps + 1) == NFA_STATUS_OK)
-            {
-                nfa_ee_cb.wait_rsp++;
-            }
+            nfa_ee_stage_routing(more, num_tlv, (UINT8)(*p_cur_offset), ps + 1);
         }
         else if (nfa_ee_cb.ee_cfg_sts & NFA_EE_STS_PREV_ROUTING)
         {
@@ -2375,10 +2596,7 @@ tNFA_STATUS nfa_ee_route_add_one_ecb(tNFA_EE_ECB *p_cb, int *p_max_len, BOOLEAN
                 nfa_ee_cb.ee_cfg_sts       &= ~NFA_EE_STS_PREV_ROUTING;
                 /* indicated routing is configured to NFCC */
                 nfa_ee_cb.ee_cfg_sts       |= NFA_EE_STS_CHANGED_ROUTING;
-                if (NFC_SetRouting(more, 0, 0, ps + 1) == NFA_STATUS_OK)
-                {
-                    nfa_ee_cb.wait_rsp++;
-                }
+                nfa_ee_stage_routing(more, 0, 0, ps + 1);
             }
         }
     }
@@ -2569,6 +2787,8 @@ void nfa_ee_lmrt_to_nfcc(tNFA_EE_MSG *p_data)
     max_len = NFC_GetLmrtSize();
     max_tlv = (UINT8)((max_len > NFA_EE_ROUT_MAX_TLV_SIZE)?NFA_EE_ROUT_MAX_TLV_SIZE:max_len);
     cur_offset  = 0;
+    nfa_ee_cb.lmrt_stage_len = 0;
+    nfa_ee_cb.lmrt_passthru  = FALSE;
     /* use the first byte of the buffer (p) to keep the num_tlv */
     *p          = 0;
     status = nfa_ee_route_add_one_ecb(&nfa_ee_cb.ecb[NFA_EE_CB_4_DH], &max_len, more, p, &cur_offset);
@@ -2594,6 +2814,8 @@ void nfa_ee_lmrt_to_nfcc(tNFA_EE_MSG *p_data)
             }
         }
     }
+    /* send the compiled table, if NFCC does not have it yet */
+    nfa_ee_commit_lmrt();
 #if(NFC_NXP_NOT_OPEN_INCLUDED == TRUE)
     nfa_ee_cb.ee_flags &= ~NFA_EE_FLAG_CFG_NFC_DEP;
     evt_data.status = status;
@@ -149,6 +149,9 @@ void nfa_ee_init (void)
 *******************************************************************************/
 void nfa_ee_sys_enable (void)
 {
+    /* NFCC starts with an empty listen mode routing table */
+    nfa_ee_cb.lmrt_last_valid = FALSE;
+
     if (nfa_ee_max_ee_cfg)
     {
         /* collect NFCEE information */
@@ -243,6 +246,7 @@ void nfa_ee_proc_nfcc_power_mode (UINT8 nfcc_power_mode)
     /* if NFCC power state is change to full power */
     if (nfcc_power_mode == NFA_DM_PWR_MODE_FULL)
     {
+        nfa_ee_cb.lmrt_last_valid = FALSE;
         if (nfa_ee_max_ee_cfg)
         {
             p_cb = nfa_ee_cb.ecb;
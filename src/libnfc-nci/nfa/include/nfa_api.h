@@ -265,6 +265,31 @@ typedef union
 /* NFA_DM callback */
 typedef void (tNFA_DM_CBACK) (UINT8 event, tNFA_DM_CBACK_DATA *p_data);
 
+/* Index of polling technologies in tNFA_POLL_STATS.activations[] */
+#define NFA_POLL_STATS_TECH_A           0
+#define NFA_POLL_STATS_TECH_B           1
+#define NFA_POLL_STATS_TECH_F           2
+#define NFA_POLL_STATS_TECH_A_ACTIVE    3
+#define NFA_POLL_STATS_TECH_F_ACTIVE    4
+#define NFA_POLL_STATS_TECH_ISO15693    5
+#define NFA_POLL_STATS_TECH_B_PRIME     6
+#define NFA_POLL_STATS_TECH_KOVIO       7
+#define NFA_POLL_STATS_NUM_TECH         8
+
+/* Data for NFA_GetPollStats () */
+typedef struct
+{
+    BOOLEAN     adaptive;                               /* TRUE if adaptive polling is enabled          */
+    UINT32      activations[NFA_POLL_STATS_NUM_TECH];   /* poll mode activations per technology         */
+    UINT32      discovery_starts;                       /* RF discovery commands sent to NFCC           */
+    UINT32      sweeps;                                 /* starts polling all technologies as configured*/
+    UINT32      ttfa_count;                             /* number of time-to-first-activation samples   */
+    UINT32      ttfa_last_ms;                           /* last time-to-first-activation in ms          */
+    UINT32      ttfa_min_ms;                            /* shortest time-to-first-activation in ms      */
+    UINT32      ttfa_max_ms;                            /* longest time-to-first-activation in ms       */
+    UINT32      ttfa_avg_ms;                            /* average time-to-first-activation in ms       */
+} tNFA_POLL_STATS;
+
 #if(NFC_NXP_NOT_OPEN_INCLUDED == TRUE)
 /* NFA Enable DTA Type Mode */
 typedef enum
@@ -327,6 +352,8 @@ typedef struct
 #define NFA_ACTIVATED_UPDATE_EVT                41  /* Activated intf for updating the   tech variables */
 #define NFA_RECOVERY_EVT                        42  /*Recovery*/
 #endif
+#define NFA_NDEF_SEGMENT_EVT                    43  /* Segment of NDEF message (streaming read)     */
+#define NFA_I93_INVENTORY_ALL_EVT               44  /* UIDs of all ISO 15693 tags in the field      */
 
 /* NFC deactivation type */
 #define NFA_DEACTIVATE_TYPE_IDLE        NFC_DEACTIVATE_TYPE_IDLE
@@ -419,6 +446,16 @@ typedef struct
     UINT16              len;            /* Length of data                   */
 } tNFA_RX_DATA;
 
+/* Structure for NFA_NDEF_SEGMENT_EVT data */
+typedef struct
+{
+    tNFA_STATUS         status;         /* Status of the segment            */
+    UINT8               *p_data;        /* Segment data (valid in callback) */
+    UINT16              len;            /* Length of segment                */
+    UINT32              offset;         /* Offset of segment in NDEF message*/
+    UINT32              total_len;      /* Total length of NDEF message     */
+} tNFA_NDEF_SEGMENT;
+
 /* Structure for NFA_CE_NDEF_WRITE_CPLT_EVT data */
 typedef struct
 {
@@ -450,6 +487,15 @@ typedef struct
     UINT8           uid[I93_UID_BYTE_LEN];  /* UID[0]:MSB, ... UID[7]:LSB  */
 } tNFA_I93_INVENTORY;
 
+/* Data for NFA_I93_INVENTORY_ALL_EVT */
+typedef struct
+{
+    tNFA_STATUS     status;                 /* Status of the search              */
+    UINT8           num_uids;               /* Number of UIDs found              */
+    BOOLEAN         overflow;               /* TRUE if more tags than reported   */
+    UINT8          *p_uids;                 /* num_uids UIDs (valid in callback), UID[0]:MSB */
+} tNFA_I93_INVENTORY_ALL;
+
 typedef struct                              /* RW_I93_SYS_INFO_EVT                          */
 {
     UINT8           info_flags;             /* information flags                            */
@@ -537,10 +583,12 @@ typedef union
     tNFA_NDEF_DETECT         ndef_detect;       /* NFA_NDEF_DETECT_EVT                  */
     tNFA_TLV_DETECT          tlv_detect;        /* NFA_TLV_DETECT_EVT                   */
     tNFA_RX_DATA             data;              /* NFA_DATA_EVT                         */
+    tNFA_NDEF_SEGMENT        ndef_segment;      /* NFA_NDEF_SEGMENT_EVT                 */
     tNFA_CE_NDEF_WRITE_CPLT  ndef_write_cplt;   /* NFA_CE_NDEF_WRITE_CPLT_EVT           */
     tNFA_LLCP_ACTIVATED      llcp_activated;    /* NFA_LLCP_ACTIVATED_EVT               */
     tNFA_LLCP_DEACTIVATED    llcp_deactivated;  /* NFA_LLCP_DEACTIVATED_EVT             */
     tNFA_I93_CMD_CPLT        i93_cmd_cplt;      /* NFA_I93_CMD_CPLT_EVT                 */
+    tNFA_I93_INVENTORY_ALL   i93_inventory_all; /* NFA_I93_INVENTORY_ALL_EVT            */
     tNFA_CE_REGISTERED       ce_registered;     /* NFA_CE_REGISTERED_EVT                */
     tNFA_CE_DEREGISTERED     ce_deregistered;   /* NFA_CE_DEREGISTERED_EVT              */
     tNFA_CE_ACTIVATED        ce_activated;      /* NFA_CE_ACTIVATED_EVT                 */
@@ -1088,6 +1136,45 @@ NFC_API extern tNFA_STATUS NFA_StopRfDiscovery (void);
 *******************************************************************************/
 NFC_API extern tNFA_STATUS NFA_SetRfDiscoveryDuration (UINT16 discovery_period_ms);
 
+/*******************************************************************************
+**
+** Function         NFA_SetAdaptivePolling
+**
+** Description      Enable or disable adaptive polling. When enabled, NFA counts
+**                  the poll mode activations of each technology. Once enough
+**                  activations are seen, the technologies that activate most
+**                  are listed first in RF_DISCOVER_CMD. Technologies with less
+**                  than 5% of the activations are polled every rare_freq
+**                  discovery periods. Every sweep_interval discovery starts,
+**                  all technologies use their configured frequency again.
+**                  Statistics are reset.
+**
+**                  rare_freq       - 0 to use the default (4)
+**                  sweep_interval  - 0 to use the default (8)
+**
+** Note:            Takes effect at the next start of RF discovery.
+**
+** Returns:
+**                  NFA_STATUS_OK, if command accepted
+**                  NFA_STATUS_FAILED: otherwise
+**
+*******************************************************************************/
+NFC_API extern tNFA_STATUS NFA_SetAdaptivePolling (BOOLEAN enable, UINT8 rare_freq, UINT8 sweep_interval);
+
+/*******************************************************************************
+**
+** Function         NFA_GetPollStats
+**
+** Description      Get poll mode activation and time-to-first-activation
+**                  statistics. Time-to-first-activation is measured from the
+**                  start (or restart after deactivation) of RF discovery to the
+**                  next poll mode activation.
+**
+** Returns          None
+**
+*******************************************************************************/
+NFC_API extern void NFA_GetPollStats (tNFA_POLL_STATS *p_stats);
+
 /*******************************************************************************
 **
 ** Function         NFA_Select
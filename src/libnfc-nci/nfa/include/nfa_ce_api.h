@@ -271,6 +271,63 @@ NFC_API extern tNFA_STATUS NFA_CeDeregisterAidOnDH (tNFA_HANDLE handle);
 *******************************************************************************/
 NFC_API extern tNFA_STATUS NFA_CeSetIsoDepListenTech (tNFA_TECHNOLOGY_MASK tech_mask);
 
+/*******************************************************************************
+**
+** Function         NFA_CeAddApduResponse
+**
+** Description      Add a R-APDU for ISO-DEP listen on DH, which is sent by NFA
+**                  without NFA_CE_DATA_EVT when the matching C-APDU is received.
+**                  A C-APDU matches if it has the same length and the same
+**                  bits set in mask. Other C-APDUs are reported as usual.
+**
+**                  If a SELECT by name is answered this way, the AID is still
+**                  selected for following C-APDUs, but NFA_CE_ACTIVATED_EVT
+**                  of registered AID is reported with the first of them.
+**
+**                  cmd_len: length of C-APDU (up to CE_T4T_MAX_APDU_RSP_CMD_LEN)
+**                  p_cmd:   C-APDU
+**                  p_mask:  bits of C-APDU to compare, NULL to compare all
+**                  rsp_len: length of R-APDU including status words
+**                  p_rsp:   R-APDU
+**
+** Returns:
+**                  NFA_STATUS_OK, if command accepted
+**                  NFA_STATUS_INVALID_PARAM, if length is not valid
+**                  NFA_STATUS_FAILED: otherwise
+**
+*******************************************************************************/
+NFC_API extern tNFA_STATUS NFA_CeAddApduResponse (UINT8   cmd_len,
+                                                  UINT8  *p_cmd,
+                                                  UINT8  *p_mask,
+                                                  UINT16  rsp_len,
+                                                  UINT8  *p_rsp);
+
+/*******************************************************************************
+**
+** Function         NFA_CeClearApduResponses
+**
+** Description      Remove all of R-APDUs added by NFA_CeAddApduResponse ()
+**
+** Returns:
+**                  NFA_STATUS_OK, if command accepted
+**                  NFA_STATUS_FAILED: otherwise
+**
+*******************************************************************************/
+NFC_API extern tNFA_STATUS NFA_CeClearApduResponses (void);
+
+/*******************************************************************************
+**
+** Function         NFA_CeGetApduResponseStats
+**
+** Description      Get number of C-APDUs answered (hits) and not answered
+**                  (misses) by R-APDUs added with NFA_CeAddApduResponse ()
+**                  since the last ISO-DEP activation.
+**
+** Returns          None
+**
+*******************************************************************************/
+NFC_API extern void NFA_CeGetApduResponseStats (UINT32 *p_hits, UINT32 *p_misses);
+
 #ifdef __cplusplus
 }
 #endif
@@ -354,6 +354,36 @@ NFC_API extern tNFA_STATUS NFA_ChoSendHs (UINT8            *p_ndef,
 NFC_API extern tNFA_STATUS NFA_ChoSendSelectError (UINT8  error_reason,
                                                    UINT32 error_data);
 
+/*******************************************************************************
+**
+** Function         NFA_ChoSetConfig
+**
+** Description      This function is called to set MIU and RW of local
+**                  Handover end point for data link connections created
+**                  afterward.
+**
+**                  MIU is limited by local link MIU when data link connection
+**                  is created.
+**
+** Returns          NFA_STATUS_OK if successfully initiated
+**                  NFA_STATUS_INVALID_PARAM if MIU or RW is out of range
+**                  NFA_STATUS_FAILED otherwise
+**
+*******************************************************************************/
+NFC_API extern tNFA_STATUS NFA_ChoSetConfig (UINT16 miu, UINT8 rw);
+
+/*******************************************************************************
+**
+** Function         NFA_ChoGetConfig
+**
+** Description      This function is called to read MIU and RW of local
+**                  Handover end point.
+**
+** Returns          None
+**
+*******************************************************************************/
+NFC_API extern void NFA_ChoGetConfig (UINT16 *p_miu, UINT8 *p_rw);
+
 /*******************************************************************************
 **
 ** Function         NFA_ChoSetTraceLevel
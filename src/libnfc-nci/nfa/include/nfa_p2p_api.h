@@ -556,6 +556,22 @@ NFC_API extern void NFA_P2pGetLLCPConfig (UINT16 *p_link_miu,
                                           UINT16 *p_data_link_timeout,
                                           UINT16 *p_delay_first_pdu_timeout);
 
+/*******************************************************************************
+**
+** Function         NFA_P2pGetLinkStats
+**
+** Description      This function is called to read statistics of current LLCP
+**                  link, or of the last activated link if it has been
+**                  deactivated: negotiated link MIU, number of PDUs, bytes of
+**                  information sent and received, throughput and round trip
+**                  time of PDU exchange.
+**
+** Returns          NFA_STATUS_OK if any LLCP link has been activated
+**                  NFA_STATUS_FAILED otherwise
+**
+*******************************************************************************/
+NFC_API extern tNFA_STATUS NFA_P2pGetLinkStats (tLLCP_LINK_STATS *p_stats);
+
 /*******************************************************************************
 **
 ** Function         NFA_P2pSetTraceLevel
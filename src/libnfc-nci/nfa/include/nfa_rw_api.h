@@ -133,6 +133,50 @@ NFC_API extern tNFA_STATUS NFA_RwDetectNDef (void);
 *******************************************************************************/
 NFC_API extern tNFA_STATUS NFA_RwReadNDef (void);
 
+/*******************************************************************************
+**
+** Function         NFA_RwReadNDefStream
+**
+** Description      Read NDEF message from tag in streaming mode. Behaves like
+**                  NFA_RwReadNDef, except that the NDEF message is not
+**                  assembled by NFA and is not passed to the NDEF handlers.
+**
+**                  Instead, each segment is sent to the connection callback
+**                  with NFA_NDEF_SEGMENT_EVT as soon as the tag response is
+**                  received (per READ BINARY for type 4 tags, per READ
+**                  MULTIPLE BLOCKS for ISO 15693 and per CHECK for type 3
+**                  tags). Type 1 and type 2 tags are delivered as a single
+**                  segment once the message has been read.
+**
+**                  NFA_READ_CPLT_EVT is sent when the read is complete, or
+**                  after NFA_RwStopNDefStream was called.
+**
+** Returns:
+**                  NFA_STATUS_OK if successfully initiated
+**                  NFA_STATUS_FAILED otherwise
+**
+*******************************************************************************/
+NFC_API extern tNFA_STATUS NFA_RwReadNDefStream (void);
+
+/*******************************************************************************
+**
+** Function         NFA_RwStopNDefStream
+**
+** Description      Stop a streaming NDEF read started with NFA_RwReadNDefStream.
+**
+**                  This function must only be called from the connection
+**                  callback while handling NFA_NDEF_SEGMENT_EVT. No further
+**                  segment is delivered; for type 4 and ISO 15693 tags no
+**                  further command is sent to the tag and NFA_READ_CPLT_EVT
+**                  is sent with NFA_STATUS_OK once the callback returns.
+**
+** Returns:
+**                  NFA_STATUS_OK if the request was accepted
+**                  NFA_STATUS_FAILED if no streaming read is in progress
+**
+*******************************************************************************/
+NFC_API extern tNFA_STATUS NFA_RwStopNDefStream (void);
+
 /*******************************************************************************
 **
 ** Function         NFA_RwWriteNDef
@@ -503,6 +547,25 @@ NFC_API extern tNFA_STATUS NFA_RwT3tWrite (UINT8                num_blocks,
 *******************************************************************************/
 NFC_API extern tNFA_STATUS NFA_RwI93Inventory (BOOLEAN afi_present, UINT8 afi, UINT8 *p_uid);
 
+/*******************************************************************************
+**
+** Function         NFA_RwI93InventoryAll
+**
+** Description:
+**      Collect the UIDs of all ISO 15693 tags in the field with/without AFI,
+**      using the activated ISO 15693 tag's RF interface.
+**
+**      When the search has completed (or if an error occurs), the
+**      app will be notified with NFA_I93_INVENTORY_ALL_EVT.
+**
+** Returns:
+**      NFA_STATUS_OK if successfully initiated
+**      NFA_STATUS_WRONG_PROTOCOL: ISO 15693 tag not activated
+**      NFA_STATUS_FAILED otherwise
+**
+*******************************************************************************/
+NFC_API extern tNFA_STATUS NFA_RwI93InventoryAll (BOOLEAN afi_present, UINT8 afi);
+
 /*******************************************************************************
 **
 ** Function         NFA_RwI93StayQuiet
@@ -444,6 +444,35 @@ NFC_API extern tNFA_STATUS NFA_SnepPutResponse (tNFA_HANDLE         conn_handle,
 NFC_API extern tNFA_STATUS NFA_SnepDisconnect (tNFA_HANDLE conn_handle,
                                                BOOLEAN     flush);
 
+/*******************************************************************************
+**
+** Function         NFA_SnepSetConfig
+**
+** Description      This function is called to set MIU and RW of local SNEP
+**                  end point for data link connections created afterward.
+**
+**                  MIU is limited by local link MIU when data link connection
+**                  is created.
+**
+** Returns          NFA_STATUS_OK if successfully initiated
+**                  NFA_STATUS_INVALID_PARAM if MIU or RW is out of range
+**                  NFA_STATUS_FAILED otherwise
+**
+*******************************************************************************/
+NFC_API extern tNFA_STATUS NFA_SnepSetConfig (UINT16 miu, UINT8 rw);
+
+/*******************************************************************************
+**
+** Function         NFA_SnepGetConfig
+**
+** Description      This function is called to read MIU and RW of local SNEP
+**                  end point.
+**
+** Returns          None
+**
+*******************************************************************************/
+NFC_API extern void NFA_SnepGetConfig (UINT16 *p_miu, UINT8 *p_rw);
+
 /*******************************************************************************
 **
 ** Function         NFA_SnepSetTraceLevel
@@ -66,6 +66,8 @@ enum
     NFA_CE_API_CFG_ISODEP_TECH_EVT,
     NFA_CE_ACTIVATE_NTF_EVT,
     NFA_CE_DEACTIVATE_NTF_EVT,
+    NFA_CE_API_ADD_APDU_RSP_EVT,
+    NFA_CE_API_CLEAR_APDU_RSP_EVT,
 
     NFA_CE_MAX_EVT
 };
@@ -132,6 +134,17 @@ typedef struct
     UINT32          listen_info;
 } tNFA_CE_API_DEREG_LISTEN;
 
+/* data type for NFA_CE_API_ADD_APDU_RSP_EVT */
+typedef struct
+{
+    BT_HDR          hdr;
+    UINT8           cmd_len;
+    UINT8           cmd[CE_T4T_MAX_APDU_RSP_CMD_LEN];
+    UINT8           mask[CE_T4T_MAX_APDU_RSP_CMD_LEN];
+    UINT16          rsp_len;
+    UINT8           *p_rsp;         /* R-APDU follows this message */
+} tNFA_CE_API_ADD_APDU_RSP;
+
 /* union of all data types */
 typedef union
 {
@@ -141,6 +154,7 @@ typedef union
     tNFA_CE_API_REG_LISTEN      reg_listen;
     tNFA_CE_API_DEREG_LISTEN    dereg_listen;
     tNFA_CE_ACTIVATE_NTF        activate_ntf;
+    tNFA_CE_API_ADD_APDU_RSP    add_apdu_rsp;
 } tNFA_CE_MSG;
 
 /****************************************************************************
@@ -225,6 +239,8 @@ BOOLEAN nfa_ce_api_dereg_listen (tNFA_CE_MSG *p_ce_msg);
 BOOLEAN nfa_ce_api_cfg_isodep_tech (tNFA_CE_MSG *p_ce_msg);
 BOOLEAN nfa_ce_activate_ntf (tNFA_CE_MSG *p_ce_msg);
 BOOLEAN nfa_ce_deactivate_ntf (tNFA_CE_MSG *p_ce_msg);
+BOOLEAN nfa_ce_api_add_apdu_rsp (tNFA_CE_MSG *p_ce_msg);
+BOOLEAN nfa_ce_api_clear_apdu_rsp (tNFA_CE_MSG *p_ce_msg);
 
 /* Internal function prototypes */
 void nfa_ce_t3t_generate_rand_nfcid (UINT8 nfcid2[NCI_RF_F_UID_LEN]);
@@ -95,6 +95,7 @@ enum
     NFA_CHO_API_SEND_HR_EVT,          /* NFA_ChoSendHr ()           */
     NFA_CHO_API_SEND_HS_EVT,          /* NFA_ChoSendHs ()           */
     NFA_CHO_API_SEL_ERR_EVT,          /* NFA_ChoSendSelectError ()  */
+    NFA_CHO_API_SET_CONFIG_EVT,       /* NFA_ChoSetConfig ()        */
 
     NFA_CHO_RX_HANDOVER_MSG_EVT,      /* Received Handover Message  */
 
@@ -163,6 +164,14 @@ typedef struct
     UINT32              error_data;
 } tNFA_CHO_API_SEL_ERR;
 
+/* data type for NFA_CHO_API_SET_CONFIG_EVT */
+typedef struct
+{
+    BT_HDR              hdr;
+    UINT16              miu;
+    UINT8               rw;
+} tNFA_CHO_API_SET_CONFIG;
+
 /* data type for NFA_CHO_NDEF_TYPE_HANDLER_EVT */
 typedef struct
 {
@@ -182,6 +191,7 @@ typedef union
     tNFA_CHO_API_SEND_HR        api_send_hr;        /* NFA_CHO_API_SEND_HR_EVT    */
     tNFA_CHO_API_SEND_HS        api_send_hs;        /* NFA_CHO_API_SEND_HS_EVT    */
     tNFA_CHO_API_SEL_ERR        api_sel_err;        /* NFA_CHO_API_SEL_ERR_EVT    */
+    tNFA_CHO_API_SET_CONFIG     api_set_config;     /* NFA_CHO_API_SET_CONFIG_EVT */
     tNFA_CHO_NDEF_TYPE_HDLR_EVT ndef_type_hdlr;     /* NFA_CHO_NDEF_TYPE_HANDLER_EVT */
     tLLCP_SAP_CBACK_DATA        llcp_cback_data;    /* LLCP callback data         */
 } tNFA_CHO_INT_EVENT_DATA;
@@ -214,6 +224,8 @@ typedef struct
     tNFA_HANDLE         wifi_ndef_type_handle;  /* handle for WiFi NDEF Type handler    */
 
     UINT16              local_link_miu;         /* MIU of local LLCP                    */
+    UINT16              miu;                    /* MIU of data link, NFA_CHO_MIU by default */
+    UINT8               rw;                     /* RW of data link, NFA_CHO_RW by default   */
     UINT16              remote_miu;             /* peer's MIU of data link connection   */
     BOOLEAN             congested;              /* TRUE if data link is congested       */
 
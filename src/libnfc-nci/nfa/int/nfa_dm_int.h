@@ -73,6 +73,7 @@ enum
     NFA_DM_API_START_RF_DISCOVERY_EVT,
     NFA_DM_API_STOP_RF_DISCOVERY_EVT,
     NFA_DM_API_SET_RF_DISC_DURATION_EVT,
+    NFA_DM_API_SET_ADAPTIVE_POLL_EVT,
     NFA_DM_API_SELECT_EVT,
     NFA_DM_API_UPDATE_RF_PARAMS_EVT,
     NFA_DM_API_DEACTIVATE_EVT,
@@ -176,6 +177,15 @@ typedef struct
 } tNFA_DM_API_SET_RF_DISC_DUR;
 #define NFA_RF_DISC_DURATION_MAX                0xFFFF
 
+/* data type for NFA_DM_API_SET_ADAPTIVE_POLL_EVT */
+typedef struct
+{
+    BT_HDR              hdr;
+    BOOLEAN             enable;
+    UINT8               rare_freq;
+    UINT8               sweep_interval;
+} tNFA_DM_API_SET_ADAPTIVE_POLL;
+
 /* data type for NFA_DM_API_REG_NDEF_HDLR_EVT */
 #define NFA_NDEF_FLAGS_HANDLE_WHOLE_MESSAGE     0x01
 #define NFA_NDEF_FLAGS_WKT_URI                  0x02
@@ -235,6 +245,7 @@ typedef union
     tNFA_DM_API_SET_CONFIG          setconfig;          /* NFA_DM_API_SET_CONFIG_EVT            */
     tNFA_DM_API_GET_CONFIG          getconfig;          /* NFA_DM_API_GET_CONFIG_EVT            */
     tNFA_DM_API_SET_RF_DISC_DUR     disc_duration;      /* NFA_DM_API_SET_RF_DISC_DURATION_EVT  */
+    tNFA_DM_API_SET_ADAPTIVE_POLL   adaptive_poll;      /* NFA_DM_API_SET_ADAPTIVE_POLL_EVT     */
     tNFA_DM_API_REG_NDEF_HDLR       reg_ndef_hdlr;      /* NFA_DM_API_REG_NDEF_HDLR_EVT         */
     tNFA_DM_API_DEREG_NDEF_HDLR     dereg_ndef_hdlr;    /* NFA_DM_API_DEREG_NDEF_HDLR_EVT       */
     tNFA_DM_API_REQ_EXCL_RF_CTRL    req_excl_rf_ctrl;   /* NFA_DM_API_REQUEST_EXCL_RF_CTRL      */
@@ -382,6 +393,26 @@ enum {
     NFA_DM_DISC_LRT_NFC_BP
 };
 
+/* adaptive polling: a polling technology is rare if it produced less than this
+** percentage of the poll mode activations; it is polled every rare_freq periods */
+#define NFA_DM_ADAPT_RARE_PERCENT       5
+#define NFA_DM_ADAPT_MIN_SAMPLES        8       /* activations before adapting      */
+#define NFA_DM_ADAPT_DEF_RARE_FREQ      4       /* default rare_freq                */
+#define NFA_DM_ADAPT_DEF_SWEEP_INTERVAL 8       /* default sweep_interval           */
+
+typedef struct
+{
+    BOOLEAN                 enabled;            /* TRUE if adaptive polling is enabled              */
+    UINT8                   rare_freq;          /* discovery frequency for rare technologies        */
+    UINT8                   sweep_interval;     /* every Nth start uses the configured frequencies  */
+    UINT8                   starts_since_sweep; /* discovery starts since the last sweep            */
+    BOOLEAN                 timing;             /* TRUE if waiting for the first activation         */
+    UINT32                  start_ms;           /* monotonic ms when discovery (re)started          */
+    UINT32                  total_activations;  /* sum of stats.activations[]                       */
+    UINT32                  ttfa_total_ms;      /* sum of time-to-first-activation samples          */
+    tNFA_POLL_STATS         stats;              /* statistics reported by NFA_GetPollStats ()       */
+} tNFA_DM_DISC_ADAPT;
+
 /* SLP_REQ (HLTA) command */
 #define SLP_REQ_CMD     0x5000
 #define NFA_DM_MAX_TECH_ROUTE   4 /* NFA_EE_MAX_TECH_ROUTE. only A, B, F, Bprime are supported by UICC now */
@@ -420,6 +451,7 @@ typedef struct
     BOOLEAN                 deact_notify_pending;   /* TRUE if notify DEACTIVATED EVT while Stop rf discovery*/
     tNFA_DEACTIVATE_TYPE    pending_deact_type;     /* pending deactivate type                          */
 
+    tNFA_DM_DISC_ADAPT      adapt;                  /* adaptive polling scheduler                       */
 } tNFA_DM_DISC_CB;
 
 /* NDEF Type Handler Definitions */
@@ -625,6 +657,7 @@ BOOLEAN nfa_dm_set_p2p_listen_tech (tNFA_DM_MSG *p_data);
 BOOLEAN nfa_dm_act_start_rf_discovery (tNFA_DM_MSG *p_data);
 BOOLEAN nfa_dm_act_stop_rf_discovery (tNFA_DM_MSG *p_data);
 BOOLEAN nfa_dm_act_set_rf_disc_duration (tNFA_DM_MSG *p_data);
+BOOLEAN nfa_dm_act_set_adaptive_poll (tNFA_DM_MSG *p_data);
 BOOLEAN nfa_dm_act_select (tNFA_DM_MSG *p_data);
 BOOLEAN nfa_dm_act_update_rf_params (tNFA_DM_MSG *p_data);
 BOOLEAN nfa_dm_act_deactivate (tNFA_DM_MSG *p_data);
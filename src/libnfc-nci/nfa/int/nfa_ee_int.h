@@ -123,12 +123,16 @@ enum
     NFA_EE_CONN_ST_MAX
 };
 typedef UINT8 tNFA_EE_CONN_ST;
+#ifndef NFA_EE_MAX_AID_CFG_LEN
 #if(NFC_NXP_NOT_OPEN_INCLUDED == TRUE)
 #define NFA_EE_MAX_AID_CFG_LEN  (580)
-#define NFA_EE_MAX_AID_CFG_LEN_PN547C2  (160)
 #else
 #define NFA_EE_MAX_AID_CFG_LEN  (510)
 #endif
+#endif
+#if(NFC_NXP_NOT_OPEN_INCLUDED == TRUE)
+#define NFA_EE_MAX_AID_CFG_LEN_PN547C2  (160)
+#endif
 #define NFA_EE_7816_STATUS_LEN  (2)
 
 /* NFA EE control block flags:
@@ -455,6 +459,19 @@ typedef UINT8 tNFA_EE_DISC_STS;
 
 typedef void (tNFA_EE_ENABLE_DONE_CBACK)(tNFA_EE_DISC_STS status);
 
+/* hashed AID lookup index over the aid_cfg[] of all the ECBs */
+#define NFA_EE_AID_HASH_SIZE            64      /* number of buckets; must be a power of 2 */
+#define NFA_EE_AID_IDX_MAX              (NFA_EE_MAX_AID_ENTRIES * NFA_EE_NUM_ECBS)
+#define NFA_EE_AID_IDX_NONE             0xFFFF  /* end of a bucket chain */
+
+typedef struct
+{
+    UINT16                      offset;         /* offset of the AID entry in aid_cfg[] */
+    UINT16                      next;           /* next index entry in the same bucket  */
+    UINT8                       ecb_idx;        /* index of the ECB in nfa_ee_cb.ecb[]  */
+    UINT8                       entry;          /* index of the AID entry in the ECB    */
+} tNFA_EE_AID_IDX;
+
 /* NFA EE Management control block */
 typedef struct
 {
@@ -472,6 +489,17 @@ typedef struct
     UINT8                ee_cfg_sts;             /* configuration status             */
     tNFA_EE_WAIT         ee_wait_evt;            /* Pending event(s) to be reported  */
     tNFA_EE_FLAGS        ee_flags;               /* flags                            */
+    UINT16               aid_hash[NFA_EE_AID_HASH_SIZE];/* AID index bucket heads    */
+    tNFA_EE_AID_IDX      aid_idx[NFA_EE_AID_IDX_MAX];/* AID index entries            */
+    UINT16               aid_idx_used;           /* number of used AID index entries */
+    BOOLEAN              aid_idx_valid;          /* TRUE, if AID index matches ECBs  */
+    UINT8                aid_idx_num_ee;         /* cur_ee when AID index was built  */
+    UINT8                lmrt_stage[NFA_EE_LMRT_CACHE_SIZE];/* LMRT being compiled   */
+    UINT16               lmrt_stage_len;         /* length of lmrt_stage             */
+    BOOLEAN              lmrt_passthru;          /* LMRT too big to stage; sent as built */
+    UINT8                lmrt_last[NFA_EE_LMRT_CACHE_SIZE];/* LMRT last sent to NFCC */
+    UINT16               lmrt_last_len;          /* length of lmrt_last              */
+    BOOLEAN              lmrt_last_valid;        /* TRUE, if lmrt_last is in NFCC    */
 } tNFA_EE_CB;
 
 /*****************************************************************************
@@ -130,6 +130,7 @@ enum
     NFA_RW_OP_I93_LOCK_DSFID,
     NFA_RW_OP_I93_GET_SYS_INFO,
     NFA_RW_OP_I93_GET_MULTI_BLOCK_STATUS,
+    NFA_RW_OP_I93_INVENTORY_ALL,
 
 #if(NFC_NXP_NOT_OPEN_INCLUDED == TRUE)
     NFA_RW_OP_T3BT_PUPI,
@@ -141,6 +142,12 @@ typedef UINT8 tNFA_RW_OP;
 
 /* Enumeration of parameter structios for nfa_rw operations */
 
+/* NFA_RW_OP_READ_NDEF params */
+typedef struct
+{
+    BOOLEAN         stream;         /* TRUE to deliver segments with NFA_NDEF_SEGMENT_EVT */
+} tNFA_RW_OP_PARAMS_READ_NDEF;
+
 /* NFA_RW_OP_WRITE_NDEF params */
 typedef struct
 {
@@ -228,6 +235,9 @@ typedef struct
 /* Union of params for all reader/writer operations */
 typedef union
 {
+    /* params for NFA_RW_OP_READ_NDEF */
+    tNFA_RW_OP_PARAMS_READ_NDEF         read_ndef;
+
     /* params for NFA_RW_OP_WRITE_NDEF */
     tNFA_RW_OP_PARAMS_WRITE_NDEF        write_ndef;
 
@@ -328,6 +338,8 @@ typedef struct
     UINT32          ndef_cur_size;  /* current size of stored NDEF data (in bytes) */
     UINT8           *p_ndef_buf;
     UINT32          ndef_rd_offset; /* current read-offset of incoming NDEF data */
+    BOOLEAN         ndef_stream;    /* TRUE if NDEF segments are forwarded with NFA_NDEF_SEGMENT_EVT */
+    BOOLEAN         ndef_stream_stop; /* TRUE if app stopped the streaming NDEF read */
 
     /* Current NDEF Write info */
     UINT8           *p_ndef_wr_buf; /* Pointer to NDEF data being written */
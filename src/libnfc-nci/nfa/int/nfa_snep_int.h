@@ -51,6 +51,7 @@ enum
     NFA_SNEP_API_GET_RESP_EVT,
     NFA_SNEP_API_PUT_RESP_EVT,
     NFA_SNEP_API_DISCONNECT_EVT,
+    NFA_SNEP_API_SET_CONFIG_EVT,
 
     NFA_SNEP_LAST_EVT
 };
@@ -145,6 +146,14 @@ typedef struct
     BOOLEAN             flush;          /* TRUE if discard pending data    */
 } tNFA_SNEP_API_DISCONNECT;
 
+/* data type for NFA_SNEP_API_SET_CONFIG_EVT */
+typedef struct
+{
+    BT_HDR              hdr;
+    UINT16              miu;            /* MIU of data link connection     */
+    UINT8               rw;             /* RW of data link connection      */
+} tNFA_SNEP_API_SET_CONFIG;
+
 /* union of all event data types */
 typedef union
 {
@@ -160,6 +169,7 @@ typedef union
     tNFA_SNEP_API_GET_RESP              api_get_resp;               /* NFA_SNEP_API_GET_RESP_EVT     */
     tNFA_SNEP_API_PUT_RESP              api_put_resp;               /* NFA_SNEP_API_PUT_RESP_EVT     */
     tNFA_SNEP_API_DISCONNECT            api_disc;                   /* NFA_SNEP_API_DISCONNECT_EVT   */
+    tNFA_SNEP_API_SET_CONFIG            api_set_config;             /* NFA_SNEP_API_SET_CONFIG_EVT   */
 } tNFA_SNEP_MSG;
 
 /*****************************************************************************
@@ -203,6 +213,8 @@ typedef struct
 typedef struct
 {
     tNFA_SNEP_CONN      conn[NFA_SNEP_MAX_CONN];
+    UINT16              miu;            /* MIU of data link connection, NFA_SNEP_MIU by default */
+    UINT8               rw;             /* RW of data link connection, NFA_SNEP_RW by default   */
     BOOLEAN             listen_enabled;
     BOOLEAN             is_dta_mode;
     UINT8               trace_level;
@@ -288,6 +300,7 @@ BOOLEAN nfa_snep_get_resp (tNFA_SNEP_MSG *p_msg);
 BOOLEAN nfa_snep_put_req (tNFA_SNEP_MSG *p_msg);
 BOOLEAN nfa_snep_get_req (tNFA_SNEP_MSG *p_msg);
 BOOLEAN nfa_snep_disconnect (tNFA_SNEP_MSG *p_msg);
+BOOLEAN nfa_snep_set_config (tNFA_SNEP_MSG *p_msg);
 
 #endif /* (defined (NFA_SNEP_INCLUDED) && (NFA_SNEP_INCLUDED==TRUE)) */
 #endif /* NFA_SNEP_INT_H */
@@ -1135,6 +1135,30 @@ void NFA_P2pGetLLCPConfig (UINT16 *p_link_miu,
     P2P_TRACE_API1 ("delay_first_pdu_timeout:%d",*p_delay_first_pdu_timeout);
 }
 
+/*******************************************************************************
+**
+** Function         NFA_P2pGetLinkStats
+**
+** Description      This function is called to read statistics of current LLCP
+**                  link, or of the last activated link if it has been
+**                  deactivated: negotiated link MIU, number of PDUs, bytes of
+**                  information sent and received, throughput and round trip
+**                  time of PDU exchange.
+**
+** Returns          NFA_STATUS_OK if any LLCP link has been activated
+**                  NFA_STATUS_FAILED otherwise
+**
+*******************************************************************************/
+tNFA_STATUS NFA_P2pGetLinkStats (tLLCP_LINK_STATS *p_stats)
+{
+    P2P_TRACE_API0 ("NFA_P2pGetLinkStats ()");
+
+    if (LLCP_GetLinkStats (p_stats) != LLCP_STATUS_SUCCESS)
+        return (NFA_STATUS_FAILED);
+
+    return (NFA_STATUS_OK);
+}
+
 /*******************************************************************************
 **
 ** Function         NFA_P2pSetTraceLevel
@@ -79,6 +79,93 @@ void nfa_rw_free_ndef_rx_buf(void)
     }
 }
 
+/*******************************************************************************
+**
+** Function         nfa_rw_send_ndef_segment
+**
+** Description      Send a segment of the NDEF message being read to the app
+**                  (streaming NDEF read)
+**
+** Returns          Nothing
+**
+*******************************************************************************/
+static void nfa_rw_send_ndef_segment (UINT8 *p_data, UINT16 len)
+{
+    tNFA_CONN_EVT_DATA conn_evt_data;
+
+    /* App does not want any more data */
+    if (nfa_rw_cb.ndef_stream_stop)
+        return;
+
+    conn_evt_data.ndef_segment.status    = NFA_STATUS_OK;
+    conn_evt_data.ndef_segment.p_data    = p_data;
+    conn_evt_data.ndef_segment.len       = len;
+    conn_evt_data.ndef_segment.offset    = nfa_rw_cb.ndef_rd_offset;
+    conn_evt_data.ndef_segment.total_len = nfa_rw_cb.ndef_cur_size;
+
+    nfa_dm_act_conn_cback_notify(NFA_NDEF_SEGMENT_EVT, &conn_evt_data);
+}
+
+/*******************************************************************************
+**
+** Function         nfa_rw_stop_ndef_stream
+**
+** Description      Stop streaming NDEF read if requested by the app while
+**                  handling NFA_NDEF_SEGMENT_EVT
+**
+** Returns          Nothing
+**
+*******************************************************************************/
+static void nfa_rw_stop_ndef_stream (void)
+{
+    tNFA_CONN_EVT_DATA conn_evt_data;
+    tNFC_STATUS status = NFC_STATUS_FAILED;
+
+    if (!nfa_rw_cb.ndef_stream_stop)
+        return;
+
+    if (nfa_rw_cb.protocol == NFC_PROTOCOL_ISO_DEP)
+        status = RW_T4tStopNDefRead ();
+    else if (nfa_rw_cb.protocol == NFC_PROTOCOL_15693)
+        status = RW_I93StopNDefRead ();
+
+    /* Other tags: remaining segments are dropped, read completes as usual */
+    if (status != NFC_STATUS_OK)
+        return;
+
+    NFA_TRACE_DEBUG1 ("nfa_rw_stop_ndef_stream (): stopped at offset %i", nfa_rw_cb.ndef_rd_offset);
+
+    /* Command complete - perform cleanup, notify app */
+    nfa_rw_command_complete();
+    nfa_rw_cb.cur_op = NFA_RW_OP_MAX;
+    conn_evt_data.status = NFA_STATUS_OK;
+    nfa_dm_act_conn_cback_notify(NFA_READ_CPLT_EVT, &conn_evt_data);
+}
+
+/*******************************************************************************
+**
+** Function         nfa_rw_handle_ndef_rx_buf
+**
+** Description      Process NDEF message read from tag: send it to NDEF
+**                  handlers, or for streaming read send whatever was buffered
+**                  (type 1 and type 2 tags) as a single segment
+**
+** Returns          Nothing
+**
+*******************************************************************************/
+static void nfa_rw_handle_ndef_rx_buf (void)
+{
+    if (!nfa_rw_cb.ndef_stream)
+    {
+        nfa_dm_ndef_handle_message (NFA_STATUS_OK, nfa_rw_cb.p_ndef_buf, nfa_rw_cb.ndef_cur_size);
+    }
+    else if (nfa_rw_cb.p_ndef_buf)
+    {
+        nfa_rw_cb.ndef_rd_offset = 0;
+        nfa_rw_send_ndef_segment (nfa_rw_cb.p_ndef_buf, (UINT16) nfa_rw_cb.ndef_cur_size);
+    }
+}
+
 /*******************************************************************************
 **
 ** Function         nfa_rw_store_ndef_rx_buf
@@ -94,8 +181,16 @@ static void nfa_rw_store_ndef_rx_buf (tRW_DATA *p_rw_data)
 
     p = (UINT8 *)(p_rw_data->data.p_data + 1) + p_rw_data->data.p_data->offset;
 
-    /* Save data into buffer */
-    memcpy(&nfa_rw_cb.p_ndef_buf[nfa_rw_cb.ndef_rd_offset], p, p_rw_data->data.p_data->len);
+    if (nfa_rw_cb.ndef_stream)
+    {
+        /* Streaming read: pass segment to app straight from the GKI buffer */
+        nfa_rw_send_ndef_segment (p, p_rw_data->data.p_data->len);
+    }
+    else
+    {
+        /* Save data into buffer */
+        memcpy(&nfa_rw_cb.p_ndef_buf[nfa_rw_cb.ndef_rd_offset], p, p_rw_data->data.p_data->len);
+    }
     nfa_rw_cb.ndef_rd_offset += p_rw_data->data.p_data->len;
 
     GKI_freebuf(p_rw_data->data.p_data);
@@ -654,7 +749,7 @@ static void nfa_rw_handle_t1t_evt (tRW_EVENT event, tRW_DATA *p_rw_data)
         if (p_rw_data->status == NFC_STATUS_OK)
         {
             /* Process the ndef record */
-            nfa_dm_ndef_handle_message(NFA_STATUS_OK, nfa_rw_cb.p_ndef_buf, nfa_rw_cb.ndef_cur_size);
+            nfa_rw_handle_ndef_rx_buf ();
         }
         else
         {
@@ -819,7 +914,7 @@ static void nfa_rw_handle_t2t_evt (tRW_EVENT event, tRW_DATA *p_rw_data)
         if (p_rw_data->status == NFC_STATUS_OK)
         {
             /* Process the ndef record */
-            nfa_dm_ndef_handle_message(NFA_STATUS_OK, nfa_rw_cb.p_ndef_buf, nfa_rw_cb.ndef_cur_size);
+            nfa_rw_handle_ndef_rx_buf ();
         }
         else
         {
@@ -931,17 +1026,17 @@ static void nfa_rw_handle_t3t_evt (tRW_EVENT event, tRW_DATA *p_rw_data)
         break;
 
     case RW_T3T_CHECK_CPLT_EVT:         /* Read completed */
-        if (p_rw_data->status == NFC_STATUS_OK)
-        {
-            /* Process the ndef record */
-            nfa_dm_ndef_handle_message(NFA_STATUS_OK, nfa_rw_cb.p_ndef_buf, nfa_rw_cb.ndef_cur_size);
-        }
-        else
+        /* For a raw read (NFA_RW_OP_T3T_READ) the blocks were already passed up with NFA_DATA_EVT */
+        if (nfa_rw_cb.cur_op == NFA_RW_OP_READ_NDEF)
         {
-            /* Notify app of failure */
-            if (nfa_rw_cb.cur_op == NFA_RW_OP_READ_NDEF)
+            if (p_rw_data->status == NFC_STATUS_OK)
             {
-                /* If current operation is READ_NDEF, then notify ndef handlers of failure */
+                /* Process the ndef record */
+                nfa_rw_handle_ndef_rx_buf ();
+            }
+            else
+            {
+                /* Notify ndef handlers of failure */
                 nfa_dm_ndef_handle_message(NFA_STATUS_FAILED, NULL, 0);
             }
         }
@@ -1071,6 +1166,9 @@ static void nfa_rw_handle_t4t_evt (tRW_EVENT event, tRW_DATA *p_rw_data)
         if (nfa_rw_cb.cur_op == NFA_RW_OP_READ_NDEF)
         {
             nfa_rw_store_ndef_rx_buf (p_rw_data);
+
+            /* Stop reading if app has all the NDEF data it needs */
+            nfa_rw_stop_ndef_stream ();
         }
         else
         {
@@ -1084,7 +1182,7 @@ static void nfa_rw_handle_t4t_evt (tRW_EVENT event, tRW_DATA *p_rw_data)
             nfa_rw_store_ndef_rx_buf (p_rw_data);
 
             /* Process the ndef record */
-            nfa_dm_ndef_handle_message (NFA_STATUS_OK, nfa_rw_cb.p_ndef_buf, nfa_rw_cb.ndef_cur_size);
+            nfa_rw_handle_ndef_rx_buf ();
 
             /* Free ndef buffer */
             nfa_rw_free_ndef_rx_buf();
@@ -1208,6 +1306,9 @@ static void nfa_rw_handle_i93_evt (tRW_EVENT event, tRW_DATA *p_rw_data)
         if (nfa_rw_cb.cur_op == NFA_RW_OP_READ_NDEF)
         {
             nfa_rw_store_ndef_rx_buf (p_rw_data);
+
+            /* Stop reading if app has all the NDEF data it needs */
+            nfa_rw_stop_ndef_stream ();
         }
         else
         {
@@ -1221,7 +1322,7 @@ static void nfa_rw_handle_i93_evt (tRW_EVENT event, tRW_DATA *p_rw_data)
             nfa_rw_store_ndef_rx_buf (p_rw_data);
 
             /* Process the ndef record */
-            nfa_dm_ndef_handle_message (NFA_STATUS_OK, nfa_rw_cb.p_ndef_buf, nfa_rw_cb.ndef_cur_size);
+            nfa_rw_handle_ndef_rx_buf ();
 
             /* Free ndef buffer */
             nfa_rw_free_ndef_rx_buf();
@@ -1352,6 +1453,21 @@ static void nfa_rw_handle_i93_evt (tRW_EVENT event, tRW_DATA *p_rw_data)
         nfa_rw_cb.cur_op = NFA_RW_OP_MAX; /* clear current operation */
         break;
 
+    case RW_I93_INVENTORY_ALL_EVT:              /* Result of RW_I93InventoryAll */
+
+        /* Command complete - perform cleanup, notify app */
+        nfa_rw_command_complete();
+
+        conn_evt_data.i93_inventory_all.status   = p_rw_data->i93_inventory_all.status;
+        conn_evt_data.i93_inventory_all.num_uids = p_rw_data->i93_inventory_all.num_uids;
+        conn_evt_data.i93_inventory_all.overflow = p_rw_data->i93_inventory_all.overflow;
+        conn_evt_data.i93_inventory_all.p_uids   = p_rw_data->i93_inventory_all.p_uids;
+
+        nfa_dm_act_conn_cback_notify(NFA_I93_INVENTORY_ALL_EVT, &conn_evt_data);
+
+        nfa_rw_cb.cur_op = NFA_RW_OP_MAX; /* clear current operation */
+        break;
+
     case RW_I93_DATA_EVT:                       /* Response of Read, Get Multi Security */
 
         /* Command complete - perform cleanup, notify app */
@@ -1603,7 +1719,8 @@ static tNFC_STATUS nfa_rw_start_ndef_read(void)
         NFA_TRACE_DEBUG0("NDEF message is zero-length");
 
         /* Send zero-lengh NDEF message to ndef callback */
-        nfa_dm_ndef_handle_message(NFA_STATUS_OK, NULL, 0);
+        if (!nfa_rw_cb.ndef_stream)
+            nfa_dm_ndef_handle_message(NFA_STATUS_OK, NULL, 0);
 
         /* Command complete - perform cleanup, notify app */
         nfa_rw_command_complete();
@@ -1614,7 +1731,17 @@ static tNFC_STATUS nfa_rw_start_ndef_read(void)
 
     /* Allocate buffer for incoming NDEF message (free previous NDEF rx buffer, if needed) */
     nfa_rw_free_ndef_rx_buf ();
-    if ((nfa_rw_cb.p_ndef_buf = (UINT8 *)nfa_mem_co_alloc(nfa_rw_cb.ndef_cur_size)) == NULL)
+    nfa_rw_cb.ndef_rd_offset = 0;
+
+    /* Streaming read: segments are sent to app as received, no need to buffer the message */
+    if (  (nfa_rw_cb.ndef_stream)
+        &&(  (protocol == NFC_PROTOCOL_T3T)
+           ||(protocol == NFC_PROTOCOL_ISO_DEP)
+           ||(protocol == NFC_PROTOCOL_15693)  )  )
+    {
+        NFA_TRACE_DEBUG1("Streaming NDEF read (size=%i)", nfa_rw_cb.ndef_cur_size);
+    }
+    else if ((nfa_rw_cb.p_ndef_buf = (UINT8 *)nfa_mem_co_alloc(nfa_rw_cb.ndef_cur_size)) == NULL)
     {
         NFA_TRACE_ERROR1("Unable to allocate a buffer for reading NDEF (size=%i)", nfa_rw_cb.ndef_cur_size);
 
@@ -1624,7 +1751,6 @@ static tNFC_STATUS nfa_rw_start_ndef_read(void)
         nfa_dm_act_conn_cback_notify(NFA_READ_CPLT_EVT, &conn_evt_data);
         return NFC_STATUS_FAILED;
     }
-    nfa_rw_cb.ndef_rd_offset = 0;
 
     switch (protocol)
     {
@@ -1762,6 +1888,9 @@ static BOOLEAN nfa_rw_read_ndef(tNFA_RW_MSG *p_data)
 
     NFA_TRACE_DEBUG0("nfa_rw_read_ndef");
 
+    nfa_rw_cb.ndef_stream      = p_data->op_req.params.read_ndef.stream;
+    nfa_rw_cb.ndef_stream_stop = FALSE;
+
     /* Check if ndef detection has been performed yet */
     if (nfa_rw_cb.ndef_st == NFA_RW_NDEF_ST_UNKNOWN)
     {
@@ -2643,6 +2772,37 @@ static BOOLEAN nfa_rw_i93_command (tNFA_RW_MSG *p_data)
     return TRUE;
 }
 
+/*******************************************************************************
+**
+** Function         nfa_rw_i93_inventory_all
+**
+** Description      Handler for collecting the UIDs of all ISO 15693 tags
+**
+** Returns          TRUE (message buffer to be freed by caller)
+**
+*******************************************************************************/
+static BOOLEAN nfa_rw_i93_inventory_all (tNFA_RW_MSG *p_data)
+{
+    tNFA_CONN_EVT_DATA conn_evt_data;
+
+    if (RW_I93InventoryAll (p_data->op_req.params.i93_cmd.afi_present,
+                            p_data->op_req.params.i93_cmd.afi) != NFC_STATUS_OK)
+    {
+        /* Command complete - perform cleanup, notify app */
+        nfa_rw_command_complete();
+        nfa_rw_cb.cur_op = NFA_RW_OP_MAX; /* clear current operation */
+
+        conn_evt_data.i93_inventory_all.status   = NFA_STATUS_FAILED;
+        conn_evt_data.i93_inventory_all.num_uids = 0;
+        conn_evt_data.i93_inventory_all.overflow = FALSE;
+        conn_evt_data.i93_inventory_all.p_uids   = NULL;
+
+        nfa_dm_act_conn_cback_notify(NFA_I93_INVENTORY_ALL_EVT, &conn_evt_data);
+    }
+
+    return TRUE;
+}
+
 /*******************************************************************************
 **
 ** Function         nfa_rw_raw_mode_data_cback
@@ -3145,6 +3305,10 @@ BOOLEAN nfa_rw_handle_op_req (tNFA_RW_MSG *p_data)
         nfa_rw_i93_command (p_data);
         break;
 
+    case NFA_RW_OP_I93_INVENTORY_ALL:
+        nfa_rw_i93_inventory_all (p_data);
+        break;
+
 #if(NFC_NXP_NOT_OPEN_INCLUDED == TRUE)
     case NFA_RW_OP_T3BT_PUPI:
         nfa_rw_t3bt_get_pupi(p_data);
@@ -3236,6 +3400,12 @@ static BOOLEAN nfa_rw_op_req_while_busy(tNFA_RW_MSG *p_data)
     case NFA_RW_OP_I93_GET_MULTI_BLOCK_STATUS:
         event = NFA_I93_CMD_CPLT_EVT;
         break;
+    case NFA_RW_OP_I93_INVENTORY_ALL:
+        conn_evt_data.i93_inventory_all.num_uids = 0;
+        conn_evt_data.i93_inventory_all.overflow = FALSE;
+        conn_evt_data.i93_inventory_all.p_uids   = NULL;
+        event = NFA_I93_INVENTORY_ALL_EVT;
+        break;
     default:
         return (freebuf);
     }
@@ -3258,6 +3428,7 @@ void nfa_rw_command_complete(void)
 {
     /* Clear the busy flag */
     nfa_rw_cb.flags &= ~NFA_RW_FL_API_BUSY;
+    nfa_rw_cb.ndef_stream = FALSE;
 
     /* Restart presence_check timer */
     nfa_rw_check_start_presence_check_timer (NFA_RW_PRESENCE_CHECK_INTERVAL);
@@ -114,6 +114,7 @@ tNFA_STATUS NFA_RwReadNDef (void)
     {
         p_msg->hdr.event = NFA_RW_OP_REQUEST_EVT;
         p_msg->op        = NFA_RW_OP_READ_NDEF;
+        p_msg->params.read_ndef.stream = FALSE;
 
         nfa_sys_sendmsg (p_msg);
 
@@ -123,6 +124,68 @@ tNFA_STATUS NFA_RwReadNDef (void)
     return (NFA_STATUS_FAILED);
 }
 
+/*******************************************************************************
+**
+** Function         NFA_RwReadNDefStream
+**
+** Description      Read NDEF message from tag in streaming mode. Each segment
+**                  of the NDEF message is sent to the connection callback with
+**                  NFA_NDEF_SEGMENT_EVT as it is received from the tag, and
+**                  NFA_READ_CPLT_EVT is sent when the read is complete.
+**
+** Returns:
+**                  NFA_STATUS_OK if successfully initiated
+**                  NFA_STATUS_FAILED otherwise
+**
+*******************************************************************************/
+tNFA_STATUS NFA_RwReadNDefStream (void)
+{
+    tNFA_RW_OPERATION *p_msg;
+
+    NFA_TRACE_API0 ("NFA_RwReadNDefStream");
+
+    if ((p_msg = (tNFA_RW_OPERATION *) GKI_getbuf ((UINT16) (sizeof (tNFA_RW_OPERATION)))) != NULL)
+    {
+        p_msg->hdr.event = NFA_RW_OP_REQUEST_EVT;
+        p_msg->op        = NFA_RW_OP_READ_NDEF;
+        p_msg->params.read_ndef.stream = TRUE;
+
+        nfa_sys_sendmsg (p_msg);
+
+        return (NFA_STATUS_OK);
+    }
+
+    return (NFA_STATUS_FAILED);
+}
+
+/*******************************************************************************
+**
+** Function         NFA_RwStopNDefStream
+**
+** Description      Stop a streaming NDEF read. Must be called from the
+**                  connection callback while handling NFA_NDEF_SEGMENT_EVT.
+**
+** Returns:
+**                  NFA_STATUS_OK if the request was accepted
+**                  NFA_STATUS_FAILED if no streaming read is in progress
+**
+*******************************************************************************/
+tNFA_STATUS NFA_RwStopNDefStream (void)
+{
+    NFA_TRACE_API0 ("NFA_RwStopNDefStream");
+
+    if (  (nfa_rw_cb.cur_op != NFA_RW_OP_READ_NDEF)
+        ||(!nfa_rw_cb.ndef_stream)  )
+    {
+        return (NFA_STATUS_FAILED);
+    }
+
+    /* Checked by nfa_rw once the NFA_NDEF_SEGMENT_EVT callback returns */
+    nfa_rw_cb.ndef_stream_stop = TRUE;
+
+    return (NFA_STATUS_OK);
+}
+
 
 
 /*******************************************************************************
@@ -862,6 +925,51 @@ tNFA_STATUS NFA_RwI93Inventory (BOOLEAN afi_present, UINT8 afi, UINT8 *p_uid)
     return (NFA_STATUS_FAILED);
 }
 
+/*******************************************************************************
+**
+** Function         NFA_RwI93InventoryAll
+**
+** Description:
+**      Collect the UIDs of all ISO 15693 tags in the field with/without AFI,
+**      using the activated ISO 15693 tag's RF interface.
+**
+**      When the search has completed (or if an error occurs), the
+**      app will be notified with NFA_I93_INVENTORY_ALL_EVT.
+**
+** Returns:
+**      NFA_STATUS_OK if successfully initiated
+**      NFA_STATUS_WRONG_PROTOCOL: ISO 15693 tag not activated
+**      NFA_STATUS_FAILED otherwise
+**
+*******************************************************************************/
+tNFA_STATUS NFA_RwI93InventoryAll (BOOLEAN afi_present, UINT8 afi)
+{
+    tNFA_RW_OPERATION *p_msg;
+
+    NFA_TRACE_API2 ("NFA_RwI93InventoryAll (): afi_present:%d, AFI: 0x%02X", afi_present, afi);
+
+    if (nfa_rw_cb.protocol != NFC_PROTOCOL_15693)
+    {
+        return (NFA_STATUS_WRONG_PROTOCOL);
+    }
+
+    if ((p_msg = (tNFA_RW_OPERATION *) GKI_getbuf ((UINT16) (sizeof (tNFA_RW_OPERATION)))) != NULL)
+    {
+        /* Fill in tNFA_RW_OPERATION struct */
+        p_msg->hdr.event = NFA_RW_OP_REQUEST_EVT;
+        p_msg->op        = NFA_RW_OP_I93_INVENTORY_ALL;
+
+        p_msg->params.i93_cmd.afi_present = afi_present;
+        p_msg->params.i93_cmd.afi = afi;
+
+        nfa_sys_sendmsg (p_msg);
+
+        return (NFA_STATUS_OK);
+    }
+
+    return (NFA_STATUS_FAILED);
+}
+
 /*******************************************************************************
 **
 ** Function         NFA_RwI93StayQuiet
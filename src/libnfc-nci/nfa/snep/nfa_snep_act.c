@@ -140,6 +140,30 @@ static void nfa_snep_timer_cback (void *p_tle)
                         nfa_snep_cb.conn[dlink].remote_sap, TRUE);
 }
 
+/*******************************************************************************
+**
+** Function         nfa_snep_get_local_miu
+**
+** Description      Get configured MIU for data link connection, limited by
+**                  local link MIU
+**
+** Returns          MIU to receive on data link connection
+**
+*******************************************************************************/
+static UINT16 nfa_snep_get_local_miu (void)
+{
+    UINT16 local_link_miu, remote_link_miu;
+
+    LLCP_GetLinkMIU (&local_link_miu, &remote_link_miu);
+
+    if ((local_link_miu) && (nfa_snep_cb.miu > local_link_miu))
+    {
+        return local_link_miu;
+    }
+
+    return nfa_snep_cb.miu;
+}
+
 /*******************************************************************************
 **
 ** Function         nfa_snep_get_efficent_miu
@@ -1221,8 +1245,8 @@ void nfa_snep_proc_llcp_connect_ind (tLLCP_SAP_CBACK_DATA  *p_data)
                                                                         p_data->connect_ind.rw);
 
             /* accept connection request */
-            params.miu = NFA_SNEP_MIU;
-            params.rw  = NFA_SNEP_RW;
+            params.miu = nfa_snep_get_local_miu ();
+            params.rw  = nfa_snep_cb.rw;
             params.sn[0] = 0;
 
             LLCP_ConnectCfm (p_data->connect_ind.local_sap,
@@ -1740,8 +1764,8 @@ BOOLEAN nfa_snep_connect (tNFA_SNEP_MSG *p_msg)
         nfa_snep_cb.conn[xx].flags = NFA_SNEP_FLAG_CLIENT|NFA_SNEP_FLAG_CONNECTING;
 
         /* create data link connection with server name */
-        conn_params.miu = NFA_SNEP_MIU;
-        conn_params.rw  = NFA_SNEP_RW;
+        conn_params.miu = nfa_snep_get_local_miu ();
+        conn_params.rw  = nfa_snep_cb.rw;
         BCM_STRNCPY_S (conn_params.sn, sizeof (conn_params.sn),
                        p_msg->api_connect.service_name, LLCP_MAX_SN_LEN);
         conn_params.sn[LLCP_MAX_SN_LEN] = 0;
@@ -1926,6 +1950,27 @@ BOOLEAN nfa_snep_disconnect (tNFA_SNEP_MSG *p_msg)
     return TRUE;
 }
 
+/*******************************************************************************
+**
+** Function         nfa_snep_set_config
+**
+** Description      Set MIU and RW for data link connections created afterward
+**
+**
+** Returns          TRUE to deallocate message
+**
+*******************************************************************************/
+BOOLEAN nfa_snep_set_config (tNFA_SNEP_MSG *p_msg)
+{
+    SNEP_TRACE_DEBUG2 ("nfa_snep_set_config (): miu = %d, rw = %d",
+                       p_msg->api_set_config.miu, p_msg->api_set_config.rw);
+
+    nfa_snep_cb.miu = p_msg->api_set_config.miu;
+    nfa_snep_cb.rw  = p_msg->api_set_config.rw;
+
+    return TRUE;
+}
+
 #if (BT_TRACE_VERBOSE == TRUE)
 /*******************************************************************************
 **
@@ -26,6 +26,7 @@
 #include "nfa_sys.h"
 #include "nfa_sys_int.h"
 #include "nfa_snep_int.h"
+#include "llcp_defs.h"
 #include "nfa_mem_co.h"
 
 /*****************************************************************************
@@ -601,6 +602,68 @@ tNFA_STATUS NFA_SnepDisconnect (tNFA_HANDLE conn_handle, BOOLEAN flush)
     return (NFA_STATUS_FAILED);
 }
 
+/*******************************************************************************
+**
+** Function         NFA_SnepSetConfig
+**
+** Description      This function is called to set MIU and RW of local SNEP
+**                  end point for data link connections created afterward.
+**
+**                  MIU is limited by local link MIU when data link connection
+**                  is created.
+**
+** Returns          NFA_STATUS_OK if successfully initiated
+**                  NFA_STATUS_INVALID_PARAM if MIU or RW is out of range
+**                  NFA_STATUS_FAILED otherwise
+**
+*******************************************************************************/
+tNFA_STATUS NFA_SnepSetConfig (UINT16 miu, UINT8 rw)
+{
+    tNFA_SNEP_API_SET_CONFIG *p_msg;
+
+    SNEP_TRACE_API2 ("NFA_SnepSetConfig (): miu:%d, rw:%d", miu, rw);
+
+    if (  (miu < LLCP_DEFAULT_MIU)
+        ||(miu > LLCP_MAX_MIU)
+        ||(rw == 0)
+        ||(rw > 0x0F)  )
+    {
+        SNEP_TRACE_ERROR0 ("NFA_SnepSetConfig (): MIU or RW is out of range");
+        return (NFA_STATUS_INVALID_PARAM);
+    }
+
+    if ((p_msg = (tNFA_SNEP_API_SET_CONFIG *) GKI_getbuf (sizeof (tNFA_SNEP_API_SET_CONFIG))) != NULL)
+    {
+        p_msg->hdr.event = NFA_SNEP_API_SET_CONFIG_EVT;
+        p_msg->miu       = miu;
+        p_msg->rw        = rw;
+
+        nfa_sys_sendmsg (p_msg);
+
+        return (NFA_STATUS_OK);
+    }
+
+    return (NFA_STATUS_FAILED);
+}
+
+/*******************************************************************************
+**
+** Function         NFA_SnepGetConfig
+**
+** Description      This function is called to read MIU and RW of local SNEP
+**                  end point.
+**
+** Returns          None
+**
+*******************************************************************************/
+void NFA_SnepGetConfig (UINT16 *p_miu, UINT8 *p_rw)
+{
+    *p_miu = nfa_snep_cb.miu;
+    *p_rw  = nfa_snep_cb.rw;
+
+    SNEP_TRACE_API2 ("NFA_SnepGetConfig (): miu:%d, rw:%d", *p_miu, *p_rw);
+}
+
 /*******************************************************************************
 **
 ** Function         NFA_SnepSetTraceLevel
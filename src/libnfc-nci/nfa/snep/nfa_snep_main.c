@@ -25,6 +25,8 @@
 #include "nfa_sys.h"
 #include "nfa_sys_int.h"
 #include "nfa_snep_int.h"
+#include "llcp_defs.h"
+#include "nci_config.h"
 
 /*****************************************************************************
 **  Global Variables
@@ -79,7 +81,8 @@ const tNFA_SNEP_ACTION nfa_snep_action[] =
     nfa_snep_put_req,                       /* NFA_SNEP_API_PUT_REQ_EVT              */
     nfa_snep_get_resp,                      /* NFA_SNEP_API_GET_RESP_EVT             */
     nfa_snep_put_resp,                      /* NFA_SNEP_API_PUT_RESP_EVT             */
-    nfa_snep_disconnect                     /* NFA_SNEP_API_DISCONNECT_EVT           */
+    nfa_snep_disconnect,                    /* NFA_SNEP_API_DISCONNECT_EVT           */
+    nfa_snep_set_config                     /* NFA_SNEP_API_SET_CONFIG_EVT           */
 };
 
 /*******************************************************************************
@@ -94,10 +97,22 @@ const tNFA_SNEP_ACTION nfa_snep_action[] =
 *******************************************************************************/
 void nfa_snep_init (BOOLEAN is_dta_mode)
 {
+    UINT32 num;
+
     /* initialize control block */
     memset (&nfa_snep_cb, 0, sizeof (tNFA_SNEP_CB));
     nfa_snep_cb.trace_level = APPL_INITIAL_TRACE_LEVEL;
     nfa_snep_cb.is_dta_mode = is_dta_mode;
+    nfa_snep_cb.miu         = NFA_SNEP_MIU;
+    nfa_snep_cb.rw          = NFA_SNEP_RW;
+
+    /* override MIU and RW of data link connection from configuration file */
+    if (  (GetNumValue (NAME_SNEP_MIU, &num, sizeof (num)))
+        &&(num >= LLCP_DEFAULT_MIU) && (num <= LLCP_MAX_MIU)  )
+        nfa_snep_cb.miu = (UINT16) num;
+    if (  (GetNumValue (NAME_SNEP_RW, &num, sizeof (num)))
+        &&(num >= 1) && (num <= 0x0F)  )
+        nfa_snep_cb.rw = (UINT8) num;
 
     SNEP_TRACE_DEBUG1 ("nfa_snep_init (): is_dta_mode=%d", is_dta_mode);
 
@@ -212,6 +227,8 @@ static char *nfa_snep_evt_code (UINT16 evt_code)
         return "API_PUT_RESP";
     case NFA_SNEP_API_DISCONNECT_EVT:
         return "API_DISCONNECT";
+    case NFA_SNEP_API_SET_CONFIG_EVT:
+        return "API_SET_CONFIG";
     default:
         return "Unknown event";
     }
@@ -83,7 +83,9 @@ void nfa_sys_event (BT_HDR *p_msg)
     /* verify id and call subsystem event handler */
     if ((id < NFA_ID_MAX) && (nfa_sys_cb.is_reg[id]))
     {
+        GKI_stall_begin (GKI_STALL_KIND_EVENT, p_msg->event);
         freebuf = (*nfa_sys_cb.reg[id]->evt_hdlr) (p_msg);
+        GKI_stall_end (GKI_STALL_KIND_EVENT);
     }
     else
     {
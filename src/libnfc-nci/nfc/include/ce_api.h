@@ -197,6 +197,51 @@ NFC_API extern tCE_T4T_AID_HANDLE CE_T4tRegisterAID (UINT8      aid_len,
 *******************************************************************************/
 NFC_API extern void CE_T4tDeregisterAID (tCE_T4T_AID_HANDLE aid_handle);
 
+/*******************************************************************************
+**
+** Function         CE_T4tAddApduResponse
+**
+** Description      Add a R-APDU which CE T4T sends without forwarding the
+**                  matching C-APDU to upper layer.
+**
+**                  cmd_len: length of C-APDU (up to CE_T4T_MAX_APDU_RSP_CMD_LEN)
+**                  p_cmd:   C-APDU
+**                  p_mask:  bits of C-APDU to compare, NULL to compare all
+**                  rsp_len: length of R-APDU including status words
+**                  p_rsp:   R-APDU
+**
+** Returns          NFC_STATUS_OK if success
+**
+*******************************************************************************/
+NFC_API extern tNFC_STATUS CE_T4tAddApduResponse (UINT8   cmd_len,
+                                                  UINT8  *p_cmd,
+                                                  UINT8  *p_mask,
+                                                  UINT16  rsp_len,
+                                                  UINT8  *p_rsp);
+
+/*******************************************************************************
+**
+** Function         CE_T4tClearApduResponses
+**
+** Description      Remove all of R-APDUs added by CE_T4tAddApduResponse ()
+**
+** Returns          None
+**
+*******************************************************************************/
+NFC_API extern void CE_T4tClearApduResponses (void);
+
+/*******************************************************************************
+**
+** Function         CE_T4tGetApduResponseStats
+**
+** Description      Get number of C-APDUs answered and not answered from the
+**                  R-APDU table since activation.
+**
+** Returns          None
+**
+*******************************************************************************/
+NFC_API extern void CE_T4tGetApduResponseStats (UINT32 *p_hits, UINT32 *p_misses);
+
 /*******************************************************************************
 **
 ** Function         CE_T4TTestSetCC
@@ -223,6 +223,30 @@ typedef void (tLLCP_SDP_CBACK) (UINT8 tid, UINT8 remote_sap);
 
 typedef void (tLLCP_DTA_CBACK) (void);
 
+/* LLCP link statistics of current or last activated link */
+
+typedef struct
+{
+    BOOLEAN is_activated;       /* TRUE if LLCP link is currently activated         */
+    UINT16  local_link_miu;     /* local link MIU                                   */
+    UINT16  peer_link_miu;      /* link MIU of peer device                          */
+    UINT16  effective_miu;      /* MIU used to send PDU                             */
+    UINT16  peer_lto;           /* link timeout of peer device in ms                */
+    UINT16  peer_wks;           /* WKS of peer device                               */
+    UINT32  duration;           /* time since activation (until deactivation) in ms */
+    UINT32  num_tx_pdu;         /* number of LLC PDUs sent, including SYMM          */
+    UINT32  num_rx_pdu;         /* number of LLC PDUs received, including SYMM      */
+    UINT32  num_tx_symm;        /* number of SYMM PDUs sent                         */
+    UINT32  num_rx_symm;        /* number of SYMM PDUs received                     */
+    UINT32  tx_info_bytes;      /* bytes of information field in sent I/UI PDUs     */
+    UINT32  rx_info_bytes;      /* bytes of information field in received I/UI PDUs */
+    UINT32  tx_throughput;      /* tx_info_bytes per second over duration           */
+    UINT32  rx_throughput;      /* rx_info_bytes per second over duration           */
+    UINT32  num_rtt;            /* number of measured PDU round trips               */
+    UINT32  rtt_avg;            /* average round trip time in ms                    */
+    UINT32  rtt_max;            /* maximum round trip time in ms                    */
+} tLLCP_LINK_STATS;
+
 /*****************************************************************************
 **  External Function Declarations
 *****************************************************************************/
@@ -648,6 +672,19 @@ LLCP_API extern UINT8 LLCP_GetRemoteLSC (void);
 *******************************************************************************/
 LLCP_API extern void LLCP_GetLinkMIU (UINT16 *p_local_link_miu, UINT16 *p_remote_link_miu);
 
+/*******************************************************************************
+**
+** Function         LLCP_GetLinkStats
+**
+** Description      Return statistics of current LLCP link, or of the last
+**                  activated link if it has been deactivated.
+**
+**
+** Returns          LLCP_STATUS_SUCCESS if any link has been activated
+**
+*******************************************************************************/
+LLCP_API extern tLLCP_STATUS LLCP_GetLinkStats (tLLCP_LINK_STATS *p_stats);
+
 /*******************************************************************************
 **
 ** Function         LLCP_DiscoverService
@@ -159,6 +159,9 @@
 #define LLCP_LTO_UNIT       10      /* 10 ms */
 #define LLCP_MAX_LTO_IN_MS  2550    /* 2550 ms; 8bits * 10ms */
 
+/* Response Waiting Time index in ATR_RES */
+#define LLCP_MAX_WAITING_TIME   14  /* RWT = (302us)*2**WT, WT shall not exceed 14 */
+
 /* Receive Window Size, RW */
 #define LLCP_RW_TYPE        0x05
 #define LLCP_RW_LEN         0x01
@@ -65,6 +65,40 @@ enum
 };
 typedef UINT8 tNDEF_STATUS;
 
+/* Location of one record inside an indexed NDEF message. All offsets are
+** relative to the start of the message.
+*/
+typedef struct
+{
+    UINT32  rec_offset;                 /* Start of the record header       */
+    UINT32  payload_offset;             /* Start of the payload             */
+    UINT32  payload_len;                /* Payload length                   */
+    UINT16  type_offset;                /* Type field, relative to record   */
+    UINT8   hdr;                        /* MB/ME/CF/SR/IL flags and TNF     */
+    UINT8   type_len;                   /* Type field length                */
+    UINT8   id_len;                     /* ID field length (follows type)   */
+} tNDEF_REC_INFO;
+
+/* One piece of record payload for NDEF_MsgBuildRec. A NULL p_data only
+** reserves len bytes.
+*/
+typedef struct
+{
+    UINT8   *p_data;
+    UINT32  len;
+} tNDEF_SPAN;
+
+/* Index of an NDEF message, built by NDEF_MsgBuildIndex. The record array
+** is provided by the caller.
+*/
+typedef struct
+{
+    UINT8           *p_msg;             /* Indexed message                  */
+    tNDEF_REC_INFO  *p_recs;            /* Record array                     */
+    UINT16          max_recs;           /* Size of the record array         */
+    UINT16          num_recs;           /* Number of records in the message */
+} tNDEF_INDEX;
+
 
 #define HR_REC_TYPE_LEN     2       /* Handover Request Record Type     */
 #define HS_REC_TYPE_LEN     2       /* Handover Select Record Type      */
@@ -241,6 +275,97 @@ EXPORT_NDEF_API extern UINT8 *NDEF_RecGetId (UINT8 *p_rec, UINT8 *p_id_len);
 *******************************************************************************/
 EXPORT_NDEF_API extern UINT8 *NDEF_RecGetPayload (UINT8 *p_rec, UINT32 *p_payload_len);
 
+/* Functions to parse a received NDEF Message through an index
+*/
+/*******************************************************************************
+**
+** Function         NDEF_MsgBuildIndex
+**
+** Description      This function validates an NDEF message and records the
+**                  location of each record in p_recs, in a single pass.
+**                  p_recs may be NULL (max_recs 0) to only count the records.
+**
+** Returns          NDEF_OK, NDEF_MSG_INSUFFICIENT_MEM if the message is valid
+**                  but has more than max_recs records (num_recs holds the
+**                  total), or the NDEF_MsgValidate error.
+**
+*******************************************************************************/
+EXPORT_NDEF_API extern tNDEF_STATUS NDEF_MsgBuildIndex (UINT8 *p_msg, UINT32 msg_len, BOOLEAN b_allow_chunks,
+                                                        tNDEF_INDEX *p_index, tNDEF_REC_INFO *p_recs, UINT16 max_recs);
+
+/*******************************************************************************
+**
+** Function         NDEF_IndexGetRec
+**
+** Description      This function gets a pointer to the record with the given
+**                  index (0-based index) in an indexed NDEF message.
+**
+** Returns          Pointer to the start of the record, or NULL
+**
+*******************************************************************************/
+EXPORT_NDEF_API extern UINT8 *NDEF_IndexGetRec (tNDEF_INDEX *p_index, INT32 index);
+
+/*******************************************************************************
+**
+** Function         NDEF_IndexGetType
+**
+** Description      This function gets a pointer to the record type of the record
+**                  with the given index in an indexed NDEF message.
+**
+** Returns          Pointer to Type (NULL if none). TNF and len are filled in.
+**
+*******************************************************************************/
+EXPORT_NDEF_API extern UINT8 *NDEF_IndexGetType (tNDEF_INDEX *p_index, INT32 index, UINT8 *p_tnf, UINT8 *p_type_len);
+
+/*******************************************************************************
+**
+** Function         NDEF_IndexGetId
+**
+** Description      This function gets a pointer to the record id of the record
+**                  with the given index in an indexed NDEF message.
+**
+** Returns          Pointer to Id (NULL if none). ID Len is filled in.
+**
+*******************************************************************************/
+EXPORT_NDEF_API extern UINT8 *NDEF_IndexGetId (tNDEF_INDEX *p_index, INT32 index, UINT8 *p_id_len);
+
+/*******************************************************************************
+**
+** Function         NDEF_IndexGetPayload
+**
+** Description      This function gets a pointer to the payload of the record
+**                  with the given index in an indexed NDEF message.
+**
+** Returns          a pointer to the payload (NULL if none). Payload len filled in.
+**
+*******************************************************************************/
+EXPORT_NDEF_API extern UINT8 *NDEF_IndexGetPayload (tNDEF_INDEX *p_index, INT32 index, UINT32 *p_payload_len);
+
+/*******************************************************************************
+**
+** Function         NDEF_IndexFindByType
+**
+** Description      This function finds the first record with the given record
+**                  type, starting at record start_index.
+**
+** Returns          Index of the record, or -1 if not found
+**
+*******************************************************************************/
+EXPORT_NDEF_API extern INT32 NDEF_IndexFindByType (tNDEF_INDEX *p_index, INT32 start_index,
+                                                   UINT8 tnf, UINT8 *p_type, UINT8 tlen);
+
+/*******************************************************************************
+**
+** Function         NDEF_IndexFindById
+**
+** Description      This function finds the first record with the given record
+**                  id, starting at record start_index.
+**
+** Returns          Index of the record, or -1 if not found
+**
+*******************************************************************************/
+EXPORT_NDEF_API extern INT32 NDEF_IndexFindById (tNDEF_INDEX *p_index, INT32 start_index, UINT8 *p_id, UINT8 ilen);
+
 
 /* Functions to build an NDEF Message
 */
@@ -271,6 +396,37 @@ EXPORT_NDEF_API extern tNDEF_STATUS  NDEF_MsgAddRec (UINT8 *p_msg, UINT32 max_si
                                      UINT8 *p_id, UINT8  id_len,
                                      UINT8 *p_payload, UINT32 payload_len);
 
+/*******************************************************************************
+**
+** Function         NDEF_RecGetEncodedSize
+**
+** Description      This function computes the encoded size of a record, so the
+**                  exact buffer size of a message can be known before it is built.
+**
+** Returns          Size of the record in bytes
+**
+*******************************************************************************/
+EXPORT_NDEF_API extern UINT32 NDEF_RecGetEncodedSize (UINT8 type_len, UINT8 id_len, UINT32 payload_len);
+
+/*******************************************************************************
+**
+** Function         NDEF_MsgBuildRec
+**
+** Description      This function writes a record at the end of an NDEF message
+**                  being built front to back. The payload is gathered from
+**                  num_spans caller buffers. The first record gets the MB bit
+**                  and the record built with b_last set gets the ME bit, so no
+**                  earlier record is ever revisited.
+**
+** Returns          OK, or error if the record did not fit
+**                  *p_cur_size is updated
+**
+*******************************************************************************/
+EXPORT_NDEF_API extern tNDEF_STATUS NDEF_MsgBuildRec (UINT8 *p_msg, UINT32 max_size, UINT32 *p_cur_size,
+                                                      UINT8 tnf, UINT8 *p_type, UINT8 type_len,
+                                                      UINT8 *p_id, UINT8 id_len,
+                                                      tNDEF_SPAN *p_spans, UINT8 num_spans, BOOLEAN b_last);
+
 /*******************************************************************************
 **
 ** Function         NDEF_MsgInsertRec
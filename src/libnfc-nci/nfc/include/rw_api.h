@@ -145,6 +145,7 @@ enum
     RW_I93_PRESENCE_CHECK_EVT,                  /* Response to RW_I93PresenceCheck    */
     RW_I93_RAW_FRAME_EVT,                       /* Response of raw frame sent         */
     RW_I93_INTF_ERROR_EVT,                      /* RF Interface error event           */
+    RW_I93_INVENTORY_ALL_EVT,                   /* Result of RW_I93InventoryAll       */
 #if(NFC_NXP_NOT_OPEN_INCLUDED == TRUE)
     RW_I93_MAX_EVT,
     RW_T3BT_RAW_READ_CPLT_EVT,
@@ -243,6 +244,14 @@ typedef struct                              /* RW_I93_INVENTORY_EVT        */
     UINT8           uid[I93_UID_BYTE_LEN];  /* UID[0]:MSB, ... UID[7]:LSB  */
 } tRW_I93_INVENTORY;
 
+typedef struct                              /* RW_I93_INVENTORY_ALL_EVT        */
+{
+    tNFC_STATUS     status;                 /* status of the search            */
+    UINT8           num_uids;               /* number of UIDs found            */
+    BOOLEAN         overflow;               /* TRUE if more VICCs answered     */
+    UINT8          *p_uids;                 /* num_uids UIDs, UID[0]:MSB, ... UID[7]:LSB */
+} tRW_I93_INVENTORY_ALL;
+
 typedef struct                              /* RW_I93_DATA_EVT               */
 {
     tNFC_STATUS     status;                 /* status of Read/Get security status command */
@@ -286,6 +295,7 @@ typedef union
     tRW_RAW_FRAME           raw_frame;  /* Response of raw frame sent            */
     tRW_T4T_SW              t4t_sw;     /* Received status words from a tag      */
     tRW_I93_INVENTORY       i93_inventory;  /* ISO 15693 Inventory response      */
+    tRW_I93_INVENTORY_ALL   i93_inventory_all; /* ISO 15693 Inventory of all VICCs */
     tRW_I93_DATA            i93_data;       /* ISO 15693 Data response           */
     tRW_I93_SYS_INFO        i93_sys_info;   /* ISO 15693 System Information      */
     tRW_I93_CMD_CMPL        i93_cmd_cmpl;   /* ISO 15693 Command complete        */
@@ -762,6 +772,10 @@ NFC_API extern tNFC_STATUS RW_T3tUpdateNDef (UINT32 len, UINT8 *p_data);
 **      segment of NDEF data received. The RW_READ_CPLT_EVT event is used to
 **      notify the application all segments have been received.
 **
+**      Blocks may belong to different services. If the block list doesn't fit
+**      into one CHECK command, it is read using as few CHECK commands as the
+**      tag accepts, each segment being reported as it is received.
+**
 **      Before using this API, the application must call RW_SelectTagType to
 **      indicate that a Type 3 tag has been activated, and to provide the
 **      tag's Manufacture ID (IDm) .
@@ -784,6 +798,9 @@ NFC_API extern tNFC_STATUS RW_T3tCheck (UINT8 num_blocks, tT3T_BLOCK_DESC *t3t_b
 **      The RW_WRITE_CPLT_EVT event is used to notify the application all
 **      segments have been received.
 **
+**      If the block list doesn't fit into one UPDATE command, it is written
+**      using as few UPDATE commands as the tag accepts.
+**
 **      Before using this API, the application must call RW_SelectTagType to
 **      indicate that a Type 3 tag has been activated, and to provide the tag's
 **      Manufacture ID (IDm) .
@@ -923,6 +940,20 @@ NFC_API extern tNFC_STATUS RW_T4tDetectNDef (void);
 *******************************************************************************/
 NFC_API extern tNFC_STATUS RW_T4tReadNDef (void);
 
+/*******************************************************************************
+**
+** Function         RW_T4tStopNDefRead
+**
+** Description      This function stops the NDEF read procedure after the
+**                  current segment. It must be called from the callback of
+**                  RW_T4T_NDEF_READ_EVT; no more event is returned for this read.
+**
+** Returns          NFC_STATUS_OK if success
+**                  NFC_STATUS_FAILED if T4T is not reading NDEF
+**
+*******************************************************************************/
+NFC_API extern tNFC_STATUS RW_T4tStopNDefRead (void);
+
 /*******************************************************************************
 **
 ** Function         RW_T4tUpdateNDef
@@ -991,6 +1022,24 @@ NFC_API extern tNFC_STATUS RW_T4tSetNDefReadOnly (void);
 *******************************************************************************/
 NFC_API extern tNFC_STATUS RW_I93Inventory (BOOLEAN including_afi, UINT8 afi, UINT8 *p_uid);
 
+/*******************************************************************************
+**
+** Function         RW_I93InventoryAll
+**
+** Description      This function collects the UIDs of all VICCs in the field
+**                  with/without AFI, using 1 slot Inventory commands with a
+**                  growing mask to resolve collisions
+**
+**                  RW_I93_INVENTORY_ALL_EVT will be returned
+**
+** Returns          NFC_STATUS_OK if success
+**                  NFC_STATUS_NO_BUFFERS if out of buffer
+**                  NFC_STATUS_BUSY if busy
+**                  NFC_STATUS_FAILED if other error
+**
+*******************************************************************************/
+NFC_API extern tNFC_STATUS RW_I93InventoryAll (BOOLEAN including_afi, UINT8 afi);
+
 /*******************************************************************************
 **
 ** Function         RW_I93StayQuiet
@@ -1259,6 +1308,20 @@ NFC_API extern tNFC_STATUS RW_I93DetectNDef (void);
 *******************************************************************************/
 NFC_API extern tNFC_STATUS RW_I93ReadNDef (void);
 
+/*******************************************************************************
+**
+** Function         RW_I93StopNDefRead
+**
+** Description      This function stops the NDEF read procedure after the
+**                  current segment. It must be called from the callback of
+**                  RW_I93_NDEF_READ_EVT; no more event is returned for this read.
+**
+** Returns          NFC_STATUS_OK if success
+**                  NFC_STATUS_FAILED if I93 is not reading NDEF
+**
+*******************************************************************************/
+NFC_API extern tNFC_STATUS RW_I93StopNDefRead (void);
+
 /*******************************************************************************
 **
 ** Function         RW_I93UpdateNDef
@@ -198,6 +198,7 @@
 #define T2T_CMD_READ            0x30    /* read  4 blocks (16 bytes) */
 #define T2T_CMD_WRITE           0xA2    /* write 1 block  (4 bytes)  */
 #define T2T_CMD_SEC_SEL         0xC2    /* Sector select             */
+#define T2T_CMD_FAST_READ       0x3A    /* read a range of blocks    */
 #define T2T_RSP_ACK             0xA
 #define T2T_RSP_NACK5           0x5
 #define T2T_RSP_NACK1           0x1     /* Nack can be either 1    */
@@ -305,6 +306,7 @@ typedef UINT8 tT3T_POLL_RC;
 #define T3T_MSG_NUM_BLOCKS_CHECK_MAX                15      /* Max Number of Blocks per CHECK command */
 
 #define T3T_MSG_BLOCKSIZE                           16      /* Data block size for UPDATE and CHECK commands */
+#define T3T_MSG_MAX_FRAME_LEN                       255     /* Max length of T3T frame, including SoD (LEN) */
 
 /* Common header definitions for T3t commands */
 #define T3T_MSG_CMD_COMMON_HDR_LEN          11      /* Common header: SoD + cmdcode + NFCID2 + num_services */
@@ -315,6 +317,7 @@ typedef UINT8 tT3T_POLL_RC;
 #define T3T_MSG_RSP_OFFSET_RSPCODE          0       /* Offset for Response code */
 #define T3T_MSG_RSP_OFFSET_IDM              1       /* Offset for Manufacturer ID */
 #define T3T_MSG_RSP_OFFSET_STATUS1          9       /* Offset for Status Flag1 */
+#define T3T_MSG_RSP_OFFSET_STATUS2          10      /* Offset for Status Flag2 */
 #define T3T_MSG_RSP_OFFSET_NUMBLOCKS        11      /* Offset for NumberOfBlocks (in CHECK response) */
 #define T3T_MSG_RSP_OFFSET_CHECK_DATA       12      /* Offset for Block Data (in CHECK response) */
 #define T3T_MSG_RSP_OFFSET_POLL_PMM         9       /* Offset for PMm (in POLL response) */
@@ -327,6 +330,7 @@ typedef UINT8 tT3T_POLL_RC;
 #define T3T_MSG_RSP_STATUS2_ERROR_MEMORY            0x70
 #define T3T_MSG_RSP_STATUS2_ERROR_EXCESSIVE_WRITES  0x71
 #define T3T_MSG_RSP_STATUS2_ERROR_PROCESSING        0xFF
+#define T3T_MSG_RSP_STATUS2_ERROR_NUM_BLOCKS        0xA2    /* Number of blocks not supported by the card */
 
 #define T3T_NFC_F_MAX_PAYLOAD_LEN                   0xFE    /* Maximum payload lenght for NFC-F messages (including SoD) */
 
@@ -347,7 +351,9 @@ typedef UINT8 tT3T_POLL_RC;
 */
 #define T4T_CMD_MIN_HDR_SIZE            4       /* CLA, INS, P1, P2 */
 #define T4T_CMD_MAX_HDR_SIZE            5       /* CLA, INS, P1, P2, Lc */
+#define T4T_CMD_MAX_EXT_HDR_SIZE        7       /* CLA, INS, P1, P2, extended Lc (3 bytes) */
 
+#define T4T_VERSION_3_0                 0x30    /* version 3.0 */
 #define T4T_VERSION_2_0                 0x20    /* version 2.0 */
 #define T4T_VERSION_1_0                 0x10    /* version 1.0 */
 #define T4T_MY_VERSION                  T4T_VERSION_2_0
@@ -358,6 +364,8 @@ typedef UINT8 tT3T_POLL_RC;
 #define T4T_CMD_INS_SELECT              0xA4
 #define T4T_CMD_INS_READ_BINARY         0xB0
 #define T4T_CMD_INS_UPDATE_BINARY       0xD6
+#define T4T_CMD_INS_READ_BINARY_ODO     0xB1    /* ReadBinary with offset in data object (V3.0)   */
+#define T4T_CMD_INS_UPDATE_BINARY_ODO   0xD7    /* UpdateBinary with offset in data object (V3.0) */
 #if(NFC_NXP_NOT_OPEN_INCLUDED == TRUE)
 #define T4T_CMD_DES_CLASS               0x90
 #define T4T_CMD_INS_GET_HW_VERSION      0x60
@@ -373,6 +381,16 @@ typedef UINT8 tT3T_POLL_RC;
 
 #define T4T_MAX_LENGTH_LE               0xFF    /* Max number of bytes to be read from file in ReadBinary Command */
 #define T4T_MAX_LENGTH_LC               0xFF    /* Max number of bytes written to NDEF file in UpdateBinary Command */
+#define T4T_MAX_LENGTH_EXT_LE           0xFFFF  /* Max number of bytes to be read with extended Le    */
+#define T4T_MAX_LENGTH_EXT_LC           0xFFFF  /* Max number of bytes written with extended Lc       */
+#define T4T_EXT_LE_SIZE                 0x02    /* extended Le after extended Lc                       */
+
+#define T4T_MAX_SHORT_OFFSET            0x7FFF  /* Max offset coded in P1-P2 of ReadBinary/UpdateBinary */
+#define T4T_ODO_TAG                     0x54    /* offset data object tag                              */
+#define T4T_ODO_OFFSET_SIZE             0x03    /* offset data object value size                       */
+#define T4T_ODO_SIZE                    0x05    /* T(1), L(1), V(3) of offset data object              */
+#define T4T_DDO_TAG                     0x53    /* discretionary data object tag                       */
+#define T4T_DDO_MAX_HDR_SIZE            0x04    /* T(1), L(up to 3) of discretionary data object       */
 
 #define T4T_RSP_STATUS_WORDS_SIZE       0x02
 
@@ -403,11 +421,18 @@ typedef UINT8 tT3T_POLL_RC;
 #define T4T_FILE_CONTROL_TLV_SIZE       0x08    /* size of T(1),L(1),V(6) for file control */
 #define T4T_FILE_CONTROL_LENGTH         0x06    /* size of V(6) for file control */
 
+#define T4T_ENDEF_FILE_CONTROL_TYPE     0x06    /* Extended NDEF File Control Type (V3.0) */
+#define T4T_ENDEF_FILE_CONTROL_TLV_SIZE 0x0A    /* size of T(1),L(1),V(8) for extended file control */
+#define T4T_ENDEF_FILE_CONTROL_LENGTH   0x08    /* size of V(8) for extended file control */
+#define T4T_EFC_WRITE_ACCESS_OFFSET_IN_TLV 0x09 /* Offset of Write access byte from type field in CC */
+#define T4T_ECC_FILE_MIN_LEN            0x0011  /* CC file length with extended file control */
+
 #define T4T_FC_READ_ACCESS              0x00    /* read access granted without any security */
 #define T4T_FC_WRITE_ACCESS             0x00    /* write access granted without any security */
 #define T4T_FC_NO_WRITE_ACCESS          0xFF    /* no write access granted at all (read-only) */
 
 #define T4T_FILE_LENGTH_SIZE            0x02
+#define T4T_EFILE_LENGTH_SIZE           0x04    /* ENLEN of extended NDEF file (V3.0) */
 #if(NFC_NXP_NOT_OPEN_INCLUDED == TRUE)
 #define T4T_ADDI_FRAME_RESP             0xAFU
 #define T4T_SIZE_IDENTIFIER_2K          0x16U
@@ -519,6 +544,7 @@ typedef UINT8 tT3T_POLL_RC;
 
 #define I93_MAX_BLOCK_LENGH                 32      /* Max block size in bytes */
 #define I93_MAX_NUM_BLOCK                   256     /* Max number of blocks    */
+#define I93_MAX_BLOCKS_PER_READ             256     /* Max number of blocks in Read Multiple Blocks */
 
 /* ICODE Capability Container(CC) definition */
 #define I93_ICODE_CC_MAGIC_NUMER            0xE1    /* magic number in CC[0]  */
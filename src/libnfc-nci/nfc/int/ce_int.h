@@ -87,6 +87,15 @@ typedef struct
     tCE_CBACK          *p_cback;
 } tCE_T4T_REG_AID;      /* registered AID table */
 
+typedef struct
+{
+    UINT8               cmd_len;
+    UINT8               cmd[CE_T4T_MAX_APDU_RSP_CMD_LEN];   /* C-APDU to match          */
+    UINT8               mask[CE_T4T_MAX_APDU_RSP_CMD_LEN];  /* bits of C-APDU to compare */
+    UINT16              rsp_len;
+    UINT8              *p_rsp;                              /* R-APDU in GKI buffer     */
+} tCE_T4T_APDU_RSP;     /* preloaded R-APDU table */
+
 typedef struct
 {
     TIMER_LIST_ENT      timer;              /* timeout for update file              */
@@ -109,6 +118,12 @@ typedef struct
     tCE_CBACK          *p_wildcard_aid_cback;               /* registered wildcard AID callback */
     tCE_T4T_REG_AID     reg_aid[CE_T4T_MAX_REG_AID];        /* registered AID table             */
     UINT8               selected_aid_idx;
+
+    tCE_T4T_APDU_RSP    apdu_rsp[CE_T4T_MAX_APDU_RSP];      /* preloaded R-APDU table           */
+    UINT8               num_apdu_rsp;
+    BOOLEAN             rx_chaining;                        /* TRUE if receiving chained C-APDU */
+    UINT32              apdu_rsp_hits;                      /* C-APDUs answered from the table  */
+    UINT32              apdu_rsp_misses;                    /* C-APDUs not found in the table   */
 } tCE_T4T_MEM;
 
 
@@ -83,6 +83,26 @@ tLLCP_SECURED llcp_secured;
 */
 #define LLCP_LINK_FLAGS_RX_ANY_LLC_PDU      0x01    /* Received any LLC PDU in activated state */
 
+/*
+** LLCP link statistics
+*/
+typedef struct
+{
+    BOOLEAN             is_valid;               /* TRUE once any link has been activated        */
+    UINT32              start_tick;             /* tick count when link was activated           */
+    UINT32              stop_tick;              /* tick count when link was deactivated         */
+    UINT32              xmit_tick;              /* tick count when last PDU was sent            */
+    UINT32              num_tx_pdu;             /* number of LLC PDUs sent                      */
+    UINT32              num_rx_pdu;             /* number of LLC PDUs received                  */
+    UINT32              num_tx_symm;            /* number of SYMM PDUs sent                     */
+    UINT32              num_rx_symm;            /* number of SYMM PDUs received                 */
+    UINT32              tx_info_bytes;          /* information bytes sent in I/UI PDUs          */
+    UINT32              rx_info_bytes;          /* information bytes received in I/UI PDUs      */
+    UINT32              num_rtt;                /* number of measured round trips               */
+    UINT32              rtt_total_ticks;        /* sum of measured round trips in ticks         */
+    UINT32              rtt_max_ticks;          /* maximum measured round trip in ticks         */
+} tLLCP_LINK_STATS_CB;
+
 /*
 ** LLCP link control block
 */
@@ -129,6 +149,8 @@ typedef struct
     UINT16              symm_delay;             /* Delay SYMM response                          */
     UINT16              data_link_timeout;      /* data link conneciton timeout                 */
     UINT16              delay_first_pdu_timeout;/* delay timeout to send first PDU as initiator */
+
+    tLLCP_LINK_STATS_CB stats;                  /* statistics of current or last activated link */
 } tLLCP_LCB;
 
 /*
@@ -225,6 +247,10 @@ typedef struct
     UINT8                   num_rx_i_pdu;       /* number of I PDU in rx queue              */
     UINT8                   rx_congest_threshold; /* dynamic congest threshold for rx I PDU */
 
+    UINT32                  connect_tick;       /* tick count when DLCB was allocated       */
+    UINT32                  tx_info_bytes;      /* information bytes sent in I PDUs         */
+    UINT32                  rx_info_bytes;      /* information bytes received in I PDUs     */
+
 } tLLCP_DLCB;
 
 /*
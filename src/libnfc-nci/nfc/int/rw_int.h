@@ -231,6 +231,7 @@ typedef struct
 #define RW_T2T_MAX_LOCK_BYTES                           0x1E    /* Maximum supported dynamic lock bytes                     */
 #define RW_T2T_SEGMENT_BYTES                            128
 #define RW_T2T_SEGMENT_SIZE                             16
+#define RW_T2T_HDR_UID_LEN                              0x08    /* UID0-2, BCC0 and UID3-6 at the start of the tag header   */
 
 #define RW_T2T_LOCK_NOT_UPDATED                         0x00    /* Lock not yet set as part of SET TAG RO op                */
 #define RW_T2T_LOCK_UPDATE_INITIATED                    0x01    /* Sent command to set the Lock bytes                       */
@@ -339,6 +340,8 @@ typedef struct
     BOOLEAN             b_read_data;                        /* Tag data block read from tag                                 */
     BOOLEAN             b_hard_lock;                        /* Hard lock the tag as part of config tag to Read only         */
     BOOLEAN             check_tag_halt;                     /* Resent command after NACK rsp to find tag is in HALT State   */
+    BOOLEAN             b_no_fast_read;                     /* Tag rejected FAST_READ, use READ from now on                 */
+    UINT8               read_rsp_len;                       /* Number of data bytes expected in response to current read    */
 #if (defined (RW_NDEF_INCLUDED) && (RW_NDEF_INCLUDED == TRUE))
     BOOLEAN             skip_dyn_locks;                     /* Skip reading dynamic lock bytes from the tag                 */
     UINT8               found_tlv;                          /* The Tlv found while searching a particular TLV               */
@@ -431,6 +434,15 @@ typedef struct
     UINT8               cur_poll_rc;            /* RC used in current POLL command */
 
     UINT8               flags;                  /* Flags see RW_T3T_FL_* */
+
+    /* CHECK/UPDATE of a block list bigger than one command (RW_T3tCheck/RW_T3tUpdate) */
+    tT3T_BLOCK_DESC     *p_batch_blocks;        /* Copy of block list (followed by block data for UPDATE) */
+    UINT8               *p_batch_data;          /* Block data for UPDATE, in p_batch_blocks buffer */
+    UINT8               batch_num_blocks;       /* Total number of blocks in block list */
+    UINT8               batch_blocks_done;      /* Number of blocks completed so far */
+    UINT8               batch_cur_blocks;       /* Number of blocks in current command */
+    UINT8               max_check_blocks;       /* Max blocks per CHECK command, reduced if card rejects it */
+    UINT8               max_update_blocks;      /* Max blocks per UPDATE command, reduced if card rejects it */
 } tRW_T3T_CB;
 
 
@@ -444,13 +456,20 @@ typedef struct
 /* Max data size using a single UpdateBinary. 6 bytes are for CLA, INS, P1, P2, Lc */
 #define RW_T4T_MAX_DATA_PER_WRITE          (NFC_RW_POOL_BUF_SIZE - BT_HDR_SIZE - NCI_MSG_OFFSET_SIZE - NCI_DATA_HDR_SIZE - T4T_CMD_MAX_HDR_SIZE)
 
+/* Max data size using a single ReadBinary with extended Le.
+** Chained response is reassembled into the largest GKI buffer */
+#define RW_T4T_MAX_DATA_PER_EXT_READ       (GKI_MAX_BUF_SIZE - BT_HDR_SIZE - NCI_DATA_HDR_SIZE - T4T_DDO_MAX_HDR_SIZE - T4T_RSP_STATUS_WORDS_SIZE)
+
+/* Max data size using a single UpdateBinary with extended Lc, including offset data object */
+#define RW_T4T_MAX_DATA_PER_EXT_WRITE      (GKI_MAX_BUF_SIZE - BT_HDR_SIZE - NCI_MSG_OFFSET_SIZE - NCI_DATA_HDR_SIZE - T4T_CMD_MAX_EXT_HDR_SIZE - T4T_ODO_SIZE - T4T_DDO_MAX_HDR_SIZE)
+
 
 
 /* Mandatory NDEF file control */
 typedef struct
 {
     UINT16              file_id;        /* File Identifier          */
-    UINT16              max_file_size;  /* Max NDEF file size       */
+    UINT32              max_file_size;  /* Max NDEF file size       */
     UINT8               read_access;    /* read access condition    */
     UINT8               write_access;   /* write access condition   */
 } tRW_T4T_NDEF_FC;
@@ -476,10 +495,11 @@ typedef struct
     UINT8               version;            /* currently effective version      */
     TIMER_LIST_ENT      timer;              /* timeout for each API call        */
 
-    UINT16              ndef_length;        /* length of NDEF data              */
+    UINT32              ndef_length;        /* length of NDEF data              */
     UINT8              *p_update_data;      /* pointer of data to update        */
-    UINT16              rw_length;          /* remaining bytes to read/write    */
-    UINT16              rw_offset;          /* remaining offset to read/write   */
+    UINT32              rw_length;          /* remaining bytes to read/write    */
+    UINT32              rw_offset;          /* remaining offset to read/write   */
+    UINT16              last_length;        /* bytes in last ReadBinary/UpdateBinary */
     BT_HDR             *p_data_to_free;     /* GKI buffet to delete after done  */
 
     tRW_T4T_CC          cc_file;            /* Capability Container File        */
@@ -492,6 +512,15 @@ typedef struct
 
     UINT16              max_read_size;      /* max reading size per a command   */
     UINT16              max_update_size;    /* max updating size per a command  */
+
+#define RW_T4T_FLAG_ENDEF_FC                0x01    /* CC has extended NDEF file control (V3.0)    */
+#define RW_T4T_FLAG_EXT_APDU                0x02    /* extended Lc/Le is used for file access      */
+#define RW_T4T_FLAG_EXT_APDU_FAILED         0x04    /* tag rejected extended Lc/Le                 */
+#define RW_T4T_FLAG_ODO                     0x08    /* last command used offset data object        */
+#define RW_T4T_FLAG_EXT_SENT                0x10    /* last command used extended Lc/Le            */
+
+    UINT8               intl_flags;         /* flags for internal information   */
+    UINT8               nlen_size;          /* size of NLEN or ENLEN            */
 #if (NFC_NXP_NOT_OPEN_INCLUDED == TRUE)
     UINT16              card_size;
     UINT8               card_type;
@@ -529,6 +558,8 @@ typedef UINT8 tRW_I93_RW_SUBSTATE;
 #define RW_I93_TLV_DETECT_STATE_LENGTH_3  0x04  /* searching for the third byte of length  */
 #define RW_I93_TLV_DETECT_STATE_VALUE     0x05  /* reading value field                     */
 
+#define RW_I93_INV_STACK_SIZE   (I93_UID_BYTE_LEN * 8)  /* one pending mask per UID bit */
+
 enum
 {
     RW_I93_ICODE_SLI,                   /* ICODE SLI, SLIX                  */
@@ -581,6 +612,22 @@ typedef struct
     UINT8              *p_update_data;          /* pointer of data to update        */
     UINT16              rw_length;              /* bytes to read/write              */
     UINT16              rw_offset;              /* offset to read/write             */
+
+    UINT16              mb_read_blocks;         /* blocks per read multi block, 0 if not set yet */
+    UINT16              mb_read_max_blocks;     /* max blocks per read multi block for this tag  */
+    UINT16              mb_read_sent_blocks;    /* blocks requested in last read multi block     */
+    UINT8               mb_read_success;        /* consecutive successful read multi block       */
+
+    BOOLEAN             inv_afi_present;        /* inventory all: AFI is present                 */
+    UINT8               inv_afi;                /* inventory all: AFI                            */
+    UINT8               inv_mask_len;           /* inventory all: bits in current mask           */
+    UINT8               inv_mask[I93_UID_BYTE_LEN];    /* current mask, [0] holds the UID LSB    */
+    UINT8               inv_depth;              /* inventory all: masks left to search           */
+    UINT8               inv_stack_len[RW_I93_INV_STACK_SIZE];
+    UINT8               inv_stack_mask[RW_I93_INV_STACK_SIZE][I93_UID_BYTE_LEN];
+    UINT8               inv_num_uids;           /* inventory all: UIDs found                     */
+    BOOLEAN             inv_overflow;           /* inventory all: more VICCs than inv_uids       */
+    UINT8               inv_uids[RW_I93_MAX_INVENTORY_UIDS][I93_UID_BYTE_LEN]; /* UID[0]:MSB     */
 } tRW_I93_CB;
 
 /* RW memory control blocks */
@@ -599,6 +646,7 @@ typedef struct
     tRW_TCB             tcb;
     tRW_CBACK           *p_cback;
     UINT32              cur_retry;          /* Retry count for the current operation */
+    UINT8               t2t_no_fast_read_uid[RW_T2T_HDR_UID_LEN]; /* last T2T that rejected FAST_READ */
 #if (defined (RW_STATS_INCLUDED) && (RW_STATS_INCLUDED == TRUE))
     tRW_STATS           stats;
 #endif  /* RW_STATS_INCLUDED */
@@ -649,6 +697,7 @@ extern void rw_t2t_handle_rsp (UINT8 *p_data);
 
 extern tNFC_STATUS rw_t2t_sector_change (UINT8 sector);
 extern tNFC_STATUS rw_t2t_read (UINT16 block);
+extern tNFC_STATUS rw_t2t_fast_read (UINT16 block, UINT16 num_blocks);
 extern tNFC_STATUS rw_t2t_write (UINT16 block, UINT8 *p_write_data);
 extern void rw_t2t_process_timeout (TIMER_LIST_ENT *p_tle);
 extern tNFC_STATUS rw_t2t_select (void);
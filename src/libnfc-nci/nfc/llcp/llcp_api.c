@@ -158,7 +158,15 @@ void LLCP_SetConfig (UINT16 link_miu,
         llcp_cb.lcb.local_link_miu = link_miu;
 
     llcp_cb.lcb.local_opt = opt;
-    llcp_cb.lcb.local_wt  = wt;
+
+    if (wt > LLCP_MAX_WAITING_TIME)
+    {
+        LLCP_TRACE_ERROR1 ("LLCP_SetConfig (): wt shall not be bigger than LLCP_MAX_WAITING_TIME (%d)",
+                            LLCP_MAX_WAITING_TIME);
+        llcp_cb.lcb.local_wt = LLCP_MAX_WAITING_TIME;
+    }
+    else
+        llcp_cb.lcb.local_wt = wt;
 
     if (link_timeout < LLCP_LTO_UNIT)
     {
@@ -1614,6 +1622,69 @@ LLCP_API void LLCP_GetLinkMIU (UINT16 *p_local_link_miu,
                        *p_local_link_miu, *p_remote_link_miu);
 }
 
+/*******************************************************************************
+**
+** Function         LLCP_GetLinkStats
+**
+** Description      Return statistics of current LLCP link, or of the last
+**                  activated link if it has been deactivated.
+**
+**
+** Returns          LLCP_STATUS_SUCCESS if any link has been activated
+**
+*******************************************************************************/
+tLLCP_STATUS LLCP_GetLinkStats (tLLCP_LINK_STATS *p_stats)
+{
+    tLLCP_LINK_STATS_CB *p_cb = &llcp_cb.lcb.stats;
+    UINT32 ticks;
+
+    LLCP_TRACE_API0 ("LLCP_GetLinkStats ()");
+
+    memset (p_stats, 0, sizeof (tLLCP_LINK_STATS));
+
+    if (!p_cb->is_valid)
+    {
+        LLCP_TRACE_ERROR0 ("LLCP_GetLinkStats (): LLCP link has never been activated");
+        return LLCP_STATUS_FAIL;
+    }
+
+    p_stats->is_activated   = (llcp_cb.lcb.link_state == LLCP_LINK_STATE_ACTIVATED);
+    p_stats->local_link_miu = llcp_cb.lcb.local_link_miu;
+    p_stats->peer_link_miu  = llcp_cb.lcb.peer_miu;
+    p_stats->effective_miu  = llcp_cb.lcb.effective_miu;
+    p_stats->peer_lto       = llcp_cb.lcb.peer_lto;
+    p_stats->peer_wks       = llcp_cb.lcb.peer_wks;
+
+    /* link is being used until it is cleaned up */
+    if (  (llcp_cb.lcb.link_state == LLCP_LINK_STATE_ACTIVATED)
+        ||(llcp_cb.lcb.link_state == LLCP_LINK_STATE_DEACTIVATING)  )
+        ticks = GKI_get_tick_count () - p_cb->start_tick;
+    else
+        ticks = p_cb->stop_tick - p_cb->start_tick;
+
+    p_stats->duration      = GKI_TICKS_TO_MS (ticks);
+    p_stats->num_tx_pdu    = p_cb->num_tx_pdu;
+    p_stats->num_rx_pdu    = p_cb->num_rx_pdu;
+    p_stats->num_tx_symm   = p_cb->num_tx_symm;
+    p_stats->num_rx_symm   = p_cb->num_rx_symm;
+    p_stats->tx_info_bytes = p_cb->tx_info_bytes;
+    p_stats->rx_info_bytes = p_cb->rx_info_bytes;
+
+    if (p_stats->duration)
+    {
+        p_stats->tx_throughput = (UINT32) (((UINT64) p_cb->tx_info_bytes * 1000) / p_stats->duration);
+        p_stats->rx_throughput = (UINT32) (((UINT64) p_cb->rx_info_bytes * 1000) / p_stats->duration);
+    }
+
+    p_stats->num_rtt = p_cb->num_rtt;
+    p_stats->rtt_max = GKI_TICKS_TO_MS (p_cb->rtt_max_ticks);
+
+    if (p_cb->num_rtt)
+        p_stats->rtt_avg = GKI_TICKS_TO_MS (p_cb->rtt_total_ticks) / p_cb->num_rtt;
+
+    return LLCP_STATUS_SUCCESS;
+}
+
 /*******************************************************************************
 **
 ** Function         LLCP_DiscoverService
@@ -952,6 +952,7 @@ void llcp_dlc_proc_i_pdu (UINT8 dsap, UINT8 ssap, UINT16 i_pdu_length, UINT8 *p_
             /* update local sequence variables */
             p_dlcb->next_rx_seq  = (p_dlcb->next_rx_seq + 1) % LLCP_SEQ_MODULO;
             p_dlcb->rcvd_ack_seq = rcv_seq;
+            p_dlcb->rx_info_bytes += info_len;
 
             appended = FALSE;
 
@@ -1355,6 +1356,7 @@ BT_HDR* llcp_dlc_get_next_pdu (tLLCP_DLCB *p_dlcb)
             llcp_util_build_info_pdu (p_dlcb, p_msg);
 
             p_dlcb->next_tx_seq  = (p_dlcb->next_tx_seq + 1) % LLCP_SEQ_MODULO;
+            p_dlcb->tx_info_bytes += p_msg->len - LLCP_PDU_HEADER_SIZE - LLCP_SEQUENCE_SIZE;
 
 #if (BT_TRACE_VERBOSE == TRUE)
             LLCP_TRACE_DEBUG6 ("LLCP TX - N(S,R):(%d,%d) V(S,SA,R,RA):(%d,%d,%d,%d)",
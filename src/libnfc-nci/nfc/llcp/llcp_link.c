@@ -95,9 +95,13 @@ static void    llcp_link_proc_agf_pdu (BT_HDR *p_msg);
 static void    llcp_link_proc_rx_pdu (UINT8 dsap, UINT8 ptype, UINT8 ssap, BT_HDR *p_msg);
 static void    llcp_link_proc_rx_data (BT_HDR *p_msg);
 
-static BT_HDR *llcp_link_get_next_pdu (BOOLEAN length_only, UINT16 *p_next_pdu_length);
+static BT_HDR *llcp_link_get_next_pdu (BOOLEAN length_only, UINT16 max_length, UINT16 *p_next_pdu_length);
 static BT_HDR *llcp_link_build_next_pdu (BT_HDR *p_agf);
 static void    llcp_link_send_to_lower (BT_HDR *p_msg);
+static UINT32  llcp_link_get_info_length (UINT8 *p, UINT16 length);
+static void    llcp_link_update_tx_stats (BT_HDR *p_pdu);
+static void    llcp_link_update_rx_stats (BT_HDR *p_msg);
+static void    llcp_link_log_stats (void);
 
 #if (LLCP_TEST_INCLUDED == TRUE) /* this is for LLCP testing */
 extern tLLCP_TEST_PARAMS llcp_test_params;
@@ -310,6 +314,11 @@ tLLCP_STATUS llcp_link_activate (tLLCP_ACTIVATE_CONFIG *p_config)
     else
         llcp_cb.lcb.effective_miu = llcp_cb.lcb.local_link_miu;
 
+    /* start statistics for this link */
+    memset (&llcp_cb.lcb.stats, 0, sizeof (tLLCP_LINK_STATS_CB));
+    llcp_cb.lcb.stats.is_valid   = TRUE;
+    llcp_cb.lcb.stats.start_tick = GKI_get_tick_count ();
+
 #if(NFC_NXP_LLCP_SECURED_P2P == TRUE)
     if((llcp_cb.lcb.local_opt & (LLCP_DPC_1 << 2)) && (llcp_cb.lcb.peer_opt & (LLCP_DPC_1 << 2 )))
     {
@@ -484,6 +493,9 @@ static void llcp_deactivate_cleanup  (UINT8 reason)
     /* We had sent out DISC */
     llcp_cb.lcb.link_state = LLCP_LINK_STATE_DEACTIVATED;
 
+    llcp_cb.lcb.stats.stop_tick = GKI_get_tick_count ();
+    llcp_link_log_stats ();
+
     llcp_link_stop_link_timer ();
 
     /* stop inactivity timer */
@@ -1734,6 +1746,8 @@ static void llcp_link_proc_rx_data (BT_HDR *p_msg)
     {
         llcp_link_stop_link_timer ();
 
+        llcp_link_update_rx_stats (p_msg);
+
         if (llcp_cb.lcb.received_first_packet == FALSE)
         {
             llcp_cb.lcb.received_first_packet = TRUE;
@@ -1837,135 +1851,132 @@ static void llcp_link_proc_rx_data (BT_HDR *p_msg)
 ** Function         llcp_link_get_next_pdu
 **
 ** Description      Get next PDU from link manager or data links w/wo dequeue
+**                  Only PDU which is not longer than max_length is considered,
+**                  so smaller PDU of other links can fill up aggregated PDU.
+**                  Logical data link and data link connection are served
+**                  in round robin, indexes are updated only when dequeued.
 **
 ** Returns          pointer of a PDU to send if length_only is FALSE
 **                  NULL otherwise
 **
 *******************************************************************************/
-static BT_HDR *llcp_link_get_next_pdu (BOOLEAN length_only, UINT16 *p_next_pdu_length)
+static BT_HDR *llcp_link_get_next_pdu (BOOLEAN length_only, UINT16 max_length, UINT16 *p_next_pdu_length)
 {
     BT_HDR *p_msg;
     int     count, xx;
+    UINT8   idx;
+    UINT16  length;
+    BOOLEAN ll_turn;
     tLLCP_APP_CB *p_app_cb;
+    tLLCP_DLCB   *p_dlcb;
+
+    *p_next_pdu_length = 0;
 
     /* processing signalling PDU first */
     if (llcp_cb.lcb.sig_xmit_q.p_first)
     {
+        p_msg = (BT_HDR*) llcp_cb.lcb.sig_xmit_q.p_first;
+
+        /* keep order of signalling PDU, don't send data before it */
+        if (p_msg->len > max_length)
+            return NULL;
+
         if (length_only)
         {
-            p_msg = (BT_HDR*) llcp_cb.lcb.sig_xmit_q.p_first;
             *p_next_pdu_length = p_msg->len;
             return NULL;
         }
-        else
-            p_msg = (BT_HDR*) GKI_dequeue (&llcp_cb.lcb.sig_xmit_q);
 
-        return p_msg;
+        return (BT_HDR*) GKI_dequeue (&llcp_cb.lcb.sig_xmit_q);
     }
-    else
+
+    /* transmitting logical data link and data link connection equaly */
+    ll_turn = !llcp_cb.lcb.ll_served;
+
+    for (xx = 0; xx < 2; xx++, ll_turn = !ll_turn)
     {
-        /* transmitting logical data link and data link connection equaly */
-        for (xx = 0; xx < 2; xx++)
+        if (ll_turn)
         {
-            if (!llcp_cb.lcb.ll_served)
+            /* Get one from logical link connection */
+            for (count = 0; count < LLCP_NUM_SAPS; count++)
             {
-                /* Get one from logical link connection */
-                for (count = 0; count < LLCP_NUM_SAPS; count++)
-                {
-                    /* round robin schedule without priority  */
-                    p_app_cb = llcp_util_get_app_cb (llcp_cb.lcb.ll_idx);
+                /* round robin schedule without priority  */
+                idx      = (UINT8) ((llcp_cb.lcb.ll_idx + count) % LLCP_NUM_SAPS);
+                p_app_cb = llcp_util_get_app_cb (idx);
 
-                    if (  (p_app_cb)
-                        &&(p_app_cb->p_app_cback)
-                        &&(p_app_cb->ui_xmit_q.count)  )
+                if (  (p_app_cb)
+                    &&(p_app_cb->p_app_cback)
+                    &&(p_app_cb->ui_xmit_q.count)
+                    &&(((BT_HDR *) p_app_cb->ui_xmit_q.p_first)->len <= max_length)  )
+                {
+                    if (length_only)
                     {
-                        if (length_only)
-                        {
-                            /* don't alternate next data link to return the same length of PDU */
-                            p_msg = (BT_HDR *) p_app_cb->ui_xmit_q.p_first;
-                            *p_next_pdu_length = p_msg->len;
-                            return NULL;
-                        }
-                        else
-                        {
-                            /* check data link connection first in next time */
-                            llcp_cb.lcb.ll_served = !llcp_cb.lcb.ll_served;
+                        *p_next_pdu_length = ((BT_HDR *) p_app_cb->ui_xmit_q.p_first)->len;
+                        return NULL;
+                    }
 
-                            p_msg = (BT_HDR*) GKI_dequeue (&p_app_cb->ui_xmit_q);
-                            llcp_cb.total_tx_ui_pdu--;
+                    p_msg = (BT_HDR*) GKI_dequeue (&p_app_cb->ui_xmit_q);
+                    llcp_cb.total_tx_ui_pdu--;
 
-                            /* this logical link has been served, so start from next logical link next time */
-                            llcp_cb.lcb.ll_idx = (llcp_cb.lcb.ll_idx + 1) % LLCP_NUM_SAPS;
+                    /* check data link connection first in next time */
+                    llcp_cb.lcb.ll_served = TRUE;
 
-                            return p_msg;
-                        }
-                    }
-                    else
-                    {
-                        /* check next logical link connection */
-                        llcp_cb.lcb.ll_idx = (llcp_cb.lcb.ll_idx + 1) % LLCP_NUM_SAPS;
-                    }
-                }
+                    /* this logical link has been served, so start from next logical link next time */
+                    llcp_cb.lcb.ll_idx = (UINT8) ((idx + 1) % LLCP_NUM_SAPS);
 
-                /* no data, so check data link connection if not checked yet */
-                llcp_cb.lcb.ll_served = !llcp_cb.lcb.ll_served;
+                    return p_msg;
+                }
             }
-            else
+        }
+        else
+        {
+            /* Get one from data link connection */
+            for (count = 0; count < LLCP_MAX_DATA_LINK; count++)
             {
-                /* Get one from data link connection */
-                for (count = 0; count < LLCP_MAX_DATA_LINK; count++)
-                {
-                    /* round robin schedule without priority  */
-                    if (llcp_cb.dlcb[llcp_cb.lcb.dl_idx].state != LLCP_DLC_STATE_IDLE)
-                    {
-                        if (length_only)
-                        {
-                            *p_next_pdu_length = llcp_dlc_get_next_pdu_length (&llcp_cb.dlcb[llcp_cb.lcb.dl_idx]);
-
-                            if (*p_next_pdu_length > 0 )
-                            {
-                                /* don't change data link connection to return the same length of PDU */
-                                return NULL;
-                            }
-                            else
-                            {
-                                /* no data, so check next data link connection */
-                                llcp_cb.lcb.dl_idx = (llcp_cb.lcb.dl_idx + 1) % LLCP_MAX_DATA_LINK;
-                            }
-                        }
-                        else
-                        {
-                            p_msg = llcp_dlc_get_next_pdu (&llcp_cb.dlcb[llcp_cb.lcb.dl_idx]);
+                /* round robin schedule without priority  */
+                idx    = (UINT8) ((llcp_cb.lcb.dl_idx + count) % LLCP_MAX_DATA_LINK);
+                p_dlcb = &llcp_cb.dlcb[idx];
 
-                            /* this data link has been served, so start from next data link next time */
-                            llcp_cb.lcb.dl_idx = (llcp_cb.lcb.dl_idx + 1) % LLCP_MAX_DATA_LINK;
+                if (p_dlcb->state == LLCP_DLC_STATE_IDLE)
+                    continue;
 
-                            if (p_msg)
-                            {
-                                /* serve logical data link next time */
-                                llcp_cb.lcb.ll_served = !llcp_cb.lcb.ll_served;
-                                return p_msg;
-                            }
-                        }
-                    }
-                    else
+                length = llcp_dlc_get_next_pdu_length (p_dlcb);
+
+                if (length > max_length)
+                    continue;
+
+                if (length_only)
+                {
+                    if (length > 0)
                     {
-                        /* check next data link connection */
-                        llcp_cb.lcb.dl_idx = (llcp_cb.lcb.dl_idx + 1) % LLCP_MAX_DATA_LINK;
+                        *p_next_pdu_length = length;
+                        return NULL;
                     }
                 }
-
-                /* if all of data link connection doesn't have data to send */
-                if (count >= LLCP_MAX_DATA_LINK)
+                else
                 {
-                    llcp_cb.lcb.ll_served = !llcp_cb.lcb.ll_served;
+                    /*
+                    ** data link may have pending DISC or tx complete event to report
+                    ** even if there is nothing to send, so let it check always
+                    */
+                    p_msg = llcp_dlc_get_next_pdu (p_dlcb);
+
+                    if (p_msg)
+                    {
+                        /* serve logical data link next time */
+                        llcp_cb.lcb.ll_served = FALSE;
+
+                        /* this data link has been served, so start from next data link next time */
+                        llcp_cb.lcb.dl_idx = (UINT8) ((idx + 1) % LLCP_MAX_DATA_LINK);
+
+                        return p_msg;
+                    }
                 }
             }
         }
     }
 
     /* nothing to send */
-    *p_next_pdu_length = 0;
     return NULL;
 }
 
@@ -1975,6 +1986,7 @@ static BT_HDR *llcp_link_get_next_pdu (BOOLEAN length_only, UINT16 *p_next_pdu_l
 **
 ** Description      Build a PDU from Link Manager and Data Link
 **                  Perform aggregation procedure if necessary
+**                  PDUs are packed into AGF PDU as many as fit in link MIU
 **
 ** Returns          BT_HDR* if sent any PDU
 **
@@ -1983,7 +1995,7 @@ static BT_HDR *llcp_link_build_next_pdu (BT_HDR *p_pdu)
 {
     BT_HDR *p_agf = NULL, *p_msg = NULL, *p_next_pdu;
     UINT8  *p, ptype;
-    UINT16  next_pdu_length, pdu_hdr;
+    UINT16  next_pdu_length, pdu_hdr, used_length, room;
 
     LLCP_TRACE_DEBUG0 ("llcp_link_build_next_pdu ()");
 
@@ -2011,7 +2023,7 @@ static BT_HDR *llcp_link_build_next_pdu (BT_HDR *p_pdu)
     else
     {
         /* Get a PDU from link manager or data links */
-        p_msg = llcp_link_get_next_pdu (FALSE, &next_pdu_length);
+        p_msg = llcp_link_get_next_pdu (FALSE, 0xFFFF, &next_pdu_length);
 
         if (!p_msg)
         {
@@ -2019,66 +2031,66 @@ static BT_HDR *llcp_link_build_next_pdu (BT_HDR *p_pdu)
         }
     }
 
-    /* Get length of next PDU from link manager or data links without dequeue */
-    llcp_link_get_next_pdu (TRUE, &next_pdu_length);
-    while (next_pdu_length > 0)
+    while (TRUE)
     {
-        /* if it's first visit */
+        /* length of information field of AGF PDU used so far */
+        if (p_agf)
+            used_length = p_agf->len - LLCP_PDU_HEADER_SIZE;
+        else
+            used_length = LLCP_PDU_AGF_LEN_SIZE + p_msg->len;
+
+        if (used_length + LLCP_PDU_AGF_LEN_SIZE >= llcp_cb.lcb.effective_miu)
+            break;
+
+        room = llcp_cb.lcb.effective_miu - used_length - LLCP_PDU_AGF_LEN_SIZE;
+
+        /* Get length of next PDU fitting into the rest of MIU without dequeue */
+        llcp_link_get_next_pdu (TRUE, room, &next_pdu_length);
+
+        if (next_pdu_length == 0)
+            break;
+
+        /* if it's first visit, allocate AGF PDU and copy the first PDU */
         if (!p_agf)
         {
-            /* if next PDU fits into MIU, allocate AGF PDU and copy the first PDU */
-            if (2 + p_msg->len + 2 + next_pdu_length <= llcp_cb.lcb.effective_miu)
+            p_agf = (BT_HDR*) GKI_getpoolbuf (LLCP_POOL_ID);
+            if (p_agf)
             {
-                p_agf = (BT_HDR*) GKI_getpoolbuf (LLCP_POOL_ID);
-                if (p_agf)
-                {
-                    p_agf->offset = NCI_MSG_OFFSET_SIZE + NCI_DATA_HDR_SIZE;
+                p_agf->offset = NCI_MSG_OFFSET_SIZE + NCI_DATA_HDR_SIZE;
 
-                    p = (UINT8 *) (p_agf + 1) + p_agf->offset;
+                p = (UINT8 *) (p_agf + 1) + p_agf->offset;
 
-                    UINT16_TO_BE_STREAM (p, LLCP_GET_PDU_HEADER (LLCP_SAP_LM, LLCP_PDU_AGF_TYPE, LLCP_SAP_LM ));
-                    UINT16_TO_BE_STREAM (p, p_msg->len);
-                    memcpy(p, (UINT8 *) (p_msg + 1) + p_msg->offset, p_msg->len);
+                UINT16_TO_BE_STREAM (p, LLCP_GET_PDU_HEADER (LLCP_SAP_LM, LLCP_PDU_AGF_TYPE, LLCP_SAP_LM ));
+                UINT16_TO_BE_STREAM (p, p_msg->len);
+                memcpy(p, (UINT8 *) (p_msg + 1) + p_msg->offset, p_msg->len);
 
-                    p_agf->len      = LLCP_PDU_HEADER_SIZE + 2 + p_msg->len;
+                p_agf->len      = LLCP_PDU_HEADER_SIZE + LLCP_PDU_AGF_LEN_SIZE + p_msg->len;
 
-                    GKI_freebuf (p_msg);
-                    p_msg = p_agf;
-                }
-                else
-                {
-                    LLCP_TRACE_ERROR0 ("llcp_link_build_next_pdu (): Out of buffer");
-                    return p_msg;
-                }
+                GKI_freebuf (p_msg);
+                p_msg = p_agf;
             }
             else
             {
-                break;
+                LLCP_TRACE_ERROR0 ("llcp_link_build_next_pdu (): Out of buffer");
+                return p_msg;
             }
         }
 
-        /* if next PDU fits into MIU, copy the next PDU into AGF */
-        if (p_agf->len - LLCP_PDU_HEADER_SIZE + 2 + next_pdu_length <= llcp_cb.lcb.effective_miu)
-        {
-            /* Get a next PDU from link manager or data links */
-            p_next_pdu = llcp_link_get_next_pdu (FALSE, &next_pdu_length);
+        /* Get a next PDU from link manager or data links */
+        p_next_pdu = llcp_link_get_next_pdu (FALSE, room, &next_pdu_length);
 
-            p = (UINT8 *) (p_agf + 1) + p_agf->offset + p_agf->len;
+        if (!p_next_pdu)
+            break;
 
-            UINT16_TO_BE_STREAM (p, p_next_pdu->len);
-            memcpy (p, (UINT8 *) (p_next_pdu + 1) + p_next_pdu->offset, p_next_pdu->len);
+        /* copy the next PDU into AGF */
+        p = (UINT8 *) (p_agf + 1) + p_agf->offset + p_agf->len;
 
-            p_agf->len += 2 + p_next_pdu->len;
+        UINT16_TO_BE_STREAM (p, p_next_pdu->len);
+        memcpy (p, (UINT8 *) (p_next_pdu + 1) + p_next_pdu->offset, p_next_pdu->len);
 
-            GKI_freebuf (p_next_pdu);
+        p_agf->len += LLCP_PDU_AGF_LEN_SIZE + p_next_pdu->len;
 
-            /* Get next PDU length from link manager or data links without dequeue */
-            llcp_link_get_next_pdu (TRUE, &next_pdu_length);
-        }
-        else
-        {
-            break;
-        }
+        GKI_freebuf (p_next_pdu);
     }
 
     if (p_agf)
@@ -2102,9 +2114,161 @@ static void llcp_link_send_to_lower (BT_HDR *p_pdu)
     DispLLCP (p_pdu, FALSE);
 #endif
          llcp_cb.lcb.symm_state = LLCP_LINK_SYMM_REMOTE_XMIT_NEXT;
+    llcp_link_update_tx_stats (p_pdu);
     NFC_SendData (NFC_RF_CONN_ID, p_pdu);
 }
 
+/*******************************************************************************
+**
+** Function         llcp_link_get_info_length
+**
+** Description      Get length of information field of I/UI PDU, summing up
+**                  I/UI PDUs aggregated in AGF PDU
+**
+** Returns          length of information field
+**
+*******************************************************************************/
+static UINT32 llcp_link_get_info_length (UINT8 *p, UINT16 length)
+{
+    UINT16 pdu_hdr, pdu_length;
+    UINT8  ptype;
+    UINT32 info_length = 0;
+
+    if (length < LLCP_PDU_HEADER_SIZE)
+        return 0;
+
+    BE_STREAM_TO_UINT16 (pdu_hdr, p);
+    ptype = (UINT8) (LLCP_GET_PTYPE (pdu_hdr));
+
+    if (ptype == LLCP_PDU_I_TYPE)
+    {
+        if (length >= LLCP_PDU_HEADER_SIZE + LLCP_SEQUENCE_SIZE)
+            info_length = length - LLCP_PDU_HEADER_SIZE - LLCP_SEQUENCE_SIZE;
+    }
+    else if (ptype == LLCP_PDU_UI_TYPE)
+    {
+        info_length = length - LLCP_PDU_HEADER_SIZE;
+    }
+    else if (ptype == LLCP_PDU_AGF_TYPE)
+    {
+        length -= LLCP_PDU_HEADER_SIZE;
+
+        while (length > LLCP_PDU_AGF_LEN_SIZE)
+        {
+            BE_STREAM_TO_UINT16 (pdu_length, p);
+            length -= LLCP_PDU_AGF_LEN_SIZE;
+
+            if (pdu_length > length)
+                break;
+
+            info_length += llcp_link_get_info_length (p, pdu_length);
+
+            p      += pdu_length;
+            length -= pdu_length;
+        }
+    }
+
+    return info_length;
+}
+
+/*******************************************************************************
+**
+** Function         llcp_link_update_tx_stats
+**
+** Description      Update link statistics for PDU being sent to peer
+**
+** Returns          void
+**
+*******************************************************************************/
+static void llcp_link_update_tx_stats (BT_HDR *p_pdu)
+{
+    tLLCP_LINK_STATS_CB *p_stats = &llcp_cb.lcb.stats;
+    UINT8  *p = (UINT8 *) (p_pdu + 1) + p_pdu->offset;
+    UINT16 pdu_hdr;
+
+    p_stats->xmit_tick = GKI_get_tick_count ();
+    p_stats->num_tx_pdu++;
+
+    if (p_pdu->len >= LLCP_PDU_HEADER_SIZE)
+    {
+        BE_STREAM_TO_UINT16 (pdu_hdr, p);
+
+        if (LLCP_GET_PTYPE (pdu_hdr) == LLCP_PDU_SYMM_TYPE)
+            p_stats->num_tx_symm++;
+        else
+            p_stats->tx_info_bytes += llcp_link_get_info_length ((UINT8 *) (p_pdu + 1) + p_pdu->offset,
+                                                                 p_pdu->len);
+    }
+}
+
+/*******************************************************************************
+**
+** Function         llcp_link_update_rx_stats
+**
+** Description      Update link statistics for PDU received from peer.
+**                  Round trip is measured from the last PDU sent to peer.
+**
+** Returns          void
+**
+*******************************************************************************/
+static void llcp_link_update_rx_stats (BT_HDR *p_msg)
+{
+    tLLCP_LINK_STATS_CB *p_stats = &llcp_cb.lcb.stats;
+    UINT8  *p = (UINT8 *) (p_msg + 1) + p_msg->offset;
+    UINT16 pdu_hdr;
+    UINT32 rtt_ticks;
+
+    if (p_stats->num_tx_pdu)
+    {
+        rtt_ticks = GKI_get_tick_count () - p_stats->xmit_tick;
+
+        p_stats->num_rtt++;
+        p_stats->rtt_total_ticks += rtt_ticks;
+
+        if (rtt_ticks > p_stats->rtt_max_ticks)
+            p_stats->rtt_max_ticks = rtt_ticks;
+    }
+
+    p_stats->num_rx_pdu++;
+
+    if (p_msg->len >= LLCP_PDU_HEADER_SIZE)
+    {
+        BE_STREAM_TO_UINT16 (pdu_hdr, p);
+
+        if (LLCP_GET_PTYPE (pdu_hdr) == LLCP_PDU_SYMM_TYPE)
+            p_stats->num_rx_symm++;
+        else
+            p_stats->rx_info_bytes += llcp_link_get_info_length ((UINT8 *) (p_msg + 1) + p_msg->offset,
+                                                                 p_msg->len);
+    }
+}
+
+/*******************************************************************************
+**
+** Function         llcp_link_log_stats
+**
+** Description      Dump statistics of deactivated link
+**
+** Returns          void
+**
+*******************************************************************************/
+static void llcp_link_log_stats (void)
+{
+    tLLCP_LINK_STATS stats;
+
+    if (LLCP_GetLinkStats (&stats) != LLCP_STATUS_SUCCESS)
+        return;
+
+    LLCP_TRACE_DEBUG4 ("LLCP link stats: MIU (local:%d, peer:%d, effective:%d), duration %d ms",
+                       stats.local_link_miu, stats.peer_link_miu, stats.effective_miu, stats.duration);
+    LLCP_TRACE_DEBUG4 ("    tx: %d PDUs (%d SYMM), %d bytes, %d bytes/s",
+                       stats.num_tx_pdu, stats.num_tx_symm, stats.tx_info_bytes, stats.tx_throughput);
+    LLCP_TRACE_DEBUG4 ("    rx: %d PDUs (%d SYMM), %d bytes, %d bytes/s",
+                       stats.num_rx_pdu, stats.num_rx_symm, stats.rx_info_bytes, stats.rx_throughput);
+    LLCP_TRACE_DEBUG3 ("    round trip: %d samples, avg %d ms, max %d ms",
+                       stats.num_rtt, stats.rtt_avg, stats.rtt_max);
+}
+
 /*******************************************************************************
 **
 ** Function         llcp_link_connection_cback
@@ -32,14 +32,63 @@
 #include "llcp_defs.h"
 #include "nfc_int.h"
 
-#if(NFC_NXP_LLCP_SECURED_P2P == TRUE)
 #include "nci_config.h"
-#endif
 
 #if (LLCP_DYNAMIC_MEMORY == FALSE)
 tLLCP_CB llcp_cb;
 #endif
 
+/*******************************************************************************
+**
+** Function         llcp_read_config
+**
+** Description      Override default link parameters with the ones found in
+**                  configuration file. Values are validated by LLCP_SetConfig.
+**
+** Returns          void
+**
+*******************************************************************************/
+static void llcp_read_config (void)
+{
+    UINT32  num;
+    BOOLEAN found = FALSE;
+    UINT16  link_miu   = llcp_cb.lcb.local_link_miu;
+    UINT8   wt         = llcp_cb.lcb.local_wt;
+    UINT16  lto        = llcp_cb.lcb.local_lto;
+    UINT16  symm_delay = llcp_cb.lcb.symm_delay;
+
+    if (GetNumValue (NAME_LLCP_MIU, &num, sizeof (num)))
+    {
+        link_miu = (UINT16) num;
+        found = TRUE;
+    }
+    if (GetNumValue (NAME_LLCP_WT, &num, sizeof (num)))
+    {
+        wt = (UINT8) num;
+        found = TRUE;
+    }
+    if (GetNumValue (NAME_LLCP_LTO, &num, sizeof (num)))
+    {
+        lto = (UINT16) num;
+        found = TRUE;
+    }
+    if (GetNumValue (NAME_LLCP_DELAY_RESP_TIME, &num, sizeof (num)))
+    {
+        symm_delay = (UINT16) num;
+        found = TRUE;
+    }
+
+    if (found)
+    {
+        LLCP_SetConfig (link_miu, llcp_cb.lcb.local_opt, wt, lto,
+                        llcp_cb.lcb.inact_timeout_init,
+                        llcp_cb.lcb.inact_timeout_target,
+                        symm_delay,
+                        llcp_cb.lcb.data_link_timeout,
+                        llcp_cb.lcb.delay_first_pdu_timeout);
+    }
+}
+
 /*******************************************************************************
 **
 ** Function         llcp_init
@@ -82,6 +131,8 @@ void llcp_init (void)
 
     llcp_cb.lcb.wks  = LLCP_WKS_MASK_LM;
 
+    llcp_read_config ();
+
     /* total number of buffers for LLCP */
     pool_count = GKI_poolcount (LLCP_POOL_ID);
 
@@ -368,6 +368,7 @@ tLLCP_DLCB *llcp_util_allocate_data_link (UINT8 reg_sap, UINT8 remote_sap)
         p_dlcb->local_sap   = reg_sap;
         p_dlcb->remote_sap  = remote_sap;
         p_dlcb->timer.param = (TIMER_PARAM_TYPE) p_dlcb;
+        p_dlcb->connect_tick = GKI_get_tick_count ();
 
         /* this is for inactivity timer and congestion control. */
         llcp_cb.num_data_link_connection++;
@@ -395,6 +396,13 @@ void llcp_util_deallocate_data_link (tLLCP_DLCB *p_dlcb)
 
         if (p_dlcb->state != LLCP_DLC_STATE_IDLE)
         {
+            LLCP_TRACE_DEBUG6 ("llcp_util_deallocate_data_link (): MIU (local:%d, remote:%d), RW (local:%d, remote:%d), tx %d bytes, rx %d bytes",
+                                p_dlcb->local_miu, p_dlcb->remote_miu,
+                                p_dlcb->local_rw, p_dlcb->remote_rw,
+                                p_dlcb->tx_info_bytes, p_dlcb->rx_info_bytes);
+            LLCP_TRACE_DEBUG1 ("llcp_util_deallocate_data_link (): allocated for %d ms",
+                                GKI_TICKS_TO_MS (GKI_get_tick_count () - p_dlcb->connect_tick));
+
             nfc_stop_quick_timer (&p_dlcb->timer);
             llcp_dlc_flush_q (p_dlcb);
 
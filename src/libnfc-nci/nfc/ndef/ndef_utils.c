@@ -69,16 +69,19 @@ static void shiftup (UINT8 *p_dest, UINT8 *p_src, UINT32 len)
 
 /*******************************************************************************
 **
-** Function         NDEF_MsgValidate
+** Function         ndef_msg_parse
 **
-** Description      This function validates an NDEF message.
+** Description      Validate an NDEF message and, if p_index is not NULL, record
+**                  the location of each record in it.
 **
-** Returns          TRUE if all OK, or FALSE if the message is invalid.
+** Returns          NDEF_OK, or the validation error
 **
 *******************************************************************************/
-tNDEF_STATUS NDEF_MsgValidate (UINT8 *p_msg, UINT32 msg_len, BOOLEAN b_allow_chunks)
+static tNDEF_STATUS ndef_msg_parse (UINT8 *p_msg, UINT32 msg_len, BOOLEAN b_allow_chunks, tNDEF_INDEX *p_index)
 {
     UINT8   *p_rec = p_msg;
+    UINT8   *p_rec_start;
+    tNDEF_REC_INFO *p_info;
     UINT8   *p_end = p_msg + msg_len;
     UINT8   rec_hdr=0, type_len, id_len;
     int     count;
@@ -102,6 +105,7 @@ tNDEF_STATUS NDEF_MsgValidate (UINT8 *p_msg, UINT32 msg_len, BOOLEAN b_allow_chu
         if (p_rec + 3 > p_end)
             return (NDEF_MSG_TOO_SHORT);
 
+        p_rec_start = p_rec;
         rec_hdr = *p_rec++;
 
         /* The second and all subsequent records must NOT have the MB bit set */
@@ -187,6 +191,27 @@ tNDEF_STATUS NDEF_MsgValidate (UINT8 *p_msg, UINT32 msg_len, BOOLEAN b_allow_chu
                 return (NDEF_MSG_LENGTH_MISMATCH);
         }
 
+        /* The record must not run past the end of the message */
+        if (  ((UINT32) (p_end - p_rec) < (UINT32) (type_len + id_len))
+            ||(payload_len > (UINT32) (p_end - p_rec) - type_len - id_len)  )
+            return (NDEF_MSG_LENGTH_MISMATCH);
+
+        if (p_index != NULL)
+        {
+            if (p_index->num_recs < p_index->max_recs)
+            {
+                p_info = &p_index->p_recs[p_index->num_recs];
+                p_info->rec_offset     = (UINT32) (p_rec_start - p_msg);
+                p_info->hdr            = rec_hdr;
+                p_info->type_offset    = (UINT16) (p_rec - p_rec_start);
+                p_info->type_len       = type_len;
+                p_info->id_len         = id_len;
+                p_info->payload_offset = (UINT32) (p_rec - p_msg) + type_len + id_len;
+                p_info->payload_len    = payload_len;
+            }
+            p_index->num_recs++;
+        }
+
         /* Point to next record */
         p_rec += (payload_len + type_len + id_len);
 
@@ -207,6 +232,233 @@ tNDEF_STATUS NDEF_MsgValidate (UINT8 *p_msg, UINT32 msg_len, BOOLEAN b_allow_chu
     return (NDEF_OK);
 }
 
+/*******************************************************************************
+**
+** Function         NDEF_MsgValidate
+**
+** Description      This function validates an NDEF message.
+**
+** Returns          TRUE if all OK, or FALSE if the message is invalid.
+**
+*******************************************************************************/
+tNDEF_STATUS NDEF_MsgValidate (UINT8 *p_msg, UINT32 msg_len, BOOLEAN b_allow_chunks)
+{
+    return (ndef_msg_parse (p_msg, msg_len, b_allow_chunks, NULL));
+}
+
+/*******************************************************************************
+**
+** Function         NDEF_MsgBuildIndex
+**
+** Description      This function validates an NDEF message and records the
+**                  location of each record in p_recs, in a single pass.
+**                  p_recs may be NULL (max_recs 0) to only count the records.
+**
+** Returns          NDEF_OK, NDEF_MSG_INSUFFICIENT_MEM if the message is valid
+**                  but has more than max_recs records (num_recs holds the
+**                  total), or the NDEF_MsgValidate error.
+**
+*******************************************************************************/
+tNDEF_STATUS NDEF_MsgBuildIndex (UINT8 *p_msg, UINT32 msg_len, BOOLEAN b_allow_chunks,
+                                 tNDEF_INDEX *p_index, tNDEF_REC_INFO *p_recs, UINT16 max_recs)
+{
+    tNDEF_STATUS status;
+
+    if (p_index == NULL)
+        return (NDEF_MSG_INSUFFICIENT_MEM);
+
+    p_index->p_msg    = p_msg;
+    p_index->p_recs   = p_recs;
+    p_index->max_recs = (p_recs != NULL) ? max_recs : 0;
+    p_index->num_recs = 0;
+
+    status = ndef_msg_parse (p_msg, msg_len, b_allow_chunks, p_index);
+
+    if (status != NDEF_OK)
+        p_index->num_recs = 0;
+    else if (p_index->num_recs > p_index->max_recs)
+        status = NDEF_MSG_INSUFFICIENT_MEM;
+
+    return (status);
+}
+
+/*******************************************************************************
+**
+** Function         ndef_index_get_info
+**
+** Description      Get the location of an indexed record.
+**
+** Returns          Pointer to the record information, or NULL
+**
+*******************************************************************************/
+static tNDEF_REC_INFO *ndef_index_get_info (tNDEF_INDEX *p_index, INT32 index)
+{
+    if (  (p_index == NULL)
+        ||(index < 0)
+        ||(index >= p_index->num_recs)
+        ||(index >= p_index->max_recs)  )
+        return (NULL);
+
+    return (&p_index->p_recs[index]);
+}
+
+/*******************************************************************************
+**
+** Function         NDEF_IndexGetRec
+**
+** Description      This function gets a pointer to the record with the given
+**                  index (0-based index) in an indexed NDEF message.
+**
+** Returns          Pointer to the start of the record, or NULL
+**
+*******************************************************************************/
+UINT8 *NDEF_IndexGetRec (tNDEF_INDEX *p_index, INT32 index)
+{
+    tNDEF_REC_INFO *p_info = ndef_index_get_info (p_index, index);
+
+    if (p_info == NULL)
+        return (NULL);
+
+    return (p_index->p_msg + p_info->rec_offset);
+}
+
+/*******************************************************************************
+**
+** Function         NDEF_IndexGetType
+**
+** Description      This function gets a pointer to the record type of the record
+**                  with the given index in an indexed NDEF message.
+**
+** Returns          Pointer to Type (NULL if none). TNF and len are filled in.
+**
+*******************************************************************************/
+UINT8 *NDEF_IndexGetType (tNDEF_INDEX *p_index, INT32 index, UINT8 *p_tnf, UINT8 *p_type_len)
+{
+    tNDEF_REC_INFO *p_info = ndef_index_get_info (p_index, index);
+
+    if (p_info == NULL)
+        return (NULL);
+
+    *p_tnf      = p_info->hdr & NDEF_TNF_MASK;
+    *p_type_len = p_info->type_len;
+
+    if (p_info->type_len == 0)
+        return (NULL);
+
+    return (p_index->p_msg + p_info->rec_offset + p_info->type_offset);
+}
+
+/*******************************************************************************
+**
+** Function         NDEF_IndexGetId
+**
+** Description      This function gets a pointer to the record id of the record
+**                  with the given index in an indexed NDEF message.
+**
+** Returns          Pointer to Id (NULL if none). ID Len is filled in.
+**
+*******************************************************************************/
+UINT8 *NDEF_IndexGetId (tNDEF_INDEX *p_index, INT32 index, UINT8 *p_id_len)
+{
+    tNDEF_REC_INFO *p_info = ndef_index_get_info (p_index, index);
+
+    if (p_info == NULL)
+        return (NULL);
+
+    *p_id_len = p_info->id_len;
+
+    if (p_info->id_len == 0)
+        return (NULL);
+
+    return (p_index->p_msg + p_info->rec_offset + p_info->type_offset + p_info->type_len);
+}
+
+/*******************************************************************************
+**
+** Function         NDEF_IndexGetPayload
+**
+** Description      This function gets a pointer to the payload of the record
+**                  with the given index in an indexed NDEF message.
+**
+** Returns          a pointer to the payload (NULL if none). Payload len filled in.
+**
+*******************************************************************************/
+UINT8 *NDEF_IndexGetPayload (tNDEF_INDEX *p_index, INT32 index, UINT32 *p_payload_len)
+{
+    tNDEF_REC_INFO *p_info = ndef_index_get_info (p_index, index);
+
+    if (p_info == NULL)
+        return (NULL);
+
+    *p_payload_len = p_info->payload_len;
+
+    if (p_info->payload_len == 0)
+        return (NULL);
+
+    return (p_index->p_msg + p_info->payload_offset);
+}
+
+/*******************************************************************************
+**
+** Function         NDEF_IndexFindByType
+**
+** Description      This function finds the first record with the given record
+**                  type, starting at record start_index.
+**
+** Returns          Index of the record, or -1 if not found
+**
+*******************************************************************************/
+INT32 NDEF_IndexFindByType (tNDEF_INDEX *p_index, INT32 start_index, UINT8 tnf, UINT8 *p_type, UINT8 tlen)
+{
+    tNDEF_REC_INFO *p_info;
+    INT32   xx;
+
+    if ((p_index == NULL) || (start_index < 0))
+        return (-1);
+
+    for (xx = start_index; (xx < p_index->num_recs) && (xx < p_index->max_recs); xx++)
+    {
+        p_info = &p_index->p_recs[xx];
+
+        if ( ((p_info->hdr & NDEF_TNF_MASK) == tnf)
+         &&  (p_info->type_len == tlen)
+         &&  (!memcmp (p_index->p_msg + p_info->rec_offset + p_info->type_offset, p_type, tlen)) )
+            return (xx);
+    }
+
+    return (-1);
+}
+
+/*******************************************************************************
+**
+** Function         NDEF_IndexFindById
+**
+** Description      This function finds the first record with the given record
+**                  id, starting at record start_index.
+**
+** Returns          Index of the record, or -1 if not found
+**
+*******************************************************************************/
+INT32 NDEF_IndexFindById (tNDEF_INDEX *p_index, INT32 start_index, UINT8 *p_id, UINT8 ilen)
+{
+    tNDEF_REC_INFO *p_info;
+    INT32   xx;
+
+    if ((p_index == NULL) || (start_index < 0))
+        return (-1);
+
+    for (xx = start_index; (xx < p_index->num_recs) && (xx < p_index->max_recs); xx++)
+    {
+        p_info = &p_index->p_recs[xx];
+
+        if ( (p_info->id_len == ilen)
+         &&  (!memcmp (p_index->p_msg + p_info->rec_offset + p_info->type_offset + p_info->type_len, p_id, ilen)) )
+            return (xx);
+    }
+
+    return (-1);
+}
+
 /*******************************************************************************
 **
 ** Function         NDEF_MsgGetNumRecs
@@ -917,6 +1169,114 @@ extern tNDEF_STATUS  NDEF_MsgAddRec (UINT8 *p_msg, UINT32 max_size, UINT32 *p_cu
     return (NDEF_OK);
 }
 
+/*******************************************************************************
+**
+** Function         NDEF_RecGetEncodedSize
+**
+** Description      This function computes the encoded size of a record, so the
+**                  exact buffer size of a message can be known before it is built.
+**
+** Returns          Size of the record in bytes
+**
+*******************************************************************************/
+UINT32 NDEF_RecGetEncodedSize (UINT8 type_len, UINT8 id_len, UINT32 payload_len)
+{
+    /* Header, type length, 1 or 4 byte payload length and optional ID length */
+    return (2 + ((payload_len < 256) ? 1 : 4) + ((id_len == 0) ? 0 : 1)
+            + type_len + id_len + payload_len);
+}
+
+/*******************************************************************************
+**
+** Function         NDEF_MsgBuildRec
+**
+** Description      This function writes a record at the end of an NDEF message
+**                  being built front to back. The payload is gathered from
+**                  num_spans caller buffers. The first record gets the MB bit
+**                  and the record built with b_last set gets the ME bit, so no
+**                  earlier record is ever revisited.
+**
+** Returns          OK, or error if the record did not fit
+**                  *p_cur_size is updated
+**
+*******************************************************************************/
+tNDEF_STATUS NDEF_MsgBuildRec (UINT8 *p_msg, UINT32 max_size, UINT32 *p_cur_size,
+                               UINT8 tnf, UINT8 *p_type, UINT8 type_len,
+                               UINT8 *p_id, UINT8 id_len,
+                               tNDEF_SPAN *p_spans, UINT8 num_spans, BOOLEAN b_last)
+{
+    UINT8   *p_rec = p_msg + *p_cur_size;
+    UINT32  payload_len = 0;
+    UINT32  recSize;
+    UINT8   xx;
+
+    if (tnf > NDEF_TNF_RESERVED)
+    {
+        tnf = NDEF_TNF_UNKNOWN;
+        type_len  = 0;
+    }
+
+    for (xx = 0; xx < num_spans; xx++)
+        payload_len += p_spans[xx].len;
+
+    recSize = NDEF_RecGetEncodedSize (type_len, id_len, payload_len);
+
+    if ((*p_cur_size + recSize) > max_size)
+        return (NDEF_MSG_INSUFFICIENT_MEM);
+
+    /* Construct the record header */
+    *p_rec = tnf;
+
+    if (*p_cur_size == 0)
+        *p_rec |= NDEF_MB_MASK;
+
+    if (b_last)
+        *p_rec |= NDEF_ME_MASK;
+
+    if (payload_len < 256)
+        *p_rec |= NDEF_SR_MASK;
+
+    if (id_len != 0)
+        *p_rec |= NDEF_IL_MASK;
+
+    p_rec++;
+
+    /* The next byte is the type field length */
+    *p_rec++ = type_len;
+
+    /* Payload length - can be 1 or 4 bytes */
+    if (payload_len < 256)
+        *p_rec++ = (UINT8)payload_len;
+    else
+        UINT32_TO_BE_STREAM (p_rec, payload_len);
+
+    /* ID field Length (optional) */
+    if (id_len != 0)
+        *p_rec++ = id_len;
+
+    /* Next comes the type */
+    if (p_type)
+        memcpy (p_rec, p_type, type_len);
+    p_rec += type_len;
+
+    /* Next comes the ID */
+    if (p_id)
+        memcpy (p_rec, p_id, id_len);
+    p_rec += id_len;
+
+    /* And lastly the payload, gathered from the spans */
+    for (xx = 0; xx < num_spans; xx++)
+    {
+        if (p_spans[xx].p_data)
+            memcpy (p_rec, p_spans[xx].p_data, p_spans[xx].len);
+        p_rec += p_spans[xx].len;
+    }
+
+    *p_cur_size += recSize;
+
+    return (NDEF_OK);
+}
+
 /*******************************************************************************
 **
 ** Function         NDEF_MsgInsertRec
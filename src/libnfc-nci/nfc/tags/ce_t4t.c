@@ -552,6 +552,148 @@ static void ce_t4t_process_select_app_cmd (UINT8 *p_cmd, BT_HDR *p_c_apdu)
     return;
 }
 
+/*******************************************************************************
+**
+** Function         ce_t4t_set_selected_aid
+**
+** Description      Update selected application for SELECT command answered
+**                  from preloaded R-APDU table, so following C-APDUs are
+**                  forwarded to the same upper layer as if it answered.
+**
+** Returns          none
+**
+*******************************************************************************/
+static void ce_t4t_set_selected_aid (UINT8 aid_len, UINT8 *p_aid)
+{
+    tCE_T4T_MEM *p_t4t = &ce_cb.mem.t4t;
+    UINT8        xx;
+
+    for (xx = 0; xx < CE_T4T_MAX_REG_AID; xx++)
+    {
+        if (  (p_t4t->reg_aid[xx].aid_len > 0)
+            &&(p_t4t->reg_aid[xx].aid_len == aid_len)
+            &&(!(memcmp(p_t4t->reg_aid[xx].aid, p_aid, aid_len)))  )
+        {
+            break;
+        }
+    }
+
+    if ((xx >= CE_T4T_MAX_REG_AID) && (p_t4t->p_wildcard_aid_cback == NULL))
+    {
+        return;
+    }
+
+    p_t4t->status &= ~ (CE_T4T_STATUS_CC_FILE_SELECTED);
+    p_t4t->status &= ~ (CE_T4T_STATUS_NDEF_SELECTED);
+    p_t4t->status &= ~ (CE_T4T_STATUS_T4T_APP_SELECTED);
+    p_t4t->status &= ~ (CE_T4T_STATUS_REG_AID_SELECTED);
+    p_t4t->status &= ~ (CE_T4T_STATUS_WILDCARD_AID_SELECTED);
+
+    p_t4t->selected_aid_idx = xx;
+
+    if (xx < CE_T4T_MAX_REG_AID)
+        p_t4t->status |= CE_T4T_STATUS_REG_AID_SELECTED;
+    else
+        p_t4t->status |= CE_T4T_STATUS_WILDCARD_AID_SELECTED;
+}
+
+/*******************************************************************************
+**
+** Function         ce_t4t_send_apdu_rsp
+**
+** Description      Send preloaded R-APDU if C-APDU is found in the table
+**
+** Returns          TRUE if R-APDU has been sent and C-APDU is freed
+**
+*******************************************************************************/
+static BOOLEAN ce_t4t_send_apdu_rsp (BT_HDR *p_c_apdu, tNFC_STATUS status)
+{
+    tCE_T4T_MEM      *p_t4t = &ce_cb.mem.t4t;
+    tCE_T4T_APDU_RSP *p_entry = NULL;
+    BT_HDR           *p_r_apdu;
+    UINT8            *p_cmd, *p;
+    UINT8             xx, yy;
+
+    /* don't match any part of chained C-APDU */
+    if (status == NFC_STATUS_CONTINUE)
+    {
+        p_t4t->rx_chaining = TRUE;
+        return FALSE;
+    }
+    else if (p_t4t->rx_chaining)
+    {
+        p_t4t->rx_chaining = FALSE;
+        return FALSE;
+    }
+
+    if (p_t4t->num_apdu_rsp == 0)
+        return FALSE;
+
+    p_cmd = (UINT8 *) (p_c_apdu + 1) + p_c_apdu->offset;
+
+    for (xx = 0; xx < p_t4t->num_apdu_rsp; xx++)
+    {
+        if (p_t4t->apdu_rsp[xx].cmd_len != p_c_apdu->len)
+            continue;
+
+        for (yy = 0; yy < p_c_apdu->len; yy++)
+        {
+            if ((p_cmd[yy] ^ p_t4t->apdu_rsp[xx].cmd[yy]) & p_t4t->apdu_rsp[xx].mask[yy])
+                break;
+        }
+
+        if (yy == p_c_apdu->len)
+        {
+            p_entry = &p_t4t->apdu_rsp[xx];
+            break;
+        }
+    }
+
+    if (p_entry == NULL)
+    {
+        GKI_disable ();
+        p_t4t->apdu_rsp_misses++;
+        GKI_enable ();
+        return FALSE;
+    }
+
+    p_r_apdu = (BT_HDR *) GKI_getpoolbuf (NFC_CE_POOL_ID);
+
+    if (!p_r_apdu)
+    {
+        CE_TRACE_ERROR0 ("ce_t4t_send_apdu_rsp (): Cannot allocate buffer");
+        GKI_disable ();
+        p_t4t->apdu_rsp_misses++;
+        GKI_enable ();
+        return FALSE;
+    }
+
+    CE_TRACE_DEBUG1 ("ce_t4t_send_apdu_rsp (): C-APDU found at index %d", xx);
+    GKI_disable ();
+    p_t4t->apdu_rsp_hits++;
+    GKI_enable ();
+
+    p_r_apdu->offset = NCI_MSG_OFFSET_SIZE + NCI_DATA_HDR_SIZE;
+    p = (UINT8 *) (p_r_apdu + 1) + p_r_apdu->offset;
+    memcpy (p, p_entry->p_rsp, p_entry->rsp_len);
+    p_r_apdu->len = p_entry->rsp_len;
+
+    /* CLA, INS, P1, P2, Lc and AID of SELECT by name */
+    if (  (p_c_apdu->len > T4T_CMD_MAX_HDR_SIZE)
+        &&(p_cmd[0] == T4T_CMD_CLASS)
+        &&(p_cmd[1] == T4T_CMD_INS_SELECT)
+        &&(p_cmd[2] == T4T_CMD_P1_SELECT_BY_NAME)
+        &&(p_cmd[4] <= p_c_apdu->len - T4T_CMD_MAX_HDR_SIZE)  )
+    {
+        ce_t4t_set_selected_aid (p_cmd[4], p_cmd + T4T_CMD_MAX_HDR_SIZE);
+    }
+
+    GKI_freebuf (p_c_apdu);
+    ce_t4t_send_to_lower (p_r_apdu);
+
+    return TRUE;
+}
+
 /*******************************************************************************
 **
 ** Function         ce_t4t_process_timeout
@@ -621,6 +763,12 @@ static void ce_t4t_data_cback (UINT8 conn_id, tNFC_CONN_EVT event, tNFC_CONN *p_
 
     CE_TRACE_DEBUG1 ("ce_t4t_data_cback (): conn_id = 0x%02X", conn_id);
 
+    /* answer static C-APDU without upper layer */
+    if (ce_t4t_send_apdu_rsp (p_c_apdu, p_data->data.status))
+    {
+        return;
+    }
+
     p_cmd = (UINT8 *) (p_c_apdu + 1) + p_c_apdu->offset;
 
     /* Class Byte */
@@ -831,6 +979,12 @@ tNFC_STATUS ce_select_t4t (void)
     /* clear other than read-only flag */
     p_t4t->status &= CE_T4T_STATUS_NDEF_FILE_READ_ONLY;
 
+    p_t4t->rx_chaining     = FALSE;
+    GKI_disable ();
+    p_t4t->apdu_rsp_hits   = 0;
+    p_t4t->apdu_rsp_misses = 0;
+    GKI_enable ();
+
     NFC_SetStaticRfCback (ce_t4t_data_cback);
 
     return NFC_STATUS_OK;
@@ -1056,6 +1210,115 @@ NFC_API extern void CE_T4tDeregisterAID (tCE_T4T_AID_HANDLE aid_handle)
     }
 }
 
+/*******************************************************************************
+**
+** Function         CE_T4tAddApduResponse
+**
+** Description      Add a R-APDU which CE T4T sends without forwarding the
+**                  matching C-APDU to upper layer.
+**
+**                  cmd_len: length of C-APDU (up to CE_T4T_MAX_APDU_RSP_CMD_LEN)
+**                  p_cmd:   C-APDU
+**                  p_mask:  bits of C-APDU to compare, NULL to compare all
+**                  rsp_len: length of R-APDU including status words
+**                  p_rsp:   R-APDU
+**
+** Returns          NFC_STATUS_OK if success
+**
+*******************************************************************************/
+tNFC_STATUS CE_T4tAddApduResponse (UINT8   cmd_len,
+                                   UINT8  *p_cmd,
+                                   UINT8  *p_mask,
+                                   UINT16  rsp_len,
+                                   UINT8  *p_rsp)
+{
+    tCE_T4T_MEM      *p_t4t = &ce_cb.mem.t4t;
+    tCE_T4T_APDU_RSP *p_entry;
+
+    CE_TRACE_API2 ("CE_T4tAddApduResponse () cmd_len:%d, rsp_len:%d", cmd_len, rsp_len);
+
+    if (  (cmd_len == 0)
+        ||(cmd_len > CE_T4T_MAX_APDU_RSP_CMD_LEN)
+        ||(rsp_len < T4T_RSP_STATUS_WORDS_SIZE)
+        ||(rsp_len > CE_T4T_MAX_LE + T4T_RSP_STATUS_WORDS_SIZE)  )
+    {
+        CE_TRACE_ERROR0 ("CE_T4tAddApduResponse (): Invalid length");
+        return NFC_STATUS_INVALID_PARAM;
+    }
+
+    if (p_t4t->num_apdu_rsp >= CE_T4T_MAX_APDU_RSP)
+    {
+        CE_TRACE_ERROR0 ("CE_T4tAddApduResponse (): No resource");
+        return NFC_STATUS_NO_BUFFERS;
+    }
+
+    p_entry = &p_t4t->apdu_rsp[p_t4t->num_apdu_rsp];
+
+    if ((p_entry->p_rsp = (UINT8 *) GKI_getbuf (rsp_len)) == NULL)
+    {
+        CE_TRACE_ERROR0 ("CE_T4tAddApduResponse (): Cannot allocate buffer");
+        return NFC_STATUS_NO_BUFFERS;
+    }
+
+    p_entry->cmd_len = cmd_len;
+    memcpy (p_entry->cmd, p_cmd, cmd_len);
+
+    if (p_mask)
+        memcpy (p_entry->mask, p_mask, cmd_len);
+    else
+        memset (p_entry->mask, 0xFF, cmd_len);
+
+    p_entry->rsp_len = rsp_len;
+    memcpy (p_entry->p_rsp, p_rsp, rsp_len);
+
+    p_t4t->num_apdu_rsp++;
+
+    return NFC_STATUS_OK;
+}
+
+/*******************************************************************************
+**
+** Function         CE_T4tClearApduResponses
+**
+** Description      Remove all of R-APDUs added by CE_T4tAddApduResponse ()
+**
+** Returns          None
+**
+*******************************************************************************/
+void CE_T4tClearApduResponses (void)
+{
+    tCE_T4T_MEM *p_t4t = &ce_cb.mem.t4t;
+    UINT8        xx;
+
+    CE_TRACE_API1 ("CE_T4tClearApduResponses () %d entries", p_t4t->num_apdu_rsp);
+
+    for (xx = 0; xx < p_t4t->num_apdu_rsp; xx++)
+    {
+        GKI_freebuf (p_t4t->apdu_rsp[xx].p_rsp);
+        p_t4t->apdu_rsp[xx].p_rsp = NULL;
+    }
+    p_t4t->num_apdu_rsp = 0;
+}
+
+/*******************************************************************************
+**
+** Function         CE_T4tGetApduResponseStats
+**
+** Description      Get number of C-APDUs answered and not answered from the
+**                  R-APDU table since activation.
+**
+** Returns          None
+**
+*******************************************************************************/
+void CE_T4tGetApduResponseStats (UINT32 *p_hits, UINT32 *p_misses)
+{
+    /* counters are updated by the NFC task; take a consistent snapshot */
+    GKI_disable ();
+    *p_hits   = ce_cb.mem.t4t.apdu_rsp_hits;
+    *p_misses = ce_cb.mem.t4t.apdu_rsp_misses;
+    GKI_enable ();
+}
+
 /*******************************************************************************
 **
 ** Function         CE_T4TTestSetCC
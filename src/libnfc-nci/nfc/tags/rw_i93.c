@@ -74,7 +74,8 @@ enum
     RW_I93_STATE_FORMAT,                /* performing format procedure          */
     RW_I93_STATE_SET_READ_ONLY,         /* performing set read-only procedure   */
 
-    RW_I93_STATE_PRESENCE_CHECK         /* checking presence of tag             */
+    RW_I93_STATE_PRESENCE_CHECK,        /* checking presence of tag             */
+    RW_I93_STATE_INVENTORY_ALL          /* collecting UIDs of all VICCs         */
 };
 
 /* sub state */
@@ -108,6 +109,7 @@ static char *rw_i93_get_tag_name (UINT8 product_version);
 static void rw_i93_data_cback (UINT8 conn_id, tNFC_CONN_EVT event, tNFC_CONN *p_data);
 void rw_i93_handle_error (tNFC_STATUS status);
 tNFC_STATUS rw_i93_send_cmd_get_sys_info (UINT8 *p_uid, UINT8 extra_flag);
+tNFC_STATUS rw_i93_get_next_blocks (UINT16 offset);
 
 /*******************************************************************************
 **
@@ -614,6 +616,81 @@ tNFC_STATUS rw_i93_send_cmd_inventory (UINT8 *p_uid, BOOLEAN including_afi, UINT
     }
 }
 
+/*******************************************************************************
+**
+** Function         rw_i93_send_cmd_inventory_mask
+**
+** Description      Send 1 slot Inventory Request with mask to VICCs
+**                  p_mask[0] holds the least significant bits of the UID
+**
+** Returns          tNFC_STATUS
+**
+*******************************************************************************/
+static tNFC_STATUS rw_i93_send_cmd_inventory_mask (UINT8 mask_len, UINT8 *p_mask)
+{
+    tRW_I93_CB  *p_i93 = &rw_cb.tcb.i93;
+    BT_HDR      *p_cmd;
+    UINT8       *p, flags;
+    UINT8       mask_bytes = (mask_len + 7) / 8;
+
+    RW_TRACE_DEBUG1 ("rw_i93_send_cmd_inventory_mask () mask_len:%d", mask_len);
+
+    p_cmd = (BT_HDR *) GKI_getpoolbuf (NFC_RW_POOL_ID);
+
+    if (!p_cmd)
+    {
+        RW_TRACE_ERROR0 ("rw_i93_send_cmd_inventory_mask (): Cannot allocate buffer");
+        return NFC_STATUS_NO_BUFFERS;
+    }
+
+    p_cmd->offset = NCI_MSG_OFFSET_SIZE + NCI_DATA_HDR_SIZE;
+    p_cmd->len    = 3 + mask_bytes;
+    p = (UINT8 *) (p_cmd + 1) + p_cmd->offset;
+
+    /* Flags */
+    flags = (I93_FLAG_SLOT_ONE | I93_FLAG_INVENTORY_SET | RW_I93_FLAG_SUB_CARRIER | RW_I93_FLAG_DATA_RATE);
+    if (p_i93->inv_afi_present)
+    {
+        flags |= I93_FLAG_AFI_PRESENT;
+    }
+
+    UINT8_TO_STREAM (p, flags);
+
+    /* Command Code */
+    UINT8_TO_STREAM (p, I93_CMD_INVENTORY);
+
+    if (p_i93->inv_afi_present)
+    {
+        /* Parameters */
+        UINT8_TO_STREAM (p, p_i93->inv_afi);    /* Optional AFI */
+        p_cmd->len++;
+    }
+
+    UINT8_TO_STREAM (p, mask_len);              /* Mask Length */
+    ARRAY_TO_STREAM (p, p_mask, mask_bytes);    /* Mask Value  */
+
+    if (!rw_i93_send_to_lower (p_cmd))
+    {
+        return NFC_STATUS_FAILED;
+    }
+
+    p_i93->sent_cmd = I93_CMD_INVENTORY;
+
+    /* a collision or an empty slot is the answer, retrying doesn't help */
+    if (p_i93->p_retry_cmd)
+    {
+        GKI_freebuf (p_i93->p_retry_cmd);
+        p_i93->p_retry_cmd = NULL;
+    }
+
+    /* most slots are empty, don't wait the full response timeout */
+    nfc_stop_quick_timer (&p_i93->timer);
+    nfc_start_quick_timer (&p_i93->timer, NFC_TTYPE_RW_I93_RESPONSE,
+                           (RW_I93_INVENTORY_TOUT_RESP*QUICK_TIMER_TICKS_PER_SEC)/1000);
+
+    return NFC_STATUS_OK;
+}
+
 /*******************************************************************************
 **
 ** Function         rw_i93_send_cmd_stay_quiet
@@ -1404,11 +1481,153 @@ tNFC_STATUS rw_i93_send_cmd_get_multi_block_sec (UINT16 first_block_number,
     }
 }
 
+/*******************************************************************************
+**
+** Function         rw_i93_is_stm_sector_tag
+**
+** Description      Check if tag limits Read Multiple Blocks to one sector
+**
+** Returns          TRUE if LRIS64K, M24LR64-R, M24LR04E-R, M24LR16E-R, M24LR64E-R
+**
+*******************************************************************************/
+static BOOLEAN rw_i93_is_stm_sector_tag (void)
+{
+    tRW_I93_CB *p_i93 = &rw_cb.tcb.i93;
+
+    return (  (p_i93->uid[1] == I93_UID_IC_MFG_CODE_STM)
+            &&(  (p_i93->product_version == RW_I93_STM_LRIS64K)
+               ||(p_i93->product_version == RW_I93_STM_M24LR64_R)
+               ||(p_i93->product_version == RW_I93_STM_M24LR04E_R)
+               ||(p_i93->product_version == RW_I93_STM_M24LR16E_R)
+               ||(p_i93->product_version == RW_I93_STM_M24LR64E_R)  )  );
+}
+
+/*******************************************************************************
+**
+** Function         rw_i93_init_read_multi_blocks
+**
+** Description      Set the initial and the maximum number of blocks per Read
+**                  Multiple Blocks command for the activated tag.
+**
+**                  The maximum is limited by the tag and by the NCI data packet
+**                  size of the RF connection, so that the response is received
+**                  without fragmentation. Reading starts with
+**                  RW_I93_READ_MULTI_BLOCK_SIZE bytes and grows up to the
+**                  maximum while the tag keeps responding.
+**
+** Returns          void
+**
+*******************************************************************************/
+static void rw_i93_init_read_multi_blocks (void)
+{
+    tRW_I93_CB *p_i93 = &rw_cb.tcb.i93;
+    tNFC_CONN_CB *p_cb = &nfc_cb.conn_cb[NFC_RF_CONN_ID];
+    UINT16      max_bytes;
+    UINT16      max_blocks;
+
+    /* response has one byte of flags before the block data */
+    if (p_cb->buff_size > 1)
+        max_bytes = p_cb->buff_size - 1;
+    else
+        max_bytes = RW_I93_READ_MULTI_BLOCK_SIZE;
+
+    max_blocks = max_bytes / p_i93->block_size;
+
+    /* number of blocks is coded in one byte */
+    if (max_blocks > I93_MAX_BLOCKS_PER_READ)
+        max_blocks = I93_MAX_BLOCKS_PER_READ;
+
+    if (  (rw_i93_is_stm_sector_tag ())
+        &&(max_blocks > I93_STM_MAX_BLOCKS_PER_READ)  )
+    {
+        max_blocks = I93_STM_MAX_BLOCKS_PER_READ;
+    }
+
+    if (max_blocks == 0)
+        max_blocks = 1;
+
+    p_i93->mb_read_max_blocks = max_blocks;
+    p_i93->mb_read_blocks     = RW_I93_READ_MULTI_BLOCK_SIZE / p_i93->block_size;
+    p_i93->mb_read_success    = 0;
+
+    if (p_i93->mb_read_blocks > max_blocks)
+        p_i93->mb_read_blocks = max_blocks;
+
+    RW_TRACE_DEBUG2 ("rw_i93_init_read_multi_blocks (): blocks:%d, max blocks:%d",
+                      p_i93->mb_read_blocks, p_i93->mb_read_max_blocks);
+}
+
+/*******************************************************************************
+**
+** Function         rw_i93_update_read_multi_blocks
+**
+** Description      Adjust number of blocks per Read Multiple Blocks command
+**                  after response to it is received during NDEF operation.
+**
+**                  After RW_I93_READ_MULTI_BLOCK_GROW_COUNT consecutive full
+**                  size reads the number of blocks is doubled. On error, the
+**                  number of blocks is halved, the tag limit is lowered to it
+**                  and the same offset is read again.
+**
+** Returns          TRUE if smaller read has been sent in place of the response
+**
+*******************************************************************************/
+static BOOLEAN rw_i93_update_read_multi_blocks (BOOLEAN success)
+{
+    tRW_I93_CB *p_i93 = &rw_cb.tcb.i93;
+
+    if (  (p_i93->sent_cmd != I93_CMD_READ_MULTI_BLOCK)
+        ||(p_i93->mb_read_blocks == 0)
+        ||(  (p_i93->state != RW_I93_STATE_DETECT_NDEF)
+           &&(p_i93->state != RW_I93_STATE_READ_NDEF)  )  )
+    {
+        return FALSE;
+    }
+
+    if (success)
+    {
+        if (p_i93->mb_read_sent_blocks >= p_i93->mb_read_blocks)
+        {
+            if (  (++p_i93->mb_read_success >= RW_I93_READ_MULTI_BLOCK_GROW_COUNT)
+                &&(p_i93->mb_read_blocks < p_i93->mb_read_max_blocks)  )
+            {
+                p_i93->mb_read_blocks *= 2;
+                if (p_i93->mb_read_blocks > p_i93->mb_read_max_blocks)
+                    p_i93->mb_read_blocks = p_i93->mb_read_max_blocks;
+
+                p_i93->mb_read_success = 0;
+                RW_TRACE_DEBUG1 ("rw_i93_update_read_multi_blocks (): grow to %d blocks", p_i93->mb_read_blocks);
+            }
+        }
+        return FALSE;
+    }
+
+    if (p_i93->mb_read_sent_blocks <= 1)
+        return FALSE;
+
+    p_i93->mb_read_blocks     = p_i93->mb_read_sent_blocks / 2;
+    p_i93->mb_read_max_blocks = p_i93->mb_read_blocks;
+    p_i93->mb_read_success    = 0;
+
+    RW_TRACE_DEBUG1 ("rw_i93_update_read_multi_blocks (): shrink to %d blocks", p_i93->mb_read_blocks);
+
+    if (p_i93->p_retry_cmd)
+    {
+        GKI_freebuf (p_i93->p_retry_cmd);
+        p_i93->p_retry_cmd = NULL;
+    }
+    p_i93->retry_count = 0;
+
+    return (rw_i93_get_next_blocks (p_i93->rw_offset) == NFC_STATUS_OK);
+}
+
 /*******************************************************************************
 **
 ** Function         rw_i93_get_next_blocks
 **
-** Description      Read as many blocks as possible (up to RW_I93_READ_MULTI_BLOCK_SIZE)
+** Description      Read as many blocks as possible. The number of blocks per
+**                  Read Multiple Blocks command adapts to the tag, see
+**                  rw_i93_update_read_multi_blocks ()
 **
 ** Returns          tNFC_STATUS
 **
@@ -1427,34 +1646,27 @@ tNFC_STATUS rw_i93_get_next_blocks (UINT16 offset)
 
     if (p_i93->intl_flags & RW_I93_FLAG_READ_MULTI_BLOCK)
     {
-        num_block = RW_I93_READ_MULTI_BLOCK_SIZE / p_i93->block_size;
+        if (p_i93->mb_read_blocks == 0)
+            rw_i93_init_read_multi_blocks ();
+
+        num_block = p_i93->mb_read_blocks;
 
         if (num_block + first_block > p_i93->num_block)
             num_block = p_i93->num_block - first_block;
 
-        if (p_i93->uid[1] == I93_UID_IC_MFG_CODE_STM)
+        /* LRIS64K, M24LR64-R, M24LR04E-R, M24LR16E-R, M24LR64E-R requires
+        **      The max number of blocks is 32 and they are all located in the same sector.
+        **      The sector is 32 blocks of 4 bytes.
+        */
+        if (  (rw_i93_is_stm_sector_tag ())
+            &&((first_block / I93_STM_BLOCKS_PER_SECTOR)
+               != ((first_block + num_block - 1) / I93_STM_BLOCKS_PER_SECTOR))  )
         {
-            /* LRIS64K, M24LR64-R, M24LR04E-R, M24LR16E-R, M24LR64E-R requires
-            **      The max number of blocks is 32 and they are all located in the same sector.
-            **      The sector is 32 blocks of 4 bytes.
-            */
-            if (  (p_i93->product_version == RW_I93_STM_LRIS64K)
-                ||(p_i93->product_version == RW_I93_STM_M24LR64_R)
-                ||(p_i93->product_version == RW_I93_STM_M24LR04E_R)
-                ||(p_i93->product_version == RW_I93_STM_M24LR16E_R)
-                ||(p_i93->product_version == RW_I93_STM_M24LR64E_R)  )
-            {
-                if (num_block > I93_STM_MAX_BLOCKS_PER_READ)
-                    num_block = I93_STM_MAX_BLOCKS_PER_READ;
-
-                if ((first_block / I93_STM_BLOCKS_PER_SECTOR)
-                    != ((first_block + num_block - 1) / I93_STM_BLOCKS_PER_SECTOR))
-                {
-                    num_block = I93_STM_BLOCKS_PER_SECTOR - (first_block % I93_STM_BLOCKS_PER_SECTOR);
-                }
-            }
+            num_block = I93_STM_BLOCKS_PER_SECTOR - (first_block % I93_STM_BLOCKS_PER_SECTOR);
         }
 
+        p_i93->mb_read_sent_blocks = num_block;
+
         return rw_i93_send_cmd_read_multi_blocks (first_block, num_block);
     }
     else
@@ -2041,6 +2253,13 @@ void rw_i93_sm_read_ndef (BT_HDR *p_resp)
 
         (*(rw_cb.p_cback)) (RW_I93_NDEF_READ_EVT, &rw_data);
 
+        /* upper layer may have stopped reading in the callback */
+        if (p_i93->state != RW_I93_STATE_READ_NDEF)
+        {
+            RW_TRACE_DEBUG0 ("NDEF read stopped by upper layer");
+            return;
+        }
+
         /* this will make read data from next block */
         p_i93->rw_offset += length;
 
@@ -2897,6 +3116,99 @@ void rw_i93_sm_set_read_only (BT_HDR *p_resp)
     }
 }
 
+/*******************************************************************************
+**
+** Function         rw_i93_sm_inventory_all
+**
+** Description      Process the answer to a 1 slot Inventory during the search
+**                  of all VICCs. A valid response yields one UID, a collision
+**                  splits the mask on the next UID bit, and no response means
+**                  no VICC matches the mask.
+**
+** Returns          void
+**
+*******************************************************************************/
+static void rw_i93_sm_inventory_all (BT_HDR *p_resp, tNFC_STATUS status)
+{
+    tRW_I93_CB *p_i93 = &rw_cb.tcb.i93;
+    tRW_DATA    rw_data;
+    UINT8      *p;
+    UINT8       bit;
+
+    if (  (p_resp)
+        &&(status == NFC_STATUS_OK)
+        &&(p_resp->len >= 2 + I93_UID_BYTE_LEN)
+        &&(!(*((UINT8 *) (p_resp + 1) + p_resp->offset) & I93_FLAG_ERROR_DETECTED))  )
+    {
+        /* Flags, DSFID, UID */
+        p = (UINT8 *) (p_resp + 1) + p_resp->offset + 2;
+
+        if (p_i93->inv_num_uids < RW_I93_MAX_INVENTORY_UIDS)
+        {
+            STREAM_TO_ARRAY8 (p_i93->inv_uids[p_i93->inv_num_uids], p);
+            p_i93->inv_num_uids++;
+        }
+        else
+        {
+            p_i93->inv_overflow = TRUE;
+        }
+    }
+    else if (  (status != NFC_STATUS_TIMEOUT)
+             &&(p_i93->inv_mask_len < I93_UID_BYTE_LEN * 8)  )
+    {
+        /* collision; search mask + '0' now and mask + '1' later */
+        bit = p_i93->inv_mask_len;
+
+        memcpy (p_i93->inv_stack_mask[p_i93->inv_depth], p_i93->inv_mask, I93_UID_BYTE_LEN);
+        p_i93->inv_stack_mask[p_i93->inv_depth][bit / 8] |= (UINT8) (1 << (bit % 8));
+        p_i93->inv_stack_len[p_i93->inv_depth] = bit + 1;
+        p_i93->inv_depth++;
+
+        p_i93->inv_mask[bit / 8] &= (UINT8) ~(1 << (bit % 8));
+        p_i93->inv_mask_len = bit + 1;
+
+        if (rw_i93_send_cmd_inventory_mask (p_i93->inv_mask_len, p_i93->inv_mask) == NFC_STATUS_OK)
+        {
+            return;
+        }
+        status = NFC_STATUS_FAILED;
+    }
+
+    if (status != NFC_STATUS_FAILED)
+    {
+        status = NFC_STATUS_OK;
+
+        if ((p_i93->inv_depth > 0) && (!p_i93->inv_overflow))
+        {
+            p_i93->inv_depth--;
+            p_i93->inv_mask_len = p_i93->inv_stack_len[p_i93->inv_depth];
+            memcpy (p_i93->inv_mask, p_i93->inv_stack_mask[p_i93->inv_depth], I93_UID_BYTE_LEN);
+
+            if (rw_i93_send_cmd_inventory_mask (p_i93->inv_mask_len, p_i93->inv_mask) == NFC_STATUS_OK)
+            {
+                return;
+            }
+            status = NFC_STATUS_FAILED;
+        }
+    }
+
+    RW_TRACE_DEBUG3 ("rw_i93_sm_inventory_all (): status:0x%02X, found %d UIDs, overflow:%d",
+                      status, p_i93->inv_num_uids, p_i93->inv_overflow);
+
+    p_i93->state    = RW_I93_STATE_IDLE;
+    p_i93->sent_cmd = 0;
+
+    rw_data.i93_inventory_all.status   = status;
+    rw_data.i93_inventory_all.num_uids = p_i93->inv_num_uids;
+    rw_data.i93_inventory_all.overflow = p_i93->inv_overflow;
+    rw_data.i93_inventory_all.p_uids   = &p_i93->inv_uids[0][0];
+
+    if (rw_cb.p_cback)
+    {
+        (*(rw_cb.p_cback)) (RW_I93_INVENTORY_ALL_EVT, &rw_data);
+    }
+}
+
 /*******************************************************************************
 **
 ** Function         rw_i93_handle_error
@@ -2917,6 +3229,13 @@ void rw_i93_handle_error (tNFC_STATUS status)
 
     nfc_stop_quick_timer (&p_i93->timer);
 
+    if (p_i93->state == RW_I93_STATE_INVENTORY_ALL)
+    {
+        /* collision or empty slot, keep searching */
+        rw_i93_sm_inventory_all (NULL, status);
+        return;
+    }
+
     if (rw_cb.p_cback)
     {
         rw_data.status = status;
@@ -3014,6 +3333,12 @@ void rw_i93_process_timeout (TIMER_LIST_ENT *p_tle)
 
     if (p_tle->event == NFC_TTYPE_RW_I93_RESPONSE)
     {
+        /* tag may not be able to send that many blocks, read less */
+        if (rw_i93_update_read_multi_blocks (FALSE))
+        {
+            return;
+        }
+
         if (  (rw_cb.tcb.i93.retry_count < RW_MAX_RETRIES)
             &&(rw_cb.tcb.i93.p_retry_cmd)
             &&(rw_cb.tcb.i93.sent_cmd != I93_CMD_STAY_QUIET))
@@ -3073,6 +3398,11 @@ static void rw_i93_data_cback (UINT8 conn_id, tNFC_CONN_EVT event, tNFC_CONN *p_
 
         if (event == NFC_ERROR_CEVT)
         {
+            if (rw_i93_update_read_multi_blocks (FALSE))
+            {
+                return;
+            }
+
             if (  (p_i93->retry_count < RW_MAX_RETRIES)
                 &&(p_i93->p_retry_cmd)  )
             {
@@ -3143,6 +3473,14 @@ static void rw_i93_data_cback (UINT8 conn_id, tNFC_CONN_EVT event, tNFC_CONN *p_
     RW_TRACE_DEBUG1 ("RW I93 state: %d", p_i93->state);
 #endif
 
+    if (  (p_resp->len)
+        &&(rw_i93_update_read_multi_blocks (!(*((UINT8 *) (p_resp + 1) + p_resp->offset) & I93_FLAG_ERROR_DETECTED)))  )
+    {
+        /* smaller read has been sent */
+        GKI_freebuf (p_resp);
+        return;
+    }
+
     switch (p_i93->state)
     {
     case RW_I93_STATE_IDLE:
@@ -3192,6 +3530,11 @@ static void rw_i93_data_cback (UINT8 conn_id, tNFC_CONN_EVT event, tNFC_CONN *p_
         GKI_freebuf (p_resp);
         break;
 
+    case RW_I93_STATE_INVENTORY_ALL:
+        rw_i93_sm_inventory_all (p_resp, p_data->data.status);
+        GKI_freebuf (p_resp);
+        break;
+
     case RW_I93_STATE_PRESENCE_CHECK:
         p_i93->state    = RW_I93_STATE_IDLE;
         p_i93->sent_cmd = 0;
@@ -3237,6 +3580,7 @@ tNFC_STATUS rw_i93_select (UINT8 *p_uid)
     NFC_SetStaticRfCback (rw_i93_data_cback);
 
     p_i93->state = RW_I93_STATE_IDLE;
+    p_i93->mb_read_blocks = 0;
 
     /* convert UID to big endian format - MSB(0xE0) in first byte */
     p = uid;
@@ -3285,6 +3629,54 @@ tNFC_STATUS RW_I93Inventory (BOOLEAN including_afi, UINT8 afi, UINT8 *p_uid)
     return (status);
 }
 
+/*******************************************************************************
+**
+** Function         RW_I93InventoryAll
+**
+** Description      This function collects the UIDs of all VICCs in the field
+**                  with/without AFI, using 1 slot Inventory commands with a
+**                  growing mask to resolve collisions
+**
+**                  RW_I93_INVENTORY_ALL_EVT will be returned
+**
+** Returns          NFC_STATUS_OK if success
+**                  NFC_STATUS_NO_BUFFERS if out of buffer
+**                  NFC_STATUS_BUSY if busy
+**                  NFC_STATUS_FAILED if other error
+**
+*******************************************************************************/
+tNFC_STATUS RW_I93InventoryAll (BOOLEAN including_afi, UINT8 afi)
+{
+    tRW_I93_CB  *p_i93 = &rw_cb.tcb.i93;
+    tNFC_STATUS status;
+
+    RW_TRACE_API2 ("RW_I93InventoryAll (), including_afi:%d, AFI:0x%02X", including_afi, afi);
+
+    if (p_i93->state != RW_I93_STATE_IDLE)
+    {
+        RW_TRACE_ERROR1 ("RW_I93InventoryAll ():Unable to start command at state (0x%X)",
+                          p_i93->state);
+        return NFC_STATUS_BUSY;
+    }
+
+    p_i93->inv_afi_present = including_afi;
+    p_i93->inv_afi         = afi;
+    p_i93->inv_mask_len    = 0;
+    p_i93->inv_depth       = 0;
+    p_i93->inv_num_uids    = 0;
+    p_i93->inv_overflow    = FALSE;
+    memset (p_i93->inv_mask, 0, I93_UID_BYTE_LEN);
+
+    status = rw_i93_send_cmd_inventory_mask (0, p_i93->inv_mask);
+
+    if (status == NFC_STATUS_OK)
+    {
+        p_i93->state = RW_I93_STATE_INVENTORY_ALL;
+    }
+
+    return (status);
+}
+
 /*******************************************************************************
 **
 ** Function         RW_I93StayQuiet
@@ -3938,6 +4330,36 @@ tNFC_STATUS RW_I93ReadNDef (void)
     return NFC_STATUS_OK;
 }
 
+/*******************************************************************************
+**
+** Function         RW_I93StopNDefRead
+**
+** Description      This function stops the NDEF read procedure after the
+**                  current segment. It must be called from the callback of
+**                  RW_I93_NDEF_READ_EVT; no further read command is sent and
+**                  no more event is returned for this read.
+**
+** Returns          NFC_STATUS_OK if success
+**                  NFC_STATUS_FAILED if I93 is not reading NDEF
+**
+*******************************************************************************/
+tNFC_STATUS RW_I93StopNDefRead (void)
+{
+    RW_TRACE_API0 ("RW_I93StopNDefRead ()");
+
+    if (rw_cb.tcb.i93.state != RW_I93_STATE_READ_NDEF)
+    {
+        RW_TRACE_ERROR1 ("RW_I93StopNDefRead ():Not reading NDEF, state (0x%X)",
+                          rw_cb.tcb.i93.state);
+        return NFC_STATUS_FAILED;
+    }
+
+    rw_cb.tcb.i93.state    = RW_I93_STATE_IDLE;
+    rw_cb.tcb.i93.sent_cmd = 0;
+
+    return NFC_STATUS_OK;
+}
+
 /*******************************************************************************
 **
 ** Function         RW_I93UpdateNDef
@@ -4203,6 +4625,8 @@ static char *rw_i93_get_state_name (UINT8 state)
 
     case RW_I93_STATE_PRESENCE_CHECK:
         return ("PRESENCE_CHECK");
+    case RW_I93_STATE_INVENTORY_ALL:
+        return ("INVENTORY_ALL");
     default:
         return ("???? UNKNOWN STATE");
     }
@@ -87,6 +87,7 @@ static void rw_t2t_proc_data (UINT8 conn_id, tNFC_DATA_CEVT *p_data)
     tRW_READ_DATA           evt_data = {0};
     tT2T_CMD_RSP_INFO       *p_cmd_rsp_info = (tT2T_CMD_RSP_INFO *) rw_cb.tcb.t2t.p_cmd_rsp_info;
     tRW_DETECT_NDEF_DATA    ndef_data;
+    UINT8                   rsp_len;
 #if (BT_TRACE_VERBOSE == TRUE)
     UINT8                   begin_state     = p_t2t->state;
 #endif
@@ -114,7 +115,13 @@ static void rw_t2t_proc_data (UINT8 conn_id, tNFC_DATA_CEVT *p_data)
 
     RW_TRACE_EVENT2 ("RW RECV [%s]:0x%x RSP", t2t_info_to_str (p_cmd_rsp_info), p_cmd_rsp_info->opcode);
 
-    if (  (  (p_pkt->len != p_cmd_rsp_info->rsp_len)
+    /* FAST_READ response length depends on the number of blocks requested */
+    if (p_cmd_rsp_info->opcode == T2T_CMD_FAST_READ)
+        rsp_len = p_t2t->read_rsp_len;
+    else
+        rsp_len = p_cmd_rsp_info->rsp_len;
+
+    if (  (  (p_pkt->len != rsp_len)
            &&(p_pkt->len != p_cmd_rsp_info->nack_rsp_len)
            &&(p_t2t->substate != RW_T2T_SUBSTATE_WAIT_SELECT_SECTOR)  )
         ||(p_t2t->state == RW_T2T_STATE_HALT)  )
@@ -164,7 +171,21 @@ static void rw_t2t_proc_data (UINT8 conn_id, tNFC_DATA_CEVT *p_data)
     {
         evt_data.status = NFC_STATUS_FAILED;
     }
-    else if (  (p_pkt->len != p_cmd_rsp_info->rsp_len)
+    else if (  (p_pkt->len != rsp_len)
+             &&(p_cmd_rsp_info->opcode == T2T_CMD_FAST_READ)  )
+    {
+        /* Tag does not support FAST_READ. The NACK put it to HALT state, so a READ
+         * would only time out; fail this operation and use READ with this tag from
+         * now on, also after it is activated again */
+        RW_TRACE_EVENT1 ("rw_t2t_proc_data - FAST_READ rejected (0x%x), tag halted", (*p & 0x0f));
+        b_notify                = FALSE;
+        p_t2t->b_no_fast_read   = TRUE;
+        memcpy (rw_cb.t2t_no_fast_read_uid, p_t2t->tag_hdr, RW_T2T_HDR_UID_LEN);
+        p_t2t->check_tag_halt   = TRUE;
+        rw_t2t_process_error ();
+        p_t2t->check_tag_halt   = FALSE;
+    }
+    else if (  (p_pkt->len != rsp_len)
              ||((p_cmd_rsp_info->opcode == T2T_CMD_WRITE) && ((*p & 0x0f) != T2T_RSP_ACK))  )
     {
         /* Received NACK response */
@@ -791,6 +812,7 @@ tNFC_STATUS rw_t2t_read (UINT16 block)
 
 
     read_cmd[0] = block % T2T_BLOCKS_PER_SECTOR;
+    p_t2t->read_rsp_len = T2T_READ_DATA_LEN;
     if (p_t2t->sector != block/T2T_BLOCKS_PER_SECTOR)
     {
         sector_byte2[0] = 0xFF;
@@ -825,6 +847,65 @@ tNFC_STATUS rw_t2t_read (UINT16 block)
     return status;
 }
 
+/*******************************************************************************
+**
+** Function         rw_t2t_fast_read
+**
+** Description      This function issues Type 2 Tag FAST_READ command to read
+**                  num_blocks blocks starting from the specified block in one
+**                  frame. READ command is used instead if the tag is not known
+**                  to support FAST_READ, if it rejected FAST_READ earlier, if
+**                  a sector change is needed or if not more than T2T_READ_BLOCKS
+**                  blocks are requested. The range is clipped to the current
+**                  sector and to RW_T2T_FAST_READ_MAX_BLOCKS.
+**
+** Returns          tNFC_STATUS
+**
+*******************************************************************************/
+tNFC_STATUS rw_t2t_fast_read (UINT16 block, UINT16 num_blocks)
+{
+    tNFC_STATUS status;
+    tRW_T2T_CB  *p_t2t = &rw_cb.tcb.t2t;
+    UINT8       read_cmd[2];
+    UINT16      sector_end;
+
+    /* Ultralight and Ultralight C do not support FAST_READ, and NACK puts the tag
+     * to HALT, so only try it on other NXP tags */
+    if (  (p_t2t->b_no_fast_read)
+        ||(!p_t2t->b_read_hdr)
+        ||(memcmp (p_t2t->tag_hdr, rw_cb.t2t_no_fast_read_uid, RW_T2T_HDR_UID_LEN) == 0)
+        ||(p_t2t->tag_hdr[0] != TAG_MIFARE_MID)
+        ||(p_t2t->tag_hdr[T2T_CC2_TMS_BYTE] == T2T_CC2_TMS_MUL)
+        ||(p_t2t->tag_hdr[T2T_CC2_TMS_BYTE] == T2T_CC2_TMS_MULC)
+        ||(p_t2t->sector != block/T2T_BLOCKS_PER_SECTOR)  )
+    {
+        return (rw_t2t_read (block));
+    }
+
+    if (num_blocks > RW_T2T_FAST_READ_MAX_BLOCKS)
+        num_blocks = RW_T2T_FAST_READ_MAX_BLOCKS;
+
+    sector_end = (UINT16) ((block / T2T_BLOCKS_PER_SECTOR + 1) * T2T_BLOCKS_PER_SECTOR);
+    if (block + num_blocks > sector_end)
+        num_blocks = (UINT16) (sector_end - block);
+
+    if (num_blocks <= T2T_READ_BLOCKS)
+        return (rw_t2t_read (block));
+
+    read_cmd[0] = (UINT8) (block % T2T_BLOCKS_PER_SECTOR);
+    read_cmd[1] = (UINT8) ((block + num_blocks - 1) % T2T_BLOCKS_PER_SECTOR);
+
+    p_t2t->read_rsp_len = (UINT8) (num_blocks * T2T_BLOCK_LEN);
+
+    if ((status = rw_t2t_send_cmd (T2T_CMD_FAST_READ, read_cmd)) == NFC_STATUS_OK)
+    {
+        p_t2t->block_read = block;
+        RW_TRACE_EVENT2 ("rw_t2t_fast_read Sent Command for Blocks: %u - %u", block, block + num_blocks - 1);
+    }
+
+    return status;
+}
+
 /*******************************************************************************
 **
 ** Function         rw_t2t_write
@@ -921,6 +1002,7 @@ tNFC_STATUS rw_t2t_select (void)
     NFC_SetStaticRfCback (rw_t2t_conn_cback);
     rw_t2t_handle_op_complete ();
     p_t2t->check_tag_halt = FALSE;
+    p_t2t->b_no_fast_read = FALSE;
 
     return NFC_STATUS_OK;
 }
@@ -76,6 +76,7 @@ static BOOLEAN rw_t2t_is_read_only_byte (UINT16 index);
 static tNFC_STATUS rw_t2t_write_ndef_first_block (UINT16 msg_len, BOOLEAN b_update_len);
 static tNFC_STATUS rw_t2t_write_ndef_next_block (UINT16 block, UINT16 msg_len, BOOLEAN b_update_len);
 static tNFC_STATUS rw_t2t_read_ndef_next_block (UINT16 block);
+static tNFC_STATUS rw_t2t_read_ndef_blocks (UINT16 block);
 static tNFC_STATUS rw_t2t_add_terminator_tlv (void);
 static BOOLEAN rw_t2t_is_read_before_write_block (UINT16 block, UINT16 *p_block_to_read);
 static tNFC_STATUS rw_t2t_set_cc (UINT8 tms);
@@ -1592,6 +1593,38 @@ tNFC_STATUS rw_t2t_add_terminator_tlv (void)
     return status;
 }
 
+/*******************************************************************************
+**
+** Function         rw_t2t_read_ndef_blocks
+**
+** Description      This function reads the blocks that hold the rest of the
+**                  NDEF message starting from the specified block, in as few
+**                  frames as the tag allows
+**
+** Returns          NCI_STATUS_OK, if read was started. Otherwise, error status.
+**
+*******************************************************************************/
+static tNFC_STATUS rw_t2t_read_ndef_blocks (UINT16 block)
+{
+    tRW_T2T_CB  *p_t2t = &rw_cb.tcb.t2t;
+    UINT16      num_bytes;
+    UINT16      num_blocks;
+    UINT16      end_block;
+
+    num_bytes = p_t2t->ndef_msg_len - p_t2t->work_offset;
+    if (p_t2t->work_offset == 0)
+        num_bytes += p_t2t->ndef_msg_offset - (block * T2T_BLOCK_LEN);
+
+    num_blocks = (num_bytes + T2T_BLOCK_LEN - 1) / T2T_BLOCK_LEN;
+
+    /* Do not read beyond the data area of the tag */
+    end_block = T2T_FIRST_DATA_BLOCK + (p_t2t->tag_hdr[T2T_CC2_TMS_BYTE] * T2T_TMS_TAG_FACTOR) / T2T_BLOCK_LEN;
+    if (block + num_blocks > end_block)
+        num_blocks = (block < end_block) ? (end_block - block) : 0;
+
+    return (rw_t2t_fast_read (block, num_blocks));
+}
+
 /*******************************************************************************
 **
 ** Function         rw_t2t_handle_ndef_read_rsp
@@ -1612,11 +1645,11 @@ static void rw_t2t_handle_ndef_read_rsp (UINT8 *p_data)
 
     /* On the first read, adjust for any partial block offset */
     offset = 0;
-    len    = T2T_READ_DATA_LEN;
+    len    = p_t2t->read_rsp_len;
 
     if (p_t2t->work_offset == 0)
     {
-        /* The Ndef Message offset may be present in the read 16 bytes */
+        /* The Ndef Message offset may be present in the read bytes */
         offset = (p_t2t->ndef_msg_offset - (p_t2t->block_read * T2T_BLOCK_SIZE));
     }
 
@@ -1641,8 +1674,8 @@ static void rw_t2t_handle_ndef_read_rsp (UINT8 *p_data)
     }
     else
     {
-        /* Read next 4 blocks */
-        if (rw_t2t_read ((UINT16) (p_t2t->block_read + T2T_READ_BLOCKS)) != NFC_STATUS_OK)
+        /* Read next blocks */
+        if (rw_t2t_read_ndef_blocks ((UINT16) (p_t2t->block_read + len / T2T_BLOCK_LEN)) != NFC_STATUS_OK)
             failed = TRUE;
     }
 
@@ -3010,7 +3043,9 @@ tNFC_STATUS RW_T2tDetectNDef (BOOLEAN skip_dyn_locks)
 **                  retrieve the NDEF attributes.
 **
 **                  Internally, this command will be separated into multiple Tag2
-**                  Read commands (if necessary) - depending on the NDEF Msg size
+**                  Read commands (if necessary) - depending on the NDEF Msg size.
+**                  FAST_READ is used to read several blocks per command on tags
+**                  that support it
 **
 ** Parameters:      p_buffer:   The buffer into which to read the NDEF message
 **                  buf_len:    The length of the buffer
@@ -3061,12 +3096,13 @@ tNFC_STATUS RW_T2tReadNDef (UINT8 *p_buffer, UINT16 buf_len)
     {
         p_t2t->state        = RW_T2T_STATE_READ_NDEF;
         p_t2t->block_read   = T2T_FIRST_DATA_BLOCK;
+        p_t2t->read_rsp_len = T2T_READ_DATA_LEN;
         rw_t2t_handle_ndef_read_rsp (p_t2t->tag_data);
     }
     else
     {
         /* Start reading NDEF Message */
-        if ((status = rw_t2t_read (block)) == NFC_STATUS_OK)
+        if ((status = rw_t2t_read_ndef_blocks (block)) == NFC_STATUS_OK)
         {
             p_t2t->state    = RW_T2T_STATE_READ_NDEF;
         }
@@ -130,6 +130,7 @@ static void rw_t3t_handle_get_sc_poll_rsp (tRW_T3T_CB *p_cb, UINT8 nci_status, U
 static void rw_t3t_handle_ndef_detect_poll_rsp (tRW_T3T_CB *p_cb, UINT8 nci_status, UINT8 num_responses, UINT8 sensf_res_buf_size, UINT8 *p_sensf_res_buf);
 static void rw_t3t_handle_fmt_poll_rsp (tRW_T3T_CB *p_cb, UINT8 nci_status, UINT8 num_responses, UINT8 sensf_res_buf_size, UINT8 *p_sensf_res_buf);
 static void rw_t3t_handle_sro_poll_rsp (tRW_T3T_CB *p_cb, UINT8 nci_status, UINT8 num_responses, UINT8 sensf_res_buf_size, UINT8 *p_sensf_res_buf);
+static void rw_t3t_free_batch (tRW_T3T_CB *p_cb);
 
 
 /* Default NDEF attribute information block (used when formatting Felica-Lite tags) */
@@ -277,6 +278,7 @@ void rw_t3t_process_error (tNFC_STATUS status)
 #endif  /* RW_STATS_INCLUDED */
 
         p_cb->rw_state = RW_T3T_STATE_IDLE;
+        rw_t3t_free_batch (p_cb);
 
         /* Notify app of result (if there was a pending command) */
         if (p_cb->cur_cmd < RW_T3T_CMD_MAX)
@@ -916,6 +918,7 @@ tNFC_STATUS rw_t3t_send_next_ndef_check_cmd (tRW_T3T_CB *p_cb)
     UINT32 ndef_bytes_remaining;
     BT_HDR *p_cmd_buf;
     UINT8 *p_cmd_start, *p;
+    UINT8 blocks_per_check;
 
     if ((p_cmd_buf = rw_t3t_get_cmd_buf ()) != NULL)
     {
@@ -931,8 +934,15 @@ tNFC_STATUS rw_t3t_send_next_ndef_check_cmd (tRW_T3T_CB *p_cb)
         /* Calculate first NDEF block ID */
         first_block_to_read = (UINT16) ((p_cb->ndef_rx_offset >> 4) + 1);
 
+        /* Read as many blocks as the peer allows, within the limit of a T3T frame */
+        blocks_per_check = p_cb->ndef_attrib.nbr;
+        if (blocks_per_check > T3T_MSG_NUM_BLOCKS_CHECK_MAX)
+            blocks_per_check = T3T_MSG_NUM_BLOCKS_CHECK_MAX;
+        else if (blocks_per_check == 0)
+            blocks_per_check = 1;
+
         /* Check if remaining blocks can fit into one CHECK command */
-        if (ndef_blocks_remaining <= p_cb->ndef_attrib.nbr)
+        if (ndef_blocks_remaining <= blocks_per_check)
         {
             /* remaining blocks can fit into one CHECK command */
             cur_blocks_to_read = ndef_blocks_remaining;
@@ -942,8 +952,8 @@ tNFC_STATUS rw_t3t_send_next_ndef_check_cmd (tRW_T3T_CB *p_cb)
         else
         {
             /* Remaining blocks cannot fit into one CHECK command */
-            cur_blocks_to_read = p_cb->ndef_attrib.nbr;            /* Read maximum number of blocks allowed by the peer */
-            p_cb->ndef_rx_readlen = ((UINT32) p_cb->ndef_attrib.nbr * 16);
+            cur_blocks_to_read = blocks_per_check;                 /* Read maximum number of blocks allowed by the peer */
+            p_cb->ndef_rx_readlen = ((UINT32) blocks_per_check * 16);
         }
 
         RW_TRACE_DEBUG3 ("rw_t3t_send_next_ndef_check_cmd: bytes_remaining: %i, cur_blocks_to_read: %i, is_final: %i",
@@ -1160,6 +1170,180 @@ tNFC_STATUS rw_t3t_send_update_cmd (tRW_T3T_CB *p_cb, UINT8 num_blocks, tT3T_BLO
     return(retval);
 }
 
+/*****************************************************************************
+**
+** Function         rw_t3t_get_batch_blocks
+**
+** Description      Get number of blocks, from the start of the block list,
+**                  that fit into one CHECK or UPDATE command. This is limited
+**                  by max blocks per command, max number of services and
+**                  length of T3T frame.
+**
+** Returns          Number of blocks
+**
+*****************************************************************************/
+static UINT8 rw_t3t_get_batch_blocks (tT3T_BLOCK_DESC *p_t3t_blocks, UINT8 num_blocks, UINT8 max_blocks, BOOLEAN is_update)
+{
+    UINT16 service_list[T3T_MSG_SERVICE_LIST_MAX];
+    UINT8 num_services = 0, max_services, i, service_code_idx;
+    UINT16 frame_len, blk_len;
+
+    /* SoD + cmdcode + NFCID2 + num_services + num_blocks */
+    frame_len    = T3T_MSG_CMD_COMMON_HDR_LEN + 1;
+    max_services = (is_update) ? T3T_MSG_NUM_SERVICES_UPDATE_MAX : T3T_MSG_NUM_SERVICES_CHECK_MAX;
+
+    if (max_blocks == 0)
+        max_blocks = 1;
+
+    for (i = 0; (i < num_blocks) && (i < max_blocks); i++)
+    {
+        for (service_code_idx = 0; service_code_idx < num_services; service_code_idx++)
+        {
+            if (service_list[service_code_idx] == p_t3t_blocks[i].service_code)
+                break;
+        }
+
+        /* block list element, and block data for UPDATE */
+        blk_len = (p_t3t_blocks[i].block_number > 0xFF) ? 3 : 2;
+        if (is_update)
+            blk_len += T3T_MSG_BLOCKSIZE;
+
+        if (service_code_idx == num_services)
+        {
+            /* new service code */
+            if (num_services >= max_services)
+                break;
+            blk_len += 2;
+        }
+
+        if (frame_len + blk_len > T3T_MSG_MAX_FRAME_LEN)
+            break;
+
+        if (service_code_idx == num_services)
+            service_list[num_services++] = p_t3t_blocks[i].service_code;
+
+        frame_len += blk_len;
+    }
+
+    return (i);
+}
+
+/*****************************************************************************
+**
+** Function         rw_t3t_free_batch
+**
+** Description      Free block list of CHECK/UPDATE API
+**
+** Returns          Nothing
+**
+*****************************************************************************/
+static void rw_t3t_free_batch (tRW_T3T_CB *p_cb)
+{
+    if (p_cb->p_batch_blocks)
+    {
+        GKI_freebuf (p_cb->p_batch_blocks);
+        p_cb->p_batch_blocks = NULL;
+        p_cb->p_batch_data   = NULL;
+    }
+    p_cb->batch_num_blocks  = 0;
+    p_cb->batch_blocks_done = 0;
+    p_cb->batch_cur_blocks  = 0;
+}
+
+/*****************************************************************************
+**
+** Function         rw_t3t_start_batch
+**
+** Description      Keep a copy of block list (and block data) of CHECK/UPDATE
+**                  API, to be sent in as few commands as the tag allows
+**
+** Returns          tNFC_STATUS
+**
+*****************************************************************************/
+static tNFC_STATUS rw_t3t_start_batch (tRW_T3T_CB *p_cb, UINT8 num_blocks, tT3T_BLOCK_DESC *p_t3t_blocks, UINT8 *p_data)
+{
+    UINT16 size;
+
+    rw_t3t_free_batch (p_cb);
+
+    size = (UINT16) (num_blocks * sizeof (tT3T_BLOCK_DESC));
+    if (p_data)
+        size += (UINT16) (num_blocks * T3T_MSG_BLOCKSIZE);
+
+    if ((p_cb->p_batch_blocks = (tT3T_BLOCK_DESC *) GKI_getbuf (size)) == NULL)
+    {
+        RW_TRACE_ERROR1 ("rw_t3t_start_batch: unable to allocate buffer for %i blocks", num_blocks);
+        return (NFC_STATUS_NO_BUFFERS);
+    }
+
+    memcpy (p_cb->p_batch_blocks, p_t3t_blocks, num_blocks * sizeof (tT3T_BLOCK_DESC));
+
+    if (p_data)
+    {
+        p_cb->p_batch_data = (UINT8 *) (p_cb->p_batch_blocks + num_blocks);
+        memcpy (p_cb->p_batch_data, p_data, num_blocks * T3T_MSG_BLOCKSIZE);
+    }
+
+    p_cb->batch_num_blocks = num_blocks;
+
+    return (NFC_STATUS_OK);
+}
+
+/*****************************************************************************
+**
+** Function         rw_t3t_send_next_batch_cmd
+**
+** Description      Send CHECK/UPDATE command for the next blocks of the
+**                  block list
+**
+** Returns          tNFC_STATUS
+**
+*****************************************************************************/
+static tNFC_STATUS rw_t3t_send_next_batch_cmd (tRW_T3T_CB *p_cb)
+{
+    tT3T_BLOCK_DESC *p_t3t_blocks = &p_cb->p_batch_blocks[p_cb->batch_blocks_done];
+    UINT8 num_blocks = p_cb->batch_num_blocks - p_cb->batch_blocks_done;
+
+    if (p_cb->p_batch_data)
+    {
+        p_cb->batch_cur_blocks = rw_t3t_get_batch_blocks (p_t3t_blocks, num_blocks, p_cb->max_update_blocks, TRUE);
+
+        RW_TRACE_DEBUG3 ("rw_t3t_send_next_batch_cmd: UPDATE %i of %i blocks remaining, max %i",
+                         p_cb->batch_cur_blocks, num_blocks, p_cb->max_update_blocks);
+
+        return (rw_t3t_send_update_cmd (p_cb, p_cb->batch_cur_blocks, p_t3t_blocks,
+                                        p_cb->p_batch_data + (p_cb->batch_blocks_done * T3T_MSG_BLOCKSIZE)));
+    }
+    else
+    {
+        p_cb->batch_cur_blocks = rw_t3t_get_batch_blocks (p_t3t_blocks, num_blocks, p_cb->max_check_blocks, FALSE);
+
+        RW_TRACE_DEBUG3 ("rw_t3t_send_next_batch_cmd: CHECK %i of %i blocks remaining, max %i",
+                         p_cb->batch_cur_blocks, num_blocks, p_cb->max_check_blocks);
+
+        return (rw_t3t_send_check_cmd (p_cb, p_cb->batch_cur_blocks, p_t3t_blocks));
+    }
+}
+
+/*****************************************************************************
+**
+** Function         rw_t3t_is_num_blocks_error
+**
+** Description      Check if tag rejected command because of number of blocks,
+**                  and if fewer blocks per command can be tried
+**
+** Returns          TRUE if command should be retried with fewer blocks
+**
+*****************************************************************************/
+static BOOLEAN rw_t3t_is_num_blocks_error (tRW_T3T_CB *p_cb, UINT8 *p_t3t_rsp)
+{
+    return (  (p_cb->p_batch_blocks != NULL)
+            &&(p_cb->batch_cur_blocks > 1)
+            &&(p_t3t_rsp[T3T_MSG_RSP_OFFSET_STATUS1] != T3T_MSG_RSP_STATUS_OK)
+            &&(p_t3t_rsp[T3T_MSG_RSP_OFFSET_STATUS2] == T3T_MSG_RSP_STATUS2_ERROR_NUM_BLOCKS)
+            &&(memcmp (p_cb->peer_nfcid2, &p_t3t_rsp[T3T_MSG_RSP_OFFSET_IDM], NCI_NFCID2_LEN) == 0)  );
+}
+
 /*****************************************************************************
 **
 ** Function         rw_t3t_check_mc_block
@@ -1385,10 +1569,21 @@ void rw_t3t_act_handle_check_rsp (tRW_T3T_CB *p_cb, BT_HDR *p_msg_rsp)
     UINT8 *p_t3t_rsp = (UINT8 *) (p_msg_rsp+1) + p_msg_rsp->offset;
     tRW_READ_DATA evt_data;
     tNFC_STATUS nfc_status = NFC_STATUS_OK;
+    BOOLEAN check_complete = TRUE;
 
     /* Validate response from tag */
-    if (  (p_t3t_rsp[T3T_MSG_RSP_OFFSET_STATUS1] != T3T_MSG_RSP_STATUS_OK)                           /* verify response status code */
-        ||(memcmp (p_cb->peer_nfcid2, &p_t3t_rsp[T3T_MSG_RSP_OFFSET_IDM], NCI_NFCID2_LEN) != 0)  )   /* verify response IDm */
+    if (rw_t3t_is_num_blocks_error (p_cb, p_t3t_rsp))
+    {
+        /* Tag supports fewer blocks per CHECK: retry with half of them */
+        p_cb->max_check_blocks = p_cb->batch_cur_blocks / 2;
+        RW_TRACE_DEBUG1 ("rw_t3t_act_handle_check_rsp: retry with max %i blocks per CHECK", p_cb->max_check_blocks);
+
+        if ((nfc_status = rw_t3t_send_next_batch_cmd (p_cb)) == NFC_STATUS_OK)
+            check_complete = FALSE;
+        GKI_freebuf (p_msg_rsp);
+    }
+    else if (  (p_t3t_rsp[T3T_MSG_RSP_OFFSET_STATUS1] != T3T_MSG_RSP_STATUS_OK)                      /* verify response status code */
+             ||(memcmp (p_cb->peer_nfcid2, &p_t3t_rsp[T3T_MSG_RSP_OFFSET_IDM], NCI_NFCID2_LEN) != 0)  )   /* verify response IDm */
     {
         nfc_status = NFC_STATUS_FAILED;
         GKI_freebuf (p_msg_rsp);
@@ -1401,6 +1596,15 @@ void rw_t3t_act_handle_check_rsp (tRW_T3T_CB *p_cb, BT_HDR *p_msg_rsp)
     }
     else
     {
+        /* Send CHECK for the next blocks before passing this segment up, so tag is busy meanwhile */
+        p_cb->batch_blocks_done += p_cb->batch_cur_blocks;
+        if (  (p_cb->p_batch_blocks)
+            &&(p_cb->batch_blocks_done < p_cb->batch_num_blocks)  )
+        {
+            if ((nfc_status = rw_t3t_send_next_batch_cmd (p_cb)) == NFC_STATUS_OK)
+                check_complete = FALSE;
+        }
+
         /* Copy incoming data into buffer */
         p_msg_rsp->offset += T3T_MSG_RSP_OFFSET_CHECK_DATA;     /* Skip over t3t header */
         p_msg_rsp->len -= T3T_MSG_RSP_OFFSET_CHECK_DATA;
@@ -1409,10 +1613,13 @@ void rw_t3t_act_handle_check_rsp (tRW_T3T_CB *p_cb, BT_HDR *p_msg_rsp)
         (*(rw_cb.p_cback)) (RW_T3T_CHECK_EVT, (tRW_DATA *) &evt_data);
     }
 
+    if (check_complete)
+    {
+        rw_t3t_free_batch (p_cb);
+        p_cb->rw_state = RW_T3T_STATE_IDLE;
 
-    p_cb->rw_state = RW_T3T_STATE_IDLE;
-
-    (*(rw_cb.p_cback)) (RW_T3T_CHECK_CPLT_EVT, (tRW_DATA *) &nfc_status);
+        (*(rw_cb.p_cback)) (RW_T3T_CHECK_CPLT_EVT, (tRW_DATA *) &nfc_status);
+    }
 }
 
 /*****************************************************************************
@@ -1428,10 +1635,20 @@ void rw_t3t_act_handle_update_rsp (tRW_T3T_CB *p_cb, BT_HDR *p_msg_rsp)
 {
     UINT8 *p_t3t_rsp = (UINT8 *) (p_msg_rsp+1) + p_msg_rsp->offset;
     tRW_READ_DATA evt_data;
+    BOOLEAN update_complete = TRUE;
 
     /* Validate response from tag */
-    if (   (p_t3t_rsp[T3T_MSG_RSP_OFFSET_STATUS1] != T3T_MSG_RSP_STATUS_OK)                          /* verify response status code */
-        ||(memcmp (p_cb->peer_nfcid2, &p_t3t_rsp[T3T_MSG_RSP_OFFSET_IDM], NCI_NFCID2_LEN) != 0)  )   /* verify response IDm */
+    if (rw_t3t_is_num_blocks_error (p_cb, p_t3t_rsp))
+    {
+        /* Tag supports fewer blocks per UPDATE: retry with half of them */
+        p_cb->max_update_blocks = p_cb->batch_cur_blocks / 2;
+        RW_TRACE_DEBUG1 ("rw_t3t_act_handle_update_rsp: retry with max %i blocks per UPDATE", p_cb->max_update_blocks);
+
+        if ((evt_data.status = rw_t3t_send_next_batch_cmd (p_cb)) == NFC_STATUS_OK)
+            update_complete = FALSE;
+    }
+    else if (  (p_t3t_rsp[T3T_MSG_RSP_OFFSET_STATUS1] != T3T_MSG_RSP_STATUS_OK)                     /* verify response status code */
+             ||(memcmp (p_cb->peer_nfcid2, &p_t3t_rsp[T3T_MSG_RSP_OFFSET_IDM], NCI_NFCID2_LEN) != 0)  )   /* verify response IDm */
     {
         evt_data.status = NFC_STATUS_FAILED;
     }
@@ -1442,13 +1659,25 @@ void rw_t3t_act_handle_update_rsp (tRW_T3T_CB *p_cb, BT_HDR *p_msg_rsp)
     }
     else
     {
-        /* Copy incoming data into buffer */
         evt_data.status = NFC_STATUS_OK;
+
+        /* Send UPDATE for the next blocks, if any */
+        p_cb->batch_blocks_done += p_cb->batch_cur_blocks;
+        if (  (p_cb->p_batch_blocks)
+            &&(p_cb->batch_blocks_done < p_cb->batch_num_blocks)  )
+        {
+            if ((evt_data.status = rw_t3t_send_next_batch_cmd (p_cb)) == NFC_STATUS_OK)
+                update_complete = FALSE;
+        }
     }
 
-    p_cb->rw_state = RW_T3T_STATE_IDLE;
+    if (update_complete)
+    {
+        rw_t3t_free_batch (p_cb);
+        p_cb->rw_state = RW_T3T_STATE_IDLE;
 
-    (*(rw_cb.p_cback)) (RW_T3T_UPDATE_CPLT_EVT, (tRW_DATA *)&evt_data);
+        (*(rw_cb.p_cback)) (RW_T3T_UPDATE_CPLT_EVT, (tRW_DATA *)&evt_data);
+    }
 
     GKI_freebuf (p_msg_rsp);
 }
@@ -1539,11 +1768,7 @@ void rw_t3t_act_handle_check_ndef_rsp (tRW_T3T_CB *p_cb, BT_HDR *p_msg_rsp)
                 rsp_num_bytes_rx -= (16 - (p_cb->ndef_attrib.ln & 0x000F));
             }
 
-            p_msg_rsp->len = rsp_num_bytes_rx;
-            read_data.p_data = p_msg_rsp;
-            (*(rw_cb.p_cback)) (RW_T3T_CHECK_EVT, (tRW_DATA *) &read_data);
-
-            /* Send CHECK cmd for next NDEF segment, if needed */
+            /* Send CHECK cmd for next NDEF segment, if needed, before passing this segment up */
             if (!(p_cb->flags & RW_T3T_FL_IS_FINAL_NDEF_SEGMENT))
             {
                 if ((nfc_status = rw_t3t_send_next_ndef_check_cmd (p_cb)) == NFC_STATUS_OK)
@@ -1552,6 +1777,10 @@ void rw_t3t_act_handle_check_ndef_rsp (tRW_T3T_CB *p_cb, BT_HDR *p_msg_rsp)
                     check_complete = FALSE;
                 }
             }
+
+            p_msg_rsp->len = rsp_num_bytes_rx;
+            read_data.p_data = p_msg_rsp;
+            (*(rw_cb.p_cback)) (RW_T3T_CHECK_EVT, (tRW_DATA *) &read_data);
         }
     }
 
@@ -2440,6 +2669,8 @@ tNFC_STATUS rw_t3t_select (UINT8 peer_nfcid2[NCI_RF_F_UID_LEN], UINT8 mrti_check
     p_cb->ndef_attrib.status = NFC_STATUS_NOT_INITIALIZED;  /* Indicate that NDEF detection has not been performed yet */
     p_cb->rw_state = RW_T3T_STATE_IDLE;
     p_cb->flags = 0;
+    p_cb->max_check_blocks  = T3T_MSG_NUM_BLOCKS_CHECK_MAX;
+    p_cb->max_update_blocks = T3T_MSG_NUM_BLOCKS_UPDATE_MAX;
     rw_t3t_mrti_to_a_b (mrti_check, &p_cb->check_tout_a, &p_cb->check_tout_b);
     rw_t3t_mrti_to_a_b (mrti_update, &p_cb->update_tout_a, &p_cb->update_tout_b);
 
@@ -2489,6 +2720,8 @@ static tNFC_STATUS rw_t3t_unselect (UINT8 peer_nfcid2[])
         p_cb->p_cur_cmd_buf = NULL;
     }
 
+    rw_t3t_free_batch (p_cb);
+
     p_cb->rw_state = RW_T3T_STATE_NOT_ACTIVATED;
     NFC_SetStaticRfCback (NULL);
 
@@ -2775,6 +3008,10 @@ tNFC_STATUS RW_T3tUpdateNDef (UINT32 len, UINT8 *p_data)
 **      segment of NDEF data received. The RW_READ_CPLT_EVT event is used to
 **      notify the application all segments have been received.
 **
+**      Blocks may belong to different services. If the block list doesn't fit
+**      into one CHECK command, it is read using as few CHECK commands as the
+**      tag accepts, each segment being reported as it is received.
+**
 **      Before using this API, the application must call RW_SelectTagType to
 **      indicate that a Type 3 tag has been activated, and to provide the
 **      tag's Manufacture ID (IDm) .
@@ -2799,8 +3036,15 @@ tNFC_STATUS RW_T3tCheck (UINT8 num_blocks, tT3T_BLOCK_DESC *t3t_blocks)
         return (NFC_STATUS_FAILED);
     }
 
-    /* Send the CHECK command */
-    retval = rw_t3t_send_check_cmd (p_cb, num_blocks, t3t_blocks);
+    if ((num_blocks == 0) || (t3t_blocks == NULL))
+        return (NFC_STATUS_FAILED);
+
+    /* Send the CHECK command(s) */
+    if ((retval = rw_t3t_start_batch (p_cb, num_blocks, t3t_blocks, NULL)) == NFC_STATUS_OK)
+    {
+        if ((retval = rw_t3t_send_next_batch_cmd (p_cb)) != NFC_STATUS_OK)
+            rw_t3t_free_batch (p_cb);
+    }
 
     return (retval);
 }
@@ -2815,6 +3059,9 @@ tNFC_STATUS RW_T3tCheck (UINT8 num_blocks, tT3T_BLOCK_DESC *t3t_blocks)
 **      The RW_WRITE_CPLT_EVT event is used to notify the application all
 **      segments have been received.
 **
+**      If the block list doesn't fit into one UPDATE command, it is written
+**      using as few UPDATE commands as the tag accepts.
+**
 **      Before using this API, the application must call RW_SelectTagType to
 **      indicate that a Type 3 tag has been activated, and to provide the tag's
 **      Manufacture ID (IDm) .
@@ -2839,8 +3086,15 @@ tNFC_STATUS RW_T3tUpdate (UINT8 num_blocks, tT3T_BLOCK_DESC *t3t_blocks, UINT8 *
         return (NFC_STATUS_FAILED);
     }
 
-    /* Send the UPDATE command */
-    retval = rw_t3t_send_update_cmd (p_cb, num_blocks, t3t_blocks, p_data);
+    if ((num_blocks == 0) || (t3t_blocks == NULL) || (p_data == NULL))
+        return (NFC_STATUS_FAILED);
+
+    /* Send the UPDATE command(s) */
+    if ((retval = rw_t3t_start_batch (p_cb, num_blocks, t3t_blocks, p_data)) == NFC_STATUS_OK)
+    {
+        if ((retval = rw_t3t_send_next_batch_cmd (p_cb)) != NFC_STATUS_OK)
+            rw_t3t_free_batch (p_cb);
+    }
 
     return (retval);
 }
@@ -100,12 +100,14 @@ static char *rw_t4t_get_sub_state_name (UINT8 sub_state);
 
 static BOOLEAN rw_t4t_send_to_lower (BT_HDR *p_c_apdu);
 static BOOLEAN rw_t4t_select_file (UINT16 file_id);
-static BOOLEAN rw_t4t_read_file (UINT16 offset, UINT16 length, BOOLEAN is_continue);
-static BOOLEAN rw_t4t_update_nlen (UINT16 ndef_len);
+static BOOLEAN rw_t4t_read_file (UINT32 offset, UINT32 length, BOOLEAN is_continue);
+static BOOLEAN rw_t4t_update_nlen (UINT32 ndef_len);
 static BOOLEAN rw_t4t_update_file (void);
 static BOOLEAN rw_t4t_update_cc_to_readonly (void);
 static BOOLEAN rw_t4t_select_application (UINT8 version);
 static BOOLEAN rw_t4t_validate_cc_file (void);
+static void rw_t4t_set_max_rw_size (void);
+static UINT8 rw_t4t_get_ddo_hdr_size (UINT16 length);
 
 #if(NFC_NXP_NOT_OPEN_INCLUDED == TRUE)
 static BOOLEAN rw_t4t_get_hw_version (void);
@@ -738,20 +740,96 @@ static BOOLEAN rw_t4t_select_file (UINT16 file_id)
     return TRUE;
 }
 
+/*******************************************************************************
+**
+** Function         rw_t4t_get_ddo_hdr_size
+**
+** Description      Get size of tag and length of discretionary data object
+**                  carrying the given number of bytes
+**
+** Returns          size of header
+**
+*******************************************************************************/
+static UINT8 rw_t4t_get_ddo_hdr_size (UINT16 length)
+{
+    if (length < 0x80)
+        return 2;
+    else if (length <= 0xFF)
+        return 3;
+    else
+        return 4;
+}
+
+/*******************************************************************************
+**
+** Function         rw_t4t_set_max_rw_size
+**
+** Description      Set max bytes to read/update per command from MLe/MLc of
+**                  CC file. Extended Lc/Le is used if MLe or MLc is bigger
+**                  than short field coding allows, unless the tag has
+**                  rejected it before.
+**
+** Returns          none
+**
+*******************************************************************************/
+static void rw_t4t_set_max_rw_size (void)
+{
+    tRW_T4T_CB  *p_t4t = &rw_cb.tcb.t4t;
+    UINT16      max_read, max_update;
+
+    if (  (  (p_t4t->cc_file.max_le > T4T_MAX_LENGTH_LE)
+           ||(p_t4t->cc_file.max_lc > T4T_MAX_LENGTH_LC)  )
+        &&(!(p_t4t->intl_flags & RW_T4T_FLAG_EXT_APDU_FAILED))  )
+    {
+        p_t4t->intl_flags |= RW_T4T_FLAG_EXT_APDU;
+        /* extended Le/Lc: valid range is 0x0001 to 0xFFFF */
+        max_read   = (RW_T4T_MAX_DATA_PER_EXT_READ < T4T_MAX_LENGTH_EXT_LE) ? RW_T4T_MAX_DATA_PER_EXT_READ : T4T_MAX_LENGTH_EXT_LE;
+        max_update = (RW_T4T_MAX_DATA_PER_EXT_WRITE < T4T_MAX_LENGTH_EXT_LC) ? RW_T4T_MAX_DATA_PER_EXT_WRITE : T4T_MAX_LENGTH_EXT_LC;
+    }
+    else
+    {
+        /* Le/Lc: valid range is 0x01 to 0xFF */
+        p_t4t->intl_flags &= ~RW_T4T_FLAG_EXT_APDU;
+        max_read   = (RW_T4T_MAX_DATA_PER_READ < T4T_MAX_LENGTH_LE) ? RW_T4T_MAX_DATA_PER_READ : T4T_MAX_LENGTH_LE;
+        max_update = (RW_T4T_MAX_DATA_PER_WRITE < T4T_MAX_LENGTH_LC) ? RW_T4T_MAX_DATA_PER_WRITE : T4T_MAX_LENGTH_LC;
+    }
+
+    /* Get max bytes to read per command */
+    if (p_t4t->cc_file.max_le >= max_read)
+        p_t4t->max_read_size = max_read;
+    else
+        p_t4t->max_read_size = p_t4t->cc_file.max_le;
+
+    /* Get max bytes to update per command */
+    if (p_t4t->cc_file.max_lc >= max_update)
+        p_t4t->max_update_size = max_update;
+    else
+        p_t4t->max_update_size = p_t4t->cc_file.max_lc;
+
+    RW_TRACE_DEBUG3 ("rw_t4t_set_max_rw_size (): max_read_size:%d, max_update_size:%d, ext:%d",
+                      p_t4t->max_read_size, p_t4t->max_update_size,
+                      (p_t4t->intl_flags & RW_T4T_FLAG_EXT_APDU) ? 1 : 0);
+}
+
 /*******************************************************************************
 **
 ** Function         rw_t4t_read_file
 **
 ** Description      Send ReadBinary Command to peer
 **
+**                  Extended Le is used if more than 255 bytes are requested.
+**                  If offset doesn't fit in P1-P2, ReadBinary with offset data
+**                  object (V3.0) is used.
+**
 ** Returns          TRUE if success
 **
 *******************************************************************************/
-static BOOLEAN rw_t4t_read_file (UINT16 offset, UINT16 length, BOOLEAN is_continue)
+static BOOLEAN rw_t4t_read_file (UINT32 offset, UINT32 length, BOOLEAN is_continue)
 {
     tRW_T4T_CB      *p_t4t = &rw_cb.tcb.t4t;
     BT_HDR          *p_c_apdu;
     UINT8           *p;
+    UINT16          le;
 
     RW_TRACE_DEBUG3 ("rw_t4t_read_file () offset:%d, length:%d, is_continue:%d, ",
                       offset, length, is_continue);
@@ -776,18 +854,86 @@ static BOOLEAN rw_t4t_read_file (UINT16 offset, UINT16 length, BOOLEAN is_contin
     /* adjust reading length if payload is bigger than max size per single command */
     if (length > p_t4t->max_read_size)
     {
-        length = (UINT8) (p_t4t->max_read_size);
+        length = p_t4t->max_read_size;
     }
 
     p_c_apdu->offset = NCI_MSG_OFFSET_SIZE + NCI_DATA_HDR_SIZE;
     p = (UINT8 *) (p_c_apdu + 1) + p_c_apdu->offset;
 
-    UINT8_TO_BE_STREAM (p, (T4T_CMD_CLASS | rw_cb.tcb.t4t.channel));
-    UINT8_TO_BE_STREAM (p, T4T_CMD_INS_READ_BINARY);
-    UINT16_TO_BE_STREAM (p, offset);
-    UINT8_TO_BE_STREAM (p, length); /* Le */
+    p_t4t->intl_flags &= ~(RW_T4T_FLAG_ODO | RW_T4T_FLAG_EXT_SENT);
+
+    if (offset > T4T_MAX_SHORT_OFFSET)
+    {
+        /* response data is in discretionary data object */
+        if (length + T4T_DDO_MAX_HDR_SIZE > p_t4t->cc_file.max_le)
+            length = p_t4t->cc_file.max_le - T4T_DDO_MAX_HDR_SIZE;
+
+        if (  (!(p_t4t->intl_flags & RW_T4T_FLAG_EXT_APDU))
+            &&(length + rw_t4t_get_ddo_hdr_size ((UINT16) length) > T4T_MAX_LENGTH_LE)  )
+        {
+            length = T4T_MAX_LENGTH_LE - rw_t4t_get_ddo_hdr_size (T4T_MAX_LENGTH_LE);
+        }
+
+        le = (UINT16) (length + rw_t4t_get_ddo_hdr_size ((UINT16) length));
+
+        UINT8_TO_BE_STREAM (p, (T4T_CMD_CLASS | rw_cb.tcb.t4t.channel));
+        UINT8_TO_BE_STREAM (p, T4T_CMD_INS_READ_BINARY_ODO);
+        UINT16_TO_BE_STREAM (p, 0x0000);
+
+        if (le > T4T_MAX_LENGTH_LE)
+        {
+            UINT8_TO_BE_STREAM (p, 0x00);
+            UINT16_TO_BE_STREAM (p, T4T_ODO_SIZE);  /* extended Lc */
+            p_c_apdu->len = T4T_CMD_MAX_EXT_HDR_SIZE;
+        }
+        else
+        {
+            UINT8_TO_BE_STREAM (p, T4T_ODO_SIZE);   /* Lc */
+            p_c_apdu->len = T4T_CMD_MAX_HDR_SIZE;
+        }
+
+        UINT8_TO_BE_STREAM (p, T4T_ODO_TAG);
+        UINT8_TO_BE_STREAM (p, T4T_ODO_OFFSET_SIZE);
+        UINT24_TO_BE_STREAM (p, offset);
+        p_c_apdu->len += T4T_ODO_SIZE;
+
+        if (le > T4T_MAX_LENGTH_LE)
+        {
+            UINT16_TO_BE_STREAM (p, le);            /* extended Le */
+            p_c_apdu->len += T4T_EXT_LE_SIZE;
+            p_t4t->intl_flags |= RW_T4T_FLAG_EXT_SENT;
+        }
+        else
+        {
+            UINT8_TO_BE_STREAM (p, le);             /* Le */
+            p_c_apdu->len++;
+        }
+
+        p_t4t->intl_flags |= RW_T4T_FLAG_ODO;
+    }
+    else
+    {
+        UINT8_TO_BE_STREAM (p, (T4T_CMD_CLASS | rw_cb.tcb.t4t.channel));
+        UINT8_TO_BE_STREAM (p, T4T_CMD_INS_READ_BINARY);
+        UINT16_TO_BE_STREAM (p, offset);
+
+        if (length > T4T_MAX_LENGTH_LE)
+        {
+            UINT8_TO_BE_STREAM (p, 0x00);
+            UINT16_TO_BE_STREAM (p, length);        /* extended Le */
+
+            p_c_apdu->len = T4T_CMD_MIN_HDR_SIZE + 3;
+            p_t4t->intl_flags |= RW_T4T_FLAG_EXT_SENT;
+        }
+        else
+        {
+            UINT8_TO_BE_STREAM (p, length);         /* Le */
 
-    p_c_apdu->len = T4T_CMD_MIN_HDR_SIZE + 1; /* adding Le */
+            p_c_apdu->len = T4T_CMD_MIN_HDR_SIZE + 1; /* adding Le */
+        }
+    }
+
+    p_t4t->last_length = (UINT16) length;
 
     if (!rw_t4t_send_to_lower (p_c_apdu))
     {
@@ -801,13 +947,14 @@ static BOOLEAN rw_t4t_read_file (UINT16 offset, UINT16 length, BOOLEAN is_contin
 **
 ** Function         rw_t4t_update_nlen
 **
-** Description      Send UpdateBinary Command to update NLEN to peer
+** Description      Send UpdateBinary Command to update NLEN (or ENLEN) to peer
 **
 ** Returns          TRUE if success
 **
 *******************************************************************************/
-static BOOLEAN rw_t4t_update_nlen (UINT16 ndef_len)
+static BOOLEAN rw_t4t_update_nlen (UINT32 ndef_len)
 {
+    tRW_T4T_CB      *p_t4t = &rw_cb.tcb.t4t;
     BT_HDR          *p_c_apdu;
     UINT8           *p;
 
@@ -827,10 +974,20 @@ static BOOLEAN rw_t4t_update_nlen (UINT16 ndef_len)
     UINT8_TO_BE_STREAM (p, T4T_CMD_CLASS);
     UINT8_TO_BE_STREAM (p, T4T_CMD_INS_UPDATE_BINARY);
     UINT16_TO_BE_STREAM (p, 0x0000);                    /* offset for NLEN */
-    UINT8_TO_BE_STREAM (p, T4T_FILE_LENGTH_SIZE);
-    UINT16_TO_BE_STREAM (p, ndef_len);
+    UINT8_TO_BE_STREAM (p, p_t4t->nlen_size);
 
-    p_c_apdu->len = T4T_CMD_MAX_HDR_SIZE + T4T_FILE_LENGTH_SIZE;
+    if (p_t4t->nlen_size == T4T_EFILE_LENGTH_SIZE)
+    {
+        UINT32_TO_BE_STREAM (p, ndef_len);
+    }
+    else
+    {
+        UINT16_TO_BE_STREAM (p, ndef_len);
+    }
+
+    p_c_apdu->len = T4T_CMD_MAX_HDR_SIZE + p_t4t->nlen_size;
+
+    p_t4t->intl_flags &= ~(RW_T4T_FLAG_ODO | RW_T4T_FLAG_EXT_SENT);
 
     if (!rw_t4t_send_to_lower (p_c_apdu))
     {
@@ -846,6 +1003,10 @@ static BOOLEAN rw_t4t_update_nlen (UINT16 ndef_len)
 **
 ** Description      Send UpdateBinary Command to peer
 **
+**                  Extended Lc is used if more than 255 bytes are sent.
+**                  If offset doesn't fit in P1-P2, UpdateBinary with offset
+**                  data object (V3.0) is used.
+**
 ** Returns          TRUE if success
 **
 *******************************************************************************/
@@ -855,38 +1016,115 @@ static BOOLEAN rw_t4t_update_file (void)
     BT_HDR          *p_c_apdu;
     UINT8           *p;
     UINT16          length;
+    UINT16          lc;
+    UINT16          buf_size;
+    BOOLEAN         use_odo;
 
     RW_TRACE_DEBUG2 ("rw_t4t_update_file () rw_offset:%d, rw_length:%d",
                       p_t4t->rw_offset, p_t4t->rw_length);
 
-    p_c_apdu = (BT_HDR *) GKI_getpoolbuf (NFC_RW_POOL_ID);
+    /* try to send all of remaining data */
+    if (p_t4t->rw_length > p_t4t->max_update_size)
+    {
+        /* adjust updating length if payload is bigger than max size per single command */
+        length = p_t4t->max_update_size;
+    }
+    else
+    {
+        length = (UINT16) p_t4t->rw_length;
+    }
 
-    if (!p_c_apdu)
+    use_odo = (p_t4t->rw_offset > T4T_MAX_SHORT_OFFSET) ? TRUE : FALSE;
+
+    if (use_odo)
     {
-        RW_TRACE_ERROR0 ("rw_t4t_write_file (): Cannot allocate buffer");
-        return FALSE;
+        /* data is sent in discretionary data object after offset data object */
+        if (length + T4T_ODO_SIZE + T4T_DDO_MAX_HDR_SIZE > p_t4t->cc_file.max_lc)
+            length = p_t4t->cc_file.max_lc - T4T_ODO_SIZE - T4T_DDO_MAX_HDR_SIZE;
+
+        if (  (!(p_t4t->intl_flags & RW_T4T_FLAG_EXT_APDU))
+            &&(length + T4T_ODO_SIZE + rw_t4t_get_ddo_hdr_size (length) > T4T_MAX_LENGTH_LC)  )
+        {
+            length = T4T_MAX_LENGTH_LC - T4T_ODO_SIZE - rw_t4t_get_ddo_hdr_size (T4T_MAX_LENGTH_LC);
+        }
+
+        lc = length + T4T_ODO_SIZE + rw_t4t_get_ddo_hdr_size (length);
+    }
+    else
+    {
+        lc = length;
     }
 
-    /* try to send all of remaining data */
-    length = p_t4t->rw_length;
+    buf_size = BT_HDR_SIZE + NCI_MSG_OFFSET_SIZE + NCI_DATA_HDR_SIZE + T4T_CMD_MAX_EXT_HDR_SIZE + lc;
+
+    /* use a bigger buffer for extended length */
+    if (buf_size > NFC_RW_POOL_BUF_SIZE)
+        p_c_apdu = (BT_HDR *) GKI_getbuf (buf_size);
+    else
+        p_c_apdu = (BT_HDR *) GKI_getpoolbuf (NFC_RW_POOL_ID);
 
-    /* adjust updating length if payload is bigger than max size per single command */
-    if (length > p_t4t->max_update_size)
+    if (!p_c_apdu)
     {
-        length = (UINT8) (p_t4t->max_update_size);
+        RW_TRACE_ERROR0 ("rw_t4t_write_file (): Cannot allocate buffer");
+        return FALSE;
     }
 
     p_c_apdu->offset = NCI_MSG_OFFSET_SIZE + NCI_DATA_HDR_SIZE;
     p = (UINT8 *) (p_c_apdu + 1) + p_c_apdu->offset;
 
+    p_t4t->intl_flags &= ~(RW_T4T_FLAG_ODO | RW_T4T_FLAG_EXT_SENT);
+
     UINT8_TO_BE_STREAM (p, T4T_CMD_CLASS);
-    UINT8_TO_BE_STREAM (p, T4T_CMD_INS_UPDATE_BINARY);
-    UINT16_TO_BE_STREAM (p, p_t4t->rw_offset);
-    UINT8_TO_BE_STREAM (p, length);
 
-    memcpy (p, p_t4t->p_update_data, length);
+    if (use_odo)
+    {
+        UINT8_TO_BE_STREAM (p, T4T_CMD_INS_UPDATE_BINARY_ODO);
+        UINT16_TO_BE_STREAM (p, 0x0000);
+        p_t4t->intl_flags |= RW_T4T_FLAG_ODO;
+    }
+    else
+    {
+        UINT8_TO_BE_STREAM (p, T4T_CMD_INS_UPDATE_BINARY);
+        UINT16_TO_BE_STREAM (p, p_t4t->rw_offset);
+    }
+
+    if (lc > T4T_MAX_LENGTH_LC)
+    {
+        UINT8_TO_BE_STREAM (p, 0x00);
+        UINT16_TO_BE_STREAM (p, lc);                /* extended Lc */
+        p_c_apdu->len = T4T_CMD_MAX_EXT_HDR_SIZE + lc;
+        p_t4t->intl_flags |= RW_T4T_FLAG_EXT_SENT;
+    }
+    else
+    {
+        UINT8_TO_BE_STREAM (p, lc);
+        p_c_apdu->len = T4T_CMD_MAX_HDR_SIZE + lc;
+    }
+
+    if (use_odo)
+    {
+        UINT8_TO_BE_STREAM (p, T4T_ODO_TAG);
+        UINT8_TO_BE_STREAM (p, T4T_ODO_OFFSET_SIZE);
+        UINT24_TO_BE_STREAM (p, p_t4t->rw_offset);
 
-    p_c_apdu->len = T4T_CMD_MAX_HDR_SIZE + length;
+        UINT8_TO_BE_STREAM (p, T4T_DDO_TAG);
+        if (length < 0x80)
+        {
+            UINT8_TO_BE_STREAM (p, length);
+        }
+        else if (length <= 0xFF)
+        {
+            UINT8_TO_BE_STREAM (p, 0x81);
+            UINT8_TO_BE_STREAM (p, length);
+        }
+        else
+        {
+            UINT8_TO_BE_STREAM (p, 0x82);
+            UINT16_TO_BE_STREAM (p, length);
+        }
+    }
+
+    memcpy (p, p_t4t->p_update_data, length);
 
     if (!rw_t4t_send_to_lower (p_c_apdu))
     {
@@ -894,6 +1132,7 @@ static BOOLEAN rw_t4t_update_file (void)
     }
 
     /* adjust offset, length and pointer for remaining data */
+    p_t4t->last_length    = length;
     p_t4t->rw_offset     += length;
     p_t4t->rw_length     -= length;
     p_t4t->p_update_data += length;
@@ -931,7 +1170,15 @@ static BOOLEAN rw_t4t_update_cc_to_readonly (void)
     /* Add Command Header */
     UINT8_TO_BE_STREAM (p, T4T_CMD_CLASS);
     UINT8_TO_BE_STREAM (p, T4T_CMD_INS_UPDATE_BINARY);
-    UINT16_TO_BE_STREAM (p, (T4T_FC_TLV_OFFSET_IN_CC + T4T_FC_WRITE_ACCESS_OFFSET_IN_TLV)); /* Offset for Read Write access byte of CC */
+    /* Offset for Read Write access byte of CC */
+    if (rw_cb.tcb.t4t.intl_flags & RW_T4T_FLAG_ENDEF_FC)
+    {
+        UINT16_TO_BE_STREAM (p, (T4T_FC_TLV_OFFSET_IN_CC + T4T_EFC_WRITE_ACCESS_OFFSET_IN_TLV));
+    }
+    else
+    {
+        UINT16_TO_BE_STREAM (p, (T4T_FC_TLV_OFFSET_IN_CC + T4T_FC_WRITE_ACCESS_OFFSET_IN_TLV));
+    }
     UINT8_TO_BE_STREAM (p, 1); /* Length of write access field in cc interms of bytes */
 
     /* Remove Write access */
@@ -994,7 +1241,8 @@ static BOOLEAN rw_t4t_select_application (UINT8 version)
 
         p_c_apdu->len = T4T_CMD_MAX_HDR_SIZE + T4T_V10_NDEF_TAG_AID_LEN;
     }
-    else if (version == T4T_VERSION_2_0)   /* this is for V2.0 */
+    else if (  (version == T4T_VERSION_2_0)   /* this is for V2.0 */
+             ||(version == T4T_VERSION_3_0)  ) /* V3.0 uses the same AID */
     {
         UINT8_TO_BE_STREAM (p, T4T_V20_NDEF_TAG_AID_LEN);
 
@@ -1040,6 +1288,13 @@ static BOOLEAN rw_t4t_validate_cc_file (void)
         return FALSE;
     }
 
+    /* V3.0 tag shares NDEF Tag Application with V2.0 */
+    if (  (T4T_GET_MAJOR_VERSION (p_t4t->cc_file.version) == T4T_GET_MAJOR_VERSION (T4T_VERSION_3_0))
+        &&(p_t4t->version == T4T_VERSION_2_0)  )
+    {
+        p_t4t->version = T4T_VERSION_3_0;
+    }
+
     if (T4T_GET_MAJOR_VERSION (p_t4t->cc_file.version) != T4T_GET_MAJOR_VERSION (p_t4t->version))
     {
         RW_TRACE_ERROR2 ("rw_t4t_validate_cc_file (): Peer version (0x%02X) is matched to ours (0x%02X)",
@@ -1075,7 +1330,8 @@ static BOOLEAN rw_t4t_validate_cc_file (void)
     }
 
     if (  (p_t4t->cc_file.ndef_fc.max_file_size < 0x0005)
-        ||(p_t4t->cc_file.ndef_fc.max_file_size == 0xFFFF)  )
+        ||(  (p_t4t->cc_file.ndef_fc.max_file_size == 0xFFFF)
+           &&(!(p_t4t->intl_flags & RW_T4T_FLAG_ENDEF_FC))  )  )
     {
         RW_TRACE_ERROR1 ("rw_t4t_validate_cc_file (): max_file_size (%d) is reserved",
                          p_t4t->cc_file.ndef_fc.max_file_size);
@@ -1498,7 +1754,8 @@ static void rw_t4t_sm_detect_ndef (BT_HDR *p_r_apdu)
 {
     tRW_T4T_CB  *p_t4t = &rw_cb.tcb.t4t;
     UINT8       *p, type, length;
-    UINT16      status_words, nlen;
+    UINT16      status_words;
+    UINT32      nlen;
     tRW_DATA    rw_data;
 
 #if (BT_TRACE_VERBOSE == TRUE)
@@ -1579,11 +1836,37 @@ static void rw_t4t_sm_detect_ndef (BT_HDR *p_r_apdu)
             BE_STREAM_TO_UINT8 (type, p);
             BE_STREAM_TO_UINT8 (length, p);
 
-            if (  (type == T4T_NDEF_FILE_CONTROL_TYPE)
-                &&(length == T4T_FILE_CONTROL_LENGTH)  )
+            if (  (type == T4T_ENDEF_FILE_CONTROL_TYPE)
+                &&(length == T4T_ENDEF_FILE_CONTROL_LENGTH)
+                &&(p_r_apdu->len < T4T_ECC_FILE_MIN_LEN + T4T_RSP_STATUS_WORDS_SIZE)  )
+            {
+                /* Extended NDEF File Control TLV doesn't fit in mandatory part, read again */
+                if (!rw_t4t_read_file (0x00, T4T_ECC_FILE_MIN_LEN, FALSE))
+                {
+                    rw_t4t_handle_error (NFC_STATUS_FAILED, 0, 0);
+                }
+                break;
+            }
+
+            if (  (  (type == T4T_NDEF_FILE_CONTROL_TYPE)
+                   &&(length == T4T_FILE_CONTROL_LENGTH)  )
+                ||(  (type == T4T_ENDEF_FILE_CONTROL_TYPE)
+                   &&(length == T4T_ENDEF_FILE_CONTROL_LENGTH)  )  )
             {
                 BE_STREAM_TO_UINT16 (p_t4t->cc_file.ndef_fc.file_id, p);
-                BE_STREAM_TO_UINT16 (p_t4t->cc_file.ndef_fc.max_file_size, p);
+
+                if (type == T4T_ENDEF_FILE_CONTROL_TYPE)
+                {
+                    BE_STREAM_TO_UINT32 (p_t4t->cc_file.ndef_fc.max_file_size, p);
+                    p_t4t->intl_flags |= RW_T4T_FLAG_ENDEF_FC;
+                    p_t4t->nlen_size   = T4T_EFILE_LENGTH_SIZE;
+                }
+                else
+                {
+                    BE_STREAM_TO_UINT16 (p_t4t->cc_file.ndef_fc.max_file_size, p);
+                    p_t4t->intl_flags &= ~RW_T4T_FLAG_ENDEF_FC;
+                    p_t4t->nlen_size   = T4T_FILE_LENGTH_SIZE;
+                }
                 BE_STREAM_TO_UINT8 (p_t4t->cc_file.ndef_fc.read_access, p);
                 BE_STREAM_TO_UINT8 (p_t4t->cc_file.ndef_fc.write_access, p);
 
@@ -1595,7 +1878,7 @@ static void rw_t4t_sm_detect_ndef (BT_HDR *p_r_apdu)
                 RW_TRACE_DEBUG1 ("  MaxLc:  0x%04X",    p_t4t->cc_file.max_lc);
                 RW_TRACE_DEBUG0 ("  NDEF File Control TLV");
                 RW_TRACE_DEBUG1 ("    FileID:      0x%04X", p_t4t->cc_file.ndef_fc.file_id);
-                RW_TRACE_DEBUG1 ("    MaxFileSize: 0x%04X", p_t4t->cc_file.ndef_fc.max_file_size);
+                RW_TRACE_DEBUG1 ("    MaxFileSize: 0x%08X", p_t4t->cc_file.ndef_fc.max_file_size);
                 RW_TRACE_DEBUG1 ("    ReadAccess:  0x%02X", p_t4t->cc_file.ndef_fc.read_access);
                 RW_TRACE_DEBUG1 ("    WriteAccess: 0x%02X", p_t4t->cc_file.ndef_fc.write_access);
 #endif
@@ -1622,8 +1905,8 @@ static void rw_t4t_sm_detect_ndef (BT_HDR *p_r_apdu)
 
     case RW_T4T_SUBSTATE_WAIT_SELECT_NDEF_FILE:
 
-        /* NDEF file has been selected then read the first 2 bytes (NLEN) */
-        if (!rw_t4t_read_file (0, T4T_FILE_LENGTH_SIZE, FALSE))
+        /* NDEF file has been selected then read the first 2 bytes (NLEN) or 4 bytes (ENLEN) */
+        if (!rw_t4t_read_file (0, p_t4t->nlen_size, FALSE))
         {
             rw_t4t_handle_error (NFC_STATUS_FAILED, 0, 0);
         }
@@ -1636,13 +1919,20 @@ static void rw_t4t_sm_detect_ndef (BT_HDR *p_r_apdu)
     case RW_T4T_SUBSTATE_WAIT_READ_NLEN:
 
         /* NLEN has been read then report upper layer */
-        if (p_r_apdu->len == T4T_FILE_LENGTH_SIZE + T4T_RSP_STATUS_WORDS_SIZE)
+        if (p_r_apdu->len == p_t4t->nlen_size + T4T_RSP_STATUS_WORDS_SIZE)
         {
             /* get length of NDEF */
             p = (UINT8 *) (p_r_apdu + 1) + p_r_apdu->offset;
-            BE_STREAM_TO_UINT16 (nlen, p);
+            if (p_t4t->nlen_size == T4T_EFILE_LENGTH_SIZE)
+            {
+                BE_STREAM_TO_UINT32 (nlen, p);
+            }
+            else
+            {
+                BE_STREAM_TO_UINT16 (nlen, p);
+            }
 
-            if (nlen <= p_t4t->cc_file.ndef_fc.max_file_size - T4T_FILE_LENGTH_SIZE)
+            if (nlen <= p_t4t->cc_file.ndef_fc.max_file_size - p_t4t->nlen_size)
             {
                 p_t4t->ndef_status = RW_T4T_NDEF_STATUS_NDEF_DETECTED;
 
@@ -1651,37 +1941,8 @@ static void rw_t4t_sm_detect_ndef (BT_HDR *p_r_apdu)
                     p_t4t->ndef_status |= RW_T4T_NDEF_STATUS_NDEF_READ_ONLY;
                 }
 
-                /* Get max bytes to read per command */
-                if (p_t4t->cc_file.max_le >= RW_T4T_MAX_DATA_PER_READ)
-                {
-                    p_t4t->max_read_size = RW_T4T_MAX_DATA_PER_READ;
-                }
-                else
-                {
-                    p_t4t->max_read_size = p_t4t->cc_file.max_le;
-                }
-
-                /* Le: valid range is 0x01 to 0xFF */
-                if (p_t4t->max_read_size >= T4T_MAX_LENGTH_LE)
-                {
-                    p_t4t->max_read_size = T4T_MAX_LENGTH_LE;
-                }
-
-                /* Get max bytes to update per command */
-                if (p_t4t->cc_file.max_lc >= RW_T4T_MAX_DATA_PER_WRITE)
-                {
-                    p_t4t->max_update_size = RW_T4T_MAX_DATA_PER_WRITE;
-                }
-                else
-                {
-                    p_t4t->max_update_size = p_t4t->cc_file.max_lc;
-                }
-
-                /* Lc: valid range is 0x01 to 0xFF */
-                if (p_t4t->max_update_size >= T4T_MAX_LENGTH_LC)
-                {
-                    p_t4t->max_update_size = T4T_MAX_LENGTH_LC;
-                }
+                /* Get max bytes to read/update per command */
+                rw_t4t_set_max_rw_size ();
 
                 p_t4t->ndef_length = nlen;
                 p_t4t->state       = RW_T4T_STATE_IDLE;
@@ -1690,7 +1951,7 @@ static void rw_t4t_sm_detect_ndef (BT_HDR *p_r_apdu)
                 {
                     rw_data.ndef.status   = NFC_STATUS_OK;
                     rw_data.ndef.protocol = NFC_PROTOCOL_ISO_DEP;
-                    rw_data.ndef.max_size = (UINT32) (p_t4t->cc_file.ndef_fc.max_file_size - (UINT16) T4T_FILE_LENGTH_SIZE);
+                    rw_data.ndef.max_size = p_t4t->cc_file.ndef_fc.max_file_size - p_t4t->nlen_size;
                     rw_data.ndef.cur_size = nlen;
                     rw_data.ndef.flags    = RW_NDEF_FL_SUPPORTED | RW_NDEF_FL_FORMATED;
                     if (p_t4t->cc_file.ndef_fc.write_access != T4T_FC_WRITE_ACCESS)
@@ -1706,8 +1967,8 @@ static void rw_t4t_sm_detect_ndef (BT_HDR *p_r_apdu)
             else
             {
                 /* NLEN should be less than max file size */
-                RW_TRACE_ERROR2 ("rw_t4t_sm_detect_ndef (): NLEN (%d) + 2 must be <= max file size (%d)",
-                                 nlen, p_t4t->cc_file.ndef_fc.max_file_size);
+                RW_TRACE_ERROR3 ("rw_t4t_sm_detect_ndef (): NLEN (%d) + %d must be <= max file size (%d)",
+                                 nlen, p_t4t->nlen_size, p_t4t->cc_file.ndef_fc.max_file_size);
 
                 p_t4t->ndef_status &= ~ (RW_T4T_NDEF_STATUS_NDEF_DETECTED);
                 rw_t4t_handle_error (NFC_STATUS_BAD_RESP, 0, 0);
@@ -1715,9 +1976,9 @@ static void rw_t4t_sm_detect_ndef (BT_HDR *p_r_apdu)
         }
         else
         {
-            /* response payload size should be T4T_FILE_LENGTH_SIZE */
+            /* response payload size should be NLEN or ENLEN size */
             RW_TRACE_ERROR2 ("rw_t4t_sm_detect_ndef (): Length (%d) of R-APDU must be %d",
-                             p_r_apdu->len, T4T_FILE_LENGTH_SIZE + T4T_RSP_STATUS_WORDS_SIZE);
+                             p_r_apdu->len, p_t4t->nlen_size + T4T_RSP_STATUS_WORDS_SIZE);
 
             p_t4t->ndef_status &= ~ (RW_T4T_NDEF_STATUS_NDEF_DETECTED);
             rw_t4t_handle_error (NFC_STATUS_BAD_RESP, 0, 0);
@@ -1744,7 +2005,7 @@ static void rw_t4t_sm_read_ndef (BT_HDR *p_r_apdu)
 {
     tRW_T4T_CB  *p_t4t = &rw_cb.tcb.t4t;
     UINT8       *p;
-    UINT16      status_words;
+    UINT16      status_words, length;
     tRW_DATA    rw_data;
 
 #if (BT_TRACE_VERBOSE == TRUE)
@@ -1761,7 +2022,24 @@ static void rw_t4t_sm_read_ndef (BT_HDR *p_r_apdu)
 
     if (status_words != T4T_RSP_CMD_CMPLTED)
     {
-        rw_t4t_handle_error (NFC_STATUS_CMD_NOT_CMPLTD, *(p-2), *(p-1));
+        if (  (status_words == T4T_RSP_WRONG_LENGTH)
+            &&(p_t4t->intl_flags & RW_T4T_FLAG_EXT_SENT)  )
+        {
+            /* extended Le is not supported, retry with short Le */
+            RW_TRACE_DEBUG0 ("rw_t4t_sm_read_ndef (): extended Le rejected, use short Le");
+
+            p_t4t->intl_flags |= RW_T4T_FLAG_EXT_APDU_FAILED;
+            rw_t4t_set_max_rw_size ();
+
+            if (!rw_t4t_read_file (p_t4t->rw_offset, p_t4t->rw_length, TRUE))
+            {
+                rw_t4t_handle_error (NFC_STATUS_FAILED, 0, 0);
+            }
+        }
+        else
+        {
+            rw_t4t_handle_error (NFC_STATUS_CMD_NOT_CMPLTD, *(p-2), *(p-1));
+        }
         GKI_freebuf (p_r_apdu);
         return;
     }
@@ -1773,6 +2051,31 @@ static void rw_t4t_sm_read_ndef (BT_HDR *p_r_apdu)
         /* Read partial or complete data */
         p_r_apdu->len -= T4T_RSP_STATUS_WORDS_SIZE;
 
+        /* strip tag and length of discretionary data object */
+        if (p_t4t->intl_flags & RW_T4T_FLAG_ODO)
+        {
+            p = (UINT8 *) (p_r_apdu + 1) + p_r_apdu->offset;
+
+            if ((p_r_apdu->len >= 2) && (*p == T4T_DDO_TAG))
+            {
+                if ((p[1] == 0x81) && (p_r_apdu->len >= 3))
+                    length = 3;
+                else if ((p[1] == 0x82) && (p_r_apdu->len >= 4))
+                    length = 4;
+                else if (p[1] < 0x80)
+                    length = 2;
+                else
+                    length = p_r_apdu->len;
+            }
+            else
+            {
+                length = p_r_apdu->len;
+            }
+
+            p_r_apdu->offset += length;
+            p_r_apdu->len    -= length;
+        }
+
         if ((p_r_apdu->len > 0) && (p_r_apdu->len <= p_t4t->rw_length))
         {
             p_t4t->rw_length -= p_r_apdu->len;
@@ -1788,7 +2091,12 @@ static void rw_t4t_sm_read_ndef (BT_HDR *p_r_apdu)
                 {
                     (*(rw_cb.p_cback)) (RW_T4T_NDEF_READ_EVT, &rw_data);
 
-                    if (!rw_t4t_read_file (p_t4t->rw_offset, p_t4t->rw_length, TRUE))
+                    /* upper layer may have stopped reading in the callback */
+                    if (p_t4t->state != RW_T4T_STATE_READ_NDEF)
+                    {
+                        RW_TRACE_DEBUG0 ("rw_t4t_sm_read_ndef (): NDEF read stopped by upper layer");
+                    }
+                    else if (!rw_t4t_read_file (p_t4t->rw_offset, p_t4t->rw_length, TRUE))
                     {
                         rw_t4t_handle_error (NFC_STATUS_FAILED, 0, 0);
                     }
@@ -1859,7 +2167,30 @@ static void rw_t4t_sm_update_ndef (BT_HDR  *p_r_apdu)
 
     if (status_words != T4T_RSP_CMD_CMPLTED)
     {
-        rw_t4t_handle_error (NFC_STATUS_CMD_NOT_CMPLTD, *(p-2), *(p-1));
+        if (  (status_words == T4T_RSP_WRONG_LENGTH)
+            &&(p_t4t->sub_state == RW_T4T_SUBSTATE_WAIT_UPDATE_RESP)
+            &&(p_t4t->intl_flags & RW_T4T_FLAG_EXT_SENT)  )
+        {
+            /* extended Lc is not supported, resend the same data with short Lc */
+            RW_TRACE_DEBUG0 ("rw_t4t_sm_update_ndef (): extended Lc rejected, use short Lc");
+
+            p_t4t->intl_flags |= RW_T4T_FLAG_EXT_APDU_FAILED;
+            rw_t4t_set_max_rw_size ();
+
+            p_t4t->rw_offset     -= p_t4t->last_length;
+            p_t4t->rw_length     += p_t4t->last_length;
+            p_t4t->p_update_data -= p_t4t->last_length;
+
+            if (!rw_t4t_update_file ())
+            {
+                rw_t4t_handle_error (NFC_STATUS_FAILED, 0, 0);
+                p_t4t->p_update_data = NULL;
+            }
+        }
+        else
+        {
+            rw_t4t_handle_error (NFC_STATUS_CMD_NOT_CMPLTD, *(p-2), *(p-1));
+        }
         return;
     }
 
@@ -2269,6 +2600,8 @@ tNFC_STATUS rw_t4t_select (void)
     /* These will be udated during NDEF detection */
     p_t4t->max_read_size   = T4T_MAX_LENGTH_LE;
     p_t4t->max_update_size = T4T_MAX_LENGTH_LC;
+    p_t4t->intl_flags      = 0;
+    p_t4t->nlen_size       = T4T_FILE_LENGTH_SIZE;
 
     return NFC_STATUS_OK;
 }
@@ -2351,7 +2684,7 @@ tNFC_STATUS RW_T4tReadNDef (void)
     if (rw_cb.tcb.t4t.ndef_status & RW_T4T_NDEF_STATUS_NDEF_DETECTED)
     {
         /* start reading NDEF */
-        if (!rw_t4t_read_file (T4T_FILE_LENGTH_SIZE, rw_cb.tcb.t4t.ndef_length, FALSE))
+        if (!rw_t4t_read_file (rw_cb.tcb.t4t.nlen_size, rw_cb.tcb.t4t.ndef_length, FALSE))
         {
             return NFC_STATUS_FAILED;
         }
@@ -2368,6 +2701,36 @@ tNFC_STATUS RW_T4tReadNDef (void)
     }
 }
 
+/*******************************************************************************
+**
+** Function         RW_T4tStopNDefRead
+**
+** Description      This function stops the NDEF read procedure after the
+**                  current segment. It must be called from the callback of
+**                  RW_T4T_NDEF_READ_EVT; no further READ BINARY is sent and
+**                  no more event is returned for this read.
+**
+** Returns          NFC_STATUS_OK if success
+**                  NFC_STATUS_FAILED if T4T is not reading NDEF
+**
+*******************************************************************************/
+tNFC_STATUS RW_T4tStopNDefRead (void)
+{
+    RW_TRACE_API0 ("RW_T4tStopNDefRead ()");
+
+    if (rw_cb.tcb.t4t.state != RW_T4T_STATE_READ_NDEF)
+    {
+        RW_TRACE_ERROR1 ("RW_T4tStopNDefRead ():Not reading NDEF, state (0x%X)",
+                          rw_cb.tcb.t4t.state);
+        return NFC_STATUS_FAILED;
+    }
+
+    rw_cb.tcb.t4t.rw_length = 0;
+    rw_cb.tcb.t4t.state     = RW_T4T_STATE_IDLE;
+
+    return NFC_STATUS_OK;
+}
+
 /*******************************************************************************
 **
 ** Function         RW_T4tUpdateNDef
@@ -2405,7 +2768,7 @@ tNFC_STATUS RW_T4tUpdateNDef (UINT16 length, UINT8 *p_data)
             return NFC_STATUS_FAILED;
         }
 
-        if (rw_cb.tcb.t4t.cc_file.ndef_fc.max_file_size < length + T4T_FILE_LENGTH_SIZE)
+        if (rw_cb.tcb.t4t.cc_file.ndef_fc.max_file_size < (UINT32) length + rw_cb.tcb.t4t.nlen_size)
         {
             RW_TRACE_ERROR2 ("RW_T4tUpdateNDef ():data (%d bytes) plus NLEN is more than max file size (%d)",
                               length, rw_cb.tcb.t4t.cc_file.ndef_fc.max_file_size);
@@ -2416,7 +2779,7 @@ tNFC_STATUS RW_T4tUpdateNDef (UINT16 length, UINT8 *p_data)
         rw_cb.tcb.t4t.ndef_length   = length;
         rw_cb.tcb.t4t.p_update_data = p_data;
 
-        rw_cb.tcb.t4t.rw_offset     = T4T_FILE_LENGTH_SIZE;
+        rw_cb.tcb.t4t.rw_offset     = rw_cb.tcb.t4t.nlen_size;
         rw_cb.tcb.t4t.rw_length     = length;
 
         /* set NLEN to 0x0000 for the first step */
@@ -59,7 +59,7 @@ const tT1T_INIT_TAG t1t_init_content[] =
     {RW_T1T_IS_TOPAZ512,0x3F,       TRUE,       {0xF2,   0x30,   0x33},   {0xF0,   0x02,   0x03}}
 };
 
-#define T2T_MAX_NUM_OPCODES         3
+#define T2T_MAX_NUM_OPCODES         4
 #define T2T_MAX_TAG_MODELS          7
 
 const tT2T_CMD_RSP_INFO t2t_cmd_rsp_infos[] =
@@ -69,7 +69,8 @@ const tT2T_CMD_RSP_INFO t2t_cmd_rsp_infos[] =
 /*  opcode            cmd_len,   rsp_len, nack_rsp_len */
     {T2T_CMD_READ,      2,          16,     1},
     {T2T_CMD_WRITE,     6,          1,      1},
-    {T2T_CMD_SEC_SEL,   2,          1,      1}
+    {T2T_CMD_SEC_SEL,   2,          1,      1},
+    {T2T_CMD_FAST_READ, 3,          0,      1}      /* rsp_len depends on the requested range */
 };
 
 const tT2T_INIT_TAG t2t_init_content[] =
@@ -104,7 +105,8 @@ const char * const t1t_cmd_str[] = {
 const char * const t2t_cmd_str[] = {
     "T2T_CMD_READ",
     "T2T_CMD_WRITE",
-    "T2T_CMD_SEC_SEL"
+    "T2T_CMD_SEC_SEL",
+    "T2T_CMD_FAST_READ"
 };
 #endif
 
@@ -97,9 +97,21 @@ static uint8_t phFriNfc_MifStd_H_GetSectorTrailerBlkNo(uint8_t SectorID );
 static NFCSTATUS phFriNfc_MifStd_H_ProSectorTrailorAcsBits(phFriNfc_NdefMap_t *NdefMap);
 static NFCSTATUS phFriNfc_MifStd_H_WrSectorTrailorBlock(phFriNfc_NdefMap_t *NdefMap);
 static NFCSTATUS phFriNfc_MifStd_H_ProWrSectorTrailor(phFriNfc_NdefMap_t *NdefMap);
+static NFCSTATUS phFriNfc_MifStd_H_ChkNdefMadDone(phFriNfc_NdefMap_t *NdefMap);
+static phFriNfc_MifStd_CacheEntry_t *phFriNfc_MifStd_H_GetCache(const phFriNfc_NdefMap_t *NdefMap,
+                                                                uint8_t                  Alloc);
+static void phFriNfc_MifStd_H_CacheMad(const phFriNfc_NdefMap_t *NdefMap);
+static uint8_t phFriNfc_MifStd_H_GetCachedMad(phFriNfc_NdefMap_t *NdefMap);
+static void phFriNfc_MifStd_H_CacheTrailer(const phFriNfc_NdefMap_t *NdefMap);
+static uint8_t phFriNfc_MifStd_H_GetCachedTrailer(phFriNfc_NdefMap_t *NdefMap);
 static NFCSTATUS   phFriNfc_MapTool_ChkSpcVer( const phFriNfc_NdefMap_t  *NdefMap,
                                         uint8_t             VersionIndex) __attribute__((unused));
 
+/* MAD and sector trailers of the last few cards, see phFriNfc_MifStd_H_GetCache */
+static phFriNfc_MifStd_CacheEntry_t gphFriNfc_MifStd_Cache[PH_FRINFC_MIFARESTD_CACHE_ENTRIES];
+/* Next entry to be replaced when the cache is full */
+static uint8_t gphFriNfc_MifStd_CacheNext = 0;
+
 /* Mifare Standard Mapping - Constants */
 #define PH_FRINFC_NDEFMAP_MIFARESTD_AUTH_MADSECT1        0xA0 /* internal Authenticate Command for MAD Sector */
 #define PH_FRINFC_NDEFMAP_MIFARESTD_AUTH_MADSECT2        0xA1 /* internal Authenticate Command for MAD Sector */
@@ -384,6 +396,13 @@ NFCSTATUS phFriNfc_MifareStdMap_ChkNdef( phFriNfc_NdefMap_t     *NdefMap)
         {
             status = PHNFCSTVAL(CID_FRI_NFC_NDEF_MAP, NFCSTATUS_INVALID_PARAMETER);
         }
+        else if((NdefMap->StdMifareContainer.currentBlock == PH_FRINFC_MIFARESTD_MAD_BLK0) &&
+                (phFriNfc_MifStd_H_GetCachedMad(NdefMap) == PH_FRINFC_MIFARESTD_FLAG1))
+        {
+            /*  The MAD of this card has been read on an earlier tap,
+                so go straight to the first NDEF compliant sector */
+            status = phFriNfc_MifStd_H_ChkNdefMadDone(NdefMap);
+        }
         else if( NdefMap->StdMifareContainer.AuthDone == 0)
         {
             /*  Block 0 contains Manufacturer information and
@@ -941,6 +960,8 @@ void phFriNfc_MifareStdMap_Process( void       *Context,
             case PH_FRINFC_NDEFMAP_STATE_WRITE_SEC:
                 /* Set flag for writing of Acs bit */
                 NdefMap->StdMifareContainer.WriteAcsBitFlag = PH_FRINFC_MIFARESTD_FLAG1;
+                /* A sector trailer has changed, forget the cached ones */
+                phFriNfc_MifareStdMap_InvalidateCache(NdefMap);
 
                 /* The first NDEF sector is already made read only,
                    set card state to read only and proceed*/
@@ -1363,6 +1384,12 @@ static void phFriNfc_MifStd_H_Complete(phFriNfc_NdefMap_t  *NdefMap,
     /* set the state back to the Reset_Init state */
     NdefMap->State =  PH_FRINFC_NDEFMAP_STATE_RESET_INIT;
 
+    /* The cached MAD or sector trailers may no longer match the card */
+    if(Result != NFCSTATUS_SUCCESS)
+    {
+        phFriNfc_MifareStdMap_InvalidateCache(NdefMap);
+    }
+
     /* set the completion routine */
     NdefMap->CompletionRoutine[NdefMap->StdMifareContainer.CRIndex].
         CompletionRoutine(NdefMap->CompletionRoutine->Context, Result);
@@ -3619,32 +3646,54 @@ static NFCSTATUS phFriNfc_MifStd_H_ProChkNdef(phFriNfc_NdefMap_t        *NdefMap
     if(NdefMap->StdMifareContainer.aidCompleteFlag ==
                         PH_FRINFC_MIFARESTD_FLAG1)
     {
-        NdefMap->StdMifareContainer.ChkNdefCompleteFlag =
-                        PH_FRINFC_MIFARESTD_FLAG1;
-        /*  The check for NDEF compliant information is now over for
-            the Mifare 1K card.
-            Update(decrement) the NoOfNdefCompBlocks as much required,
-            depending on the NDEF compliant information found */
-        /* Check the Sectors are Ndef Compliant */
-        phFriNfc_MifStd_H_ChkNdefCmpltSects(NdefMap);
-        if((NdefMap->StdMifareContainer.NoOfNdefCompBlocks == 0) ||
-            (NdefMap->StdMifareContainer.NoOfNdefCompBlocks > 255))
-        {
-            Result = PHNFCSTVAL( CID_FRI_NFC_NDEF_MAP,
-                                NFCSTATUS_NO_NDEF_SUPPORT);
-        }
-        else
-        {
-            NdefMap->StdMifareContainer.aidCompleteFlag =
-                            PH_FRINFC_MIFARESTD_FLAG0;
-            NdefMap->StdMifareContainer.NFCforumSectFlag =
-                                    PH_FRINFC_MIFARESTD_FLAG0;
-            NdefMap->StdMifareContainer.currentBlock = PH_FRINFC_MIFARESTD_BLK4;
-            Result = phFriNfc_MifStd_H_BlkChk(NdefMap);
-            Result = ((Result != NFCSTATUS_SUCCESS)?
-                        Result:phFriNfc_MifStd_H_AuthSector(NdefMap));
-        }
+        /* Remember the MAD for the next tap of this card */
+        phFriNfc_MifStd_H_CacheMad(NdefMap);
+        Result = phFriNfc_MifStd_H_ChkNdefMadDone(NdefMap);
+    }
 
+    return Result;
+}
+
+/******************************************************************************
+ * Function         phFriNfc_MifStd_H_ChkNdefMadDone
+ *
+ * Description      This function is called once the aid array is filled,
+ *                  either from the MAD blocks or from the cache. It counts
+ *                  the NDEF compliant blocks and authenticates the first
+ *                  NDEF compliant sector.
+ *
+ * Returns          This function return NFCSTATUS_PENDING in case of success
+ *                  In case of failure returns other failure value.
+ *
+ ******************************************************************************/
+static NFCSTATUS phFriNfc_MifStd_H_ChkNdefMadDone(phFriNfc_NdefMap_t *NdefMap)
+{
+    NFCSTATUS   Result = NFCSTATUS_SUCCESS;
+
+    NdefMap->StdMifareContainer.ChkNdefCompleteFlag =
+                    PH_FRINFC_MIFARESTD_FLAG1;
+    /*  The check for NDEF compliant information is now over for
+        the Mifare 1K card.
+        Update(decrement) the NoOfNdefCompBlocks as much required,
+        depending on the NDEF compliant information found */
+    /* Check the Sectors are Ndef Compliant */
+    phFriNfc_MifStd_H_ChkNdefCmpltSects(NdefMap);
+    if((NdefMap->StdMifareContainer.NoOfNdefCompBlocks == 0) ||
+        (NdefMap->StdMifareContainer.NoOfNdefCompBlocks > 255))
+    {
+        Result = PHNFCSTVAL( CID_FRI_NFC_NDEF_MAP,
+                            NFCSTATUS_NO_NDEF_SUPPORT);
+    }
+    else
+    {
+        NdefMap->StdMifareContainer.aidCompleteFlag =
+                        PH_FRINFC_MIFARESTD_FLAG0;
+        NdefMap->StdMifareContainer.NFCforumSectFlag =
+                                PH_FRINFC_MIFARESTD_FLAG0;
+        NdefMap->StdMifareContainer.currentBlock = PH_FRINFC_MIFARESTD_BLK4;
+        Result = phFriNfc_MifStd_H_BlkChk(NdefMap);
+        Result = ((Result != NFCSTATUS_SUCCESS)?
+                    Result:phFriNfc_MifStd_H_AuthSector(NdefMap));
     }
 
     return Result;
@@ -3675,7 +3724,12 @@ static NFCSTATUS phFriNfc_MifStd_H_ProAuth(phFriNfc_NdefMap_t       *NdefMap)
     {
         NdefMap->StdMifareContainer.AuthDone = 1;
         NdefMap->StdMifareContainer.ReadAcsBitFlag = 1;
-        Result = phFriNfc_MifStd_H_RdAcsBit(NdefMap);
+        /* If the sector trailer is already known, process it straight
+           away so the first data block follows the authentication */
+        Result = ((phFriNfc_MifStd_H_GetCachedTrailer(NdefMap) ==
+                    PH_FRINFC_MIFARESTD_FLAG1)?
+                    phFriNfc_MifStd_H_ProAcsBits(NdefMap):
+                    phFriNfc_MifStd_H_RdAcsBit(NdefMap));
     }
 
     return Result;
@@ -3731,6 +3785,8 @@ static NFCSTATUS phFriNfc_MifStd_H_ProAcsBits(phFriNfc_NdefMap_t        *NdefMap
         if(NdefMap->StdMifareContainer.ReadAcsBitFlag ==
             PH_FRINFC_MIFARESTD_FLAG1)
         {
+            phFriNfc_MifStd_H_CacheTrailer(NdefMap);
+
             /* check for the correct access bits */
             Result = phFriNfc_MifStd_H_ChkAcsBit(NdefMap);
 
@@ -5564,6 +5620,9 @@ phFriNfc_MifareStdMap_ConvertToReadOnly (
              totalNoSectors  = PH_FRINFC_MIFARESTD4K_TOTAL_SECTOR;
         }
 
+        /* The sector trailers are about to be rewritten */
+        phFriNfc_MifareStdMap_InvalidateCache(NdefMap);
+
         /* Store Key B in the context */
         if(ScrtKeyB ==NULL)
         {
@@ -5913,3 +5972,201 @@ static NFCSTATUS   phFriNfc_MapTool_ChkSpcVer( const phFriNfc_NdefMap_t  *NdefMa
 
     return (status);
 }
+
+/******************************************************************************
+ * Function         phFriNfc_MifStd_H_GetCache
+ *
+ * Description      This function looks up the cache entry of the card in the
+ *                  field by UID. If Alloc is set and the card is not known,
+ *                  the oldest entry is recycled for it.
+ *
+ * Returns          Pointer to the cache entry, NULL if there is none (or the
+ *                  UID of the card is not known).
+ *
+ ******************************************************************************/
+static phFriNfc_MifStd_CacheEntry_t *phFriNfc_MifStd_H_GetCache(const phFriNfc_NdefMap_t *NdefMap,
+                                                                uint8_t                  Alloc)
+{
+    phFriNfc_MifStd_CacheEntry_t *pEntry = NULL;
+    const phNfc_sIso14443AInfo_t *pInfo;
+    uint8_t index = 0;
+
+    if(NdefMap->psRemoteDevInfo == NULL)
+    {
+        return NULL;
+    }
+
+    pInfo = &NdefMap->psRemoteDevInfo->RemoteDevInfo.Iso14443A_Info;
+    if((pInfo->UidLength == 0) || (pInfo->UidLength > PHNFC_MAX_UID_LENGTH))
+    {
+        return NULL;
+    }
+
+    for(index = 0; index < PH_FRINFC_MIFARESTD_CACHE_ENTRIES; index++)
+    {
+        if((gphFriNfc_MifStd_Cache[index].UidLength == pInfo->UidLength) &&
+           (gphFriNfc_MifStd_Cache[index].CardType == NdefMap->CardType) &&
+           (memcmp(gphFriNfc_MifStd_Cache[index].Uid, pInfo->Uid, pInfo->UidLength) == 0))
+        {
+            pEntry = &gphFriNfc_MifStd_Cache[index];
+            break;
+        }
+    }
+
+    if((pEntry == NULL) && (Alloc == PH_FRINFC_MIFARESTD_FLAG1))
+    {
+        pEntry = &gphFriNfc_MifStd_Cache[gphFriNfc_MifStd_CacheNext];
+        gphFriNfc_MifStd_CacheNext = (uint8_t)((gphFriNfc_MifStd_CacheNext + 1) %
+                                        PH_FRINFC_MIFARESTD_CACHE_ENTRIES);
+        memset(pEntry, 0, sizeof(phFriNfc_MifStd_CacheEntry_t));
+        memcpy(pEntry->Uid, pInfo->Uid, pInfo->UidLength);
+        pEntry->UidLength = pInfo->UidLength;
+        pEntry->CardType = NdefMap->CardType;
+    }
+
+    return pEntry;
+}
+
+/******************************************************************************
+ * Function         phFriNfc_MifStd_H_CacheMad
+ *
+ * Description      This function stores the aid array built from the MAD
+ *                  blocks in the cache entry of the card.
+ *
+ * Returns          void
+ *
+ ******************************************************************************/
+static void phFriNfc_MifStd_H_CacheMad(const phFriNfc_NdefMap_t *NdefMap)
+{
+    phFriNfc_MifStd_CacheEntry_t *pEntry =
+                    phFriNfc_MifStd_H_GetCache(NdefMap, PH_FRINFC_MIFARESTD_FLAG1);
+
+    if(pEntry != NULL)
+    {
+        memcpy(pEntry->aid, NdefMap->StdMifareContainer.aid, sizeof(pEntry->aid));
+        pEntry->MadValid = PH_FRINFC_MIFARESTD_FLAG1;
+    }
+
+    return;
+}
+
+/******************************************************************************
+ * Function         phFriNfc_MifStd_H_GetCachedMad
+ *
+ * Description      This function restores the aid array from the cache, so
+ *                  that check ndef does not have to authenticate and read
+ *                  the MAD sector(s) again.
+ *
+ * Returns          PH_FRINFC_MIFARESTD_FLAG1 if the aid array was restored,
+ *                  PH_FRINFC_MIFARESTD_FLAG0 otherwise.
+ *
+ ******************************************************************************/
+static uint8_t phFriNfc_MifStd_H_GetCachedMad(phFriNfc_NdefMap_t *NdefMap)
+{
+    phFriNfc_MifStd_CacheEntry_t *pEntry =
+                    phFriNfc_MifStd_H_GetCache(NdefMap, PH_FRINFC_MIFARESTD_FLAG0);
+
+    if((pEntry == NULL) || (pEntry->MadValid != PH_FRINFC_MIFARESTD_FLAG1))
+    {
+        return PH_FRINFC_MIFARESTD_FLAG0;
+    }
+
+    memcpy(NdefMap->StdMifareContainer.aid, pEntry->aid, sizeof(pEntry->aid));
+    NdefMap->StdMifareContainer.ChkNdefFlag = PH_FRINFC_MIFARESTD_FLAG1;
+    NdefMap->CardState = PH_NDEFMAP_CARD_STATE_INITIALIZED;
+
+    return PH_FRINFC_MIFARESTD_FLAG1;
+}
+
+/******************************************************************************
+ * Function         phFriNfc_MifStd_H_CacheTrailer
+ *
+ * Description      This function stores the sector trailer that has just
+ *                  been read for the sector of the current block.
+ *
+ * Returns          void
+ *
+ ******************************************************************************/
+static void phFriNfc_MifStd_H_CacheTrailer(const phFriNfc_NdefMap_t *NdefMap)
+{
+    phFriNfc_MifStd_CacheEntry_t *pEntry = NULL;
+    uint8_t SectorID = phFriNfc_MifStd_H_GetSect(NdefMap->StdMifareContainer.currentBlock);
+
+    if(SectorID >= PH_FRINFC_NDEFMAP_MIFARESTD_TOTALNO_BLK)
+    {
+        return;
+    }
+
+    pEntry = phFriNfc_MifStd_H_GetCache(NdefMap, PH_FRINFC_MIFARESTD_FLAG1);
+    if(pEntry != NULL)
+    {
+        memcpy(pEntry->Trailer[SectorID], NdefMap->SendRecvBuf,
+                PH_FRINFC_MIFARESTD_BLOCK_BYTES);
+        pEntry->TrailerValid[SectorID] = PH_FRINFC_MIFARESTD_FLAG1;
+    }
+
+    return;
+}
+
+/******************************************************************************
+ * Function         phFriNfc_MifStd_H_GetCachedTrailer
+ *
+ * Description      This function puts the cached sector trailer of the
+ *                  current sector in the receive buffer as if it had just
+ *                  been read, instead of reading the access bits again.
+ *                  It is not used while converting the card to read only.
+ *
+ * Returns          PH_FRINFC_MIFARESTD_FLAG1 if the trailer was taken from
+ *                  the cache, PH_FRINFC_MIFARESTD_FLAG0 otherwise.
+ *
+ ******************************************************************************/
+static uint8_t phFriNfc_MifStd_H_GetCachedTrailer(phFriNfc_NdefMap_t *NdefMap)
+{
+    phFriNfc_MifStd_CacheEntry_t *pEntry = NULL;
+    uint8_t SectorID = phFriNfc_MifStd_H_GetSect(NdefMap->StdMifareContainer.currentBlock);
+
+    if((SectorID >= PH_FRINFC_NDEFMAP_MIFARESTD_TOTALNO_BLK) ||
+        (NdefMap->StdMifareContainer.ReadOnlySectorIndex != PH_FRINFC_MIFARESTD_VAL0))
+    {
+        return PH_FRINFC_MIFARESTD_FLAG0;
+    }
+
+    pEntry = phFriNfc_MifStd_H_GetCache(NdefMap, PH_FRINFC_MIFARESTD_FLAG0);
+    if((pEntry == NULL) || (pEntry->TrailerValid[SectorID] != PH_FRINFC_MIFARESTD_FLAG1))
+    {
+        return PH_FRINFC_MIFARESTD_FLAG0;
+    }
+
+    NdefMap->State = PH_FRINFC_NDEFMAP_STATE_RD_ACS_BIT;
+    memcpy(NdefMap->SendRecvBuf, pEntry->Trailer[SectorID],
+            PH_FRINFC_MIFARESTD_BLOCK_BYTES);
+    *NdefMap->SendRecvLength = PH_FRINFC_MIFARESTD_BYTES_READ;
+
+    return PH_FRINFC_MIFARESTD_FLAG1;
+}
+
+/******************************************************************************
+ * Function         phFriNfc_MifareStdMap_InvalidateCache
+ *
+ * Description      This function drops the cached MAD and sector trailers of
+ *                  the card in the field. It has to be called whenever a
+ *                  MAD or sector trailer block may have been written.
+ *
+ * Returns          void
+ *
+ ******************************************************************************/
+void phFriNfc_MifareStdMap_InvalidateCache(const phFriNfc_NdefMap_t *NdefMap)
+{
+    phFriNfc_MifStd_CacheEntry_t *pEntry = NULL;
+
+    if(NdefMap != NULL)
+    {
+        pEntry = phFriNfc_MifStd_H_GetCache(NdefMap, PH_FRINFC_MIFARESTD_FLAG0);
+        if(pEntry != NULL)
+        {
+            memset(pEntry, 0, sizeof(phFriNfc_MifStd_CacheEntry_t));
+        }
+    }
+
+    return;
+}
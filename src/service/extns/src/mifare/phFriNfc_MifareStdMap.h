@@ -193,6 +193,26 @@
 #define PH_FRINFC_MIFARESTD_GPB_RD_WR_VAL                 0x00 /* GPB Read Write value */
 #define PH_FRINFC_MIFARESTD_KEY_LEN                       0x06 /* MIFARE Std key length */
 #define PH_FRINFC_MIFARESTD_DEFAULT_KEY                   0xFF /* MIFARE Std Default Key */
+#define PH_FRINFC_MIFARESTD_CACHE_ENTRIES                 4 /* Number of cards remembered by the
+                                                               MAD/sector trailer cache */
+
+/* MAD and sector trailer contents of a card seen before, keyed by its UID.
+   Used to skip the MAD reads and the per sector access bit reads when the
+   same card is tapped again */
+typedef struct phFriNfc_MifStd_CacheEntry
+{
+    /* UID of the card, UidLength 0 means the entry is free */
+    uint8_t             Uid[PHNFC_MAX_UID_LENGTH];
+    uint8_t             UidLength;
+    /* Card type (1k/2k/4k) the entry was built for */
+    uint8_t             CardType;
+    /* aid[] holds the NDEF compliance of each sector read from the MAD */
+    uint8_t             MadValid;
+    uint8_t             aid[PH_FRINFC_NDEFMAP_MIFARESTD_TOTALNO_BLK];
+    /* Sector trailer of each sector, valid if TrailerValid is set */
+    uint8_t             TrailerValid[PH_FRINFC_NDEFMAP_MIFARESTD_TOTALNO_BLK];
+    uint8_t             Trailer[PH_FRINFC_NDEFMAP_MIFARESTD_TOTALNO_BLK][PH_FRINFC_MIFARESTD_BLOCK_BYTES];
+}phFriNfc_MifStd_CacheEntry_t;
 
 
 NFCSTATUS phFriNfc_MifareStdMap_H_Reset(  phFriNfc_NdefMap_t        *NdefMap);
@@ -215,4 +235,6 @@ NFCSTATUS phFrinfc_MifareClassic_GetContainerSize(const phFriNfc_NdefMap_t *Ndef
 NFCSTATUS
 phFriNfc_MifareStdMap_ConvertToReadOnly (phFriNfc_NdefMap_t *NdefMap, const uint8_t *ScrtKeyB);
 
+void phFriNfc_MifareStdMap_InvalidateCache(const phFriNfc_NdefMap_t *NdefMap);
+
 #endif /* PHFRINFC_MIFARESTDMAP_H */
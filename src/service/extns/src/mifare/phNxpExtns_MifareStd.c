@@ -974,6 +974,8 @@ NFCSTATUS Mfc_FormatNdef(uint8_t *secretkey, uint8_t len)
                         PH_FRINFC_SMTCRDFMT_MFSTD_1K_CRD:(((sak & 0x19) == 0x19)?
                         PH_FRINFC_SMTCRDFMT_MFSTD_2K_CRD:
                         PH_FRINFC_SMTCRDFMT_MFSTD_4K_CRD));
+        /* Formatting rewrites the MAD and all sector trailers */
+        phFriNfc_MifareStdMap_InvalidateCache(NdefMap);
         status = phFriNfc_MfStd_Format( NdefSmtCrdFmt, mif_std_key);
     }
 
@@ -1106,6 +1108,8 @@ NFCSTATUS Mfc_Transceive(uint8_t *p_data, uint32_t len)
         EXTNS_SetCallBackFlag(FALSE);
         NdefMap->Cmd.MfCmd = phNfc_eMifareWrite16;
         gphNxpExtns_Context.RawWriteCallBack = TRUE;
+        /* The block may be a MAD or sector trailer block */
+        phFriNfc_MifareStdMap_InvalidateCache(NdefMap);
 
         memcpy(NdefMap->SendRecvBuf, &p_data[1], len-1);
         NdefMap->SendLength = len-1;
@@ -443,6 +443,20 @@ NFCSTATUS EXTNS_MfcInit(tNFA_ACTIVATED activationData)
     NdefMap->psRemoteDevInfo->RemoteDevInfo.Iso14443A_Info.AtqA[0] = rfDetail.rf_tech_param.param.pa.sens_res[0];
     NdefMap->psRemoteDevInfo->RemoteDevInfo.Iso14443A_Info.AtqA[1] = rfDetail.rf_tech_param.param.pa.sens_res[1];
 
+    /* UID is used by the Mifare Std map to recognise a card seen before */
+    if (rfDetail.rf_tech_param.param.pa.nfcid1_len <= PHNFC_MAX_UID_LENGTH)
+    {
+        memcpy(NdefMap->psRemoteDevInfo->RemoteDevInfo.Iso14443A_Info.Uid,
+               rfDetail.rf_tech_param.param.pa.nfcid1,
+               rfDetail.rf_tech_param.param.pa.nfcid1_len);
+        NdefMap->psRemoteDevInfo->RemoteDevInfo.Iso14443A_Info.UidLength =
+                                    rfDetail.rf_tech_param.param.pa.nfcid1_len;
+    }
+    else
+    {
+        NdefMap->psRemoteDevInfo->RemoteDevInfo.Iso14443A_Info.UidLength = 0;
+    }
+
     return NFCSTATUS_SUCCESS;
 }
 
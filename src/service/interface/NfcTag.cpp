@@ -93,6 +93,8 @@ NfcTag::NfcTag ()
     mReadCompletedStatus (NFA_STATUS_OK),
     mLastKovioUidLen (0),
     mNdefDetectionTimedOut (false),
+    mInventoryStatus (NFA_STATUS_OK),
+    mInventoryNumUids (0),
     mIsDynamicTagId (false),
     mPresenceCheckAlgorithm (NFA_RW_PRES_CHK_DEFAULT),
     mIsFelicaLite(false)
@@ -166,8 +168,15 @@ void NfcTag::initialize ()
 *******************************************************************************/
 void NfcTag::abort ()
 {
-    SyncEventGuard g (mReadCompleteEvent);
-    mReadCompleteEvent.notifyOne ();
+    {
+        SyncEventGuard g (mReadCompleteEvent);
+        mReadCompleteEvent.notifyOne ();
+    }
+    {
+        SyncEventGuard g (mInventoryEvent);
+        mInventoryStatus = NFA_STATUS_FAILED;
+        mInventoryEvent.notifyOne ();
+    }
 }
 
 
@@ -1259,6 +1268,189 @@ void NfcTag::selectTag (int tagHandle)
 }
 
 
+/*******************************************************************************
+**
+** Function:        setInventoryUid
+**
+** Description:     Fill tag's uid from technology parameters of a discovery
+**                  or activation notification.  Uses the same byte order as
+**                  setNfcTagUid.
+**                  tag: tag information to fill.
+**                  techParams: technology parameters of the tag.
+**
+** Returns:         None
+**
+*******************************************************************************/
+void NfcTag::setInventoryUid (nfc_tag_info_t& tag, tNFC_RF_TECH_PARAMS& techParams)
+{
+    tag.uid_length = 0;
+    switch (techParams.mode)
+    {
+    case NFC_DISCOVERY_TYPE_POLL_A:
+    case NFC_DISCOVERY_TYPE_POLL_A_ACTIVE:
+        tag.uid_length = techParams.param.pa.nfcid1_len;
+        memcpy (tag.uid, techParams.param.pa.nfcid1, tag.uid_length);
+        break;
+
+    case NFC_DISCOVERY_TYPE_POLL_B:
+    case NFC_DISCOVERY_TYPE_POLL_B_PRIME:
+        tag.uid_length = NFC_NFCID0_MAX_LEN;
+        memcpy (tag.uid, techParams.param.pb.nfcid0, NFC_NFCID0_MAX_LEN);
+        break;
+
+    case NFC_DISCOVERY_TYPE_POLL_F:
+    case NFC_DISCOVERY_TYPE_POLL_F_ACTIVE:
+        tag.uid_length = NFC_NFCID2_LEN;
+        memcpy (tag.uid, techParams.param.pf.nfcid2, NFC_NFCID2_LEN);
+        break;
+
+    case NFC_DISCOVERY_TYPE_POLL_ISO15693:
+        tag.uid_length = I93_UID_BYTE_LEN;
+        memcpy (tag.uid, techParams.param.pi93.uid, I93_UID_BYTE_LEN);
+        break;
+
+    default:
+        if (NFC_DISCOVERY_TYPE_POLL_KOVIO == techParams.mode)
+        {
+            tag.uid_length = techParams.param.pk.uid_len;
+            memcpy (tag.uid, techParams.param.pk.uid, tag.uid_length);
+        }
+        break;
+    }
+}
+
+/*******************************************************************************
+**
+** Function:        addI93Inventory
+**
+** Description:     Run an ISO 15693 inventory search through the activated
+**                  tag and append the labels not yet in tags.  The labels
+**                  share the handle of the activated tag; they are read with
+**                  addressed commands through it.
+**                  tags: tag list to append to.
+**                  count: number of entries already in tags.
+**                  maxTags: capacity of tags.
+**
+** Returns:         New number of entries in tags.
+**
+*******************************************************************************/
+int NfcTag::addI93Inventory (nfc_tag_info_t* tags, int count, int maxTags)
+{
+    static const unsigned I93_INVENTORY_WAIT_MS = 20000; //safety net, search ends on its own
+    tNFA_STATUS stat = NFA_STATUS_FAILED;
+
+    {
+        SyncEventGuard g (mInventoryEvent);
+        mInventoryNumUids = 0;
+        stat = NFA_RwI93InventoryAll (FALSE, 0);
+        if (stat == NFA_STATUS_OK)
+        {
+            if (!mInventoryEvent.wait (I93_INVENTORY_WAIT_MS))
+            {
+                NXPLOG_API_E ("%s: timeout waiting for inventory", "NfcTag::addI93Inventory");
+                return count;
+            }
+            stat = mInventoryStatus;
+        }
+    }
+    if (stat != NFA_STATUS_OK)
+    {
+        NXPLOG_API_E ("%s: inventory failed; error=0x%X", "NfcTag::addI93Inventory", stat);
+        return count;
+    }
+
+    NXPLOG_API_D ("%s: %d labels answered", "NfcTag::addI93Inventory", mInventoryNumUids);
+    for (int i = 0; (i < mInventoryNumUids) && (count < maxTags); i++)
+    {
+        nfc_tag_info_t& tag = tags [count];
+        bool known = false;
+
+        //nfc_tag_info_t carries ISO 15693 UIDs LSB first, like setNfcTagUid
+        for (int j = 0; j < I93_UID_BYTE_LEN; j++)
+            tag.uid [j] = mInventoryUids [i][I93_UID_BYTE_LEN - j - 1];
+        for (int k = 0; k < count; k++)
+        {
+            if ((tags [k].uid_length == I93_UID_BYTE_LEN)
+                    && (memcmp (tags [k].uid, tag.uid, I93_UID_BYTE_LEN) == 0))
+            {
+                known = true;
+                break;
+            }
+        }
+        if (known)
+            continue;
+
+        tag.technology = TARGET_TYPE_ISO15693;
+        tag.handle = mTechHandles [mActivationIndex];
+        tag.protocol = NFA_PROTOCOL_ISO15693;
+        tag.uid_length = I93_UID_BYTE_LEN;
+        count++;
+    }
+    return count;
+}
+
+/*******************************************************************************
+**
+** Function:        getInventory
+**
+** Description:     Build the list of every tag seen in the field: the tags
+**                  reported by RF_DISCOVER_NTF (or the activated tag), plus
+**                  the ISO 15693 labels found by an inventory search when
+**                  the activated tag is an ISO 15693 tag.
+**                  gSyncMutex must be held.
+**                  tags: receives the tag information.
+**                  maxTags: capacity of tags.
+**
+** Returns:         Number of tags written to tags.
+**
+*******************************************************************************/
+int NfcTag::getInventory (nfc_tag_info_t* tags, int maxTags)
+{
+    int count = 0;
+
+    NXPLOG_API_D ("%s: enter; mNumDiscTechList=%d", "NfcTag::getInventory", mNumDiscTechList);
+
+    //one entry per RF discovery ID; a tag may be reported once per protocol
+    for (int i = 0; (i < mNumDiscTechList) && (count < maxTags); i++)
+    {
+        bool known = false;
+        for (int k = 0; k < count; k++)
+        {
+            if ((int) tags [k].handle == mDiscInfo.mDiscHandles [i])
+            {
+                known = true;
+                break;
+            }
+        }
+        if (known || (mDiscInfo.mDiscNfcTypes [i] == NFA_PROTOCOL_NFC_DEP))
+            continue;
+
+        tags [count].technology = mDiscInfo.mDiscList [i];
+        tags [count].handle = mDiscInfo.mDiscHandles [i];
+        tags [count].protocol = mDiscInfo.mDiscNfcTypes [i];
+        setInventoryUid (tags [count], mDiscInfo.mDiscParams [i]);
+        count++;
+    }
+
+    //single tag: the NFCC activated it without RF_DISCOVER_NTF
+    if ((count == 0) && (count < maxTags) && (mActivationState == Active) && (mNumTechList > 0))
+    {
+        tags [count].technology = mTechList [mActivationIndex];
+        tags [count].handle = mTechHandles [mActivationIndex];
+        tags [count].protocol = mTechLibNfcTypes [mActivationIndex];
+        setInventoryUid (tags [count], mTechParams [mActivationIndex]);
+        count++;
+    }
+
+    if ((mActivationState == Active) && (mProtocol == NFA_PROTOCOL_ISO15693))
+    {
+        count = addI93Inventory (tags, count, maxTags);
+    }
+
+    NXPLOG_API_D ("%s: exit; %d tags", "NfcTag::getInventory", count);
+    return count;
+}
+
 /*******************************************************************************
 **
 ** Function:        getT1tMaxMessageSize
@@ -1506,6 +1698,20 @@ void NfcTag::connectionEventHandler (UINT8 event, tNFA_CONN_EVT_DATA* data)
         }
         break;
 
+        case NFA_I93_INVENTORY_ALL_EVT:
+        {
+            tNFA_I93_INVENTORY_ALL& inventory = data->i93_inventory_all;
+            SyncEventGuard g (mInventoryEvent);
+            mInventoryStatus = inventory.status;
+            mInventoryNumUids = (inventory.status == NFA_STATUS_OK) ? inventory.num_uids : 0;
+            if (mInventoryNumUids > RW_I93_MAX_INVENTORY_UIDS)
+                mInventoryNumUids = RW_I93_MAX_INVENTORY_UIDS;
+            if (mInventoryNumUids > 0)
+                memcpy (mInventoryUids, inventory.p_uids, mInventoryNumUids * I93_UID_BYTE_LEN);
+            mInventoryEvent.notifyOne ();
+        }
+        break;
+
         case NFA_NDEF_DETECT_EVT:
         {
             tNFA_NDEF_DETECT& ndef_detect = data->ndef_detect;
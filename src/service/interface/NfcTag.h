@@ -42,7 +42,7 @@ extern "C"
     #include "linux_nfc_api.h"
 }
 
-#define MAX_TAGS_DISCOVERED   0x11U
+#define MAX_TAGS_DISCOVERED   0x40U
 
 typedef struct activationParams{
     int mTechParams;
@@ -258,6 +258,23 @@ public:
     *******************************************************************************/
     void selectTag (int tagHandle);
 
+    /*******************************************************************************
+    **
+    ** Function:        getInventory
+    **
+    ** Description:     Build the list of every tag seen in the field: the tags
+    **                  reported by RF_DISCOVER_NTF (or the activated tag), plus
+    **                  the ISO 15693 labels found by an inventory search when
+    **                  the activated tag is an ISO 15693 tag.
+    **                  gSyncMutex must be held.
+    **                  tags: receives the tag information.
+    **                  maxTags: capacity of tags.
+    **
+    ** Returns:         Number of tags written to tags.
+    **
+    *******************************************************************************/
+    int getInventory (nfc_tag_info_t* tags, int maxTags);
+
     /*******************************************************************************
     **
     ** Function:        getT1tMaxMessageSize
@@ -544,6 +561,10 @@ private:
     bool mNdefDetectionTimedOut; // whether NDEF detection algorithm timed out
     tNFC_RF_TECH_PARAMS mTechParams [MAX_NUM_TECHNOLOGY]; //array of technology parameters
     SyncEvent mReadCompleteEvent;
+    SyncEvent mInventoryEvent;
+    tNFA_STATUS mInventoryStatus;
+    int mInventoryNumUids;
+    UINT8 mInventoryUids [RW_I93_MAX_INVENTORY_UIDS][I93_UID_BYTE_LEN]; //UID[0]:MSB
     struct timespec mLastKovioTime; // time of last Kovio tag activation
     UINT8 mLastKovioUid[NFC_KOVIO_MAX_LEN]; // uid of last Kovio tag activated
     bool mIsDynamicTagId; // whether the tag has dynamic tag ID
@@ -638,6 +659,35 @@ private:
     *******************************************************************************/
     void setNfcTagUid (nfc_tag_info_t& tag, tNFA_ACTIVATED& activationData);
 
+    /*******************************************************************************
+    **
+    ** Function:        setInventoryUid
+    **
+    ** Description:     Fill tag's uid from technology parameters of a discovery
+    **                  or activation notification.
+    **                  tag: tag information to fill.
+    **                  techParams: technology parameters of the tag.
+    **
+    ** Returns:         None
+    **
+    *******************************************************************************/
+    void setInventoryUid (nfc_tag_info_t& tag, tNFC_RF_TECH_PARAMS& techParams);
+
+    /*******************************************************************************
+    **
+    ** Function:        addI93Inventory
+    **
+    ** Description:     Run an ISO 15693 inventory search through the activated
+    **                  tag and append the labels not yet in tags.
+    **                  tags: tag list to append to.
+    **                  count: number of entries already in tags.
+    **                  maxTags: capacity of tags.
+    **
+    ** Returns:         New number of entries in tags.
+    **
+    *******************************************************************************/
+    int addI93Inventory (nfc_tag_info_t* tags, int count, int maxTags);
+
     /*******************************************************************************
     **
     ** Function:        resetTechnologies
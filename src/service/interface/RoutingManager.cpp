@@ -47,6 +47,7 @@ extern "C"
     #include "nfc_api.h"
     #include "nfa_api.h"
     #include "nfa_ce_api.h"
+    #include "ce_int.h"
     #include "nci_config.h"
 }
 
@@ -65,19 +66,26 @@ extern bool isDiscoveryStarted();
 
 RoutingManager::RoutingManager ()
 : mRxDataBufferLen(0),
+  mRxDataOverflow(false),
+  mInDataCallback(false),
+  mResponsePending(false),
+  mTurnaroundTotalUs(0),
+  mTurnaroundCount(0),
+  mRoutingStatus(NFA_STATUS_OK),
   mActiveSe(ROUTE_HOST),
   mSeTechMask(0x0),
   mDefaultEe(ROUTE_HOST),
   mHostListnEnable (true),
   mFwdFuntnEnable (true),
   mSkipCheckNDEF (true),
+  mHostRouting (HOST_ROUTING_UNKNOWN),
   mCallback(NULL)
 {
     NXPLOG_API_D("%s: default route is 0x%02X\n",
                  "RoutingManager::RoutingManager()", mDefaultEe);
     mRxDataBuffer = (UINT8*)malloc(MAX_CE_RX_BUFFER_SIZE * sizeof(UINT8));
-    memset(mRxDataBuffer, 0, MAX_CE_RX_BUFFER_SIZE);
     mRxDataBufferLen = 0;
+    memset(&mHceStats, 0, sizeof(mHceStats));
 }
 
 RoutingManager::~RoutingManager ()
@@ -134,7 +142,9 @@ bool RoutingManager::initialize ()
             NXPLOG_API_E ("Failed to register wildcard AID for DH");
         }
     }
-    memset(mRxDataBuffer, 0, MAX_CE_RX_BUFFER_SIZE);
+    mRxDataBufferLen = 0;
+    mRxDataOverflow = false;
+    mHostRouting = HOST_ROUTING_UNKNOWN;
 
     if ((nfaStat = NFA_AllEeGetInfo (&mActualNumEe, mEeInfo)) != NFA_STATUS_OK)
     {
@@ -152,6 +162,7 @@ void RoutingManager::finalize()
     //NFA_CeDeregisterAidOnDH(mHostHandle);
     mCallback = NULL;
     mRxDataBufferLen = 0;
+    mHostRouting = HOST_ROUTING_UNKNOWN;
 }
 
 RoutingManager& RoutingManager::getInstance ()
@@ -163,14 +174,21 @@ RoutingManager& RoutingManager::getInstance ()
 void RoutingManager::enableRoutingToHost(bool skipCheckNDEF)
 {
     tNFA_STATUS nfaStat;
+    bool routed = true;
     NXPLOG_API_D ("%s enter", "RoutingManager::enableRoutingToHost()");
     mSkipCheckNDEF = skipCheckNDEF;
+    if (mHostRouting == HOST_ROUTING_ENABLED)
+    {
+        NXPLOG_API_D ("%s: routing to host unchanged", "RoutingManager::enableRoutingToHost()");
+        return;
+    }
     {
         SyncEventGuard guard (mRoutingEvent);
 
         // Route Nfc-A & B to host
         if (mSeTechMask == 0)
         {
+            mRoutingStatus = NFA_STATUS_FAILED;
             nfaStat = NFA_EeSetDefaultProtoRouting(mDefaultEe ,
                                         NFC_PROTOCOL_MASK_ISO7816|NFA_PROTOCOL_MASK_ISO_DEP,
                                         0, 0, 0, 0);
@@ -178,47 +196,64 @@ void RoutingManager::enableRoutingToHost(bool skipCheckNDEF)
             {
                 mRoutingEvent.wait ();
             }
-            else
+            if ((nfaStat != NFA_STATUS_OK) || (mRoutingStatus != NFA_STATUS_OK))
             {
                 NXPLOG_API_E ("Fail to set  iso7816 routing");
+                routed = false;
             }
         }
  
         // Route Nfc-F to host if we don't have a SE
+        mRoutingStatus = NFA_STATUS_FAILED;
         nfaStat = NFA_EeSetDefaultTechRouting (mDefaultEe, NFA_TECHNOLOGY_MASK_F, 0, 0,0,0);
         if (nfaStat == NFA_STATUS_OK)
         {
             mRoutingEvent.wait ();
         }
-        else
+        if ((nfaStat != NFA_STATUS_OK) || (mRoutingStatus != NFA_STATUS_OK))
         {
             NXPLOG_API_E ("Fail to set default tech routing for Nfc-F");
+            routed = false;
         }
      }
-    commitRouting();
+    if (!commitRouting())
+        routed = false;
+    // only skip the next call if everything was applied
+    mHostRouting = routed ? HOST_ROUTING_ENABLED : HOST_ROUTING_UNKNOWN;
 }
 
 void RoutingManager::disableRoutingToHost()
 {
     tNFA_STATUS nfaStat;
+    bool routed = true;
     NXPLOG_API_D ("%s enter", "RoutingManager::disableRoutingToHost()");
+    if (mHostRouting == HOST_ROUTING_DISABLED)
+    {
+        NXPLOG_API_D ("%s: routing to host unchanged", "RoutingManager::disableRoutingToHost()");
+        return;
+    }
     {
         SyncEventGuard guard (mRoutingEvent);
         // Default routing for NFC-A & B technology if we don't have a SE
         if (mSeTechMask == 0)
         {
+            mRoutingStatus = NFA_STATUS_FAILED;
             nfaStat = NFA_EeSetDefaultProtoRouting(mDefaultEe, 0, 0, 0, 0, 0);
             if (nfaStat == NFA_STATUS_OK)
             {
                 mRoutingEvent.wait ();
             }
-            else
+            if ((nfaStat != NFA_STATUS_OK) || (mRoutingStatus != NFA_STATUS_OK))
             {
                 NXPLOG_API_E ("Fail to set  iso7816 routing");
+                routed = false;
             }
         }
     }
-    commitRouting();
+    if (!commitRouting())
+        routed = false;
+    // only skip the next call if everything was applied
+    mHostRouting = routed ? HOST_ROUTING_DISABLED : HOST_ROUTING_UNKNOWN;
 }
 
 bool RoutingManager::commitRouting()
@@ -239,6 +274,13 @@ void RoutingManager::deregisterHostCallback()
 
 void RoutingManager::notifyHceActivated(UINT8 mode)
 {
+    mHceStatsMutex.lock();
+    memset(&mHceStats, 0, sizeof(mHceStats));
+    mTurnaroundTotalUs = 0;
+    mTurnaroundCount = 0;
+    mResponsePending = false;
+    mHceStatsMutex.unlock();
+
     if (nativeNfcManager_isNfcActive())
     {
         if (mCallback && (NULL != mCallback->onHostCardEmulationActivated))
@@ -262,6 +304,8 @@ void RoutingManager::notifyHceDeactivated()
 void RoutingManager::handleData (const UINT8* data, UINT32 dataLen, tNFA_STATUS status)
 {
     tNFA_STATUS nfaStat = NFA_STATUS_OK;
+    UINT8* apdu = (UINT8*) data;
+    UINT32 apduLen = dataLen;
 
     if (dataLen <= 0)
     {
@@ -271,15 +315,43 @@ void RoutingManager::handleData (const UINT8* data, UINT32 dataLen, tNFA_STATUS
 
     if (status == NFA_STATUS_CONTINUE)
     {
-        memcpy((mRxDataBuffer + mRxDataBufferLen), data, dataLen);
-        mRxDataBufferLen += dataLen;
+        if (mRxDataBufferLen + dataLen > MAX_CE_RX_BUFFER_SIZE)
+        {
+            NXPLOG_API_E("RoutingManager::handleData: chained C-APDU too long");
+            mRxDataOverflow = true;
+        }
+        else if (!mRxDataOverflow)
+        {
+            memcpy((mRxDataBuffer + mRxDataBufferLen), data, dataLen);
+            mRxDataBufferLen += dataLen;
+        }
         return; //expect another NFA_CE_DATA_EVT to come
     }
     else if (status == NFA_STATUS_OK)
     {
-        memcpy(mRxDataBuffer, data, dataLen);
-        mRxDataBufferLen = dataLen;
         //entire data packet has been received; no more NFA_CE_DATA_EVT
+        //only a chained C-APDU is copied, so only that one is limited by the buffer
+        if (mRxDataOverflow ||
+            ((mRxDataBufferLen > 0) && (mRxDataBufferLen + dataLen > MAX_CE_RX_BUFFER_SIZE)))
+        {
+            NXPLOG_API_E("RoutingManager::handleData: chained C-APDU too long, dropped");
+            mHceStatsMutex.lock();
+            mHceStats.dropped_count++;
+            mHceStatsMutex.unlock();
+            goto TheEnd;
+        }
+        if (mRxDataBufferLen > 0)
+        {
+            //last part of chained C-APDU
+            memcpy((mRxDataBuffer + mRxDataBufferLen), data, dataLen);
+            mRxDataBufferLen += dataLen;
+            apdu = mRxDataBuffer;
+            apduLen = mRxDataBufferLen;
+            mHceStatsMutex.lock();
+            mHceStats.chained_count++;
+            mHceStatsMutex.unlock();
+        }
+        //otherwise give the C-APDU to the application straight from the stack buffer
     }
     else if (status == NFA_STATUS_FAILED)
     {
@@ -287,7 +359,7 @@ void RoutingManager::handleData (const UINT8* data, UINT32 dataLen, tNFA_STATUS
         goto TheEnd;
     }
     if (mSkipCheckNDEF
-            && mRxDataBufferLen == T4T_CHECK_NDEF_APDU_LENGTH && memcmp(mRxDataBuffer, T4T_CHECK_NDEF_APDU, T4T_CHECK_NDEF_APDU_LENGTH) == 0)
+            && apduLen == T4T_CHECK_NDEF_APDU_LENGTH && memcmp(apdu, T4T_CHECK_NDEF_APDU, T4T_CHECK_NDEF_APDU_LENGTH) == 0)
     {
         //ignore check Ndef command, interop with PN544
         nfaStat = NFA_Deactivate (FALSE);
@@ -301,12 +373,166 @@ void RoutingManager::handleData (const UINT8* data, UINT32 dataLen, tNFA_STATUS
     {
         if (mCallback && (NULL != mCallback->onDataReceived))
         {
-            mCallback->onDataReceived(mRxDataBuffer, mRxDataBufferLen);
+            mHceStatsMutex.lock();
+            mHceStats.apdu_count++;
+            mResponsePending = true;
+            clock_gettime(CLOCK_MONOTONIC, &mRxDataTime);
+            mHceStatsMutex.unlock();
+
+            //the application may reply from the callback, see sendResponse()
+            mDataCallbackThread = pthread_self();
+            mInDataCallback = true;
+            mCallback->onDataReceived(apdu, apduLen);
+            mInDataCallback = false;
         }
     }
 TheEnd:
-    memset(mRxDataBuffer, 0, MAX_CE_RX_BUFFER_SIZE);
     mRxDataBufferLen = 0;
+    mRxDataOverflow = false;
+}
+
+/*******************************************************************************
+**
+** Function:        sendResponse
+**
+** Description:     Send a R-APDU to the remote reader and measure the time
+**                  since its C-APDU was received.
+**                  When called from onDataReceived, the frame is sent without
+**                  taking gSyncMutex: another thread may hold it while waiting
+**                  for an event from the stack thread running the callback.
+**                  buf: R-APDU.
+**                  bufLen: R-APDU length.
+**
+** Returns:         NFA_STATUS_OK if sent.
+**
+*******************************************************************************/
+INT32 RoutingManager::sendResponse (UINT8* buf, UINT32 bufLen)
+{
+    tNFA_STATUS status;
+    struct timespec now;
+    UINT32 turnaroundUs;
+
+    if (mInDataCallback && pthread_equal(mDataCallbackThread, pthread_self()))
+    {
+        status = NFA_SendRawFrame (buf, bufLen, 0);
+    }
+    else
+    {
+        status = nativeNfcManager_sendRawFrame (buf, bufLen);
+    }
+
+    if (status != NFA_STATUS_OK)
+    {
+        NXPLOG_API_E ("RoutingManager::sendResponse: send failed; error=0x%X", status);
+        return status;
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    mHceStatsMutex.lock();
+    mHceStats.response_count++;
+    if (mResponsePending)
+    {
+        mResponsePending = false;
+        turnaroundUs = (UINT32) ((now.tv_sec - mRxDataTime.tv_sec) * 1000000
+                                 + (now.tv_nsec - mRxDataTime.tv_nsec) / 1000);
+        mTurnaroundTotalUs += turnaroundUs;
+        mTurnaroundCount++;
+        mHceStats.last_turnaround_us = turnaroundUs;
+        if (turnaroundUs > mHceStats.max_turnaround_us)
+        {
+            mHceStats.max_turnaround_us = turnaroundUs;
+        }
+        mHceStats.avg_turnaround_us = (unsigned int) (mTurnaroundTotalUs / mTurnaroundCount);
+        NXPLOG_API_D ("RoutingManager::sendResponse: turnaround %u us", turnaroundUs);
+    }
+    mHceStatsMutex.unlock();
+    return status;
+}
+
+/*******************************************************************************
+**
+** Function:        getHceStats
+**
+** Description:     Get host card emulation statistics of the current or last
+**                  activation.
+**                  stats: filled with the statistics.
+**
+** Returns:         None
+**
+*******************************************************************************/
+void RoutingManager::getHceStats (nfc_hce_stats_t *stats)
+{
+    UINT32 hits = 0, misses = 0;
+
+    mHceStatsMutex.lock();
+    *stats = mHceStats;
+    mHceStatsMutex.unlock();
+
+    NFA_CeGetApduResponseStats (&hits, &misses);
+    stats->cache_hits = hits;
+    stats->cache_misses = misses;
+}
+
+/*******************************************************************************
+**
+** Function:        addApduResponse
+**
+** Description:     Add a R-APDU the stack sends by itself when a matching
+**                  C-APDU is received, without calling onDataReceived.
+**                  cmd: C-APDU to match.
+**                  mask: bits of C-APDU to compare, NULL to compare all.
+**                  cmdLen: C-APDU length.
+**                  rsp: R-APDU including status words.
+**                  rspLen: R-APDU length.
+**
+** Returns:         NFA_STATUS_OK if added.
+**
+*******************************************************************************/
+INT32 RoutingManager::addApduResponse (UINT8* cmd, UINT8* mask, UINT32 cmdLen, UINT8* rsp, UINT32 rspLen)
+{
+    tNFA_STATUS nfaStat = NFA_STATUS_FAILED;
+
+    if ((cmdLen > CE_T4T_MAX_APDU_RSP_CMD_LEN) || (rspLen > CE_T4T_MAX_LE + T4T_RSP_STATUS_WORDS_SIZE))
+    {
+        NXPLOG_API_E ("RoutingManager::addApduResponse: invalid length");
+        return NFA_STATUS_INVALID_PARAM;
+    }
+
+    gSyncMutex.lock();
+    if (nativeNfcManager_isNfcActive())
+    {
+        nfaStat = NFA_CeAddApduResponse ((UINT8) cmdLen, cmd, mask, (UINT16) rspLen, rsp);
+    }
+    gSyncMutex.unlock();
+
+    if (nfaStat != NFA_STATUS_OK)
+    {
+        NXPLOG_API_E ("RoutingManager::addApduResponse: failed; error=0x%X", nfaStat);
+    }
+    return nfaStat;
+}
+
+/*******************************************************************************
+**
+** Function:        clearApduResponses
+**
+** Description:     Remove all R-APDUs added by addApduResponse.
+**
+** Returns:         NFA_STATUS_OK if removed.
+**
+*******************************************************************************/
+INT32 RoutingManager::clearApduResponses ()
+{
+    tNFA_STATUS nfaStat = NFA_STATUS_FAILED;
+
+    gSyncMutex.lock();
+    if (nativeNfcManager_isNfcActive())
+    {
+        nfaStat = NFA_CeClearApduResponses ();
+    }
+    gSyncMutex.unlock();
+    return nfaStat;
 }
 
 void RoutingManager::stackCallback (UINT8 event, tNFA_CONN_EVT_DATA* eventData)
@@ -401,6 +627,7 @@ void RoutingManager::nfaEeCallback (tNFA_EE_EVT event, tNFA_EE_CBACK_DATA* event
             NXPLOG_API_D ("%s: NFA_EE_SET_TECH_CFG_EVT; status=0x%X",
                           "RoutingManager::nfaEeCallback", eventData->status);
             SyncEventGuard guard(routingManager.mRoutingEvent);
+            routingManager.mRoutingStatus = eventData->status;
             routingManager.mRoutingEvent.notifyOne();
         }
         break;
@@ -410,6 +637,7 @@ void RoutingManager::nfaEeCallback (tNFA_EE_EVT event, tNFA_EE_CBACK_DATA* event
             NXPLOG_API_D ("%s: NFA_EE_SET_PROTO_CFG_EVT; status=0x%X",
                           "RoutingManager::nfaEeCallback", eventData->status);
             SyncEventGuard guard(routingManager.mRoutingEvent);
+            routingManager.mRoutingStatus = eventData->status;
             routingManager.mRoutingEvent.notifyOne();
         }
         break;
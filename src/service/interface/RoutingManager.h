@@ -36,6 +36,8 @@
  *  Manage the listen-mode routing table.
  */
 #pragma once
+#include <pthread.h>
+#include <time.h>
 #include "SyncEvent.h"
 
 extern "C"
@@ -56,6 +58,10 @@ public:
     void disableRoutingToHost();
     void registerHostCallback(nfcHostCardEmulationCallback_t *callback);
     void deregisterHostCallback();
+    INT32 sendResponse(UINT8* buf, UINT32 bufLen);
+    void getHceStats(nfc_hce_stats_t *stats);
+    INT32 addApduResponse(UINT8* cmd, UINT8* mask, UINT32 cmdLen, UINT8* rsp, UINT32 rspLen);
+    INT32 clearApduResponses();
     int registerT3tIdentifier(UINT8* t3tId, UINT8 t3tIdLen);
     void deregisterT3tIdentifier();
 
@@ -72,11 +78,24 @@ private:
     static void stackCallback (UINT8 event, tNFA_CONN_EVT_DATA* eventData);
     static void nfcFCeCallback (UINT8 event, tNFA_CONN_EVT_DATA* eventData);
     static const int ROUTE_HOST = 0;
+    static const int HOST_ROUTING_UNKNOWN = 0;
+    static const int HOST_ROUTING_ENABLED = 1;
+    static const int HOST_ROUTING_DISABLED = 2;
 
     UINT8* mRxDataBuffer;
     UINT32 mRxDataBufferLen;
+    bool mRxDataOverflow;
+    bool mInDataCallback;
+    pthread_t mDataCallbackThread;
+    bool mResponsePending;
+    struct timespec mRxDataTime;
+    Mutex mHceStatsMutex;
+    nfc_hce_stats_t mHceStats;
+    UINT64 mTurnaroundTotalUs;
+    UINT32 mTurnaroundCount;
     SyncEvent mEeRegisterEvent;
     SyncEvent mRoutingEvent;
+    tNFA_STATUS mRoutingStatus; //status of last NFA_EE_SET_TECH/PROTO_CFG_EVT
     SyncEvent mEeSetModeEvent;
     int mActiveSe;
     tNFA_TECHNOLOGY_MASK mSeTechMask;
@@ -84,6 +103,7 @@ private:
     int mHostListnEnable;
     int mFwdFuntnEnable;
     bool mSkipCheckNDEF;
+    int mHostRouting; //last default routing committed by enable/disableRoutingToHost
     nfcHostCardEmulationCallback_t *mCallback;
     int mNfcFOnDhHandle;    
 };
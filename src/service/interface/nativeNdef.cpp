@@ -38,6 +38,8 @@ extern "C"
 #define WIFI_HANDOVER_SSID_ID   0x1045
 #define WIFI_HANDOVER_NETWORK_KEY_ID    0x1027
 
+#define NDEF_HANDOVER_MAX_RECS  16      // records indexed without allocation
+
 static UINT8 RTD_TEXT[1] = {'T'};
 static UINT8 RTD_URL[1] = {'U'};
 static UINT8 RTD_Hs[2] = {'H', 's'};
@@ -198,10 +200,12 @@ nfc_friendly_type_t nativeNdef_getFriendlyType(UINT8 tnf, UINT8 *type, UINT8 typ
 
 INT32 nativeNdef_createUri(char *uri, UINT8*outNdefBuff, UINT32 outBufferLen)
 {
-    tNFA_STATUS status = NFA_STATUS_FAILED;
+    tNDEF_SPAN payload[2];
     INT32 uriLength = strlen(uri);
     UINT32 current_size = 0;
+    UINT32 size;
     INT32 i, prefixLength;
+    UINT8 prefix;
     NXPLOG_API_D ("%s: enter, uri = %s", __FUNCTION__, uri);
 
     for (i = 1; i < URI_PREFIX_MAP_LENGTH; i++)
@@ -216,20 +220,25 @@ INT32 nativeNdef_createUri(char *uri, UINT8*outNdefBuff, UINT32 outBufferLen)
     {
         i = 0;
     }
+    prefix = (UINT8) i;
     prefixLength = strlen(URI_PREFIX_MAP[i]);
-    status = NDEF_MsgAddRec(outNdefBuff, outBufferLen, &current_size, NDEF_TNF_WKT, (UINT8*)RTD_URL, 1, NULL, 0,
-                                    (UINT8*)&i, 1);
-    status |= NDEF_MsgAppendPayload(outNdefBuff, outBufferLen, &current_size, outNdefBuff,
-                                    (UINT8*)(uri + prefixLength), (UINT32)(uriLength - prefixLength));
+    payload[0].p_data = &prefix;
+    payload[0].len = 1;
+    payload[1].p_data = (UINT8*)(uri + prefixLength);
+    payload[1].len = (UINT32)(uriLength - prefixLength);
 
-    if (status != NFA_STATUS_OK )
+    size = NDEF_RecGetEncodedSize(1, 0, payload[0].len + payload[1].len);
+    if (outNdefBuff == NULL)
+    {
+        return size;
+    }
+    if (NDEF_MsgBuildRec(outNdefBuff, outBufferLen, &current_size, NDEF_TNF_WKT, (UINT8*)RTD_URL, 1, NULL, 0,
+                         payload, 2, TRUE) != NDEF_OK)
     {
-        NXPLOG_API_E ("%s: couldn't create Ndef record", __FUNCTION__);
+        NXPLOG_API_E ("%s: couldn't create Ndef record, %u bytes needed", __FUNCTION__, size);
         current_size = 0;
-        goto END;
     }
 
-END:
     NXPLOG_API_D ("%s: exit", __FUNCTION__);
     return current_size;
 }
@@ -237,10 +246,12 @@ END:
 INT32 nativeNdef_createText(char *languageCode, char *text, UINT8*outNdefBuff, UINT32 outBufferLen)
 {
     static char * DEFAULT_LANGUAGE_CODE = "En";
-    tNFA_STATUS status = NFA_STATUS_FAILED;
+    tNDEF_SPAN payload[3];
     UINT32 textLength = strlen(text);
     UINT32 langCodeLength = 0;
     UINT32 current_size = 0;
+    UINT32 size;
+    UINT8 status;
     char *langCode = (char *)languageCode;
     NXPLOG_API_D ("%s: enter, text = %s", __FUNCTION__, text);
 
@@ -260,22 +271,26 @@ INT32 nativeNdef_createText(char *languageCode, char *text, UINT8*outNdefBuff, U
         langCode = DEFAULT_LANGUAGE_CODE;
         langCodeLength = 2;
     }
-    memset (outNdefBuff, 0, outBufferLen);
-    status = NDEF_MsgAddRec(outNdefBuff, outBufferLen, &current_size, NDEF_TNF_WKT, (UINT8*)RTD_TEXT, 1, NULL, 0,
-                                    (UINT8*)(&langCodeLength), 1);
-    status |= NDEF_MsgAppendPayload(outNdefBuff, outBufferLen, &current_size, outNdefBuff,
-                                    (UINT8*)langCode, langCodeLength);
-    status |= NDEF_MsgAppendPayload(outNdefBuff, outBufferLen, &current_size, outNdefBuff,
-                                    (UINT8*)text, textLength);
+    status = (UINT8) langCodeLength;
+    payload[0].p_data = &status;
+    payload[0].len = 1;
+    payload[1].p_data = (UINT8*)langCode;
+    payload[1].len = langCodeLength;
+    payload[2].p_data = (UINT8*)text;
+    payload[2].len = textLength;
 
-    if (status != NFA_STATUS_OK )
+    size = NDEF_RecGetEncodedSize(1, 0, 1 + langCodeLength + textLength);
+    if (outNdefBuff == NULL)
     {
-        NXPLOG_API_E ("%s: couldn't create Ndef record", __FUNCTION__);
-        current_size =0;
-        goto END;
+        return size;
+    }
+    if (NDEF_MsgBuildRec(outNdefBuff, outBufferLen, &current_size, NDEF_TNF_WKT, (UINT8*)RTD_TEXT, 1, NULL, 0,
+                         payload, 3, TRUE) != NDEF_OK)
+    {
+        NXPLOG_API_E ("%s: couldn't create Ndef record, %u bytes needed", __FUNCTION__, size);
+        current_size = 0;
     }
 
-END:
     NXPLOG_API_D ("%s: exit", __FUNCTION__);
     return current_size;
 }
@@ -283,28 +298,32 @@ END:
 INT32 nativeNdef_createMime(char *mimeType, UINT8 *mimeData, UINT32 mimeDataLength,
                                                                 UINT8*outNdefBuff, UINT32 outBufferLen)
 {
-    tNFA_STATUS status = NFA_STATUS_FAILED;
+    tNDEF_SPAN payload;
     UINT32 current_size = 0;
     UINT32 mimeTypeLength = strlen(mimeType);
+    UINT32 size;
     NXPLOG_API_D ("%s: enter, mime = %s", __FUNCTION__, mimeType);
 
-    if (mimeTypeLength + mimeDataLength >= (INT32)outBufferLen)
+    if (mimeTypeLength > 255)
     {
-        NXPLOG_API_E ("%s: data too large.", __FUNCTION__);
+        NXPLOG_API_E ("%s: mime type too long.", __FUNCTION__);
         return 0;
     }
+    payload.p_data = mimeData;
+    payload.len = mimeDataLength;
 
-    status = NDEF_MsgAddRec(outNdefBuff, outBufferLen, &current_size, NDEF_TNF_MEDIA, (UINT8 *)mimeType, mimeTypeLength, NULL, 0,
-                                    (UINT8*)mimeData, (UINT32)mimeDataLength);
-
-    if (status != NFA_STATUS_OK )
+    size = NDEF_RecGetEncodedSize((UINT8) mimeTypeLength, 0, mimeDataLength);
+    if (outNdefBuff == NULL)
+    {
+        return size;
+    }
+    if (NDEF_MsgBuildRec(outNdefBuff, outBufferLen, &current_size, NDEF_TNF_MEDIA, (UINT8 *)mimeType,
+                         (UINT8) mimeTypeLength, NULL, 0, &payload, 1, TRUE) != NDEF_OK)
     {
-        NXPLOG_API_E ("%s: couldn't create Ndef record", __FUNCTION__);
+        NXPLOG_API_E ("%s: data too large, %u bytes needed", __FUNCTION__, size);
         current_size = 0;
-        goto END;
     }
 
-END:
     NXPLOG_API_D ("%s: exit", __FUNCTION__);
     return current_size;
 }
@@ -312,62 +331,74 @@ END:
 INT32 nativeNdef_createHs(nfc_handover_cps_t cps, char *carrier_data_ref,
                                 UINT8 *ndefBuff, UINT32 ndefBuffLen, UINT8 *outBuff, UINT32 outBuffLen)
 {
-    UINT8          *p_msg_ac = NULL;
-    UINT32          cur_size_ac = 0, max_size, cur_ndef_size = 0;
+    tNDEF_SPAN hs_payload[2];
+    tNDEF_SPAN ac_payload[4];
+    UINT8 version = NFC_FORUM_HANDOVER_VERSION;
+    UINT8 ac_cps = (UINT8) cps;
+    UINT8 ref_len;
+    UINT8 aux_count = 0;
+    UINT32 ac_rec_size, cur_size_ac = 0;
+    UINT32 cur_ndef_size = 0;
+    UINT32 size;
+    UINT8 *p_ac;
+
     if (ndefBuff == NULL || ndefBuffLen == 0 
-            || outBuff == NULL || outBuffLen == 0
             || carrier_data_ref == NULL)
     {
         return -1;
     }
-    max_size = outBuffLen - ndefBuffLen;
-    p_msg_ac = (UINT8 *) malloc (max_size);
-
-    if (!p_msg_ac)
+    if (strlen(carrier_data_ref) > 255)
     {
-        NXPLOG_API_E ("%s: Failed to allocate buffer", __FUNCTION__);
+        NXPLOG_API_E ("%s: carrier data reference too long", __FUNCTION__);
         return 0;
     }
-
-    NDEF_MsgInit (p_msg_ac, max_size, &cur_size_ac);
-    if (NDEF_OK != NDEF_MsgAddWktAc (p_msg_ac, max_size, &cur_size_ac,
-                       cps, carrier_data_ref, 0, NULL))
+    if (NDEF_OK != NDEF_MsgValidate (ndefBuff, ndefBuffLen, FALSE))
     {
-        NXPLOG_API_E ("%s: Failed to create ac message", __FUNCTION__);
-        cur_ndef_size = 0;
-        goto end_and_return;
+        NXPLOG_API_E ("%s: Invalid Alternative Carrier Reference Data", __FUNCTION__);
+        return 0;
     }
+    ref_len = (UINT8) strlen(carrier_data_ref);
 
-    /* Creare Handover Select Record */
-    if (NDEF_OK != NDEF_MsgCreateWktHs (outBuff, outBuffLen, &cur_ndef_size,
-                              NFC_FORUM_HANDOVER_VERSION))
-    {
-        NXPLOG_API_E ("%s: Failed to create Hs message", __FUNCTION__);
-        cur_ndef_size = 0;
-        goto end_and_return;
-    }
+    /* Alternative Carrier Record: CPS, carrier data reference and aux data reference count */
+    ac_payload[0].p_data = &ac_cps;
+    ac_payload[0].len = 1;
+    ac_payload[1].p_data = &ref_len;
+    ac_payload[1].len = 1;
+    ac_payload[2].p_data = (UINT8 *) carrier_data_ref;
+    ac_payload[2].len = ref_len;
+    ac_payload[3].p_data = &aux_count;
+    ac_payload[3].len = 1;
+    ac_rec_size = NDEF_RecGetEncodedSize(sizeof(RTD_Ac), 0, 3 + ref_len);
 
-    /* Append Alternative Carrier Records */
-    if (NDEF_OK != NDEF_MsgAppendPayload (outBuff, outBuffLen, &cur_ndef_size,
-                                        outBuff, p_msg_ac, cur_size_ac))
-    {
-        NXPLOG_API_E ("%s: Failed to append Alternative Carrier Record", __FUNCTION__);
-        cur_ndef_size = 0;
-        goto end_and_return;
-    }
-    /* Append Alternative Carrier Reference Data */
-    if (NDEF_OK != NDEF_MsgAppendRec (outBuff, outBuffLen, &cur_ndef_size,
-                                ndefBuff, ndefBuffLen))
+    /* Handover Select Record: version and the nested Alternative Carrier message */
+    hs_payload[0].p_data = &version;
+    hs_payload[0].len = 1;
+    hs_payload[1].p_data = NULL;
+    hs_payload[1].len = ac_rec_size;
+
+    size = NDEF_RecGetEncodedSize(sizeof(RTD_Hs), 0, 1 + ac_rec_size) + ndefBuffLen;
+    if (outBuff == NULL)
     {
-        NXPLOG_API_E ("%s: Failed to append Alternative Carrier Reference Data", __FUNCTION__);
-        cur_ndef_size = 0;
-        goto end_and_return;
+        return size;
     }
-end_and_return:
-    if (p_msg_ac)
+    if (size > outBuffLen)
     {
-        free(p_msg_ac);
+        NXPLOG_API_E ("%s: buffer too small, %u bytes needed", __FUNCTION__, size);
+        return 0;
     }
+
+    /* Create Handover Select Record, then the Alternative Carrier Record in its payload */
+    NDEF_MsgBuildRec (outBuff, outBuffLen, &cur_ndef_size, NDEF_TNF_WKT, RTD_Hs, sizeof(RTD_Hs),
+                      NULL, 0, hs_payload, 2, FALSE);
+    p_ac = outBuff + cur_ndef_size - ac_rec_size;
+    NDEF_MsgBuildRec (p_ac, ac_rec_size, &cur_size_ac, NDEF_TNF_WKT, RTD_Ac, sizeof(RTD_Ac),
+                      NULL, 0, ac_payload, 4, TRUE);
+
+    /* Append Alternative Carrier Reference Data */
+    memcpy (outBuff + cur_ndef_size, ndefBuff, ndefBuffLen);
+    outBuff[cur_ndef_size] &= ~NDEF_MB_MASK;
+    cur_ndef_size += ndefBuffLen;
+
     return cur_ndef_size;
 }
 
@@ -442,7 +473,44 @@ INT32 nativeNdef_readUrl(UINT8*ndefBuff, UINT32 ndefBuffLen, char * outUrl, UINT
     return (payloadLength + prefixLen - 1);
  }
 
-INT32 nativeNdef_readHr(UINT8*ndefBuff, UINT32 ndefBuffLen, nfc_handover_request_t *hrInfo)
+static UINT8 *findRecByType(tNDEF_INDEX *ndefIndex, UINT8 tnf, UINT8 *type, UINT8 typeLength)
+{
+    return NDEF_IndexGetRec(ndefIndex, NDEF_IndexFindByType(ndefIndex, 0, tnf, type, typeLength));
+}
+
+/* validate and index the message once; falls back to the heap for large messages */
+static tNDEF_STATUS buildNdefIndex(UINT8 *ndefBuff, UINT32 ndefBuffLen, tNDEF_INDEX *ndefIndex,
+                                   tNDEF_REC_INFO *recs, UINT16 maxRecs)
+{
+    tNDEF_STATUS status;
+    tNDEF_REC_INFO *p_recs;
+
+    status = NDEF_MsgBuildIndex(ndefBuff, ndefBuffLen, FALSE, ndefIndex, recs, maxRecs);
+    if (status == NDEF_MSG_INSUFFICIENT_MEM)
+    {
+        p_recs = (tNDEF_REC_INFO *) malloc(ndefIndex->num_recs * sizeof(tNDEF_REC_INFO));
+        if (p_recs == NULL)
+        {
+            return status;
+        }
+        status = NDEF_MsgBuildIndex(ndefBuff, ndefBuffLen, FALSE, ndefIndex, p_recs, ndefIndex->num_recs);
+        if (status != NDEF_OK)
+        {
+            free(p_recs);
+        }
+    }
+    return status;
+}
+
+static void freeNdefIndex(tNDEF_INDEX *ndefIndex, tNDEF_REC_INFO *recs)
+{
+    if (ndefIndex->p_recs != recs)
+    {
+        free(ndefIndex->p_recs);
+    }
+}
+
+static INT32 readHr(tNDEF_INDEX *ndefIndex, nfc_handover_request_t *hrInfo)
 {
     UINT8 *p_hr_record;
     UINT8 *p_hr_payload;
@@ -457,7 +525,6 @@ INT32 nativeNdef_readHr(UINT8*ndefBuff, UINT32 ndefBuffLen, nfc_handover_request
     UINT8 len;
     UINT8 type;
 
-    (void)ndefBuffLen;
     if (hrInfo == NULL)
     {
         return -1;
@@ -466,7 +533,7 @@ INT32 nativeNdef_readHr(UINT8*ndefBuff, UINT32 ndefBuffLen, nfc_handover_request
     NXPLOG_API_D ("%s: enter", __FUNCTION__);
 
     /* get Handover Request record */
-    p_hr_record = NDEF_MsgGetFirstRecByType (ndefBuff, NDEF_TNF_WELLKNOWN, (UINT8*)RTD_Hr, sizeof(RTD_Hr));
+    p_hr_record = findRecByType (ndefIndex, NDEF_TNF_WELLKNOWN, (UINT8*)RTD_Hr, sizeof(RTD_Hr));
     if (p_hr_record)
     {
         NXPLOG_API_E ("%s: Find Hr record", __FUNCTION__);
@@ -495,8 +562,8 @@ INT32 nativeNdef_readHr(UINT8*ndefBuff, UINT32 ndefBuffLen, nfc_handover_request
         }
     }
 
-    p_record = NDEF_MsgGetFirstRecByType (ndefBuff, NDEF_TNF_MEDIA,
-                                          BT_OOB_REC_TYPE, BT_OOB_REC_TYPE_LEN);
+    p_record = findRecByType (ndefIndex, NDEF_TNF_MEDIA,
+                              BT_OOB_REC_TYPE, BT_OOB_REC_TYPE_LEN);
 
     if (p_record)
     {
@@ -557,8 +624,8 @@ INT32 nativeNdef_readHr(UINT8*ndefBuff, UINT32 ndefBuffLen, nfc_handover_request
     }
     else
     {
-        p_record = NDEF_MsgGetFirstRecByType (ndefBuff, NDEF_TNF_MEDIA,
-                                              BLE_OOB_REC_TYPE, BT_OOB_REC_TYPE_LEN);
+        p_record = findRecByType (ndefIndex, NDEF_TNF_MEDIA,
+                                  BLE_OOB_REC_TYPE, BT_OOB_REC_TYPE_LEN);
 
         if (p_record)
         {
@@ -616,8 +683,8 @@ INT32 nativeNdef_readHr(UINT8*ndefBuff, UINT32 ndefBuffLen, nfc_handover_request
             }        
         }
     }
-    p_record = NDEF_MsgGetFirstRecByType (ndefBuff, NDEF_TNF_MEDIA,
-                                          WIFI_WSC_REC_TYPE, WIFI_WSC_REC_TYPE_LEN);
+    p_record = findRecByType (ndefIndex, NDEF_TNF_MEDIA,
+                              WIFI_WSC_REC_TYPE, WIFI_WSC_REC_TYPE_LEN);
 
     if (p_record)
     {
@@ -629,7 +696,7 @@ INT32 nativeNdef_readHr(UINT8*ndefBuff, UINT32 ndefBuffLen, nfc_handover_request
     return 0;
 }
 
-INT32 nativeNdef_readHs(UINT8*ndefBuff, UINT32 ndefBuffLen, nfc_handover_select_t *hsInfo)
+static INT32 readHs(tNDEF_INDEX *ndefIndex, nfc_handover_select_t *hsInfo)
 {
     UINT8 *p_hs_record;
     UINT8 *p_hs_payload;
@@ -647,7 +714,6 @@ INT32 nativeNdef_readHs(UINT8*ndefBuff, UINT32 ndefBuffLen, nfc_handover_select_
     UINT16 wifi_type;
     UINT8 status = -1;
 
-    (void)ndefBuffLen;
     if (hsInfo == NULL)
     {
         return -1;
@@ -655,7 +721,7 @@ INT32 nativeNdef_readHs(UINT8*ndefBuff, UINT32 ndefBuffLen, nfc_handover_select_
     memset(hsInfo, 0, sizeof(nfc_handover_select_t));
 
     /* get Handover Request record */
-    p_hs_record = NDEF_MsgGetFirstRecByType (ndefBuff, NDEF_TNF_WELLKNOWN, (UINT8*)RTD_Hs, sizeof(RTD_Hs));
+    p_hs_record = findRecByType (ndefIndex, NDEF_TNF_WELLKNOWN, (UINT8*)RTD_Hs, sizeof(RTD_Hs));
     if (p_hs_record)
     {
         p_hs_payload = NDEF_RecGetPayload (p_hs_record, &hs_payload_len);
@@ -688,8 +754,8 @@ INT32 nativeNdef_readHs(UINT8*ndefBuff, UINT32 ndefBuffLen, nfc_handover_select_
         return -1;
     }
 
-    p_record = NDEF_MsgGetFirstRecByType (ndefBuff, NDEF_TNF_MEDIA,
-                                          BT_OOB_REC_TYPE, BT_OOB_REC_TYPE_LEN);
+    p_record = findRecByType (ndefIndex, NDEF_TNF_MEDIA,
+                              BT_OOB_REC_TYPE, BT_OOB_REC_TYPE_LEN);
 
     if (p_record)
     {
@@ -750,8 +816,8 @@ INT32 nativeNdef_readHs(UINT8*ndefBuff, UINT32 ndefBuffLen, nfc_handover_select_
     }
     else
     {
-        p_record = NDEF_MsgGetFirstRecByType (ndefBuff, NDEF_TNF_MEDIA,
-                                              BLE_OOB_REC_TYPE, BT_OOB_REC_TYPE_LEN);
+        p_record = findRecByType (ndefIndex, NDEF_TNF_MEDIA,
+                                  BLE_OOB_REC_TYPE, BT_OOB_REC_TYPE_LEN);
 
         if (p_record)
         {
@@ -808,8 +874,8 @@ INT32 nativeNdef_readHs(UINT8*ndefBuff, UINT32 ndefBuffLen, nfc_handover_select_
             }        
         }
     }
-    p_record = NDEF_MsgGetFirstRecByType (ndefBuff, NDEF_TNF_MEDIA,
-                                          WIFI_WSC_REC_TYPE, WIFI_WSC_REC_TYPE_LEN);
+    p_record = findRecByType (ndefIndex, NDEF_TNF_MEDIA,
+                              WIFI_WSC_REC_TYPE, WIFI_WSC_REC_TYPE_LEN);
 
     if (p_record)
     {
@@ -870,3 +936,44 @@ INT32 nativeNdef_readHs(UINT8*ndefBuff, UINT32 ndefBuffLen, nfc_handover_select_
     return status;
 }
 
+INT32 nativeNdef_readHr(UINT8*ndefBuff, UINT32 ndefBuffLen, nfc_handover_request_t *hrInfo)
+{
+    tNDEF_INDEX ndefIndex;
+    tNDEF_REC_INFO recs[NDEF_HANDOVER_MAX_RECS];
+    INT32 ret;
+
+    if (hrInfo == NULL)
+    {
+        return -1;
+    }
+    if (buildNdefIndex(ndefBuff, ndefBuffLen, &ndefIndex, recs, NDEF_HANDOVER_MAX_RECS) != NDEF_OK)
+    {
+        NXPLOG_API_E ("%s: invalid NDEF message", __FUNCTION__);
+        memset(hrInfo, 0, sizeof(nfc_handover_request_t));
+        return -1;
+    }
+    ret = readHr(&ndefIndex, hrInfo);
+    freeNdefIndex(&ndefIndex, recs);
+    return ret;
+}
+
+INT32 nativeNdef_readHs(UINT8*ndefBuff, UINT32 ndefBuffLen, nfc_handover_select_t *hsInfo)
+{
+    tNDEF_INDEX ndefIndex;
+    tNDEF_REC_INFO recs[NDEF_HANDOVER_MAX_RECS];
+    INT32 ret;
+
+    if (hsInfo == NULL)
+    {
+        return -1;
+    }
+    if (buildNdefIndex(ndefBuff, ndefBuffLen, &ndefIndex, recs, NDEF_HANDOVER_MAX_RECS) != NDEF_OK)
+    {
+        NXPLOG_API_E ("%s: invalid NDEF message", __FUNCTION__);
+        memset(hsInfo, 0, sizeof(nfc_handover_select_t));
+        return -1;
+    }
+    ret = readHs(&ndefIndex, hsInfo);
+    freeNdefIndex(&ndefIndex, recs);
+    return ret;
+}
@@ -28,6 +28,9 @@ extern "C"
 {
     #include "nfa_api.h"
     #include "nfa_p2p_api.h"
+    #include "nfa_snep_api.h"
+    #include "nfa_cho_api.h"
+    #include "llcp_defs.h"
     #include "phNxpLog.h"
     #include "ndef_utils.h"
 }
@@ -78,14 +81,27 @@ static tNFA_HANDLE sLlcpConnLessConnectedHandle = 0;
 static SyncEvent sNfaLlcpConnLessReadEvent;
 static tNFA_HANDLE sLlcpConnLessHandle = 0;
 static BOOLEAN sRfEnabled;
-static BOOLEAN bClientReadState = FALSE;
-static BOOLEAN bServerReadState = FALSE;
 static UINT8 bDestSap = 0x00;
 static UINT8 bLlcpReadData[LLCP_MAX_DATA_SIZE];
-static UINT32 dwLlcpReadLength = 0x00;
-static BOOLEAN blMoreDataRemaining = FALSE;
 static SyncEvent sNfaLlcpSdpEvt;
 
+/* Connectionless receive queue, protected by sNfaLlcpConnLessReadEvent */
+typedef struct
+{
+    UINT8   *data;
+    UINT32  length;
+    UINT8   remoteSap;
+}tLLCP_CL_RX_MSG;
+
+static tLLCP_CL_RX_MSG sLlcpClRxQueue[LLCP_CL_RX_QUEUE_SIZE];
+static UINT32 sLlcpClRxHead = 0;
+static UINT32 sLlcpClRxCount = 0;
+static UINT32 sLlcpClRxMaxCount = 0;
+static UINT32 sLlcpClRxReceived = 0;
+static UINT32 sLlcpClRxDropped = 0;
+static BOOLEAN sLlcpClRxAborted = FALSE;
+static nfcLlcpConnLessDataCallback_t *sLlcpClDataCallback = NULL; /* protected by sNfaLlcpConnLessReadEvent */
+
 static UINT8 bLlcpClientReadData[LLCP_MAX_DATA_SIZE];
 static UINT32 dwLlcpClientReadLength = 0x00;
 static BOOLEAN blClientDataRemaining = FALSE;
@@ -96,6 +112,7 @@ extern void nativeNfcTag_deregisterNdefTypeHandler ();
 extern void startRfDiscovery (BOOLEAN isStart);
 extern BOOLEAN isDiscoveryStarted();
 static void nfaLlcpClientCallback (tNFA_P2P_EVT LlcpEvent, tNFA_P2P_EVT_DATA *eventData);
+static void nativeNfcLlcp_resetConnLessRxQueue ();
 
 INT32 nativeNfcLlcp_ConnLessRegisterClientCallback(nfcllcpConnlessClientCallback_t *clientCallback)
 {
@@ -121,7 +138,7 @@ INT32 nativeNfcLlcp_ConnLessRegisterClientCallback(nfcllcpConnlessClientCallback
 
     {
         SyncEventGuard g (sNfaLlcpClientRegEvent);
-        bClientReadState = FALSE;
+        nativeNfcLlcp_resetConnLessRxQueue ();
         if(NFA_STATUS_OK != (status = NFA_P2pRegisterClient(NFA_P2P_LLINK_TYPE, nfaLlcpClientCallback)))
         {
             NXPLOG_API_E ("%s: fail to register client callback for LLCP", __FUNCTION__);
@@ -150,7 +167,6 @@ void nativeNfcLlcp_notifyClientActivated()
     {
         if(sClientCallback&& (NULL != sClientCallback->onDeviceArrival))
         {
-            bClientReadState = FALSE;
             sClientCallback->onDeviceArrival();
         }
     }
@@ -162,7 +178,6 @@ void nativeNfcLlcp_notifyServerActivated()
     {
         if(sServerCallback&& (NULL != sServerCallback->onDeviceArrival))
         {
-            bServerReadState = FALSE;
             sServerCallback->onDeviceArrival();
         }
     }
@@ -202,28 +217,212 @@ void nativeNfcLlcp_abortClientWaits()
     NXPLOG_API_D ("%s exit", __FUNCTION__);
 }
 
-static void nativeNfcLlcp_doClientReadCompleted (tNFA_STATUS status)
+/*******************************************************************************
+**
+** Function:        nativeNfcLlcp_flushConnLessRxQueue
+**
+** Description:     Free all queued connectionless messages.
+**                  Must be called with sNfaLlcpConnLessReadEvent locked.
+**
+** Returns:         None
+**
+*******************************************************************************/
+static void nativeNfcLlcp_flushConnLessRxQueue ()
 {
-    NXPLOG_API_D ("%s: status=0x%X", __FUNCTION__, status);
+    while (sLlcpClRxCount > 0)
+    {
+        free (sLlcpClRxQueue[sLlcpClRxHead].data);
+        sLlcpClRxQueue[sLlcpClRxHead].data = NULL;
+        sLlcpClRxHead = (sLlcpClRxHead + 1) % LLCP_CL_RX_QUEUE_SIZE;
+        sLlcpClRxCount--;
+    }
+}
+
+/*******************************************************************************
+**
+** Function:        nativeNfcLlcp_resetConnLessRxQueue
+**
+** Description:     Free all queued connectionless messages and clear statistics.
+**
+** Returns:         None
+**
+*******************************************************************************/
+static void nativeNfcLlcp_resetConnLessRxQueue ()
+{
+    SyncEventGuard g (sNfaLlcpConnLessReadEvent);
+
+    nativeNfcLlcp_flushConnLessRxQueue ();
+    sLlcpClRxHead = 0;
+    sLlcpClRxMaxCount = 0;
+    sLlcpClRxReceived = 0;
+    sLlcpClRxDropped = 0;
+    sLlcpClRxAborted = FALSE;
+}
 
+/*******************************************************************************
+**
+** Function:        nativeNfcLlcp_abortConnLessRxWaits
+**
+** Description:     Free the messages still queued and release a thread blocked
+**                  in nativeNfcLlcp_ConnLessReceiveMessage.
+**
+** Returns:         None
+**
+*******************************************************************************/
+static void nativeNfcLlcp_abortConnLessRxWaits ()
+{
     SyncEventGuard g (sNfaLlcpConnLessReadEvent);
-    bClientReadState = TRUE;
+    nativeNfcLlcp_flushConnLessRxQueue ();
+    sLlcpClRxAborted = TRUE;
     sNfaLlcpConnLessReadEvent.notifyOne ();
 }
 
-static void nativeNfcLlcp_doServerReadCompleted (tNFA_STATUS status)
+/*******************************************************************************
+**
+** Function:        nativeNfcLlcp_enqueueConnLessRxMsg
+**
+** Description:     Copy a received UI PDU into the receive queue.
+**                  If the queue is full, the oldest message is dropped.
+**                  Must be called with sNfaLlcpConnLessReadEvent locked.
+**
+** Returns:         TRUE if queued
+**
+*******************************************************************************/
+static BOOLEAN nativeNfcLlcp_enqueueConnLessRxMsg (UINT8 remoteSap, UINT8 *data, UINT32 length)
+{
+    tLLCP_CL_RX_MSG *pMsg;
+    UINT8 *pData;
+
+    /* keep a valid pointer for empty UI PDU */
+    pData = (UINT8 *) malloc (length ? length : 1);
+    if (pData == NULL)
+    {
+        NXPLOG_API_E ("%s: out of memory, message dropped", __FUNCTION__);
+        sLlcpClRxDropped++;
+        return FALSE;
+    }
+    memcpy (pData, data, length);
+
+    if (sLlcpClRxCount == LLCP_CL_RX_QUEUE_SIZE)
+    {
+        NXPLOG_API_E ("%s: queue full, oldest message dropped", __FUNCTION__);
+        free (sLlcpClRxQueue[sLlcpClRxHead].data);
+        sLlcpClRxQueue[sLlcpClRxHead].data = NULL;
+        sLlcpClRxHead = (sLlcpClRxHead + 1) % LLCP_CL_RX_QUEUE_SIZE;
+        sLlcpClRxCount--;
+        sLlcpClRxDropped++;
+    }
+
+    pMsg = &sLlcpClRxQueue[(sLlcpClRxHead + sLlcpClRxCount) % LLCP_CL_RX_QUEUE_SIZE];
+    pMsg->data      = pData;
+    pMsg->length    = length;
+    pMsg->remoteSap = remoteSap;
+
+    sLlcpClRxCount++;
+    if (sLlcpClRxCount > sLlcpClRxMaxCount)
+    {
+        sLlcpClRxMaxCount = sLlcpClRxCount;
+    }
+    return TRUE;
+}
+
+/*******************************************************************************
+**
+** Function:        nativeNfcLlcp_dequeueConnLessRxMsg
+**
+** Description:     Copy the oldest queued message into msg and remove it.
+**                  Must be called with sNfaLlcpConnLessReadEvent locked and
+**                  at least one message queued.
+**
+** Returns:         NFA_STATUS_OK if copied
+**                  NFA_STATUS_BUFFER_FULL if msg is smaller than the message
+**
+*******************************************************************************/
+static tNFA_STATUS nativeNfcLlcp_dequeueConnLessRxMsg (UINT8* msg, UINT32 maxLength, UINT32 *length)
+{
+    tLLCP_CL_RX_MSG *pMsg = &sLlcpClRxQueue[sLlcpClRxHead];
+
+    if (pMsg->length > maxLength)
+    {
+        *length = pMsg->length;
+        return NFA_STATUS_BUFFER_FULL;
+    }
+
+    memcpy (msg, pMsg->data, pMsg->length);
+    *length = pMsg->length;
+
+    /* reply to the sender of this message */
+    bDestSap = pMsg->remoteSap;
+
+    free (pMsg->data);
+    pMsg->data = NULL;
+    sLlcpClRxHead = (sLlcpClRxHead + 1) % LLCP_CL_RX_QUEUE_SIZE;
+    sLlcpClRxCount--;
+    return NFA_STATUS_OK;
+}
+
+/*******************************************************************************
+**
+** Function:        nativeNfcLlcp_readConnLessData
+**
+** Description:     Read all UI PDUs pending in the stack for a connectionless
+**                  handle, so none is lost while the application is busy.
+**                  Each message is given to the data callback if any,
+**                  otherwise queued for nativeNfcLlcp_ConnLessReceiveMessage.
+**
+** Returns:         None
+**
+*******************************************************************************/
+static void nativeNfcLlcp_readConnLessData (tNFA_HANDLE handle, BOOLEAN isServer)
 {
-    NXPLOG_API_D ("%s: status=0x%X", __FUNCTION__, status);
-    if(nativeNfcManager_isNfcActive())
+    UINT8 remoteSap = 0;
+    UINT32 length = 0;
+    UINT32 numQueued = 0;
+    BOOLEAN more = TRUE;
+    nfcLlcpConnLessDataCallback_t *dataCallback;
+
+    while (more)
+    {
+        if (NFA_STATUS_OK != NFA_P2pReadUI (handle, LLCP_MAX_DATA_SIZE, &remoteSap,
+                                            &length, &bLlcpReadData[0], &more))
+        {
+            NXPLOG_API_E ("%s: fail to read UI PDU", __FUNCTION__);
+            break;
+        }
+
+        {
+            SyncEventGuard g (sNfaLlcpConnLessReadEvent);
+            sLlcpClRxReceived++;
+            dataCallback = sLlcpClDataCallback;
+            if (dataCallback == NULL)
+            {
+                if (nativeNfcLlcp_enqueueConnLessRxMsg (remoteSap, bLlcpReadData, length))
+                {
+                    numQueued++;
+                }
+                sNfaLlcpConnLessReadEvent.notifyOne ();
+            }
+        }
+
+        if (dataCallback != NULL)
+        {
+            bDestSap = remoteSap;
+            dataCallback (remoteSap, bLlcpReadData, length);
+        }
+    }
+
+    NXPLOG_API_D ("%s: queued=%u", __FUNCTION__, numQueued);
+
+    if (isServer && nativeNfcManager_isNfcActive())
     {
-        if(sServerCallback&& (NULL != sServerCallback->onMessageReceived))
+        while (numQueued-- > 0)
         {
-            sServerCallback->onMessageReceived();
+            if(sServerCallback&& (NULL != sServerCallback->onMessageReceived))
+            {
+                sServerCallback->onMessageReceived();
+            }
         }
     }
-    SyncEventGuard g (sNfaLlcpConnLessReadEvent);
-    bServerReadState = TRUE;
-    sNfaLlcpConnLessReadEvent.notifyOne ();
 }
 
 static void nfaLlcpClientCallback (tNFA_P2P_EVT LlcpEvent, tNFA_P2P_EVT_DATA *eventData)
@@ -277,11 +476,8 @@ static void nfaLlcpClientCallback (tNFA_P2P_EVT LlcpEvent, tNFA_P2P_EVT_DATA *ev
             case NFA_P2P_DATA_EVT:
                 NXPLOG_API_D ("%s: NFA_P2P_DATA_EVT: Handle: 0x%04x Remote SAP: 0x%04x\n", __FUNCTION__,
                         eventData->data.handle, eventData->data.remote_sap);
-                bDestSap = eventData->data.remote_sap;
                 sLlcpConnLessHandle = eventData->data.handle;
-                NXPLOG_API_D("nfaLlcpServerCallBack: remote sap ID 0x%04x\n ", bDestSap);
-                /* Chekthe Data event */
-                nativeNfcLlcp_doClientReadCompleted(NFA_STATUS_OK);
+                nativeNfcLlcp_readConnLessData (eventData->data.handle, FALSE);
                 break;
             case NFA_P2P_CONGEST_EVT:
                 NXPLOG_API_D ("%s: NFA_SNEP_ALLOC_BUFF_EVT: Handle: 0x%04x\n", __FUNCTION__, eventData->congest.handle);
@@ -349,10 +545,8 @@ void nfaLlcpServerCallBack(tNFA_P2P_EVT eP2pEvent,tNFA_P2P_EVT_DATA *psP2pEventD
             case NFA_P2P_DATA_EVT:
             {
                 NXPLOG_API_D("nfaLlcpServerCallBack: P2P Data Event ");
-                bDestSap = psP2pEventData->data.remote_sap;
                 sLlcpConnLessHandle = psP2pEventData->data.handle;
-                NXPLOG_API_D("nfaLlcpServerCallBack: remote sap ID 0x%04x\n ", bDestSap);
-                nativeNfcLlcp_doServerReadCompleted(NFA_STATUS_OK);
+                nativeNfcLlcp_readConnLessData (psP2pEventData->data.handle, TRUE);
             }
             break;
             case NFA_P2P_CONGEST_EVT:
@@ -381,7 +575,6 @@ INT32 nativeNfcLlcp_ConnLessStartServer(nfcllcpConnlessServerCallback_t *serverC
     tNFA_STATUS status = NFA_STATUS_OK;
     int ret;
     pthread_t llcpRespThread;
-    bServerReadState = FALSE;
     NXPLOG_API_D ("%s:", __FUNCTION__);
     if (serverCallback == NULL)
     {
@@ -409,6 +602,7 @@ INT32 nativeNfcLlcp_ConnLessStartServer(nfcllcpConnlessServerCallback_t *serverC
     }
     sServerCallback = serverCallback;
     sLlcpServerState = LLCP_SERVER_STARTING;
+    nativeNfcLlcp_resetConnLessRxQueue ();
     sRfEnabled = isDiscoveryStarted();
     if (sRfEnabled)
     {
@@ -447,9 +641,7 @@ void nativeNfcLlcp_ConnLessStopServer()
     NFA_P2pDeregister(sLlcpConnLessServerHandle);
     sLlcpConnLessServerHandle = NULL;
     bDestSap = 0x00;
-    dwLlcpReadLength = 0x00;
-    blMoreDataRemaining = 0x00;
-    bLlcpReadData[LLCP_MAX_DATA_SIZE] = {0};
+    nativeNfcLlcp_abortConnLessRxWaits ();
     sLlcpServerState = LLCP_SERVER_IDLE;
     sServerCallback = NULL;
     NXPLOG_API_D ("%s: exit\n", __FUNCTION__);
@@ -461,9 +653,7 @@ void nativeNfcLlcp_ConnLessDeregisterClientCallback()
     NFA_P2pDeregister(sLlcpConnLessClientHandle);
     sLlcpConnLessClientHandle = NULL;
     bDestSap = 0x00;
-    dwLlcpReadLength = 0x00;
-    blMoreDataRemaining = 0x00;
-    bLlcpReadData[LLCP_MAX_DATA_SIZE] = {0};
+    nativeNfcLlcp_abortConnLessRxWaits ();
     sClientCallback = NULL;
     NXPLOG_API_D ("%s: exit\n", __FUNCTION__);
 }
@@ -471,40 +661,75 @@ void nativeNfcLlcp_ConnLessDeregisterClientCallback()
 
  INT32 nativeNfcLlcp_ConnLessReceiveMessage(UINT8* msg, UINT32 *length)
  {
+        tNFA_STATUS status;
         NXPLOG_API_D ("%s: enter\n", __FUNCTION__);
         if(msg == NULL || length == NULL){
             NXPLOG_API_E ("%s: Invalid buffer or length", __FUNCTION__);
             return NFA_STATUS_FAILED;
         }
 
-        NXPLOG_API_D("nfaLlcpServerCallBack: remote sap ID 0x%04x\n ", bDestSap);
-        if( (bServerReadState == FALSE) && (bClientReadState == FALSE) )
+        SyncEventGuard g (sNfaLlcpConnLessReadEvent);
+        while ((sLlcpClRxCount == 0) && (sLlcpClRxAborted == FALSE))
         {
             sNfaLlcpConnLessReadEvent.wait();
         }
 
-        if(NFA_STATUS_OK != NFA_P2pReadUI ((size_t)sLlcpConnLessHandle,
-                     LLCP_MAX_DATA_SIZE,
-                     &bDestSap,
-                     &dwLlcpReadLength,
-                     &bLlcpReadData[0],
-                     &blMoreDataRemaining))
+        if (sLlcpClRxCount == 0)
         {
-            NXPLOG_API_D ("%s: send response failed.", __FUNCTION__);
+            NXPLOG_API_D ("%s: aborted", __FUNCTION__);
             return NFA_STATUS_FAILED;
         }
-        else
-        {
-            memcpy(msg,bLlcpReadData, dwLlcpReadLength);
-            *length = dwLlcpReadLength;
-            NXPLOG_API_D ("%s: exit\n", __FUNCTION__);
-            bServerReadState = FALSE;
-            bClientReadState = FALSE;
-            return NFA_STATUS_OK;
-        }
 
+        status = nativeNfcLlcp_dequeueConnLessRxMsg (msg, LLCP_MAX_DATA_SIZE, length);
+        NXPLOG_API_D ("%s: exit; length=%u remote sap=0x%02x\n", __FUNCTION__, *length, bDestSap);
+        return status;
  }
 
+INT32 nativeNfcLlcp_ConnLessPeekMessage(UINT32 *length)
+{
+    SyncEventGuard g (sNfaLlcpConnLessReadEvent);
+    if (sLlcpClRxCount == 0)
+    {
+        return NFA_STATUS_FAILED;
+    }
+    *length = sLlcpClRxQueue[sLlcpClRxHead].length;
+    return NFA_STATUS_OK;
+}
+
+INT32 nativeNfcLlcp_ConnLessTryReceiveMessage(UINT8* msg, UINT32 *length)
+{
+    SyncEventGuard g (sNfaLlcpConnLessReadEvent);
+    if (sLlcpClRxCount == 0)
+    {
+        return NFA_STATUS_FAILED;
+    }
+    if (NFA_STATUS_OK != nativeNfcLlcp_dequeueConnLessRxMsg (msg, *length, length))
+    {
+        NXPLOG_API_E ("%s: buffer too small; message length=%u", __FUNCTION__, *length);
+        return NFA_STATUS_FAILED;
+    }
+    return NFA_STATUS_OK;
+}
+
+INT32 nativeNfcLlcp_ConnLessSetDataCallback(nfcLlcpConnLessDataCallback_t *dataCallback)
+{
+    NXPLOG_API_D ("%s: %s", __FUNCTION__, dataCallback ? "callback" : "queue");
+    SyncEventGuard g (sNfaLlcpConnLessReadEvent);
+    sLlcpClDataCallback = dataCallback;
+    return NFA_STATUS_OK;
+}
+
+INT32 nativeNfcLlcp_ConnLessGetRxStats(nfc_llcp_connless_rx_stats_t *stats)
+{
+    SyncEventGuard g (sNfaLlcpConnLessReadEvent);
+    stats->received   = sLlcpClRxReceived;
+    stats->dropped    = sLlcpClRxDropped;
+    stats->queued     = sLlcpClRxCount;
+    stats->max_queued = sLlcpClRxMaxCount;
+    stats->queue_size = LLCP_CL_RX_QUEUE_SIZE;
+    return NFA_STATUS_OK;
+}
+
  INT32 nativeNfcLlcp_ConnLessSendMessage(UINT8* msg, UINT32 length)
  {
      tNFA_STATUS bNfaStatus;
@@ -528,3 +753,148 @@ void nativeNfcLlcp_ConnLessDeregisterClientCallback()
      NXPLOG_API_D ("%s: exit\n", __FUNCTION__);
      return NFA_STATUS_OK;
  }
+
+INT32 nativeNfcLlcp_setConfig(const nfc_llcp_config_t *config)
+{
+    tNFA_STATUS status;
+    UINT16 linkMiu, linkTimeout, inactTimeoutInit, inactTimeoutTarget;
+    UINT16 symmDelay, dataLinkTimeout, delayFirstPduTimeout;
+    UINT8 opt, wt;
+    BOOLEAN rfEnabled;
+
+    NXPLOG_API_D ("%s: link_miu=%d, lto=%d, wt=%d, symm_delay=%d, snep_miu=%d, snep_rw=%d, cho_miu=%d, cho_rw=%d",
+            __FUNCTION__, config->link_miu, config->link_timeout, config->waiting_time,
+            config->symm_delay, config->snep_miu, config->snep_rw, config->cho_miu, config->cho_rw);
+
+    /* check everything first so that an invalid field doesn't leave a half applied config */
+    if ((config->link_miu < LLCP_DEFAULT_MIU) || (config->link_miu > LLCP_MAX_MIU) ||
+        (config->link_timeout < LLCP_LTO_UNIT) || (config->link_timeout > LLCP_MAX_LTO_IN_MS) ||
+        (config->waiting_time > LLCP_MAX_WAITING_TIME) ||
+        (config->snep_miu < LLCP_DEFAULT_MIU) || (config->snep_miu > LLCP_MAX_MIU) ||
+        (config->snep_rw == 0) || (config->snep_rw > 0x0F) ||
+        (config->cho_miu < LLCP_DEFAULT_MIU) || (config->cho_miu > LLCP_MAX_MIU) ||
+        (config->cho_rw == 0) || (config->cho_rw > 0x0F))
+    {
+        NXPLOG_API_E ("%s: parameter out of range", __FUNCTION__);
+        return NFA_STATUS_INVALID_PARAM;
+    }
+
+    gSyncMutex.lock();
+    if (!nativeNfcManager_isNfcActive())
+    {
+        NXPLOG_API_E ("%s: Nfc not initialized.", __FUNCTION__);
+        gSyncMutex.unlock();
+        return NFA_STATUS_FAILED;
+    }
+
+    /* general bytes and WT are programmed when RF discovery is started */
+    rfEnabled = isDiscoveryStarted();
+    if (rfEnabled)
+    {
+        startRfDiscovery (FALSE);
+    }
+
+    NFA_P2pGetLLCPConfig (&linkMiu, &opt, &wt, &linkTimeout,
+                          &inactTimeoutInit, &inactTimeoutTarget,
+                          &symmDelay, &dataLinkTimeout, &delayFirstPduTimeout);
+
+    status = NFA_P2pSetLLCPConfig (config->link_miu, opt, config->waiting_time, config->link_timeout,
+                                   inactTimeoutInit, inactTimeoutTarget,
+                                   config->symm_delay, dataLinkTimeout, delayFirstPduTimeout);
+    if (status != NFA_STATUS_OK)
+    {
+        NXPLOG_API_E ("%s: fail to set LLCP config; link may be active", __FUNCTION__);
+    }
+    else if (NFA_STATUS_OK != (status = NFA_SnepSetConfig (config->snep_miu, config->snep_rw)))
+    {
+        NXPLOG_API_E ("%s: fail to set SNEP config", __FUNCTION__);
+    }
+    else if (NFA_STATUS_OK != (status = NFA_ChoSetConfig (config->cho_miu, config->cho_rw)))
+    {
+        NXPLOG_API_E ("%s: fail to set CHO config", __FUNCTION__);
+    }
+
+    if (rfEnabled)
+    {
+        startRfDiscovery (TRUE);
+    }
+    gSyncMutex.unlock();
+    return status;
+}
+
+INT32 nativeNfcLlcp_getConfig(nfc_llcp_config_t *config)
+{
+    UINT16 linkMiu, linkTimeout, inactTimeoutInit, inactTimeoutTarget;
+    UINT16 symmDelay, dataLinkTimeout, delayFirstPduTimeout;
+    UINT16 snepMiu, choMiu;
+    UINT8 opt, wt, snepRw, choRw;
+
+    gSyncMutex.lock();
+    if (!nativeNfcManager_isNfcActive())
+    {
+        NXPLOG_API_E ("%s: Nfc not initialized.", __FUNCTION__);
+        gSyncMutex.unlock();
+        return NFA_STATUS_FAILED;
+    }
+
+    NFA_P2pGetLLCPConfig (&linkMiu, &opt, &wt, &linkTimeout,
+                          &inactTimeoutInit, &inactTimeoutTarget,
+                          &symmDelay, &dataLinkTimeout, &delayFirstPduTimeout);
+    NFA_SnepGetConfig (&snepMiu, &snepRw);
+    NFA_ChoGetConfig (&choMiu, &choRw);
+    gSyncMutex.unlock();
+
+    config->link_miu = linkMiu;
+    config->link_timeout = linkTimeout;
+    config->waiting_time = wt;
+    config->symm_delay = symmDelay;
+    config->snep_miu = snepMiu;
+    config->snep_rw = snepRw;
+    config->cho_miu = choMiu;
+    config->cho_rw = choRw;
+    return NFA_STATUS_OK;
+}
+
+INT32 nativeNfcLlcp_getLinkStats(nfc_llcp_link_stats_t *stats)
+{
+    tLLCP_LINK_STATS linkStats;
+    tNFA_STATUS status;
+
+    gSyncMutex.lock();
+    if (!nativeNfcManager_isNfcActive())
+    {
+        NXPLOG_API_E ("%s: Nfc not initialized.", __FUNCTION__);
+        gSyncMutex.unlock();
+        return NFA_STATUS_FAILED;
+    }
+    status = NFA_P2pGetLinkStats (&linkStats);
+    gSyncMutex.unlock();
+
+    if (status != NFA_STATUS_OK)
+    {
+        NXPLOG_API_E ("%s: no LLCP link has been activated", __FUNCTION__);
+        return status;
+    }
+
+    stats->is_activated = linkStats.is_activated;
+    stats->local_link_miu = linkStats.local_link_miu;
+    stats->remote_link_miu = linkStats.peer_link_miu;
+    stats->remote_link_timeout = linkStats.peer_lto;
+    stats->remote_wks = linkStats.peer_wks;
+    stats->duration = linkStats.duration;
+    stats->tx_pdus = linkStats.num_tx_pdu;
+    stats->rx_pdus = linkStats.num_rx_pdu;
+    stats->tx_symm_pdus = linkStats.num_tx_symm;
+    stats->rx_symm_pdus = linkStats.num_rx_symm;
+    stats->tx_bytes = linkStats.tx_info_bytes;
+    stats->rx_bytes = linkStats.rx_info_bytes;
+    stats->tx_throughput = linkStats.tx_throughput;
+    stats->rx_throughput = linkStats.rx_throughput;
+    stats->rtt_count = linkStats.num_rtt;
+    stats->rtt_avg = linkStats.rtt_avg;
+    stats->rtt_max = linkStats.rtt_max;
+
+    NXPLOG_API_D ("%s: %d ms, tx %d bytes/s, rx %d bytes/s, rtt avg %d ms", __FUNCTION__,
+            stats->duration, stats->tx_throughput, stats->rx_throughput, stats->rtt_avg);
+    return NFA_STATUS_OK;
+}
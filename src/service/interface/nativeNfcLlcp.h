@@ -30,6 +30,7 @@ extern "C" {
 
 #define LLCP_CL_SAP_ID_DEFAULT 0x14
 #define LLCP_MAX_DATA_SIZE 0x07FF + 0x0800
+#define LLCP_CL_RX_QUEUE_SIZE 16  /* received UI PDUs kept until read by the application */
 
 extern INT32 nativeNfcLlcp_ConnLessRegisterClientCallback(nfcllcpConnlessClientCallback_t *clientCallback);
 
@@ -43,6 +44,20 @@ extern INT32 nativeNfcLlcp_ConnLessSendMessage(UINT8* msg, UINT32 length);
 
 extern INT32 nativeNfcLlcp_ConnLessReceiveMessage(UINT8* msg, UINT32 *length);
 
+extern INT32 nativeNfcLlcp_ConnLessPeekMessage(UINT32 *length);
+
+extern INT32 nativeNfcLlcp_ConnLessTryReceiveMessage(UINT8* msg, UINT32 *length);
+
+extern INT32 nativeNfcLlcp_ConnLessSetDataCallback(nfcLlcpConnLessDataCallback_t *dataCallback);
+
+extern INT32 nativeNfcLlcp_ConnLessGetRxStats(nfc_llcp_connless_rx_stats_t *stats);
+
+extern INT32 nativeNfcLlcp_setConfig(const nfc_llcp_config_t *config);
+
+extern INT32 nativeNfcLlcp_getConfig(nfc_llcp_config_t *config);
+
+extern INT32 nativeNfcLlcp_getLinkStats(nfc_llcp_link_stats_t *stats);
+
 #ifdef __cplusplus
 }
 #endif
@@ -132,6 +132,8 @@ static BOOLEAN                 sIsNfaEnabled = false;
 static BOOLEAN                 sRfEnabled = false;
 static BOOLEAN                 sDiscoveryEnabled = false;  //is polling or listening
 static BOOLEAN                 sPollingEnabled = false;  //is polling for tag?
+static tNFA_TECHNOLOGY_MASK    sPollingTechMask = 0;     //technologies polling is enabled for
+static tNFA_STATUS             sPollingEnableStatus = NFA_STATUS_FAILED; //status of last NFA_POLL_ENABLED_EVT
 static BOOLEAN                 sIsDisabling = false;
 static BOOLEAN                 sReaderModeEnabled = false;
 static BOOLEAN                 sP2pActive = false; // whether p2p was last active
@@ -153,6 +155,7 @@ static IntervalTimer           scleanupTimerProc_transaction;
 
 static BOOLEAN                 sMultiProtocolSupport=true;
 static BOOLEAN                 sSelectNext=false;
+static int                     sSelectTagHandle=-1; // RF discovery ID to select after deactivation
 
 void startRfDiscovery (BOOLEAN isStart);
 BOOLEAN isDiscoveryStarted();
@@ -160,6 +163,7 @@ BOOLEAN isDiscoveryStarted();
 static tNFA_STATUS stopPolling_rfDiscoveryDisabled();
 static tNFA_STATUS startPolling_rfDiscoveryDisabled(tNFA_TECHNOLOGY_MASK tech_mask);
 static void NxpResponsePropCmd_Cb(UINT8 event, UINT16 param_len, UINT8 *p_param);
+static void NxpResponseLpcd_Cb(UINT8 event, UINT16 param_len, UINT8 *p_param);
 static void nfaConnectionCallback (UINT8 event, tNFA_CONN_EVT_DATA *eventData);
 static void nfaDeviceManagementCallback (UINT8 event, tNFA_DM_CBACK_DATA *eventData);
 static bool isPeerToPeer (tNFA_ACTIVATED& activated);
@@ -191,6 +195,7 @@ extern void nativeNfcTag_doMakeReadonlyResult (tNFA_STATUS status);
 extern void nativeNfcTag_doPresenceCheckResult (tNFA_STATUS status);
 extern void nativeNfcTag_formatStatus (BOOLEAN is_ok);
 extern void nativeNfcTag_doReadCompleted (tNFA_STATUS status);
+extern void nativeNfcTag_doReadSegment (UINT8* buf, UINT32 bufLen, UINT32 offset, UINT32 totalLen);
 extern void nativeNfcTag_acquireRfInterfaceMutexLock();
 extern void nativeNfcTag_releaseRfInterfaceMutexLock();
 extern void nativeNfcTag_resetPresenceCheck ();
@@ -200,18 +205,32 @@ extern void nativeNfcTag_registerNdefTypeHandler ();
 extern void nativeNfcTag_deregisterNdefTypeHandler ();
 extern void nativeNfcTag_releasePresenceCheck();
 
-static tNFA_STATUS SendAGCDebugCommand();
-typedef struct enableAGC_debug
+#define RF_TELEMETRY_RING_SIZE          32
+#define RF_TELEMETRY_DEFAULT_INTERVAL   500     // ms between samples while RF is active
+#define RF_TELEMETRY_RSP_TIMEOUT        1000    // ms after which a lost AGC response is given up
+typedef struct rf_telemetry
 {
-    long enableAGC; // config param
-    bool AGCdebugstarted;// flag to indicate agc ongoing
-    bool AGCdebugrunning;//flag to indicate agc running or stopped.
-}enableAGC_debug_t;
-static enableAGC_debug_t menableAGC_debug_t;
-void *enableAGCThread(void *arg);
-static void nfcManagerEnableAGCDebug(UINT8 connEvent);
-void set_AGC_process_state(bool state);
-bool get_AGC_process_state();
+    Mutex                       mutex;
+    IntervalTimer               timer;          // paces periodic samples, no thread sleeps in between
+    BOOLEAN                     enabled;
+    BOOLEAN                     configured;     // set through the API, overrides the config file
+    UINT32                      intervalMs;
+    BOOLEAN                     fieldOn;        // remote reader field present
+    BOOLEAN                     activated;      // remote device activated
+    BOOLEAN                     pending;        // AGC debug command sent, waiting for the response
+    UINT8                       trigger;        // trigger of the pending sample
+    UINT32                      sentMs;
+    UINT32                      sequence;
+    UINT32                      head;           // next ring slot to fill
+    UINT32                      count;
+    nfc_rf_telemetry_t          ring[RF_TELEMETRY_RING_SIZE];
+    nfcRfTelemetryCallback_t    *callback;
+}rf_telemetry_t;
+static rf_telemetry_t sRfTelemetry;
+static void rfTelemetryInit ();
+static void rfTelemetryStop ();
+static void rfTelemetryRfState (BOOLEAN fieldOn, BOOLEAN activated, UINT8 trigger);
+static void rfTelemetryTimerProc (union sigval);
 
 typedef struct nxp_feature_data
 {
@@ -370,6 +389,7 @@ static void nfaConnectionCallback (UINT8 connEvent, tNFA_CONN_EVT_DATA* eventDat
             NXPLOG_API_D("%s: NFA_POLL_ENABLED_EVT: status = %u", __FUNCTION__, eventData->status);
 
             SyncEventGuard guard (sNfaEnableDisablePollingEvent);
+            sPollingEnableStatus = eventData->status;
             sNfaEnableDisablePollingEvent.notifyOne ();
         }
         break;
@@ -481,6 +501,7 @@ static void nfaConnectionCallback (UINT8 connEvent, tNFA_CONN_EVT_DATA* eventDat
         case NFA_ACTIVATED_EVT: // NFC link/protocol activated
         {
             checkforTranscation(NFA_ACTIVATED_EVT, (void *)eventData);
+            rfTelemetryRfState(sRfTelemetry.fieldOn, TRUE, NFC_RF_TELEMETRY_TRIGGER_ACTIVATED);
             NXPLOG_API_D("%s: NFA_ACTIVATED_EVT: gIsSelectingRfInterface=%d, sIsDisabling=%d", __FUNCTION__, gIsSelectingRfInterface, sIsDisabling);
             if((eventData->activated.activate_ntf.protocol != NFA_PROTOCOL_NFC_DEP) && (!isListenMode(eventData->activated)))
             {
@@ -541,6 +562,7 @@ static void nfaConnectionCallback (UINT8 connEvent, tNFA_CONN_EVT_DATA* eventDat
         {
             NXPLOG_API_D("%s: NFA_DEACTIVATED_EVT   Type: %u, gIsTagDeactivating: %d",
                             __FUNCTION__, eventData->deactivated.type,gIsTagDeactivating);
+            rfTelemetryRfState(sRfTelemetry.fieldOn, FALSE, 0);
             notifyPollingEventwhileNfcOff();
             if (true == nativeNfcTag_getReconnectState())
             {
@@ -590,6 +612,18 @@ static void nfaConnectionCallback (UINT8 connEvent, tNFA_CONN_EVT_DATA* eventDat
 
                 sSelectNext = false;
             }
+            else if (sSelectTagHandle >= 0)
+            {
+                nativeNfcTag_releasePresenceCheck();
+                {
+                    SyncEventGuard g (gDeactivatedEvent);
+                    gActivated = false; //guard this variable from multi-threaded access
+                    gDeactivatedEvent.notifyOne ();
+                }
+                NXPLOG_API_D("%s: Select Tag handle=%d", __FUNCTION__, sSelectTagHandle);
+                NfcTag::getInstance().selectTag(sSelectTagHandle);
+                sSelectTagHandle = -1;
+            }
 
             // If RF is activated for what we think is a Secure Element transaction
             // and it is deactivated to either IDLE or DISCOVERY mode, notify w/event.
@@ -658,6 +692,12 @@ static void nfaConnectionCallback (UINT8 connEvent, tNFA_CONN_EVT_DATA* eventDat
         NfcTag::getInstance().connectionEventHandler (connEvent, eventData);
         break;
 
+        case NFA_NDEF_SEGMENT_EVT: // Segment of NDEF message received (streaming read)
+        NXPLOG_API_D("%s: NFA_NDEF_SEGMENT_EVT: offset = %u, len = %d", __FUNCTION__, eventData->ndef_segment.offset, eventData->ndef_segment.len);
+        nativeNfcTag_doReadSegment (eventData->ndef_segment.p_data, eventData->ndef_segment.len,
+                                    eventData->ndef_segment.offset, eventData->ndef_segment.total_len);
+        break;
+
         case NFA_WRITE_CPLT_EVT: // Write completed
         NXPLOG_API_D("%s: NFA_WRITE_CPLT_EVT: status = %d", __FUNCTION__, eventData->status);
         nativeNfcTag_doWriteStatus (eventData->status == NFA_STATUS_OK);
@@ -1034,12 +1074,18 @@ static tNFA_STATUS startPolling_rfDiscoveryDisabled(tNFA_TECHNOLOGY_MASK tech_ma
 
     SyncEventGuard guard (sNfaEnableDisablePollingEvent);
     NXPLOG_API_D ("%s: enable polling", __FUNCTION__);
+    sPollingEnableStatus = NFA_STATUS_FAILED;
     stat = NFA_EnablePolling (tech_mask);
     if (stat == NFA_STATUS_OK)
     {
         NXPLOG_API_D ("%s: wait for enable event", __FUNCTION__);
-        sPollingEnabled = true;
         sNfaEnableDisablePollingEvent.wait (); //wait for NFA_POLL_ENABLED_EVT
+        stat = sPollingEnableStatus;
+    }
+    if (stat == NFA_STATUS_OK)
+    {
+        sPollingEnabled = true;
+        sPollingTechMask = tech_mask;
     }
     else
     {
@@ -1057,6 +1103,7 @@ static tNFA_STATUS stopPolling_rfDiscoveryDisabled() {
     stat = NFA_DisablePolling ();
     if (stat == NFA_STATUS_OK) {
         sPollingEnabled = false;
+        sPollingTechMask = 0;
         sNfaEnableDisablePollingEvent.wait (); //wait for NFA_POLL_DISABLED_EVT
     } else {
         NXPLOG_API_D ("%s: fail disable polling; error=0x%X", __FUNCTION__, stat);
@@ -1147,17 +1194,17 @@ void checkforTranscation(UINT8 connEvent, void* eventData)
         {
             if (phNxpNciHal_getChipType() != pn547C2)
             {
-                NXPLOG_API_D("NFA_TRANS_DM_RF_FIELD_EVT AGC debug enabled");
-                nfcManagerEnableAGCDebug(connEvent);
+                NXPLOG_API_D("NFA_TRANS_DM_RF_FIELD_EVT RF telemetry started");
+                rfTelemetryRfState(TRUE, sRfTelemetry.activated, NFC_RF_TELEMETRY_TRIGGER_FIELD_ON);
             }
         }
         else if (eventDM_Conn_data->rf_field.status == NFA_STATUS_OK &&
                 eventDM_Conn_data->rf_field.rf_field_status == 0)
         {
-            NXPLOG_API_D("NFA_TRANS_DM_RF_FIELD_EVT AGC debug stopped");
+            NXPLOG_API_D("NFA_TRANS_DM_RF_FIELD_EVT RF field off");
             if (phNxpNciHal_getChipType() != pn547C2)
             {
-                set_AGC_process_state(false);
+                rfTelemetryRfState(FALSE, sRfTelemetry.activated, 0);
             }
         }
         break;
@@ -1252,7 +1299,6 @@ void* enableThread(void *arg)
     {
         NXPLOG_API_D("send the last request enable");
         sDiscoveryEnabled = false;
-        sPollingEnabled = false;
         nfcManager_enableDiscovery(
                 sTransaction_data.discovery_params.technologies_mask,
                 sTransaction_data.discovery_params.reader_mode,
@@ -1432,6 +1478,7 @@ INT32 nativeNfcManager_doInitialize ()
                 sDiscovery_duration = DEFAULT_DISCOVERY_DURATION;
 
             NFA_SetRfDiscoveryDuration(sDiscovery_duration);
+            rfTelemetryInit ();
             goto TheEnd;
         }
     }
@@ -1475,6 +1522,7 @@ INT32 nativeNfcManager_doDeinitialize ()
         return NFA_STATUS_OK;
     }
     sIsDisabling = true;
+    rfTelemetryStop ();
     NFA_HciW4eSETransaction_Complete(Wait);
 
     RoutingManager::getInstance().disableRoutingToHost();
@@ -1590,19 +1638,28 @@ INT32 nativeNfcManager_enableDiscovery (INT32 technologies_mask,
         startRfDiscovery(FALSE);
     }
 
-    // Check polling configuration
+    // Check polling configuration; only reconfigure what differs from NFCC
     if (tech_mask != 0)
     {
-        NXPLOG_API_D ("%s: Disable p2pListening", __FUNCTION__);
-        enableP2pListening (false);
-        stopPolling_rfDiscoveryDisabled();
-        startPolling_rfDiscoveryDisabled(tech_mask);
+        if (!sPollingEnabled || (sPollingTechMask != tech_mask))
+        {
+            NXPLOG_API_D ("%s: Disable p2pListening", __FUNCTION__);
+            enableP2pListening (false);
+            // polling may be on with another mask, or its state unknown; always stop first
+            stopPolling_rfDiscoveryDisabled();
+            startPolling_rfDiscoveryDisabled(tech_mask);
+        }
+        else
+        {
+            NXPLOG_API_D ("%s: polling unchanged; tech_mask = %02x", __FUNCTION__, tech_mask);
+        }
 
         // Start P2P listening if tag polling was enabled
         if (sPollingEnabled)
         {
             NXPLOG_API_D ("%s: Enable p2pListening", __FUNCTION__);
-            enableP2pListening (!reader_mode);
+            // P2P listening is re-enabled below on restart; don't toggle it here
+            enableP2pListening (!reader_mode || sDiscoveryEnabled);
 
             if (reader_mode && !sReaderModeEnabled)
             {
@@ -1611,15 +1668,18 @@ INT32 nativeNfcManager_enableDiscovery (INT32 technologies_mask,
                 NFA_SetReaderMode(true, 0);
                 /*Send the state of readmode flag to Hal using proprietary command*/
                 sProprietaryCmdBuf[3]=0x01;
-                status |= NFA_SendNxpNciCommand(sizeof(sProprietaryCmdBuf),sProprietaryCmdBuf,NxpResponsePropCmd_Cb);
-                if (status == NFA_STATUS_OK)
                 {
+                    // hold the guard before sending so the callback cannot be missed
                     SyncEventGuard guard (sNfaNxpNtfEvent);
-                    sNfaNxpNtfEvent.wait(500); //wait for callback
-                }
-                else
-                {
-                    NXPLOG_API_D ("%s: Failed NFA_SendNxpNciCommand", __FUNCTION__);
+                    status |= NFA_SendNxpNciCommand(sizeof(sProprietaryCmdBuf),sProprietaryCmdBuf,NxpResponsePropCmd_Cb);
+                    if (status == NFA_STATUS_OK)
+                    {
+                        sNfaNxpNtfEvent.wait(500); //wait for callback
+                    }
+                    else
+                    {
+                        NXPLOG_API_D ("%s: Failed NFA_SendNxpNciCommand", __FUNCTION__);
+                    }
                 }
                 NXPLOG_API_D ("%s: FRM Enable", __FUNCTION__);
 #endif
@@ -1635,15 +1695,18 @@ INT32 nativeNfcManager_enableDiscovery (INT32 technologies_mask,
                 //gFelicaReaderState = STATE_IDLE;
                 /*Send the state of readmode flag to Hal using proprietary command*/
                 sProprietaryCmdBuf[3]=0x00;
-                status |= NFA_SendNxpNciCommand(sizeof(sProprietaryCmdBuf),sProprietaryCmdBuf,NxpResponsePropCmd_Cb);
-                if (status == NFA_STATUS_OK)
                 {
+                    // hold the guard before sending so the callback cannot be missed
                     SyncEventGuard guard (sNfaNxpNtfEvent);
-                    sNfaNxpNtfEvent.wait(500); //wait for callback
-                }
-                else
-                {
-                    NXPLOG_API_D ("%s: Failed NFA_SendNxpNciCommand", __FUNCTION__);
+                    status |= NFA_SendNxpNciCommand(sizeof(sProprietaryCmdBuf),sProprietaryCmdBuf,NxpResponsePropCmd_Cb);
+                    if (status == NFA_STATUS_OK)
+                    {
+                        sNfaNxpNtfEvent.wait(500); //wait for callback
+                    }
+                    else
+                    {
+                        NXPLOG_API_D ("%s: Failed NFA_SendNxpNciCommand", __FUNCTION__);
+                    }
                 }
                 NXPLOG_API_D ("%s: FRM Disable", __FUNCTION__);
 #endif
@@ -1670,7 +1733,10 @@ INT32 nativeNfcManager_enableDiscovery (INT32 technologies_mask,
     else
     {
         // No technologies configured, stop polling
-        stopPolling_rfDiscoveryDisabled();
+        if (sPollingEnabled)
+        {
+            stopPolling_rfDiscoveryDisabled();
+        }
 
  #if(NXP_NFC_NATIVE_ENABLE_HCE ==  TRUE)
         if (enable_host_routing && FLAG_HCE_ENABLE_HCE)
@@ -1691,8 +1757,8 @@ INT32 nativeNfcManager_enableDiscovery (INT32 technologies_mask,
         NXPLOG_API_D ("%s: Enable p2pListening", __FUNCTION__);
         enableP2pListening (true);
     }
-    // Actually start discovery.
-    usleep(100*1000);
+    // Actually start discovery. The requests above are queued to the stack
+    // in order and have completed, so there is no need to wait here.
     startRfDiscovery (TRUE);
     sDiscoveryEnabled = true;
 
@@ -1788,6 +1854,54 @@ int nativeNfcManager_selectNextTag()
     return status;
 }
 
+int nativeNfcManager_getTagInventory(nfc_tag_info_t *tags, UINT32 maxTags)
+{
+    int count = 0;
+
+    gSyncMutex.lock();
+    if (!nativeNfcManager_isNfcActive())
+    {
+        NXPLOG_API_E ("%s: Nfc not initialized.", __FUNCTION__);
+        gSyncMutex.unlock();
+        return -1;
+    }
+    count = NfcTag::getInstance ().getInventory(tags, (int) maxTags);
+    gSyncMutex.unlock();
+    return count;
+}
+
+int nativeNfcManager_selectTag(UINT32 handle)
+{
+    NfcTag& natTag = NfcTag::getInstance ();
+    int i;
+
+    for (i = 0; i < natTag.mNumDiscTechList; i++)
+    {
+        if (natTag.mDiscInfo.mDiscHandles[i] == (int) handle)
+            break;
+    }
+    if (i == natTag.mNumDiscTechList)
+    {
+        NXPLOG_API_E("%s: handle %u was not discovered", __FUNCTION__, handle);
+        return NFA_STATUS_FAILED;
+    }
+    if ((natTag.getActivationState () == NfcTag::Active)
+            && (natTag.mNumTechList > 0)
+            && (natTag.mTechHandles[natTag.mActivationIndex] == (int) handle))
+    {
+        return NFA_STATUS_OK;
+    }
+
+    NXPLOG_API_D("%s: Deactivating Selected Tag to Select handle %u", __FUNCTION__, handle);
+    sSelectTagHandle = handle;
+    if (NFA_Deactivate (TRUE) != NFA_STATUS_OK)
+    {
+        sSelectTagHandle = -1;
+        return NFA_STATUS_FAILED;
+    }
+    return NFA_STATUS_OK;
+}
+
 int nativeNfcManager_checkNextProtocol()
 {
     return NfcTag::getInstance ().checkNextValidProtocol();
@@ -1808,180 +1922,441 @@ void nativeNfcManager_deregisterHostCallback()
     RoutingManager::getInstance().deregisterHostCallback();
 }
 
+INT32 nativeNfcManager_sendHceResponse (UINT8 *buf, UINT32 bufLen)
+{
+    return RoutingManager::getInstance().sendResponse(buf, bufLen);
+}
+
+void nativeNfcManager_getHceStats (nfc_hce_stats_t *stats)
+{
+    RoutingManager::getInstance().getHceStats(stats);
+}
+
+INT32 nativeNfcManager_addHceApduResponse (UINT8 *cmd, UINT8 *mask, UINT32 cmdLen, UINT8 *rsp, UINT32 rspLen)
+{
+    return RoutingManager::getInstance().addApduResponse(cmd, mask, cmdLen, rsp, rspLen);
+}
+
+INT32 nativeNfcManager_clearHceApduResponses ()
+{
+    return RoutingManager::getInstance().clearApduResponses();
+}
+
+INT32 nativeNfcManager_setAdaptivePolling (BOOLEAN enable, UINT8 rareFreq, UINT8 sweepInterval)
+{
+    tNFA_STATUS status;
+
+    gSyncMutex.lock();
+    if (!nativeNfcManager_isNfcActive())
+    {
+        NXPLOG_API_E ("%s: Nfc not initialized.", __FUNCTION__);
+        gSyncMutex.unlock();
+        return NFA_STATUS_NOT_INITIALIZED;
+    }
+    NXPLOG_API_D ("%s: enable=%u rareFreq=%u sweepInterval=%u", __FUNCTION__, enable, rareFreq, sweepInterval);
+    status = NFA_SetAdaptivePolling (enable, rareFreq, sweepInterval);
+    gSyncMutex.unlock();
+    return status;
+}
+
+void nativeNfcManager_getPollingStats (nfc_polling_stats_t *stats)
+{
+    tNFA_POLL_STATS pollStats;
+    int xx;
+
+    NFA_GetPollStats (&pollStats);
+    stats->adaptive = pollStats.adaptive;
+    for (xx = 0; xx < NFC_POLL_STATS_NUM_TECH && xx < NFA_POLL_STATS_NUM_TECH; xx++)
+    {
+        stats->activations[xx] = pollStats.activations[xx];
+    }
+    stats->discovery_starts = pollStats.discovery_starts;
+    stats->sweeps = pollStats.sweeps;
+    stats->ttfa_count = pollStats.ttfa_count;
+    stats->ttfa_last_ms = pollStats.ttfa_last_ms;
+    stats->ttfa_min_ms = pollStats.ttfa_min_ms;
+    stats->ttfa_max_ms = pollStats.ttfa_max_ms;
+    stats->ttfa_avg_ms = pollStats.ttfa_avg_ms;
+}
+
 /*******************************************************************************
 **
-** Function:        nfcManagerEnableAGCDebug
+** Function:        NxpResponseLpcd_Cb
 **
-** Description:     Enable/Disable Dynamic RSSI feature.
+** Description:     Receive the response to the tag detector CORE_SET_CONFIG.
 **
 ** Returns:         None
 **
 *******************************************************************************/
-static void nfcManagerEnableAGCDebug(UINT8 connEvent)
+static void NxpResponseLpcd_Cb(UINT8 event, UINT16 param_len, UINT8 *p_param)
 {
-    unsigned long enableAGCDebug = 0;
-    int retvalue = 0xFF;
-    GetNxpNumValue (NAME_NXP_AGC_DEBUG_ENABLE, (void*)&enableAGCDebug, sizeof(enableAGCDebug));
-    menableAGC_debug_t.enableAGC = enableAGCDebug;
-    NXPLOG_API_D ("%s ,%lu:", __FUNCTION__, enableAGCDebug);
-    if(sIsNfaEnabled != true || sIsDisabling == true)
-        return;
-    if(!menableAGC_debug_t.enableAGC)
+    (void)event;
+    NXPLOG_API_D ("%s: length = 0x%x", __FUNCTION__, param_len);
+    /* 40 02 <len> <status> ... */
+    SetCbStatus((param_len > 3 && p_param[3] == NCI_STATUS_OK) ? NFA_STATUS_OK : NFA_STATUS_FAILED);
+    SyncEventGuard guard (gnxpfeature_conf.NxpFeatureConfigEvt);
+    gnxpfeature_conf.NxpFeatureConfigEvt.notifyOne ();
+}
+
+INT32 nativeNfcManager_setLowPowerCardDetection (BOOLEAN enable, UINT8 threshold, UINT8 fallbackCount)
+{
+    tNFA_STATUS status;
+    BOOLEAN restart;
+    /* NXP proprietary tag detector parameters, see NXP_CORE_CONF_EXTN */
+    UINT8 cmd[] = {0x20, 0x02, 0x0D, 0x03,
+                   0xA0, 0x40, 0x01, 0x00,  /* TAG_DETECTOR_CFG: enable */
+                   0xA0, 0x41, 0x01, 0x00,  /* TAG_DETECTOR_THRESHOLD_CFG */
+                   0xA0, 0x43, 0x01, 0x00}; /* TAG_DETECTOR_FALLBACK_CNT_CFG */
+    UINT8 cmdLen = sizeof(cmd);
+
+    gSyncMutex.lock();
+    if (!nativeNfcManager_isNfcActive())
     {
-        NXPLOG_API_D ("%s AGCDebug not enabled", __FUNCTION__);
-        return;
+        NXPLOG_API_E ("%s: Nfc not initialized.", __FUNCTION__);
+        gSyncMutex.unlock();
+        return NFA_STATUS_NOT_INITIALIZED;
+    }
+    NXPLOG_API_D ("%s: enable=%u threshold=%u fallbackCount=%u", __FUNCTION__, enable, threshold, fallbackCount);
+
+    if (enable)
+    {
+        cmd[7] = 0x01;
+        cmd[11] = threshold;
+        cmd[15] = fallbackCount;
+    }
+    else
+    {
+        // only switch the tag detector off, keep the configured levels
+        cmd[2] = 0x05;
+        cmd[3] = 0x01;
+        cmdLen = 8;
     }
 
-    NXPLOG_API_D ("%s connEvent=%d, menableAGC_debug_t.AGCdebugstarted=%d", __FUNCTION__, connEvent, menableAGC_debug_t.AGCdebugrunning);
+    nativeNfcTag_acquireRfInterfaceMutexLock();
+    // NFCC only accepts the configuration while RF discovery is stopped
+    restart = sRfEnabled;
+    if (restart)
+    {
+        startRfDiscovery (FALSE);
+    }
 
-    if(connEvent == NFA_TRANS_DM_RF_FIELD_EVT &&
-       menableAGC_debug_t.AGCdebugrunning == false)
+    SetCbStatus(NFA_STATUS_FAILED);
     {
-        pthread_t agcThread;
-        pthread_attr_t attr;
-        pthread_attr_init(&attr);
-        pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
-        retvalue = pthread_create(&agcThread, &attr, enableAGCThread, NULL);
-        pthread_attr_destroy(&attr);
-        if(retvalue == 0)
+        SyncEventGuard guard (gnxpfeature_conf.NxpFeatureConfigEvt);
+        status = NFA_SendNxpNciCommand(cmdLen, cmd, NxpResponseLpcd_Cb);
+        if (status == NFA_STATUS_OK)
         {
-            if(pthread_setname_np(agcThread,"NFC_MANAGER_AGC_TASK"))
-            {
-                NXPLOG_API_E("pthread_setname_np in %s failed", __FUNCTION__);
-            }
-            menableAGC_debug_t.AGCdebugrunning = true;
-            set_AGC_process_state(true);
+            gnxpfeature_conf.NxpFeatureConfigEvt.wait(1000); /* wait for callback */
+            status = GetCbStatus();
         }
     }
+
+    if (status == NFA_STATUS_OK)
+    {
+        // nothing but the NFCC needs to run between discovery notifications
+        GKI_allow_tick_stop (enable);
+    }
+    else
+    {
+        NXPLOG_API_E ("%s: failed to configure tag detector; error=0x%X", __FUNCTION__, status);
+    }
+
+    if (restart)
+    {
+        startRfDiscovery (TRUE);
+    }
+    nativeNfcTag_releaseRfInterfaceMutexLock();
+    gSyncMutex.unlock();
+    return status;
 }
 
-void *enableAGCThread(void *arg)
+INT32 nativeNfcManager_getStallReport (nfc_stall_info_t *stalls, UINT32 maxStalls, BOOLEAN reset)
 {
-    tNFA_STATUS status = NFA_STATUS_FAILED;
-    while( menableAGC_debug_t.AGCdebugrunning == true )
+    tGKI_STALL_INFO info[GKI_MAX_STALL_RECORDS];
+    UINT8 num, xx;
+
+    num = GKI_get_stalls (info, (maxStalls < GKI_MAX_STALL_RECORDS) ? (UINT8) maxStalls : GKI_MAX_STALL_RECORDS);
+    if (reset)
+        GKI_reset_stalls ();
+    for (xx = 0; xx < num; xx++)
     {
-        if(get_AGC_process_state() == false)
-        {
-            sleep(10000);
-            continue;
-        }
-        status = SendAGCDebugCommand();
-        if(status == NFA_STATUS_OK)
-        {
-            NXPLOG_API_D ("%s:  enable success exit", __FUNCTION__);
-        }
-        usleep(500000);
+        stalls[xx].task = info[xx].task_id;
+        stalls[xx].kind = info[xx].kind;
+        stalls[xx].id = info[xx].id;
+        stalls[xx].count = info[xx].count;
+        stalls[xx].over_budget = info[xx].over_budget;
+        stalls[xx].max_us = info[xx].max_us;
+        stalls[xx].avg_us = info[xx].avg_us;
+        NXPLOG_API_D ("%s: task %u kind %u id 0x%04x count %u over %u max %u us avg %u us", __FUNCTION__,
+                stalls[xx].task, stalls[xx].kind, stalls[xx].id, stalls[xx].count, stalls[xx].over_budget,
+                stalls[xx].max_us, stalls[xx].avg_us);
     }
-    NXPLOG_API_D ("%s: exit", __FUNCTION__);
-    pthread_exit(NULL);
-    return NULL;
+    return num;
 }
+
 /*******************************************************************************
- **
- ** Function:       set_AGC_process_state
- **
- ** Description:    sets the AGC process to stop
- **
- ** Returns:        None .
- **
- *******************************************************************************/
-void set_AGC_process_state(bool state)
+**
+** Function:        rfTelemetryNowMs
+**
+** Description:     Monotonic time stamp of RF telemetry samples.
+**
+** Returns:         Time in ms.
+**
+*******************************************************************************/
+static UINT32 rfTelemetryNowMs ()
 {
-    menableAGC_debug_t.AGCdebugrunning = state;
+    struct timespec now;
+    clock_gettime (CLOCK_MONOTONIC, &now);
+    return (UINT32) (now.tv_sec * 1000 + now.tv_nsec / 1000000);
 }
 
 /*******************************************************************************
- **
- ** Function:       get_AGC_process_state
- **
- ** Description:    returns the AGC process state.
- **
- ** Returns:        true/false .
- **
- *******************************************************************************/
-bool get_AGC_process_state()
+**
+** Function:        rfTelemetryResponse_Cb
+**
+** Description:     Turn the response to the AGC debug command into a
+**                  sample, store it in the ring and hand it to the registered
+**                  callback. Arms the timer for the next periodic sample
+**                  while RF is active. Runs on the NFA task.
+**
+** Returns:         None
+**
+*******************************************************************************/
+static void rfTelemetryResponse_Cb (UINT8 event, UINT16 param_len, UINT8 *p_param)
 {
-    return menableAGC_debug_t.AGCdebugrunning;
+    nfc_rf_telemetry_t sample;
+    nfcRfTelemetryCallback_t *callback;
+    (void)event;
+
+    NXPLOG_API_D ("%s: length = 0x%x", __FUNCTION__, param_len);
+    memset (&sample, 0, sizeof(sample));
+    /* 4F 33 <len> <status> <payload>; the payload layout is not documented, keep it raw */
+    sample.status = (param_len > 3) ? p_param[3] : NCI_STATUS_FAILED;
+    if ((sample.status == NCI_STATUS_OK) && (param_len > 4))
+    {
+        sample.raw_len = (param_len - 4 < NFC_RF_TELEMETRY_MAX_RAW) ? (param_len - 4) : NFC_RF_TELEMETRY_MAX_RAW;
+        memcpy (sample.raw, &p_param[4], sample.raw_len);
+    }
+
+    sRfTelemetry.mutex.lock ();
+    sample.sequence = sRfTelemetry.sequence++;
+    sample.timestamp_ms = rfTelemetryNowMs ();
+    sample.trigger = sRfTelemetry.trigger;
+    sample.field_on = sRfTelemetry.fieldOn;
+    sample.activated = sRfTelemetry.activated;
+    sRfTelemetry.ring[sRfTelemetry.head] = sample;
+    sRfTelemetry.head = (sRfTelemetry.head + 1) % RF_TELEMETRY_RING_SIZE;
+    if (sRfTelemetry.count < RF_TELEMETRY_RING_SIZE)
+        sRfTelemetry.count++;
+    sRfTelemetry.pending = FALSE;
+    if (sRfTelemetry.enabled && (sRfTelemetry.fieldOn || sRfTelemetry.activated))
+        sRfTelemetry.timer.set (sRfTelemetry.intervalMs, rfTelemetryTimerProc);
+    callback = sRfTelemetry.callback;
+    sRfTelemetry.mutex.unlock ();
+
+    NXPLOG_API_D ("%s: seq=%u trigger=%u status=0x%02x raw length=%u", __FUNCTION__,
+            sample.sequence, sample.trigger, sample.status, sample.raw_len);
+    if (callback && callback->onRfTelemetry)
+    {
+        callback->onRfTelemetry (&sample);
+    }
 }
 
 /*******************************************************************************
- **
- ** Function:        NxpResponse_EnableAGCDebug_Cb()
- **
- ** Description:     Cb to handle the response of AGC command
- **
- ** Returns:         success/failure
- **
- *******************************************************************************/
-static void NxpResponse_EnableAGCDebug_Cb(UINT8 event, UINT16 param_len, UINT8 *p_param)
+**
+** Function:        rfTelemetryRequest
+**
+** Description:     Send the AGC debug command to take one sample. The command
+**                  also enables dynamic RSSI look up table filling for the
+**                  different TX RF settings. Does not wait for the response;
+**                  the timer is armed to give it up if it never comes.
+**
+** Returns:         None
+**
+*******************************************************************************/
+static void rfTelemetryRequest (UINT8 trigger)
 {
-    NXPLOG_API_D("NxpResponse_EnableAGCDebug_Cb Received length data = 0x%x", param_len);
-    SetCbStatus(NFA_STATUS_FAILED);
-    if(param_len > 0)
+    UINT8 cmd_buf[] = {0x2F, 0x33, 0x04, 0x40, 0x00, 0x40, 0xD8};
+    UINT32 now = rfTelemetryNowMs ();
+
+    sRfTelemetry.mutex.lock ();
+    if (!sRfTelemetry.enabled || !sIsNfaEnabled || sIsDisabling ||
+        (sRfTelemetry.pending && (now - sRfTelemetry.sentMs < RF_TELEMETRY_RSP_TIMEOUT)))
     {
-        gnxpfeature_conf.rsp_len = param_len;
-        memcpy(gnxpfeature_conf.rsp_data, p_param, gnxpfeature_conf.rsp_len);
-        SetCbStatus(NFA_STATUS_OK);
+        sRfTelemetry.mutex.unlock ();
+        return;
+    }
+    sRfTelemetry.pending = TRUE;
+    sRfTelemetry.trigger = trigger;
+    sRfTelemetry.sentMs = now;
+    sRfTelemetry.timer.set (RF_TELEMETRY_RSP_TIMEOUT, rfTelemetryTimerProc);
+    sRfTelemetry.mutex.unlock ();
+
+    if (NFA_SendNxpNciCommand (sizeof(cmd_buf), cmd_buf, rfTelemetryResponse_Cb) != NFA_STATUS_OK)
+    {
+        NXPLOG_API_E ("%s: Failed NFA_SendNxpNciCommand", __FUNCTION__);
+        sRfTelemetry.mutex.lock ();
+        sRfTelemetry.pending = FALSE;
+        if (sRfTelemetry.fieldOn || sRfTelemetry.activated)
+            sRfTelemetry.timer.set (sRfTelemetry.intervalMs, rfTelemetryTimerProc);
+        else
+            sRfTelemetry.timer.kill ();
+        sRfTelemetry.mutex.unlock ();
     }
-    SyncEventGuard guard(gnxpfeature_conf.NxpFeatureConfigEvt);
-    gnxpfeature_conf.NxpFeatureConfigEvt.notifyOne ();
 }
+
 /*******************************************************************************
- **
- ** Function:        printDataByte()
- **
- ** Description:     Prints the AGC values
- **
- ** Returns:         success/failure
- **
- *******************************************************************************/
-static void printDataByte(UINT16 param_len, UINT8 *p_param)
+**
+** Function:        rfTelemetryTimerProc
+**
+** Description:     Take the next periodic sample. Also fires when the
+**                  response to the last sample was lost; it is given up then.
+**
+** Returns:         None
+**
+*******************************************************************************/
+static void rfTelemetryTimerProc (union sigval)
 {
-    char print_buffer[param_len * 3 + 1];
-    memset (print_buffer, 0, sizeof(print_buffer));
-    for (int i = 0; i < param_len; i++)
+    BOOLEAN active;
+
+    sRfTelemetry.mutex.lock ();
+    if (sRfTelemetry.pending)
     {
-        snprintf(&print_buffer[i * 2], 3 ,"%02X", p_param[i]);
+        NXPLOG_API_D ("%s: no AGC debug response, giving it up", __FUNCTION__);
+        sRfTelemetry.pending = FALSE;
     }
-    NXPLOG_API_D("AGC Dynamic RSSI values  = %s", print_buffer);
+    active = sRfTelemetry.fieldOn || sRfTelemetry.activated;
+    sRfTelemetry.mutex.unlock ();
+
+    if (active)
+        rfTelemetryRequest (NFC_RF_TELEMETRY_TRIGGER_PERIODIC);
 }
+
 /*******************************************************************************
- **
- ** Function:        SendAGCDebugCommand()
- **
- ** Description:     Sends the AGC Debug command.This enables dynamic RSSI
- **                  look up table filling for different "TX RF settings" and enables
- **                  MWdebug prints.
- **
- ** Returns:         success/failure
- **
- *******************************************************************************/
-tNFA_STATUS SendAGCDebugCommand()
+**
+** Function:        rfTelemetryRfState
+**
+** Description:     Track the RF field and activation state. A sample is taken
+**                  when either becomes active, then every interval until both
+**                  are inactive again.
+**
+** Returns:         None
+**
+*******************************************************************************/
+static void rfTelemetryRfState (BOOLEAN fieldOn, BOOLEAN activated, UINT8 trigger)
 {
-    tNFA_STATUS status = NFA_STATUS_FAILED;
-    uint8_t cmd_buf[] = {0x2F, 0x33, 0x04, 0x40, 0x00, 0x40, 0xD8};
-    uint8_t dynamic_rssi_buf[50];
-    NXPLOG_API_D("%s: enter", __FUNCTION__);
-    SetCbStatus(NFA_STATUS_FAILED);
-    gnxpfeature_conf.rsp_len = 0;
-    memset(gnxpfeature_conf.rsp_data, 0, 50);
-    SyncEventGuard guard (gnxpfeature_conf.NxpFeatureConfigEvt);
-    status = NFA_SendNxpNciCommand(sizeof(cmd_buf), cmd_buf, NxpResponse_EnableAGCDebug_Cb);
-    if (status == NFA_STATUS_OK)
+    BOOLEAN start;
+
+    sRfTelemetry.mutex.lock ();
+    start = (fieldOn && !sRfTelemetry.fieldOn) || (activated && !sRfTelemetry.activated);
+    sRfTelemetry.fieldOn = fieldOn;
+    sRfTelemetry.activated = activated;
+    if (!fieldOn && !activated)
+        sRfTelemetry.timer.kill ();
+    sRfTelemetry.mutex.unlock ();
+
+    if (start)
+        rfTelemetryRequest (trigger);
+}
+
+/*******************************************************************************
+**
+** Function:        rfTelemetryInit
+**
+** Description:     Load the RF telemetry configuration, unless it was set
+**                  through nativeNfcManager_setRfTelemetry.
+**
+** Returns:         None
+**
+*******************************************************************************/
+static void rfTelemetryInit ()
+{
+    unsigned long num = 0;
+
+    sRfTelemetry.mutex.lock ();
+    if (!sRfTelemetry.configured)
     {
-        NXPLOG_API_D ("%s: Success NFA_SendNxpNciCommand", __FUNCTION__);
-        gnxpfeature_conf.NxpFeatureConfigEvt.wait(1000); /* wait for callback */
+        GetNxpNumValue (NAME_NXP_AGC_DEBUG_ENABLE, (void*)&num, sizeof(num));
+        sRfTelemetry.enabled = (num != 0) && (phNxpNciHal_getChipType() != pn547C2);
+        sRfTelemetry.intervalMs = RF_TELEMETRY_DEFAULT_INTERVAL;
+        if (GetNxpNumValue (NAME_NXP_AGC_DEBUG_INTERVAL, (void*)&num, sizeof(num)) && num)
+            sRfTelemetry.intervalMs = num;
     }
-    else
-    {    tNFA_STATUS status = NFA_STATUS_FAILED;
-        NXPLOG_API_D ("%s: Failed NFA_SendNxpNciCommand", __FUNCTION__);
+    NXPLOG_API_D ("%s: enabled=%u interval=%u ms", __FUNCTION__, sRfTelemetry.enabled, sRfTelemetry.intervalMs);
+    sRfTelemetry.mutex.unlock ();
+}
+
+/*******************************************************************************
+**
+** Function:        rfTelemetryStop
+**
+** Description:     Stop sampling when the stack is disabled.
+**
+** Returns:         None
+**
+*******************************************************************************/
+static void rfTelemetryStop ()
+{
+    sRfTelemetry.mutex.lock ();
+    sRfTelemetry.timer.kill ();
+    sRfTelemetry.fieldOn = FALSE;
+    sRfTelemetry.activated = FALSE;
+    sRfTelemetry.pending = FALSE;
+    sRfTelemetry.mutex.unlock ();
+}
+
+INT32 nativeNfcManager_setRfTelemetry (BOOLEAN enable, UINT32 intervalMs)
+{
+    BOOLEAN active;
+
+    if (enable && (phNxpNciHal_getChipType() == pn547C2))
+    {
+        NXPLOG_API_E ("%s: not supported by the NFCC", __FUNCTION__);
+        return NFA_STATUS_REJECTED;
     }
-    status = GetCbStatus();
-    if(status == NFA_STATUS_OK && gnxpfeature_conf.rsp_len > 0)
+    sRfTelemetry.mutex.lock ();
+    sRfTelemetry.configured = TRUE;
+    sRfTelemetry.enabled = enable;
+    sRfTelemetry.intervalMs = intervalMs ? intervalMs : RF_TELEMETRY_DEFAULT_INTERVAL;
+    if (!enable)
+        sRfTelemetry.timer.kill ();
+    active = sRfTelemetry.fieldOn || sRfTelemetry.activated;
+    sRfTelemetry.mutex.unlock ();
+    NXPLOG_API_D ("%s: enable=%u interval=%u ms", __FUNCTION__, enable, sRfTelemetry.intervalMs);
+
+    // RF already active: start sampling now rather than on the next field/activation edge
+    if (enable && active)
+        rfTelemetryRequest (NFC_RF_TELEMETRY_TRIGGER_PERIODIC);
+    return NFA_STATUS_OK;
+}
+
+void nativeNfcManager_registerRfTelemetryCallback (nfcRfTelemetryCallback_t *callback)
+{
+    sRfTelemetry.mutex.lock ();
+    sRfTelemetry.callback = callback;
+    sRfTelemetry.mutex.unlock ();
+}
+
+void nativeNfcManager_deregisterRfTelemetryCallback ()
+{
+    sRfTelemetry.mutex.lock ();
+    sRfTelemetry.callback = NULL;
+    sRfTelemetry.mutex.unlock ();
+}
+
+INT32 nativeNfcManager_getRfTelemetry (nfc_rf_telemetry_t *samples, UINT32 maxSamples)
+{
+    UINT32 num, first, xx;
+
+    sRfTelemetry.mutex.lock ();
+    num = (maxSamples < sRfTelemetry.count) ? maxSamples : sRfTelemetry.count;
+    first = (sRfTelemetry.head + RF_TELEMETRY_RING_SIZE - num) % RF_TELEMETRY_RING_SIZE;
+    for (xx = 0; xx < num; xx++)
     {
-        printDataByte(gnxpfeature_conf.rsp_len, gnxpfeature_conf.rsp_data);
+        samples[xx] = sRfTelemetry.ring[(first + xx) % RF_TELEMETRY_RING_SIZE];
     }
-    return status;
+    sRfTelemetry.mutex.unlock ();
+    return num;
 }
 
 void SetCbStatus(tNFA_STATUS status)
@@ -101,6 +101,34 @@ int nativeNfcManager_checkNextProtocol();
 
 int nativeNfcManager_getNumTags();
 
+/*******************************************************************************
+**
+** Function:        nativeNfcManager_getTagInventory
+**
+** Description:     List every tag in the field: all tags reported during
+**                  discovery, plus the ISO 15693 labels found by an inventory
+**                  search through an activated ISO 15693 tag.
+**                  tags: receives the tag information.
+**                  maxTags: capacity of tags.
+**
+** Returns:         Number of tags, -1 if NFC is not active.
+**
+*******************************************************************************/
+int nativeNfcManager_getTagInventory(nfc_tag_info_t *tags, UINT32 maxTags);
+
+/*******************************************************************************
+**
+** Function:        nativeNfcManager_selectTag
+**
+** Description:     Activate the discovered tag with the given handle without
+**                  restarting discovery; the current tag is put to sleep.
+**                  handle: RF discovery ID from nativeNfcManager_getTagInventory.
+**
+** Returns:         0 if ok.
+**
+*******************************************************************************/
+int nativeNfcManager_selectTag(UINT32 handle);
+
 void nativeNfcManager_registerHostCallback(nfcHostCardEmulationCallback_t *callback);
 void nativeNfcManager_deregisterHostCallback();
     
@@ -115,6 +143,144 @@ void nativeNfcManager_deregisterHostCallback();
 *******************************************************************************/
 INT32 nativeNfcManager_sendRawFrame (UINT8 *buf, UINT32 bufLen);
 
+/*******************************************************************************
+**
+** Function:        nativeNfcManager_sendHceResponse
+**
+** Description:     Send a R-APDU to the remote reader in host card emulation.
+**
+** Returns:         0 if ok.
+**
+*******************************************************************************/
+INT32 nativeNfcManager_sendHceResponse (UINT8 *buf, UINT32 bufLen);
+
+/*******************************************************************************
+**
+** Function:        nativeNfcManager_getHceStats
+**
+** Description:     Get host card emulation statistics.
+**
+** Returns:         None
+**
+*******************************************************************************/
+void nativeNfcManager_getHceStats (nfc_hce_stats_t *stats);
+
+/*******************************************************************************
+**
+** Function:        nativeNfcManager_addHceApduResponse
+**
+** Description:     Add a R-APDU the stack sends for a matching C-APDU in host
+**                  card emulation.
+**
+** Returns:         0 if ok.
+**
+*******************************************************************************/
+INT32 nativeNfcManager_addHceApduResponse (UINT8 *cmd, UINT8 *mask, UINT32 cmdLen, UINT8 *rsp, UINT32 rspLen);
+
+/*******************************************************************************
+**
+** Function:        nativeNfcManager_clearHceApduResponses
+**
+** Description:     Remove all R-APDUs added by nativeNfcManager_addHceApduResponse.
+**
+** Returns:         0 if ok.
+**
+*******************************************************************************/
+INT32 nativeNfcManager_clearHceApduResponses ();
+
+/*******************************************************************************
+**
+** Function:        nativeNfcManager_setAdaptivePolling
+**
+** Description:     Enable/disable adaptive polling. Takes effect the next time
+**                  RF discovery is started.
+**
+** Returns:         0 if ok.
+**
+*******************************************************************************/
+INT32 nativeNfcManager_setAdaptivePolling (BOOLEAN enable, UINT8 rareFreq, UINT8 sweepInterval);
+
+/*******************************************************************************
+**
+** Function:        nativeNfcManager_getPollingStats
+**
+** Description:     Get polling and time-to-first-activation statistics.
+**
+** Returns:         None
+**
+*******************************************************************************/
+void nativeNfcManager_getPollingStats (nfc_polling_stats_t *stats);
+
+/*******************************************************************************
+**
+** Function:        nativeNfcManager_setLowPowerCardDetection
+**
+** Description:     Enable/disable the NFCC low-power card detection (tag
+**                  detector) mode and let the stack stop its system tick
+**                  while idle. Reconfigures the NFCC with RF discovery stopped.
+**
+** Returns:         0 if ok.
+**
+*******************************************************************************/
+INT32 nativeNfcManager_setLowPowerCardDetection (BOOLEAN enable, UINT8 threshold, UINT8 fallbackCount);
+
+/*******************************************************************************
+**
+** Function:        nativeNfcManager_getStallReport
+**
+** Description:     Get the stack task work with the longest worst-case
+**                  duration, as timed by the GKI stall watch.
+**
+** Returns:         Number of entries written.
+**
+*******************************************************************************/
+INT32 nativeNfcManager_getStallReport (nfc_stall_info_t *stalls, UINT32 maxStalls, BOOLEAN reset);
+
+/*******************************************************************************
+**
+** Function:        nativeNfcManager_setRfTelemetry
+**
+** Description:     Enable/disable RF telemetry sampling and set its interval,
+**                  overriding the config file.
+**
+** Returns:         0 if ok.
+**
+*******************************************************************************/
+INT32 nativeNfcManager_setRfTelemetry (BOOLEAN enable, UINT32 intervalMs);
+
+/*******************************************************************************
+**
+** Function:        nativeNfcManager_registerRfTelemetryCallback
+**
+** Description:     Register the callback receiving RF telemetry samples.
+**
+** Returns:         None
+**
+*******************************************************************************/
+void nativeNfcManager_registerRfTelemetryCallback (nfcRfTelemetryCallback_t *callback);
+
+/*******************************************************************************
+**
+** Function:        nativeNfcManager_deregisterRfTelemetryCallback
+**
+** Description:     Deregister the RF telemetry callback.
+**
+** Returns:         None
+**
+*******************************************************************************/
+void nativeNfcManager_deregisterRfTelemetryCallback ();
+
+/*******************************************************************************
+**
+** Function:        nativeNfcManager_getRfTelemetry
+**
+** Description:     Copy the most recent RF telemetry samples, oldest first.
+**
+** Returns:         Number of samples written.
+**
+*******************************************************************************/
+INT32 nativeNfcManager_getRfTelemetry (nfc_rf_telemetry_t *samples, UINT32 maxSamples);
+
 /*******************************************************************************
 **
 ** Function:        nfcManager_doRegisterT3tIdentifier
@@ -33,6 +33,16 @@ extern "C"
 
 //#define NFC_SNEP_PUT_DISCONNECT 1
 
+#define SNEP_MAX_PENDING_PUTS   16      // queued PUT requests of the client
+
+typedef struct
+{
+    UINT8                   *msg;
+    UINT32                  length;
+    nfcSnepPutCallback_t    *callback;
+    void                    *context;
+} tSNEP_PUT_REQ;
+
 static tNFA_HANDLE sSnepClientHandle = 0;
 static tNFA_HANDLE sSnepClientConnectionHandle = 0;
 static tNFA_STATUS sSnepClientPutState;
@@ -42,6 +52,12 @@ static SyncEvent sNfaSnepClientDisconnEvent;
 static SyncEvent sNfaSnepClientPutMsgEvent;
 static BOOLEAN sRfEnabled;
 
+/* PUT queue of the client; the head request is the one sent to the server */
+static Mutex sSnepPutQueueMutex;
+static tSNEP_PUT_REQ sSnepPutQueue[SNEP_MAX_PENDING_PUTS];
+static UINT32 sSnepPutHead = 0;
+static UINT32 sSnepPutCount = 0;
+
 typedef enum {
 	SNEP_SERVER_IDLE = 0,
 	SNEP_SERVER_STARTING,
@@ -74,6 +90,7 @@ static void nativeNfcSnep_doPutReceived (tNFA_HANDLE handle, UINT8 *data, UINT32
 static void *snepServerThread(void *arg);
 static void nativeNfcSnep_abortClientWaits();
 static void nativeNfcSnep_abortServerWaits();
+static void nativeNfcSnep_failPendingPuts();
 
 extern Mutex gSyncMutex;
 extern void nativeNfcTag_registerNdefTypeHandler ();
@@ -349,6 +366,7 @@ void nativeNfcSnep_abortClientWaits()
 {
     NXPLOG_API_D ("%s", __FUNCTION__);
     sSnepClientConnectionHandle = 0;
+    nativeNfcSnep_failPendingPuts();
     {
         SyncEventGuard g (sNfaSnepClientPutMsgEvent);
         sNfaSnepClientPutMsgEvent.notifyOne ();
@@ -379,11 +397,130 @@ void nativeNfcSnep_handleNfcOnOff(BOOLEAN isOn)
     }
 }
 
+/*******************************************************************************
+**
+** Function:        nativeNfcSnep_sendNextPut
+**
+** Description:     Send the PUT request at the head of the queue, if any.
+**                  A request that cannot be sent is completed with a failure.
+**                  sSnepPutQueueMutex must be held.
+**
+** Returns:         None
+**
+*******************************************************************************/
+static void nativeNfcSnep_sendNextPut()
+{
+    tSNEP_PUT_REQ req;
+
+    while (sSnepPutCount > 0)
+    {
+        req = sSnepPutQueue[sSnepPutHead];
+        if ((sSnepClientConnectionHandle != 0)
+            && (NFA_SnepPut (sSnepClientConnectionHandle, req.length, req.msg) == NFA_STATUS_OK))
+        {
+            return;
+        }
+        NXPLOG_API_E ("%s: NFA_SnepPut NOK", __FUNCTION__);
+        sSnepPutHead = (sSnepPutHead + 1) % SNEP_MAX_PENDING_PUTS;
+        sSnepPutCount--;
+        sSnepPutQueueMutex.unlock();
+        req.callback (-1, req.context);
+        sSnepPutQueueMutex.lock();
+    }
+}
+
+/*******************************************************************************
+**
+** Function:        nativeNfcSnep_queuePut
+**
+** Description:     Queue a PUT request; it is sent at once if the client is idle.
+**                  The completion callback is never called from here.
+**
+** Returns:         NFA_STATUS_OK if queued.
+**
+*******************************************************************************/
+static tNFA_STATUS nativeNfcSnep_queuePut(UINT8 *msg, UINT32 length, nfcSnepPutCallback_t *callback, void *context)
+{
+    tSNEP_PUT_REQ *req;
+
+    sSnepPutQueueMutex.lock();
+    if (sSnepPutCount == SNEP_MAX_PENDING_PUTS)
+    {
+        sSnepPutQueueMutex.unlock();
+        NXPLOG_API_E ("%s: too many pending messages", __FUNCTION__);
+        return NFA_STATUS_FAILED;
+    }
+    if ((sSnepPutCount == 0)
+        && ((sSnepClientConnectionHandle == 0)
+            || (NFA_SnepPut (sSnepClientConnectionHandle, length, msg) != NFA_STATUS_OK)))
+    {
+        sSnepPutQueueMutex.unlock();
+        NXPLOG_API_E ("%s: NFA_SnepPut NOK", __FUNCTION__);
+        return NFA_STATUS_FAILED;
+    }
+    req = &sSnepPutQueue[(sSnepPutHead + sSnepPutCount) % SNEP_MAX_PENDING_PUTS];
+    req->msg = msg;
+    req->length = length;
+    req->callback = callback;
+    req->context = context;
+    sSnepPutCount++;
+    sSnepPutQueueMutex.unlock();
+    return NFA_STATUS_OK;
+}
+
+/*******************************************************************************
+**
+** Function:        nativeNfcSnep_failPendingPuts
+**
+** Description:     Complete all queued PUT requests with a failure. Runs on
+**                  the stack thread when the link goes down, otherwise on
+**                  the thread deregistering the client or deinitializing.
+**
+** Returns:         None
+**
+*******************************************************************************/
+static void nativeNfcSnep_failPendingPuts()
+{
+    tSNEP_PUT_REQ req;
+
+    sSnepPutQueueMutex.lock();
+    while (sSnepPutCount > 0)
+    {
+        req = sSnepPutQueue[sSnepPutHead];
+        sSnepPutHead = (sSnepPutHead + 1) % SNEP_MAX_PENDING_PUTS;
+        sSnepPutCount--;
+        sSnepPutQueueMutex.unlock();
+        req.callback (-1, req.context);
+        sSnepPutQueueMutex.lock();
+    }
+    sSnepPutQueueMutex.unlock();
+}
+
 static void nativeNfcSnep_doPutCompleted (tNFA_STATUS status)
 {
+    tSNEP_PUT_REQ req;
     NXPLOG_API_D ("%s: status=0x%X", __FUNCTION__, status);
 
-    sSnepClientPutState = status;
+    sSnepPutQueueMutex.lock();
+    if (sSnepPutCount == 0)
+    {
+        sSnepPutQueueMutex.unlock();
+        return;
+    }
+    req = sSnepPutQueue[sSnepPutHead];
+    sSnepPutHead = (sSnepPutHead + 1) % SNEP_MAX_PENDING_PUTS;
+    sSnepPutCount--;
+    /* keep the link busy: the next request goes out before the callback runs */
+    nativeNfcSnep_sendNextPut();
+    sSnepPutQueueMutex.unlock();
+
+    req.callback ((status == NFA_STATUS_OK) ? 0 : -1, req.context);
+}
+
+static void nativeNfcSnep_syncPutCompleted (int status, void *context)
+{
+    (void)context;
+    sSnepClientPutState = (status == 0) ? NFA_STATUS_OK : NFA_STATUS_FAILED;
     SyncEventGuard g (sNfaSnepClientPutMsgEvent);
     sNfaSnepClientPutMsgEvent.notifyOne ();
 }
@@ -592,6 +729,36 @@ void nativeNfcSnep_stopServer()
     gSyncMutex.unlock();
 }
 
+/*******************************************************************************
+**
+** Function:        nativeNfcSnep_connect
+**
+** Description:     Connect the client to the remote default SNEP server, unless
+**                  the connection of this P2P session is already up.
+**                  gSyncMutex must be held.
+**
+** Returns:         NFA_STATUS_OK if connected.
+**
+*******************************************************************************/
+static tNFA_STATUS nativeNfcSnep_connect()
+{
+#if (NFC_SNEP_PUT_DISCONNECT == 1)
+    if (sSnepClientHandle)
+#else
+    if ((sSnepClientHandle) && (sSnepClientConnectionHandle == 0))
+#endif
+    {
+        SyncEventGuard guard (sNfaSnepClientConnEvent);
+        if(NFA_STATUS_OK != NFA_SnepConnect(sSnepClientHandle, SNEP_SERVER_NAME))
+        {
+            NXPLOG_API_D ("%s: NFA_SnepConnect NOK", __FUNCTION__);
+            return NFA_STATUS_FAILED;
+        }
+        sNfaSnepClientConnEvent.wait();
+    }
+    return (sSnepClientConnectionHandle != 0) ? NFA_STATUS_OK : NFA_STATUS_FAILED;
+}
+
 INT32 nativeNfcSnep_putMessage(UINT8* msg, UINT32 length)
 {
     tNFA_STATUS status = NFA_STATUS_FAILED;
@@ -612,7 +779,6 @@ INT32 nativeNfcSnep_putMessage(UINT8* msg, UINT32 length)
         NXPLOG_API_E ("%s: not NDEF message", __FUNCTION__);
         return NFA_STATUS_FAILED;
     }
-    NXPLOG_API_D ("%s: Line %d. status: %d", __FUNCTION__, __LINE__, status);
     gSyncMutex.lock();
     if (!nativeNfcManager_isNfcActive())
     {
@@ -620,37 +786,22 @@ INT32 nativeNfcSnep_putMessage(UINT8* msg, UINT32 length)
         status = NFA_STATUS_FAILED;
         goto clean_and_return;
     }
-    NXPLOG_API_D ("%s: Line %d. status: %d", __FUNCTION__, __LINE__, status);
-#if (NFC_SNEP_PUT_DISCONNECT == 1)
-    if (sSnepClientHandle)
-#else
-    if ((sSnepClientHandle) && (sSnepClientConnectionHandle == 0))
-#endif
-	{
-        NXPLOG_API_D ("%s: Line %d. status: %d", __FUNCTION__, __LINE__, status);
-        SyncEventGuard guard (sNfaSnepClientConnEvent);
-        if(NFA_STATUS_OK != NFA_SnepConnect(sSnepClientHandle, SNEP_SERVER_NAME))
-        {
-            NXPLOG_API_D ("%s: NFA_SnepConnect NOK", __FUNCTION__);
-            status = NFA_STATUS_FAILED;
-            goto clean_and_return;
-        }
-        sNfaSnepClientConnEvent.wait();
+    if (nativeNfcSnep_connect() != NFA_STATUS_OK)
+    {
+        status = NFA_STATUS_FAILED;
+        goto clean_and_return;
     }
 
-    NXPLOG_API_D ("%s: Line %d. status: %d", __FUNCTION__, __LINE__, status);
-    /* Send Put Request */
-    if (sSnepClientConnectionHandle != 0)
+    /* Send Put Request, behind any pending asynchronous one */
     {
-        NXPLOG_API_D ("%s: Line %d. status: %d", __FUNCTION__, __LINE__, status);
         SyncEventGuard guard (sNfaSnepClientPutMsgEvent);
-        if(NFA_STATUS_OK != NFA_SnepPut (sSnepClientConnectionHandle, length, msg))
+        sSnepClientPutState = NFA_STATUS_FAILED;
+        if(NFA_STATUS_OK != nativeNfcSnep_queuePut (msg, length, nativeNfcSnep_syncPutCompleted, NULL))
         {
             NXPLOG_API_E ("%s: NFA_SnepPut NOK", __FUNCTION__);
             status = NFA_STATUS_FAILED;
             goto clean_and_return;
         }
-        NXPLOG_API_D ("%s: Line %d. status: %d", __FUNCTION__, __LINE__, status);
         sNfaSnepClientPutMsgEvent.wait();
         if (sSnepClientPutState != NFA_STATUS_OK)
         {
@@ -659,14 +810,10 @@ INT32 nativeNfcSnep_putMessage(UINT8* msg, UINT32 length)
         }
         else
         {
-            NXPLOG_API_D ("%s: Line %d. status: %d", __FUNCTION__, __LINE__, status);
             status = NFA_STATUS_OK; // Successful push
-//            sSnepClientPutState = NFA_STATUS_FAILED; // this would be on reason makes later push fail
         }
     }
-    NXPLOG_API_D ("%s: Line %d. status: %d", __FUNCTION__, __LINE__, status);
 #if (NFC_SNEP_PUT_DISCONNECT == 1)
-    NXPLOG_API_D ("%s: Line %d. status: %d", __FUNCTION__, __LINE__, status);
     /* Disconnect from Snep Server */
     if (sSnepClientConnectionHandle != 0)
     {
@@ -685,3 +832,41 @@ clean_and_return:
     gSyncMutex.unlock();
     return status;
 }
+
+INT32 nativeNfcSnep_putMessageAsync(UINT8* msg, UINT32 length, nfcSnepPutCallback_t *callback, void *context)
+{
+    tNFA_STATUS status = NFA_STATUS_FAILED;
+    NXPLOG_API_D ("%s: data length = %d", __FUNCTION__, length);
+
+    if (!sSnepClientHandle)
+    {
+        NXPLOG_API_E ("%s: no connection", __FUNCTION__);
+        return NFA_STATUS_FAILED;
+    }
+    if (!msg || length == 0 || !callback)
+    {
+        NXPLOG_API_E ("%s: wrong param", __FUNCTION__);
+        return NFA_STATUS_FAILED;
+    }
+    if(NFA_STATUS_OK != NDEF_MsgValidate(msg, length, FALSE))
+    {
+        NXPLOG_API_E ("%s: not NDEF message", __FUNCTION__);
+        return NFA_STATUS_FAILED;
+    }
+    gSyncMutex.lock();
+    if (!nativeNfcManager_isNfcActive())
+    {
+        NXPLOG_API_E ("%s: Nfc not initialized.", __FUNCTION__);
+        goto clean_and_return;
+    }
+    /* the connection stays up for the whole P2P session */
+    if (nativeNfcSnep_connect() != NFA_STATUS_OK)
+    {
+        goto clean_and_return;
+    }
+    status = nativeNfcSnep_queuePut(msg, length, callback, context);
+clean_and_return:
+    NXPLOG_API_D ("%s: return = %d", __FUNCTION__, status);
+    gSyncMutex.unlock();
+    return status;
+}
@@ -38,6 +38,8 @@ extern void nativeNfcSnep_stopServer();
 
 extern INT32 nativeNfcSnep_putMessage(UINT8* msg, UINT32 length);
 
+extern INT32 nativeNfcSnep_putMessageAsync(UINT8* msg, UINT32 length, nfcSnepPutCallback_t *callback, void *context);
+
 extern void  nativeNfcSnep_handleNfcOnOff (BOOLEAN isOn);
 
 #ifdef __cplusplus
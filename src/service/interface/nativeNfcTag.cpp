@@ -65,6 +65,11 @@ extern "C"
 //default general trasceive timeout in millisecond
 #define DEFAULT_GENERAL_TRANS_TIMEOUT  2000
 #define DEFAULT_PRESENCE_CHECK_MDELAY 125
+#define T3T_MAX_BLOCKS_PER_READ 255    // max blocks of NFA_RwT3tRead
+#define MFC_BLOCK_SIZE          16
+#define MFC_MAX_BLOCKS          256    // MIFARE Classic 4K
+#define MFC_READ_CMD            0x30
+#define MFC_WRITE_CMD           0xA0
 
 /*****************************************************************************
 **
@@ -110,6 +115,9 @@ static BOOLEAN       sMakeReadonlyWaitingForComplete = FALSE;
 static BOOLEAN       sWriteOk = FALSE;
 static BOOLEAN       sWriteWaitingForComplete = FALSE;
 static BOOLEAN       sIsReadingNdefMessage = FALSE;
+static nfcTagNdefSegmentCallback_t *sNdefSegmentCallback = NULL; // set during streaming NDEF read
+static void          *sNdefSegmentContext = NULL;
+static BOOLEAN       sIsReadingT3tBlocks = FALSE; // set during NFA_RwT3tRead; data comes as NFA_DATA_EVT
 static BOOLEAN       sFormatOk = FALSE;
 static sem_t         sMakeReadonlySem;
 static sem_t         sFormatSem;
@@ -150,6 +158,8 @@ static INT32 reSelect (tNFA_INTF_TYPE rfInterface, BOOLEAN fSwitchIfNeeded);
 static BOOLEAN switchRfInterface(tNFA_INTF_TYPE rfInterface);
 static inline void setReconnectState(BOOLEAN flag);
 static INT32 nativeNfcTag_doReconnect ();
+static INT32 doMfcBlocks (UINT32 tagHandle, UINT8 firstBlock, UINT32 numBlocks, const nfc_mfc_key_t *keys,
+                          UINT8 *buffer, UINT32 bufferLen, UINT8 *sectorStatus, BOOLEAN isWrite);
 
 extern BOOLEAN       gActivated;
 extern SyncEvent     gDeactivatedEvent;
@@ -158,6 +168,7 @@ extern Mutex         gSyncMutex;
 void nativeNfcTag_abortWaits();
 void nativeNfcTag_resetPresenceCheck();
 void nativeNfcTag_releasePresenceCheck();
+void nativeNfcTag_doReadSegment (UINT8* buf, UINT32 bufLen, UINT32 offset, UINT32 totalLen);
 
 static void nfaVSCNtfCallback(UINT8 event, UINT16 param_len, UINT8 *p_param)
 {
@@ -785,6 +796,13 @@ static void ndefHandlerCallback (tNFA_NDEF_EVT event, tNFA_NDEF_EVT_DATA *eventD
         case NFA_NDEF_DATA_EVT:
         {
             NXPLOG_API_D ("%s: NFA_NDEF_DATA_EVT; data_len = %lu", __FUNCTION__, eventData->ndef_data.len);
+            if (sNdefSegmentCallback != NULL)
+            {
+                /* streaming read of a tag that is read as a whole (MIFARE Classic) */
+                nativeNfcTag_doReadSegment (eventData->ndef_data.p_data, eventData->ndef_data.len,
+                                            0, eventData->ndef_data.len);
+                break;
+            }
             sRxDataActualSize = eventData->ndef_data.len;
             if (sRxDataBufferLen >= sRxDataActualSize)
             {
@@ -890,6 +908,33 @@ void nativeNfcTag_doReadCompleted (tNFA_STATUS status)
 }
 
 
+/*******************************************************************************
+**
+** Function:        nativeNfcTag_doReadSegment
+**
+** Description:     Receive a segment of the NDEF message during streaming read.
+**                  Called by NFA_NDEF_SEGMENT_EVT.
+**                  buf: Segment data.
+**                  bufLen: Length of segment.
+**                  offset: Offset of segment in the NDEF message.
+**                  totalLen: Length of the NDEF message.
+**
+** Returns:         None
+**
+*******************************************************************************/
+void nativeNfcTag_doReadSegment (UINT8* buf, UINT32 bufLen, UINT32 offset, UINT32 totalLen)
+{
+    if ((sIsReadingNdefMessage == FALSE) || (sNdefSegmentCallback == NULL))
+        return; //not streaming NDEF message right now, so just return
+
+    sRxDataActualSize = offset + bufLen;
+    if (sNdefSegmentCallback (buf, bufLen, offset, totalLen, sNdefSegmentContext) != 0)
+    {
+        NXPLOG_API_D ("%s: stopped by application after %u bytes", __FUNCTION__, sRxDataActualSize);
+        NFA_RwStopNDefStream ();
+    }
+}
+
 /*******************************************************************************
 **
 ** Function:        nativeNfcTag_doTransceiveStatus
@@ -907,7 +952,24 @@ void nativeNfcTag_doTransceiveStatus (tNFA_STATUS status, UINT8* buf, UINT32 buf
     UINT32 handle = sCurrentConnectedHandle;
 
     sPresCheckRequired = FALSE;
-    
+
+    if (sIsReadingT3tBlocks)
+    {
+        // segment of T3T blocks; read completes with NFA_READ_CPLT_EVT
+        if ((status == NFA_STATUS_OK) && (sRxDataActualSize != (UINT32) -1)
+            && (sRxDataActualSize + bufLen <= sRxDataBufferLen))
+        {
+            memcpy (sRxDataBuffer + sRxDataActualSize, buf, bufLen);
+            sRxDataActualSize += bufLen;
+        }
+        else
+        {
+            NXPLOG_API_E ("%s: T3T read failed or buffer too small", __FUNCTION__);
+            sRxDataActualSize = -1;
+        }
+        return;
+    }
+
     SyncEventGuard g (sTransceiveEvent);
     NXPLOG_API_D ("%s: data len=%d", __FUNCTION__, bufLen);
     if (NfcTag::getInstance ().mTechLibNfcTypes[handle] == NFA_PROTOCOL_MIFARE)
@@ -1715,6 +1777,498 @@ End:
     return (isNdef) ? sRxDataActualSize : -1;
 }
 
+/*******************************************************************************
+**
+** Function:        nativeNfcTag_doReadNdefStream
+**
+** Description:     Read the NDEF message on the tag, passing each segment to
+**                  callback as soon as it is received from the tag.
+**                  tagHandle: tag handle.
+**                  callback: segment callback; returns non-zero to stop reading.
+**                  context: passed back to callback.
+**
+** Returns:         Number of bytes delivered, or -1 if failed.
+**
+*******************************************************************************/
+INT32 nativeNfcTag_doReadNdefStream(UINT32 tagHandle, nfcTagNdefSegmentCallback_t *callback, void *context)
+{
+    NXPLOG_API_D ("%s: enter", __FUNCTION__);
+    tNFA_STATUS status = NFA_STATUS_FAILED;
+    UINT32 handle = sCurrentConnectedHandle;
+
+    if (tagHandle != sCurrentConnectedHandle)
+    {
+        NXPLOG_API_E ("%s: Wrong tag handle!\n)", __FUNCTION__);
+        return -1;
+    }
+
+    if (callback == NULL)
+    {
+        NXPLOG_API_E ("%s: invalide callback!", __FUNCTION__);
+        return -1;
+    }
+    gSyncMutex.lock();
+    if (!nativeNfcManager_isNfcActive())
+    {
+        NXPLOG_API_E ("%s: Nfc not initialized.", __FUNCTION__);
+        goto End;
+    }
+
+    if (sCheckNdefCurrentSize == 0)
+    {
+        NXPLOG_API_D ("%s: no Ndef message", __FUNCTION__);
+        goto End;
+    }
+
+    sNdefSegmentCallback = callback;
+    sNdefSegmentContext = context;
+    sRxDataActualSize = 0;
+    {
+        SyncEventGuard g (sReadEvent);
+        sIsReadingNdefMessage = TRUE;
+        if (NfcTag::getInstance ().mTechLibNfcTypes[handle] == NFA_PROTOCOL_MIFARE)
+        {
+            status = EXTNS_MfcReadNDef();
+        }
+        else
+        {
+            status = NFA_RwReadNDefStream ();
+        }
+        if (status == NFA_STATUS_OK)
+        {
+            sReadEvent.wait (); //wait for NFA_READ_CPLT_EVT
+        }
+    }
+    sIsReadingNdefMessage = FALSE;
+    sNdefSegmentCallback = NULL;
+    sNdefSegmentContext = NULL;
+
+    if ((status == NFA_STATUS_OK) && (sRxDataActualSize == (UINT32) -1))
+    {
+        status = NFA_STATUS_FAILED;
+    }
+
+End:
+    gSyncMutex.unlock();
+    NXPLOG_API_D ("%s: exit; status=0x%X", __FUNCTION__, status);
+    return (status == NFA_STATUS_OK) ? sRxDataActualSize : -1;
+}
+
+/*******************************************************************************
+**
+** Function:        nativeNfcTag_doReadT3tBlocks
+**
+** Description:     Read blocks of a Type 3 (FeliCa) tag. The stack reads the
+**                  block list with as few CHECK commands as the tag accepts.
+**                  tagHandle: tag handle.
+**                  serviceCodes: service code of each block.
+**                  blockNumbers: block number of each block.
+**                  numBlocks: number of blocks.
+**                  rxBuffer: buffer for block data, 16 bytes per block.
+**                  rxBufferLen: length of rxBuffer.
+**
+** Returns:         Number of bytes read, or -1 if failed.
+**
+*******************************************************************************/
+INT32 nativeNfcTag_doReadT3tBlocks(UINT32 tagHandle, UINT16 *serviceCodes, UINT16 *blockNumbers, UINT32 numBlocks,
+                                   UINT8 *rxBuffer, UINT32 rxBufferLen)
+{
+    NXPLOG_API_D ("%s: enter; num blocks = %u", __FUNCTION__, numBlocks);
+    tNFA_STATUS status = NFA_STATUS_FAILED;
+    tNFA_T3T_BLOCK_DESC blocks[T3T_MAX_BLOCKS_PER_READ];
+    UINT32 i;
+
+    if (tagHandle != sCurrentConnectedHandle)
+    {
+        NXPLOG_API_E ("%s: Wrong tag handle!\n)", __FUNCTION__);
+        return -1;
+    }
+
+    if ((serviceCodes == NULL) || (blockNumbers == NULL) || (numBlocks == 0) || (numBlocks > T3T_MAX_BLOCKS_PER_READ)
+        || (rxBuffer == NULL) || (rxBufferLen < numBlocks * T3T_MSG_BLOCKSIZE))
+    {
+        NXPLOG_API_E ("%s: invalid parameter!", __FUNCTION__);
+        return -1;
+    }
+    gSyncMutex.lock();
+    if (!nativeNfcManager_isNfcActive())
+    {
+        NXPLOG_API_E ("%s: Nfc not initialized.", __FUNCTION__);
+        goto End;
+    }
+
+    if (NfcTag::getInstance ().mTechLibNfcTypes[tagHandle] != NFA_PROTOCOL_T3T)
+    {
+        NXPLOG_API_E ("%s: not a Type 3 tag", __FUNCTION__);
+        goto End;
+    }
+
+    for (i = 0; i < numBlocks; i++)
+    {
+        blocks[i].service_code = serviceCodes[i];
+        blocks[i].block_number = blockNumbers[i];
+    }
+
+    sRxDataBuffer = rxBuffer;
+    sRxDataBufferLen = rxBufferLen;
+    sRxDataActualSize = 0;
+    {
+        SyncEventGuard g (sReadEvent);
+        sIsReadingNdefMessage = TRUE;
+        sIsReadingT3tBlocks = TRUE;
+        status = NFA_RwT3tRead ((UINT8) numBlocks, blocks);
+        if (status == NFA_STATUS_OK)
+        {
+            sReadEvent.wait (); //wait for NFA_READ_CPLT_EVT
+        }
+    }
+    sIsReadingT3tBlocks = FALSE;
+    sIsReadingNdefMessage = FALSE;
+
+    if ((status == NFA_STATUS_OK) && (sRxDataActualSize == (UINT32) -1))
+    {
+        status = NFA_STATUS_FAILED;
+    }
+
+End:
+    sRxDataBuffer = NULL;
+    sRxDataBufferLen = 0;
+    gSyncMutex.unlock();
+    NXPLOG_API_D ("%s: exit; status=0x%X", __FUNCTION__, status);
+    return (status == NFA_STATUS_OK) ? sRxDataActualSize : -1;
+}
+
+/*******************************************************************************
+**
+** Function:        mfcSectorOfBlock
+**
+** Description:     Get the MIFARE Classic sector holding a block. Sectors 0-31
+**                  have 4 blocks, sectors 32-39 (4K only) have 16 blocks.
+**
+** Returns:         Sector number.
+**
+*******************************************************************************/
+static UINT32 mfcSectorOfBlock (UINT32 block)
+{
+    return (block < 128) ? (block / 4) : (32 + (block - 128) / 16);
+}
+
+/*******************************************************************************
+**
+** Function:        mfcLastBlockOfSector
+**
+** Description:     Get the last block (sector trailer) of a MIFARE Classic sector.
+**
+** Returns:         Block number.
+**
+*******************************************************************************/
+static UINT32 mfcLastBlockOfSector (UINT32 sector)
+{
+    return (sector < 32) ? (sector * 4 + 3) : (128 + (sector - 32) * 16 + 15);
+}
+
+/*******************************************************************************
+**
+** Function:        doMfcTransceive
+**
+** Description:     Send one MIFARE Classic command through the MIFARE extension
+**                  and wait for its response. gSyncMutex must be held.
+**                  txBuffer: command (same framing as nativeNfcTag_doTransceive).
+**                  rxBuffer: buffer for the raw response.
+**                  rxBufferLen: length of rxBuffer.
+**                  tagLost: set to TRUE if the tag did not answer.
+**
+** Returns:         TRUE if the tag accepted the command.
+**
+*******************************************************************************/
+static BOOLEAN doMfcTransceive (UINT8 *txBuffer, UINT32 txBufferLen, UINT8 *rxBuffer, UINT32 rxBufferLen,
+                                BOOLEAN *tagLost)
+{
+    tNFA_STATUS status = NFA_STATUS_FAILED;
+    BOOLEAN waitOk = FALSE;
+    UINT8 *resp;
+    uint32_t respLen;
+
+    {
+        SyncEventGuard g (sTransceiveEvent);
+        sTransceiveRfTimeout = FALSE;
+        sWaitingForTransceive = TRUE;
+        sRxDataBuffer = rxBuffer;
+        sRxDataBufferLen = rxBufferLen;
+        sRxDataActualSize = 0;
+        status = EXTNS_MfcTransceive ((uint8_t *)txBuffer, (uint32_t)txBufferLen);
+        if (status == NFA_STATUS_OK)
+        {
+            waitOk = sTransceiveEvent.wait (DEFAULT_GENERAL_TRANS_TIMEOUT);
+        }
+    }
+    sWaitingForTransceive = FALSE;
+
+    if (status != NFA_STATUS_OK)
+    {
+        NXPLOG_API_E ("%s: fail send; error=%d", __FUNCTION__, status);
+        return FALSE;
+    }
+    if (waitOk == FALSE || sTransceiveRfTimeout)
+    {
+        NXPLOG_API_E ("%s: wait response timeout", __FUNCTION__);
+        doDisconnect ();
+        *tagLost = TRUE;
+        return FALSE;
+    }
+    if (NfcTag::getInstance ().getActivationState () != NfcTag::Active)
+    {
+        NXPLOG_API_E ("%s: already deactivated", __FUNCTION__);
+        *tagLost = TRUE;
+        return FALSE;
+    }
+    if (sRxDataActualSize == 0)
+    {
+        return FALSE;
+    }
+
+    resp = rxBuffer;
+    respLen = sRxDataActualSize;
+    return (EXTNS_CheckMfcResponse (&resp, &respLen) == NFCSTATUS_SUCCESS) ? TRUE : FALSE;
+}
+
+/*******************************************************************************
+**
+** Function:        doMfcBlocks
+**
+** Description:     Read or write a range of MIFARE Classic blocks. Each sector
+**                  is authenticated once with its key, then all its blocks of
+**                  the range are accessed back to back. A failing sector halts
+**                  the card, which is woken up again before the next sector.
+**                  tagHandle: tag handle.
+**                  firstBlock: first block of the range.
+**                  numBlocks: number of blocks.
+**                  keys: one key per sector of the range.
+**                  buffer: block data, 16 bytes per block.
+**                  bufferLen: length of buffer.
+**                  sectorStatus: for return, MFC_SECTOR_* per sector (may be NULL).
+**                  isWrite: TRUE to write the blocks, FALSE to read them.
+**
+** Returns:         Number of sectors accessed successfully, or -1 if failed.
+**
+*******************************************************************************/
+static INT32 doMfcBlocks (UINT32 tagHandle, UINT8 firstBlock, UINT32 numBlocks, const nfc_mfc_key_t *keys,
+                          UINT8 *buffer, UINT32 bufferLen, UINT8 *sectorStatus, BOOLEAN isWrite)
+{
+    NfcTag& natTag = NfcTag::getInstance ();
+    UINT8 cmd[2 + MFC_BLOCK_SIZE];
+    UINT8 resp[2 + MFC_BLOCK_SIZE];
+    UINT8 *uid = NULL;
+    UINT32 uidLen = 0;
+    UINT32 lastBlock = firstBlock + numBlocks - 1;
+    UINT32 firstSector = mfcSectorOfBlock (firstBlock);
+    UINT32 sector;
+    UINT32 block = firstBlock;
+    BOOLEAN tagLost = FALSE;
+    INT32 sectorsOk = -1;
+
+    if (tagHandle != sCurrentConnectedHandle)
+    {
+        NXPLOG_API_E ("%s: Wrong tag handle!\n)", __FUNCTION__);
+        return -1;
+    }
+    if ((keys == NULL) || (buffer == NULL) || (numBlocks == 0) || (firstBlock + numBlocks > MFC_MAX_BLOCKS)
+        || (bufferLen < numBlocks * MFC_BLOCK_SIZE))
+    {
+        NXPLOG_API_E ("%s: invalid parameter!", __FUNCTION__);
+        return -1;
+    }
+
+    gSyncMutex.lock();
+    if (!nativeNfcManager_isNfcActive())
+    {
+        NXPLOG_API_E ("%s: Nfc not initialized.", __FUNCTION__);
+        goto End;
+    }
+    if (natTag.mTechLibNfcTypes[tagHandle] != NFA_PROTOCOL_MIFARE)
+    {
+        NXPLOG_API_E ("%s: not a MIFARE Classic tag", __FUNCTION__);
+        goto End;
+    }
+    if (sRxDataBuffer != NULL)
+    {
+        NXPLOG_API_E ("%s: !!!! sRxDataBuffer must be NULL!", __FUNCTION__);
+    }
+    if (doReconnectFlag == 0)
+    {
+        nativeNfcTag_doReconnect ();
+        doReconnectFlag = 0x01;
+    }
+    if (natTag.getActivationState () != NfcTag::Active)
+    {
+        NXPLOG_API_E ("%s: tag not active", __FUNCTION__);
+        goto End;
+    }
+
+    sSwitchBackTimer.kill ();
+    natTag.getTypeATagUID (&uid, &uidLen);
+    sectorsOk = 0;
+    for (sector = firstSector; block <= lastBlock; sector++)
+    {
+        const nfc_mfc_key_t *key = &keys[sector - firstSector];
+        UINT32 sectorEnd = mfcLastBlockOfSector (sector);
+        UINT8 status = MFC_SECTOR_OK;
+
+        if (sectorEnd > lastBlock)
+        {
+            sectorEnd = lastBlock;
+        }
+
+        if (tagLost)
+        {
+            status = MFC_SECTOR_IO_FAILED;
+        }
+        else
+        {
+            /* authenticate once for the whole sector */
+            memset (cmd, 0, sizeof(cmd));
+            cmd[0] = key->key_type;
+            cmd[1] = (UINT8) block;
+            if ((uid != NULL) && (uidLen >= 4))
+            {
+                memcpy (&cmd[2], &uid[uidLen - 4], 4);
+            }
+            memcpy (&cmd[6], key->key, sizeof(key->key));
+            if (!doMfcTransceive (cmd, 12, resp, sizeof(resp), &tagLost))
+            {
+                NXPLOG_API_E ("%s: authentication of sector %u failed", __FUNCTION__, sector);
+                status = MFC_SECTOR_AUTH_FAILED;
+            }
+        }
+
+        for (; block <= sectorEnd; block++)
+        {
+            UINT8 *data = buffer + (block - firstBlock) * MFC_BLOCK_SIZE;
+
+            if (status != MFC_SECTOR_OK)
+            {
+                if (!isWrite)
+                {
+                    memset (data, 0, MFC_BLOCK_SIZE);
+                }
+                continue;
+            }
+            cmd[1] = (UINT8) block;
+            if (isWrite)
+            {
+                cmd[0] = MFC_WRITE_CMD;
+                memcpy (&cmd[2], data, MFC_BLOCK_SIZE);
+                if (!doMfcTransceive (cmd, 2 + MFC_BLOCK_SIZE, resp, sizeof(resp), &tagLost))
+                {
+                    status = MFC_SECTOR_IO_FAILED;
+                }
+            }
+            else
+            {
+                cmd[0] = MFC_READ_CMD;
+                if (doMfcTransceive (cmd, 2, resp, sizeof(resp), &tagLost)
+                    && (sRxDataActualSize >= 1 + MFC_BLOCK_SIZE))
+                {
+                    memcpy (data, &resp[1], MFC_BLOCK_SIZE);
+                }
+                else
+                {
+                    status = MFC_SECTOR_IO_FAILED;
+                }
+            }
+            if (status != MFC_SECTOR_OK)
+            {
+                NXPLOG_API_E ("%s: access to block %u failed", __FUNCTION__, block);
+                if (!isWrite)
+                {
+                    memset (data, 0, MFC_BLOCK_SIZE);
+                }
+            }
+        }
+
+        if (status == MFC_SECTOR_OK)
+        {
+            sectorsOk++;
+        }
+        else if (!tagLost)
+        {
+            /* the card halts after an error; wake it up for the next sector */
+            nativeNfcTag_doReconnect ();
+        }
+        if (sectorStatus != NULL)
+        {
+            sectorStatus[sector - firstSector] = status;
+        }
+    }
+
+End:
+    sRxDataBuffer = NULL;
+    sRxDataBufferLen = 0;
+    gSyncMutex.unlock();
+    NXPLOG_API_D ("%s: exit; sectors ok=%d", __FUNCTION__, sectorsOk);
+    return sectorsOk;
+}
+
+/*******************************************************************************
+**
+** Function:        nativeNfcTag_doReadMfcBlocks
+**
+** Description:     Read a range of blocks of a MIFARE Classic tag. Each sector
+**                  is authenticated once; blocks of failed sectors are zero-filled.
+**                  tagHandle: tag handle.
+**                  firstBlock: first block to read.
+**                  numBlocks: number of blocks.
+**                  keys: one key per sector of the range.
+**                  rxBuffer: buffer for block data, 16 bytes per block.
+**                  rxBufferLen: length of rxBuffer.
+**                  sectorStatus: for return, MFC_SECTOR_* per sector (may be NULL).
+**
+** Returns:         Number of bytes read, or -1 if no sector could be read.
+**
+*******************************************************************************/
+INT32 nativeNfcTag_doReadMfcBlocks(UINT32 tagHandle, UINT8 firstBlock, UINT32 numBlocks, const nfc_mfc_key_t *keys,
+                                   UINT8 *rxBuffer, UINT32 rxBufferLen, UINT8 *sectorStatus)
+{
+    NXPLOG_API_D ("%s: enter; first block = %u, num blocks = %u", __FUNCTION__, firstBlock, numBlocks);
+    INT32 sectorsOk = doMfcBlocks (tagHandle, firstBlock, numBlocks, keys, rxBuffer, rxBufferLen, sectorStatus, FALSE);
+
+    return (sectorsOk > 0) ? (INT32) (numBlocks * MFC_BLOCK_SIZE) : -1;
+}
+
+/*******************************************************************************
+**
+** Function:        nativeNfcTag_doWriteMfcBlocks
+**
+** Description:     Write a range of blocks of a MIFARE Classic tag. Each sector
+**                  is authenticated once.
+**                  tagHandle: tag handle.
+**                  firstBlock: first block to write.
+**                  numBlocks: number of blocks.
+**                  keys: one key per sector of the range.
+**                  txBuffer: block data, 16 bytes per block.
+**                  txBufferLen: length of txBuffer.
+**                  sectorStatus: for return, MFC_SECTOR_* per sector (may be NULL).
+**
+** Returns:         0 if all sectors were written, or -1 if failed.
+**
+*******************************************************************************/
+INT32 nativeNfcTag_doWriteMfcBlocks(UINT32 tagHandle, UINT8 firstBlock, UINT32 numBlocks, const nfc_mfc_key_t *keys,
+                                    const UINT8 *txBuffer, UINT32 txBufferLen, UINT8 *sectorStatus)
+{
+    NXPLOG_API_D ("%s: enter; first block = %u, num blocks = %u", __FUNCTION__, firstBlock, numBlocks);
+    INT32 sectorsOk;
+
+    if (numBlocks == 0)
+    {
+        return -1;
+    }
+    sectorsOk = doMfcBlocks (tagHandle, firstBlock, numBlocks, keys, (UINT8 *) txBuffer, txBufferLen,
+                             sectorStatus, TRUE);
+
+    return (sectorsOk == (INT32) (mfcSectorOfBlock (firstBlock + numBlocks - 1) - mfcSectorOfBlock (firstBlock) + 1)) ?
+           0 : -1;
+}
+
 /*******************************************************************************
 **
 ** Function:        writeNdef
@@ -52,6 +52,61 @@ extern BOOLEAN nativeNfcTag_checkNdef(UINT32 tagHandle, ndef_info_t *info);
 *******************************************************************************/
 extern INT32 nativeNfcTag_doReadNdef(UINT32 tagHandle, UINT8* ndefBuffer,  UINT32 ndefBufferLength, nfc_friendly_type_t *friendly_ndef_type);
 
+/*******************************************************************************
+**
+** Function:        nativeNfcTag_doReadNdefStream
+**
+** Description:     Read the NDEF message on the tag, passing each segment to
+**                  callback as soon as it is received from the tag.
+**                  tagHandle: tag handle.
+**
+** Returns:         Number of bytes delivered, or -1 if failed.
+**
+*******************************************************************************/
+extern INT32 nativeNfcTag_doReadNdefStream(UINT32 tagHandle, nfcTagNdefSegmentCallback_t *callback, void *context);
+
+/*******************************************************************************
+**
+** Function:        nativeNfcTag_doReadT3tBlocks
+**
+** Description:     Read blocks of a Type 3 (FeliCa) tag, possibly from several
+**                  services.
+**                  tagHandle: tag handle.
+**
+** Returns:         Number of bytes read, or -1 if failed.
+**
+*******************************************************************************/
+extern INT32 nativeNfcTag_doReadT3tBlocks(UINT32 tagHandle, UINT16 *serviceCodes, UINT16 *blockNumbers, UINT32 numBlocks,
+                                          UINT8 *rxBuffer, UINT32 rxBufferLen);
+
+/*******************************************************************************
+**
+** Function:        nativeNfcTag_doReadMfcBlocks
+**
+** Description:     Read a range of blocks of a MIFARE Classic tag,
+**                  authenticating each sector once.
+**                  tagHandle: tag handle.
+**
+** Returns:         Number of bytes read, or -1 if no sector could be read.
+**
+*******************************************************************************/
+extern INT32 nativeNfcTag_doReadMfcBlocks(UINT32 tagHandle, UINT8 firstBlock, UINT32 numBlocks, const nfc_mfc_key_t *keys,
+                                          UINT8 *rxBuffer, UINT32 rxBufferLen, UINT8 *sectorStatus);
+
+/*******************************************************************************
+**
+** Function:        nativeNfcTag_doWriteMfcBlocks
+**
+** Description:     Write a range of blocks of a MIFARE Classic tag,
+**                  authenticating each sector once.
+**                  tagHandle: tag handle.
+**
+** Returns:         0 if all sectors were written, or -1 if failed.
+**
+*******************************************************************************/
+extern INT32 nativeNfcTag_doWriteMfcBlocks(UINT32 tagHandle, UINT8 firstBlock, UINT32 numBlocks, const nfc_mfc_key_t *keys,
+                                           const UINT8 *txBuffer, UINT32 txBufferLen, UINT8 *sectorStatus);
+
 /*******************************************************************************
 **
 ** Function:        writeNdef
@@ -48,7 +48,7 @@ int ndef_readHandoverRequestInfo(unsigned char *ndef_buff, unsigned int ndef_buf
 int ndef_createUri(char *uri, unsigned char *out_ndef_buff, unsigned int out_ndef_buff_length)
 {
     int size;
-    if (uri == NULL || out_ndef_buff == NULL || out_ndef_buff_length <= 0)
+    if (uri == NULL || (out_ndef_buff != NULL && out_ndef_buff_length == 0))
     {
         return 0;
     }
@@ -60,7 +60,7 @@ int ndef_createText(char *language_code, char *text,
                                                     unsigned char *out_ndef_buff, unsigned int out_ndef_buff_length)
 {
     int size;
-    if (text == NULL || out_ndef_buff == NULL || out_ndef_buff_length <= 0)
+    if (text == NULL || (out_ndef_buff != NULL && out_ndef_buff_length == 0))
     {
         return 0;
     }
@@ -72,7 +72,7 @@ int ndef_createMime(char *mime_type, unsigned char *mime_data, unsigned int mime
                                                     unsigned char *out_ndef_buff, unsigned int out_ndef_buff_length)
 {
     int size;
-    if (mime_type == NULL || mime_data == NULL || out_ndef_buff == NULL || out_ndef_buff_length == 0)
+    if (mime_type == NULL || mime_data == NULL || (out_ndef_buff != NULL && out_ndef_buff_length == 0))
     {
         return 0;
     }
@@ -86,7 +86,7 @@ int ndef_createHandoverSelect(nfc_handover_cps_t cps, char *carrier_data_ref,
     int size;
     if (ndef_buff == NULL || ndef_buff_length == 0 
             || carrier_data_ref == NULL
-            || out_ndef_buff == NULL || out_ndef_buff_length == 0)
+            || (out_ndef_buff != NULL && out_ndef_buff_length == 0))
     {
         return 0;
     }
@@ -108,6 +108,57 @@ int nfcTag_readNdef(unsigned int handle, unsigned char *ndef_buffer,  unsigned i
     return ret;
 }
 
+int nfcTag_readNdefStream(unsigned int handle, nfcTagNdefSegmentCallback_t *callback, void *context)
+{
+    int ret;
+    if (callback == NULL)
+    {
+        return -1;
+    }
+    ret = nativeNfcTag_doReadNdefStream(handle, callback, context);
+    return ret;
+}
+
+int nfcTag_readFelicaBlocks(unsigned int handle, unsigned short *service_codes, unsigned short *block_numbers,
+                            unsigned int num_blocks, unsigned char *rx_buffer, unsigned int rx_buffer_length)
+{
+    int ret;
+    if (service_codes == NULL || block_numbers == NULL || rx_buffer == NULL)
+    {
+        return -1;
+    }
+    ret = nativeNfcTag_doReadT3tBlocks(handle, service_codes, block_numbers, num_blocks, rx_buffer, rx_buffer_length);
+    return ret;
+}
+
+int nfcTag_readMifareClassicBlocks(unsigned int handle, unsigned char first_block, unsigned int num_blocks,
+                                   const nfc_mfc_key_t *keys, unsigned char *rx_buffer,
+                                   unsigned int rx_buffer_length, unsigned char *sector_status)
+{
+    int ret;
+    if (keys == NULL || rx_buffer == NULL)
+    {
+        return -1;
+    }
+    ret = nativeNfcTag_doReadMfcBlocks(handle, first_block, num_blocks, keys, rx_buffer, rx_buffer_length,
+                                       sector_status);
+    return ret;
+}
+
+int nfcTag_writeMifareClassicBlocks(unsigned int handle, unsigned char first_block, unsigned int num_blocks,
+                                    const nfc_mfc_key_t *keys, const unsigned char *tx_buffer,
+                                    unsigned int tx_buffer_length, unsigned char *sector_status)
+{
+    int ret;
+    if (keys == NULL || tx_buffer == NULL)
+    {
+        return -1;
+    }
+    ret = nativeNfcTag_doWriteMfcBlocks(handle, first_block, num_blocks, keys, tx_buffer, tx_buffer_length,
+                                        sector_status);
+    return ret;
+}
+
 int nfcTag_writeNdef(unsigned int handle, unsigned char *ndef_buffer, unsigned int ndef_buffer_length)
 {
     int ret;
@@ -207,6 +258,20 @@ int nfcManager_getNumTags(void)
 	return nativeNfcManager_getNumTags();
 }
 
+int nfcManager_getTagInventory(nfc_tag_info_t *tags, unsigned int max_tags)
+{
+    if (tags == NULL)
+    {
+        return -1;
+    }
+    return nativeNfcManager_getTagInventory(tags, max_tags);
+}
+
+int nfcManager_selectTag(unsigned int handle)
+{
+    return nativeNfcManager_selectTag(handle);
+}
+
 int nfcManager_getFwVersion ()
 {
     tNFC_FW_VERSION fwVer = {0};
@@ -214,6 +279,59 @@ int nfcManager_getFwVersion ()
     return ((fwVer.rom_code_version & 0xFF ) << 16) | ((fwVer.major_version & 0xFF ) << 8) | (fwVer.minor_version & 0xFF);
 }
 
+int nfcManager_setAdaptivePolling(int enable, unsigned char rare_freq, unsigned char sweep_interval)
+{
+    return nativeNfcManager_setAdaptivePolling(enable ? TRUE : FALSE, rare_freq, sweep_interval);
+}
+
+int nfcManager_getPollingStats(nfc_polling_stats_t *stats)
+{
+    if (stats == NULL)
+    {
+        return -1;
+    }
+    nativeNfcManager_getPollingStats(stats);
+    return 0;
+}
+
+int nfcManager_setLowPowerCardDetection(int enable, unsigned char threshold, unsigned char fallback_count)
+{
+    return nativeNfcManager_setLowPowerCardDetection(enable ? TRUE : FALSE, threshold, fallback_count);
+}
+
+int nfcManager_getStallReport(nfc_stall_info_t *stalls, unsigned int max_stalls, int reset)
+{
+    if (stalls == NULL)
+    {
+        return -1;
+    }
+    return nativeNfcManager_getStallReport(stalls, max_stalls, reset ? TRUE : FALSE);
+}
+
+int nfcManager_setRfTelemetry(int enable, unsigned int interval_ms)
+{
+    return nativeNfcManager_setRfTelemetry(enable ? TRUE : FALSE, interval_ms);
+}
+
+void nfcManager_registerRfTelemetryCallback(nfcRfTelemetryCallback_t *callback)
+{
+    nativeNfcManager_registerRfTelemetryCallback(callback);
+}
+
+void nfcManager_deregisterRfTelemetryCallback()
+{
+    nativeNfcManager_deregisterRfTelemetryCallback();
+}
+
+int nfcManager_getRfTelemetry(nfc_rf_telemetry_t *samples, unsigned int max_samples)
+{
+    if (samples == NULL)
+    {
+        return -1;
+    }
+    return nativeNfcManager_getRfTelemetry(samples, max_samples);
+}
+
 int nfcSnep_registerClientCallback(nfcSnepClientCallback_t *client_callback)
 {
     return nativeNfcSnep_registerClientCallback(client_callback);
@@ -238,6 +356,15 @@ int nfcSnep_putMessage(unsigned char* msg, unsigned int length)
     return nativeNfcSnep_putMessage(msg, length);
 }
 
+int nfcSnep_putMessageAsync(unsigned char* msg, unsigned int length, nfcSnepPutCallback_t *callback, void *context)
+{
+    if (callback == NULL)
+    {
+        return -1;
+    }
+    return nativeNfcSnep_putMessageAsync(msg, length, callback, context);
+}
+
 void nfcHce_registerHceCallback(nfcHostCardEmulationCallback_t *callback)
 {
     nativeNfcManager_registerHostCallback(callback);
@@ -262,7 +389,32 @@ void nfcHce_registerT3tIdentifier (UINT8 *Id, UINT8 Idsize)
 
 int nfcHce_sendCommand(unsigned char* command, unsigned int command_length)
 {
-    return nativeNfcManager_sendRawFrame(command, command_length);
+    return nativeNfcManager_sendHceResponse(command, command_length);
+}
+
+int nfcHce_getStats(nfc_hce_stats_t *stats)
+{
+    if (stats == NULL)
+    {
+        return -1;
+    }
+    nativeNfcManager_getHceStats(stats);
+    return 0;
+}
+
+int nfcHce_addApduResponse(unsigned char* command, unsigned char* mask, unsigned int command_length,
+                           unsigned char* response, unsigned int response_length)
+{
+    if (command == NULL || response == NULL)
+    {
+        return -1;
+    }
+    return nativeNfcManager_addHceApduResponse(command, mask, command_length, response, response_length);
+}
+
+int nfcHce_clearApduResponses()
+{
+    return nativeNfcManager_clearHceApduResponses();
 }
 
 int nfcHo_registerCallback(nfcHandoverCallback_t *callback)
@@ -317,5 +469,85 @@ int nfcLlcp_ConnLessSendMessage(unsigned char* msg, unsigned int length)
 
 int nfcLlcp_ConnLessReceiveMessage(unsigned char* msg, unsigned int *length)
 {
-    return nativeNfcLlcp_ConnLessReceiveMessage(msg, length);
+    UINT32 len;
+    int status;
+
+    if (msg == NULL || length == NULL)
+    {
+        return -1;
+    }
+    len = *length;
+    status = nativeNfcLlcp_ConnLessReceiveMessage(msg, &len);
+    *length = (unsigned int) len;
+    return status;
+}
+
+int nfcLlcp_ConnLessPeekMessage(unsigned int *length)
+{
+    UINT32 len = 0;
+    int status;
+
+    if (length == NULL)
+    {
+        return -1;
+    }
+    status = nativeNfcLlcp_ConnLessPeekMessage(&len);
+    *length = (unsigned int) len;
+    return status;
+}
+
+int nfcLlcp_ConnLessTryReceiveMessage(unsigned char* msg, unsigned int *length)
+{
+    UINT32 len;
+    int status;
+
+    if (msg == NULL || length == NULL)
+    {
+        return -1;
+    }
+    len = *length;
+    status = nativeNfcLlcp_ConnLessTryReceiveMessage(msg, &len);
+    *length = (unsigned int) len;
+    return status;
+}
+
+int nfcLlcp_ConnLessSetDataCallback(nfcLlcpConnLessDataCallback_t *data_callback)
+{
+    return nativeNfcLlcp_ConnLessSetDataCallback(data_callback);
+}
+
+int nfcLlcp_ConnLessGetRxStats(nfc_llcp_connless_rx_stats_t *stats)
+{
+    if (stats == NULL)
+    {
+        return -1;
+    }
+    return nativeNfcLlcp_ConnLessGetRxStats(stats);
+}
+
+int nfcLlcp_setConfig(const nfc_llcp_config_t *config)
+{
+    if (config == NULL)
+    {
+        return -1;
+    }
+    return nativeNfcLlcp_setConfig(config);
+}
+
+int nfcLlcp_getConfig(nfc_llcp_config_t *config)
+{
+    if (config == NULL)
+    {
+        return -1;
+    }
+    return nativeNfcLlcp_getConfig(config);
+}
+
+int nfcLlcp_getLinkStats(nfc_llcp_link_stats_t *stats)
+{
+    if (stats == NULL)
+    {
+        return -1;
+    }
+    return nativeNfcLlcp_getLinkStats(stats);
 }